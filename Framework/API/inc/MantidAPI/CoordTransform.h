@@ -37,6 +37,10 @@ public:
   /// Wrapper for VMD
   Mantid::Kernel::VMD applyVMD(const Mantid::Kernel::VMD &inputVector) const;
 
+  /// Transform many vectors at once
+  virtual void applyBatch(const coord_t *inputVectors, size_t inputStride,
+                          size_t numVectors, coord_t *outVectors) const;
+
   /// @return the number of input dimensions
   size_t getInD() const { return inD; };
 
@@ -7,6 +7,7 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -30,6 +31,12 @@ class SpectrumInfo;
   DetectorInfo provides easy access to commonly used parameters of individual
   detectors, such as mask and monitor flags, L1, L2, and 2-theta.
 
+  Detector positions and monitor flags are gathered into flat arrays on first
+  access, so repeated queries do not need to construct parameterized detectors.
+  L2 and 2-theta are derived from the cached positions. Mask flags are looked
+  up directly in the ParameterMap on every call, since many algorithms set them
+  via the map.
+
   This class is thread safe with OpenMP BUT NOT WITH ANY OTHER THREADING LIBRARY
   such as Poco threads or Intel TBB.
 
@@ -94,9 +101,6 @@ private:
   const Geometry::IDetector &getDetector(const size_t index) const;
   boost::shared_ptr<const Geometry::IDetector>
   getDetectorPtr(const size_t index) const;
-  void setCachedDetector(
-      size_t index,
-      boost::shared_ptr<const Geometry::IDetector> detector) const;
   const Geometry::IComponent &getSource() const;
   const Geometry::IComponent &getSample() const;
 
@@ -108,9 +112,13 @@ private:
   void doCacheSource() const;
   void doCacheSample() const;
   void cacheL1() const;
+  void cacheDetectors() const;
+  void invalidateDetectors();
 
   Geometry::ParameterMap *m_pmap;
   boost::shared_ptr<const Geometry::Instrument> m_instrument;
+  /// The map wrapped in m_instrument, used for direct mask flag lookups.
+  const Geometry::ParameterMap *m_parameterMap{nullptr};
   std::vector<detid_t> m_detectorIDs;
   std::unordered_map<detid_t, size_t> m_detIDToIndex;
   // The following variables are mutable, since they are initialized (cached)
@@ -126,6 +134,13 @@ private:
   mutable std::once_flag m_sampleCached;
   mutable std::once_flag m_L1Cached;
 
+  // Flat per-detector data, filled on first access by cacheDetectors().
+  mutable std::vector<const Geometry::IComponent *> m_baseDetectors;
+  mutable std::vector<Kernel::V3D> m_positions;
+  mutable std::vector<char> m_isMonitor;
+  mutable std::atomic<bool> m_detectorsCached{false};
+  mutable std::mutex m_detectorsMutex;
+
   mutable std::vector<boost::shared_ptr<const Geometry::IDetector>>
       m_lastDetector;
   mutable std::vector<size_t> m_lastIndex;
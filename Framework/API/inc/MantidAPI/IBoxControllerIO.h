@@ -67,6 +67,22 @@ public:
   virtual void loadBlock(std::vector<double> & /* Block */,
                          const uint64_t /*blockPosition*/,
                          const size_t /*BlockSize*/) const = 0;
+  /** Get a pointer to a float data block in a memory-mapped file, which
+   * avoids copying the data. The default implementation maps nothing.
+   * @return false if the block is not available in memory, in which case
+   * loadBlock has to be used */
+  virtual bool getMappedBlock(const float *& /* Block */,
+                              const uint64_t /*blockPosition*/,
+                              const size_t /*BlockSize*/) const {
+    return false;
+  }
+  /** Get a pointer to a double data block in a memory-mapped file
+   * @return false if the block is not available in memory */
+  virtual bool getMappedBlock(const double *& /* Block */,
+                              const uint64_t /*blockPosition*/,
+                              const size_t /*BlockSize*/) const {
+    return false;
+  }
 
   /** flush the IO buffers */
   virtual void flushData() const = 0;
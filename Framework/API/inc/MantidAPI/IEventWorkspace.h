@@ -61,6 +61,8 @@ public:
                          MantidVec &Y, MantidVec &E,
                          bool skipError = false) const override = 0;
 
+  /// Drop the cached histograms. Only needed after writing to events through
+  /// references obtained before the histograms were last read.
   virtual void clearMRU() const = 0;
 
 protected:
@@ -45,6 +45,8 @@ public:
   std::map<specnum_t, Kernel::V3D> getNeighbours(specnum_t spec,
                                                  const double radius) const;
   std::map<specnum_t, Kernel::V3D> getNeighboursExact(specnum_t spec) const;
+  std::vector<std::map<specnum_t, Kernel::V3D>>
+  getNeighboursExact(const std::vector<specnum_t> &spectra) const;
 
 private:
   const MatrixWorkspace &m_workspace;
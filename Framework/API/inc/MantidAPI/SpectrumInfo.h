@@ -29,6 +29,10 @@ class MatrixWorkspace;
   spectra (which may correspond to one or more detectors), such as mask and
   monitor flags, L1, L2, and 2-theta.
 
+  Per-spectrum values are computed from the flat per-detector data held by
+  DetectorInfo, without constructing a DetectorGroup. Results are not cached
+  per spectrum, since the detector IDs of a spectrum can change at any time.
+
   This class is thread safe with OpenMP BUT NOT WITH ANY OTHER THREADING LIBRARY
   such as Poco threads or Intel TBB.
 
@@ -85,8 +89,7 @@ public:
 
 private:
   const Geometry::IDetector &getDetector(const size_t index) const;
-  std::vector<boost::shared_ptr<const Geometry::IDetector>>
-  getDetectorVector(const size_t index) const;
+  const std::vector<size_t> &getDetectorIndices(const size_t index) const;
 
   const MatrixWorkspace &m_workspace;
   DetectorInfo *m_mutableDetectorInfo{nullptr};
@@ -94,6 +97,7 @@ private:
   mutable std::vector<boost::shared_ptr<const Geometry::IDetector>>
       m_lastDetector;
   mutable std::vector<size_t> m_lastIndex;
+  mutable std::vector<std::vector<size_t>> m_detectorIndices;
 };
 
 } // namespace API
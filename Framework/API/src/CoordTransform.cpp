@@ -52,5 +52,27 @@ CoordTransform::applyVMD(const Mantid::Kernel::VMD &inputVector) const {
   return out;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the transformation to many input vectors, e.g. the centers of all
+ * events in a box. The default calls apply() for each vector; subclasses
+ * override it to avoid the per-vector virtual call.
+ *
+ * @param inputVectors :: the first input vector, of size inD
+ * @param inputStride :: distance in BYTES between consecutive input vectors.
+ *        sizeof(MDLeanEvent<nd>) transforms the centers of a vector of events
+ *        starting at the center of the first event.
+ * @param numVectors :: number of vectors to transform
+ * @param outVectors :: contiguous array of numVectors * outD output
+ *        coordinates
+ */
+void CoordTransform::applyBatch(const coord_t *inputVectors,
+                                size_t inputStride, size_t numVectors,
+                                coord_t *outVectors) const {
+  const char *input = reinterpret_cast<const char *>(inputVectors);
+  for (size_t i = 0; i < numVectors; ++i, input += inputStride)
+    this->apply(reinterpret_cast<const coord_t *>(input),
+                outVectors + i * outD);
+}
+
 } // namespace Mantid
 } // namespace API
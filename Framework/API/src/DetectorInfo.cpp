@@ -2,6 +2,7 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/ComponentHelper.h"
 #include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/MultiThreaded.h"
@@ -27,6 +28,9 @@ DetectorInfo::DetectorInfo(
   if (!m_instrument)
     throw std::runtime_error("Workspace does not contain an instrument!");
 
+  if (m_instrument->isParametrized())
+    m_parameterMap = m_instrument->getParameterMap().get();
+
   m_detectorIDs = instrument->getDetectorIDs(false /* do not skip monitors */);
   for (size_t i = 0; i < m_detectorIDs.size(); ++i)
     m_detIDToIndex[m_detectorIDs[i]] = i;
@@ -34,12 +38,19 @@ DetectorInfo::DetectorInfo(
 
 /// Returns true if the detector is a monitor.
 bool DetectorInfo::isMonitor(const size_t index) const {
-  return getDetector(index).isMonitor();
+  cacheDetectors();
+  return m_isMonitor[index] != 0;
 }
 
 /// Returns true if the detector is a masked.
 bool DetectorInfo::isMasked(const size_t index) const {
-  return getDetector(index).isMasked();
+  if (!m_parameterMap)
+    return false;
+  cacheDetectors();
+  // Same lookup as Detector::isMasked(), but without creating a parameterized
+  // detector.
+  const auto masked = m_parameterMap->get(m_baseDetectors[index], "masked");
+  return masked && masked->value<bool>();
 }
 
 /** Returns L2 (distance from sample to spectrum).
@@ -49,9 +60,9 @@ bool DetectorInfo::isMasked(const size_t index) const {
  */
 double DetectorInfo::l2(const size_t index) const {
   if (!isMonitor(index))
-    return getDetector(index).getDistance(getSample());
+    return position(index).distance(samplePosition());
   else
-    return getDetector(index).getDistance(getSource()) - l1();
+    return position(index).distance(sourcePosition()) - l1();
 }
 
 /// Returns 2 theta (scattering angle w.r.t. to beam direction).
@@ -64,7 +75,8 @@ double DetectorInfo::twoTheta(const size_t index) const {
         "Source and sample are at same position!");
   }
 
-  return getDetector(index).getTwoTheta(samplePos, beamLine);
+  const Kernel::V3D sampleDetVec = position(index) - samplePos;
+  return sampleDetVec.angle(beamLine);
 }
 
 /// Returns signed 2 theta (signed scattering angle w.r.t. to beam direction).
@@ -79,13 +91,20 @@ double DetectorInfo::signedTwoTheta(const size_t index) const {
   // Get the instrument up axis.
   const Kernel::V3D &instrumentUpAxis =
       m_instrument->getReferenceFrame()->vecPointingUp();
-  return getDetector(index)
-      .getSignedTwoTheta(samplePos, beamLine, instrumentUpAxis);
+  const Kernel::V3D sampleDetVec = position(index) - samplePos;
+  double angle = sampleDetVec.angle(beamLine);
+
+  const Kernel::V3D cross = beamLine.cross_prod(sampleDetVec);
+  const Kernel::V3D normToSurface = beamLine.cross_prod(instrumentUpAxis);
+  if (normToSurface.scalar_prod(cross) < 0)
+    angle *= -1;
+  return angle;
 }
 
 /// Returns the position of the detector with given index.
 Kernel::V3D DetectorInfo::position(const size_t index) const {
-  return getDetector(index).getPos();
+  cacheDetectors();
+  return m_positions[index];
 }
 
 /// Returns the rotation of the detector with given index.
@@ -100,6 +119,8 @@ void DetectorInfo::setPosition(const size_t index,
   using namespace Geometry::ComponentHelper;
   TransformType positionType = Absolute;
   moveComponent(det, *m_pmap, position, positionType);
+  if (m_detectorsCached)
+    m_positions[index] = det.getPos();
 }
 
 /// Set the absolute rotation of the detector with given index.
@@ -121,7 +142,11 @@ void DetectorInfo::setPosition(const Geometry::IComponent &comp,
   TransformType positionType = Absolute;
   moveComponent(comp, *m_pmap, pos, positionType);
 
-  if (!dynamic_cast<const Geometry::Detector *>(&comp)) {
+  if (const auto det = dynamic_cast<const Geometry::Detector *>(&comp)) {
+    const auto it = m_detIDToIndex.find(det->getID());
+    if (m_detectorsCached && it != m_detIDToIndex.end())
+      m_positions[it->second] = getDetector(it->second).getPos();
+  } else {
     // If comp is a detector cached positions stay valid. In all other cases
     // (higher level in instrument tree, or other leaf component such as sample
     // or source) we flush all cached positions.
@@ -129,9 +154,7 @@ void DetectorInfo::setPosition(const Geometry::IComponent &comp,
       m_sourcePos = m_source->getPos();
     if (m_sample)
       m_samplePos = m_sample->getPos();
-    // Detector positions are currently not cached, the cached pointers to
-    // detectors stay valid. Once we store positions in DetectorInfo we need to
-    // update detector positions here.
+    invalidateDetectors();
   }
 }
 
@@ -153,9 +176,8 @@ void DetectorInfo::setRotation(const Geometry::IComponent &comp,
       m_sourcePos = m_source->getPos();
     if (m_sample)
       m_samplePos = m_sample->getPos();
-    // Detector positions and rotations are currently not cached, the cached
-    // pointers to detectors stay valid. Once we store positions and rotations
-    // in DetectorInfo we need to update detector positions and rotations here.
+    // Detector rotations are not cached, but positions are.
+    invalidateDetectors();
   }
 }
 
@@ -202,14 +224,6 @@ DetectorInfo::getDetectorPtr(const size_t index) const {
   return m_lastDetector[thread];
 }
 
-/// Sets the cached detector. This is an optimization used by SpectrumInfo.
-void DetectorInfo::setCachedDetector(
-    size_t index, boost::shared_ptr<const Geometry::IDetector> detector) const {
-  size_t thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
-  m_lastIndex[thread] = index;
-  m_lastDetector[thread] = detector;
-}
-
 /// Returns a reference to the source component. The value is cached, so calling
 /// it repeatedly is cheap.
 const Geometry::IComponent &DetectorInfo::getSource() const {
@@ -260,5 +274,34 @@ void DetectorInfo::doCacheSample() const {
 
 void DetectorInfo::cacheL1() const { m_L1 = m_source->getDistance(*m_sample); }
 
+/** Fill the flat per-detector arrays if they are not valid.
+ *
+ * The arrays are filled in parallel on first use, so the cost of constructing a
+ * parameterized detector is paid once per detector rather than once per
+ * query. */
+void DetectorInfo::cacheDetectors() const {
+  if (m_detectorsCached)
+    return;
+  std::lock_guard<std::mutex> lock(m_detectorsMutex);
+  if (m_detectorsCached)
+    return;
+
+  const auto numberOfDetectors = static_cast<int64_t>(m_detectorIDs.size());
+  m_baseDetectors.resize(m_detectorIDs.size());
+  m_positions.resize(m_detectorIDs.size());
+  m_isMonitor.resize(m_detectorIDs.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numberOfDetectors; ++i) {
+    const auto det = m_instrument->getDetector(m_detectorIDs[i]);
+    m_baseDetectors[i] = det->getComponentID();
+    m_positions[i] = det->getPos();
+    m_isMonitor[i] = det->isMonitor();
+  }
+  m_detectorsCached = true;
+}
+
+/// Flag the flat per-detector arrays for refilling on next access.
+void DetectorInfo::invalidateDetectors() { m_detectorsCached = false; }
+
 } // namespace API
 } // namespace Mantid
@@ -63,5 +63,17 @@ NearestNeighbourInfo::getNeighboursExact(specnum_t spec) const {
   return m_nearestNeighbours.neighbours(spec);
 }
 
+/** Queries the NearestNeighbours object for many spectrum numbers at once.
+*
+* @param spectra :: spectrum numbers of the detectors you are looking at
+* @return map of DetectorID to distance for the nearest neighbours of each of
+* the spectra
+*/
+std::vector<std::map<specnum_t, Kernel::V3D>>
+NearestNeighbourInfo::getNeighboursExact(
+    const std::vector<specnum_t> &spectra) const {
+  return m_nearestNeighbours.neighbours(spectra);
+}
+
 } // namespace API
 } // namespace Mantid
@@ -12,26 +12,34 @@ namespace API {
 SpectrumInfo::SpectrumInfo(const MatrixWorkspace &workspace)
     : m_workspace(workspace), m_detectorInfo(workspace.detectorInfo()),
       m_lastDetector(PARALLEL_GET_MAX_THREADS),
-      m_lastIndex(PARALLEL_GET_MAX_THREADS, -1) {}
+      m_lastIndex(PARALLEL_GET_MAX_THREADS, -1),
+      m_detectorIndices(PARALLEL_GET_MAX_THREADS) {}
 
 SpectrumInfo::SpectrumInfo(MatrixWorkspace &workspace)
     : m_workspace(workspace),
       m_mutableDetectorInfo(&workspace.mutableDetectorInfo()),
       m_detectorInfo(*m_mutableDetectorInfo),
       m_lastDetector(PARALLEL_GET_MAX_THREADS),
-      m_lastIndex(PARALLEL_GET_MAX_THREADS, -1) {}
+      m_lastIndex(PARALLEL_GET_MAX_THREADS, -1),
+      m_detectorIndices(PARALLEL_GET_MAX_THREADS) {}
 
 // Defined as default in source for forward declaration with std::unique_ptr.
 SpectrumInfo::~SpectrumInfo() = default;
 
 /// Returns true if the detector(s) associated with the spectrum are monitors.
 bool SpectrumInfo::isMonitor(const size_t index) const {
-  return getDetector(index).isMonitor();
+  for (const auto detIndex : getDetectorIndices(index))
+    if (!m_detectorInfo.isMonitor(detIndex))
+      return false;
+  return true;
 }
 
 /// Returns true if the detector(s) associated with the spectrum are masked.
 bool SpectrumInfo::isMasked(const size_t index) const {
-  return getDetector(index).isMasked();
+  for (const auto detIndex : getDetectorIndices(index))
+    if (!m_detectorInfo.isMasked(detIndex))
+      return false;
+  return true;
 }
 
 /** Returns L2 (distance from sample to spectrum).
@@ -41,13 +49,10 @@ bool SpectrumInfo::isMasked(const size_t index) const {
  */
 double SpectrumInfo::l2(const size_t index) const {
   double l2{0.0};
-  const auto &dets = getDetectorVector(index);
-  for (const auto &det : dets) {
-    const auto &detIndex = m_detectorInfo.indexOf(det->getID());
-    m_detectorInfo.setCachedDetector(detIndex, det);
+  const auto &detIndices = getDetectorIndices(index);
+  for (const auto detIndex : detIndices)
     l2 += m_detectorInfo.l2(detIndex);
-  }
-  return l2 / static_cast<double>(dets.size());
+  return l2 / static_cast<double>(detIndices.size());
 }
 
 /** Returns the scattering angle 2 theta (angle w.r.t. to beam direction).
@@ -60,13 +65,10 @@ double SpectrumInfo::twoTheta(const size_t index) const {
         "Two theta (scattering angle) is not defined for monitors.");
 
   double twoTheta{0.0};
-  const auto &dets = getDetectorVector(index);
-  for (const auto &det : dets) {
-    const auto &detIndex = m_detectorInfo.indexOf(det->getID());
-    m_detectorInfo.setCachedDetector(detIndex, det);
+  const auto &detIndices = getDetectorIndices(index);
+  for (const auto detIndex : detIndices)
     twoTheta += m_detectorInfo.twoTheta(detIndex);
-  }
-  return twoTheta / static_cast<double>(dets.size());
+  return twoTheta / static_cast<double>(detIndices.size());
 }
 
 /** Returns the signed scattering angle 2 theta (angle w.r.t. to beam
@@ -80,25 +82,19 @@ double SpectrumInfo::signedTwoTheta(const size_t index) const {
         "Two theta (scattering angle) is not defined for monitors.");
 
   double signedTwoTheta{0.0};
-  const auto &dets = getDetectorVector(index);
-  for (const auto &det : dets) {
-    const auto &detIndex = m_detectorInfo.indexOf(det->getID());
-    m_detectorInfo.setCachedDetector(detIndex, det);
+  const auto &detIndices = getDetectorIndices(index);
+  for (const auto detIndex : detIndices)
     signedTwoTheta += m_detectorInfo.signedTwoTheta(detIndex);
-  }
-  return signedTwoTheta / static_cast<double>(dets.size());
+  return signedTwoTheta / static_cast<double>(detIndices.size());
 }
 
 /// Returns the position of the spectrum with given index.
 Kernel::V3D SpectrumInfo::position(const size_t index) const {
   Kernel::V3D newPos;
-  const auto &dets = getDetectorVector(index);
-  for (const auto &det : dets) {
-    const auto &detIndex = m_detectorInfo.indexOf(det->getID());
-    m_detectorInfo.setCachedDetector(detIndex, det);
+  const auto &detIndices = getDetectorIndices(index);
+  for (const auto detIndex : detIndices)
     newPos += m_detectorInfo.position(detIndex);
-  }
-  return newPos / static_cast<double>(dets.size());
+  return newPos / static_cast<double>(detIndices.size());
 }
 
 /// Returns true if the spectrum is associated with detectors in the instrument.
@@ -193,17 +189,35 @@ const Geometry::IDetector &SpectrumInfo::getDetector(const size_t index) const {
   return *m_lastDetector[thread];
 }
 
-std::vector<Geometry::IDetector_const_sptr>
-SpectrumInfo::getDetectorVector(const size_t index) const {
-  const auto &det = getDetector(index);
-  const auto &ndet = det.nDets();
-  if (ndet > 1) {
-    const auto group = dynamic_cast<const Geometry::DetectorGroup *>(&det);
-    return group->getDetectors();
+/** Returns the indices of the detectors of the spectrum with given index.
+ *
+ * The returned reference is to a per-thread buffer that is overwritten by the
+ * next call on the same thread. Invalid detector IDs are skipped for spectra
+ * with more than one detector, mirroring the DetectorGroup created by
+ * getDetector(). The returned indices are never empty: a spectrum without any
+ * valid detector ID throws, so that averages over the detectors are defined.
+ */
+const std::vector<size_t> &
+SpectrumInfo::getDetectorIndices(const size_t index) const {
+  const auto &dets = m_workspace.getSpectrum(index).getDetectorIDs();
+  auto &indices =
+      m_detectorIndices[static_cast<size_t>(PARALLEL_THREAD_NUMBER)];
+  indices.clear();
+  if (dets.size() == 1) {
+    indices.push_back(m_detectorInfo.indexOf(*dets.begin()));
   } else {
-    size_t thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
-    return {m_lastDetector[thread]};
+    for (const auto &id : dets) {
+      const auto it = m_detectorInfo.m_detIDToIndex.find(id);
+      if (it != m_detectorInfo.m_detIDToIndex.end())
+        indices.push_back(it->second);
+    }
   }
+  if (indices.empty())
+    throw Kernel::Exception::NotFoundError("MatrixWorkspace::getDetector(): No "
+                                           "detectors for this workspace "
+                                           "index.",
+                                           "");
+  return indices;
 }
 
 } // namespace API
@@ -110,6 +110,16 @@ public:
       TS_ASSERT_EQUALS(info.isMasked(static_cast<size_t>(i)), i % 2 == 0);
   }
 
+  void test_isMasked_after_maskWorkspaceIndex() {
+    auto ws = makeWorkspace(2);
+    const auto &info = ws->detectorInfo();
+    TS_ASSERT(!info.isMasked(1));
+    // Masking via the workspace does not reset DetectorInfo, the flag must not
+    // be served from a stale cache.
+    ws->maskWorkspaceIndex(1);
+    TS_ASSERT(info.isMasked(1));
+  }
+
   void test_l2() {
     const auto &detectorInfo = m_workspace.detectorInfo();
     double x2 = 5.0 * 5.0;
@@ -6,6 +6,8 @@
 #include "MantidTestHelpers/FakeObjects.h"
 #include "MantidTestHelpers/InstrumentCreationHelper.h"
 #include "MantidAPI/NearestNeighbourInfo.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/NeighbourIndex.h"
 
 using Mantid::API::NearestNeighbourInfo;
 
@@ -18,13 +20,7 @@ public:
   }
   static void destroySuite(NearestNeighbourInfoTest *suite) { delete suite; }
 
-  NearestNeighbourInfoTest() {
-    workspace.initialize(100, 1, 1);
-    InstrumentCreationHelper::addFullInstrumentToWorkspace(workspace, false,
-                                                           false, "");
-    workspace.rebuildSpectraMapping();
-    workspace.maskWorkspaceIndex(0);
-  }
+  NearestNeighbourInfoTest() { createWorkspace(workspace); }
 
   void test_construct() {
     TS_ASSERT_THROWS_NOTHING(NearestNeighbourInfo(workspace, false));
@@ -52,7 +48,37 @@ public:
     TS_ASSERT_EQUALS(neighbours.count(1), 0);
   }
 
+  void test_neighbours_of_many_spectra() {
+    NearestNeighbourInfo nn(workspace, false, 4);
+    const std::vector<Mantid::specnum_t> spectra{2, 3, 50};
+    const auto neighbours = nn.getNeighboursExact(spectra);
+    TS_ASSERT_EQUALS(neighbours.size(), 3);
+    for (size_t i = 0; i < spectra.size(); ++i)
+      TS_ASSERT(neighbours[i] == nn.getNeighboursExact(spectra[i]));
+  }
+
+  void test_index_is_shared_until_parameters_change() {
+    WorkspaceTester ws;
+    createWorkspace(ws);
+    auto &cache = ws.getInstrument()->neighbourIndexCache();
+    NearestNeighbourInfo nn2(ws, false, 2);
+    NearestNeighbourInfo nn4(ws, false, 4);
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    ws.maskWorkspaceIndex(1);
+    NearestNeighbourInfo masked(ws, true, 4);
+    TS_ASSERT_EQUALS(cache.size(), 2);
+    TS_ASSERT_EQUALS(masked.getNeighboursExact(3).count(2), 0);
+  }
+
 private:
+  void createWorkspace(WorkspaceTester &ws) {
+    ws.initialize(100, 1, 1);
+    InstrumentCreationHelper::addFullInstrumentToWorkspace(ws, false, false,
+                                                           "");
+    ws.rebuildSpectraMapping();
+    ws.maskWorkspaceIndex(0);
+  }
+
   WorkspaceTester workspace;
 };
 
@@ -327,6 +327,22 @@ public:
     m_workspace.getSpectrum(1).setDetectorID(2);
   }
 
+  void test_grouped_without_valid_IDs_throws() {
+    const auto &spectrumInfo = m_grouped.spectrumInfo();
+    // Ids in instrument start at 1, 0 and 7 are out of range. Averaging over
+    // no detectors is not defined.
+    m_grouped.getSpectrum(1).setDetectorIDs({0, 7});
+    TS_ASSERT(!spectrumInfo.hasDetectors(1));
+    TS_ASSERT_THROWS(spectrumInfo.l2(1), Exception::NotFoundError);
+    TS_ASSERT_THROWS(spectrumInfo.twoTheta(1), Exception::NotFoundError);
+    TS_ASSERT_THROWS(spectrumInfo.signedTwoTheta(1), Exception::NotFoundError);
+    TS_ASSERT_THROWS(spectrumInfo.position(1), Exception::NotFoundError);
+    TS_ASSERT_THROWS(spectrumInfo.isMonitor(1), Exception::NotFoundError);
+    TS_ASSERT_THROWS(spectrumInfo.isMasked(1), Exception::NotFoundError);
+    // Restore old value
+    m_grouped.getSpectrum(1).setDetectorIDs({1, 2});
+  }
+
   void test_detector() {
     const auto &spectrumInfo = m_workspace.spectrumInfo();
     TS_ASSERT_THROWS_NOTHING(spectrumInfo.detector(0));
@@ -403,6 +419,16 @@ public:
     const std::string instrumentName("SimpleFakeInstrument");
     InstrumentCreationHelper::addFullInstrumentToWorkspace(
         m_workspace, includeMonitors, startYNegative, instrumentName);
+
+    // Same instrument, but groups of 4 detectors per spectrum.
+    m_grouped.init(numberOfHistograms, numberOfBins, numberOfBins - 1);
+    InstrumentCreationHelper::addFullInstrumentToWorkspace(
+        m_grouped, includeMonitors, startYNegative, instrumentName);
+    for (size_t i = 0; i < numberOfHistograms; ++i) {
+      const auto first = static_cast<detid_t>(4 * (i % 2500) + 1);
+      m_grouped.getSpectrum(i).setDetectorIDs(
+          {first, first + 1, first + 2, first + 3});
+    }
   }
 
   void test_typical() {
@@ -422,8 +448,58 @@ public:
     TS_ASSERT_DELTA(result, 5214709.740869, 1e-6);
   }
 
+  void test_grouped() {
+    // Spectra with several detectors used to require construction of a
+    // DetectorGroup for every call.
+    double result = 0.0;
+    const auto &spectrumInfo = m_grouped.spectrumInfo();
+    for (size_t i = 0; i < 10000; ++i) {
+      result += spectrumInfo.l2(i);
+      result += spectrumInfo.twoTheta(i);
+    }
+    // Each spectrum averages 4 neighbouring pixels
+    double expected = 0.0;
+    for (size_t i = 0; i < 10000; ++i) {
+      const auto first = static_cast<detid_t>(4 * (i % 2500) + 1);
+      for (detid_t id = first; id < first + 4; ++id)
+        expected += (pixelL2(id) + pixelTwoTheta(id)) / 4.0;
+    }
+    TS_ASSERT_DELTA(result, expected, 1e-4);
+  }
+
+  void test_repeated_passes() {
+    // Algorithms often loop over all spectra more than once, e.g., for a
+    // mask check followed by the actual computation.
+    double result = 0.0;
+    const auto &spectrumInfo = m_workspace.spectrumInfo();
+    for (int repeat = 0; repeat < 8; ++repeat) {
+      for (size_t i = 0; i < 10000; ++i) {
+        if (!spectrumInfo.isMasked(i))
+          result += spectrumInfo.l2(i) + spectrumInfo.twoTheta(i);
+      }
+    }
+    // Nothing is masked, spectrum i is the pixel with ID i + 1
+    double expected = 0.0;
+    for (size_t i = 0; i < 10000; ++i) {
+      const auto id = static_cast<detid_t>(i + 1);
+      expected += pixelL2(id) + pixelTwoTheta(id);
+    }
+    TS_ASSERT_DELTA(result, 8.0 * expected, 1e-3);
+  }
+
 private:
+  /// Pixels of SimpleFakeInstrument sit at z = 5 m, 0.1 m apart along y, with
+  /// pixel 2 on the beam axis and the sample at the origin.
+  static double pixelY(const detid_t id) { return (id - 2) * 0.1; }
+  static double pixelL2(const detid_t id) {
+    return std::sqrt(5.0 * 5.0 + pixelY(id) * pixelY(id));
+  }
+  static double pixelTwoTheta(const detid_t id) {
+    return std::atan2(std::abs(pixelY(id)), 5.0);
+  }
+
   WorkspaceTester m_workspace;
+  WorkspaceTester m_grouped;
 };
 
 #endif /* MANTID_API_SPECTRUMINFOTEST_H_ */
@@ -140,8 +140,6 @@ private:
 
   std::vector<std::string> getTimeSeriesLogNames();
 
-  Kernel::TimeSplitterType generateSplitters(int wsindex);
-
   void splitLog(DataObjects::EventWorkspace_sptr eventws, std::string logname,
                 Kernel::TimeSplitterType &splitters);
 
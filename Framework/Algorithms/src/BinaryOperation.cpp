@@ -224,14 +224,6 @@ void BinaryOperation::exec() {
       // Make sure m_eout still points to the same as m_out;
       m_eout = boost::dynamic_pointer_cast<EventWorkspace>(m_out);
     }
-
-    // Always clear the MRUs.
-    m_eout->clearMRU();
-    if (m_elhs)
-      m_elhs->clearMRU();
-    if (m_erhs)
-      m_erhs->clearMRU();
-
   } else {
     // ---- Output will be WS2D -------
 
@@ -784,9 +776,6 @@ void BinaryOperation::do2D(bool mismatchedSpectra) {
     }
     PARALLEL_CHECK_INTERUPT_REGION
   }
-  // Make sure we don't use outdated MRU
-  if (m_ClearRHSWorkspace)
-    m_erhs->clearMRU();
 }
 
 /** Copies any bin masking from the smaller/rhs input workspace to the output.
@@ -385,9 +385,6 @@ ConvertUnits::convertQuickly(API::MatrixWorkspace_const_sptr inputWS,
   }
   PARALLEL_CHECK_INTERUPT_REGION
 
-  if (m_inputEvents)
-    eventWS->clearMRU();
-
   return outputWS;
 }
 
@@ -592,8 +589,6 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
                         << failedDetectorCount
                         << " spectra. Masking spectrum.\n";
   }
-  if (m_inputEvents)
-    eventWS->clearMRU();
 
   if (emode == 1) {
     //... direct efixed gather
@@ -11,6 +11,7 @@
 #include "MantidDataObjects/GroupingWorkspace.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <iterator>
 #include <numeric>
@@ -28,6 +29,141 @@ namespace Algorithms {
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(DiffractionFocussing2)
 
+namespace {
+/// The smallest number of input spectra summed by one task
+const size_t MIN_CHUNK_SIZE = 200;
+/// The number of tasks the input spectra of all the groups are split into,
+/// if there are enough of them
+const size_t TARGET_NUMBER_OF_CHUNKS = 128;
+
+/// A range of the input spectra of one group, summed by one task
+struct Chunk {
+  /// The index of the group in the list of valid groups
+  size_t group;
+  /// The range of positions in the list of input spectra of the group
+  size_t begin;
+  size_t end;
+};
+
+/** Split the input spectra of each group into chunks, so that a few large
+ * groups are summed by as many tasks as many small ones. The size of the
+ * chunks depends on the total number of spectra only, so the sums do not
+ * depend on the number of threads.
+ * @param groups :: The group numbers
+ * @param wsIndices :: The input workspace indices of each group number
+ * @param firstChunk :: Filled with the index of the first chunk of each group,
+ * followed by the total number of chunks
+ * @return The chunks, in order of group
+ */
+std::vector<Chunk>
+splitIntoChunks(const std::vector<int> &groups,
+                const std::vector<std::vector<size_t>> &wsIndices,
+                std::vector<size_t> &firstChunk) {
+  std::vector<size_t> groupSizes;
+  for (const int group : groups)
+    groupSizes.push_back(wsIndices[group].size());
+  const size_t total =
+      std::accumulate(groupSizes.begin(), groupSizes.end(), size_t(0));
+  const size_t chunkSize =
+      std::max(MIN_CHUNK_SIZE, (total + TARGET_NUMBER_OF_CHUNKS - 1) /
+                                   TARGET_NUMBER_OF_CHUNKS);
+  std::vector<Chunk> chunks;
+  firstChunk.clear();
+  for (size_t group = 0; group < groupSizes.size(); ++group) {
+    firstChunk.push_back(chunks.size());
+    for (size_t begin = 0; begin < groupSizes[group]; begin += chunkSize) {
+      chunks.push_back(
+          {group, begin, std::min(begin + chunkSize, groupSizes[group])});
+    }
+  }
+  firstChunk.push_back(chunks.size());
+  return chunks;
+}
+
+/** Add up the partial sums of the chunks of each group pairwise, in a tree.
+ * Each level of the tree is done in parallel over all the groups.
+ * @param chunks :: The chunks, as returned by splitIntoChunks
+ * @param firstChunk :: The index of the first chunk of each group
+ * @param partials :: The partial sum of each chunk. The sum of a group is
+ * left in the partial sum of its first chunk.
+ * @param parallel :: Whether to add in parallel
+ * @param add :: Adds its second argument to its first one
+ */
+template <typename T, typename Add>
+void reduceChunks(const std::vector<Chunk> &chunks,
+                  const std::vector<size_t> &firstChunk,
+                  std::vector<T> &partials, const bool parallel, Add add) {
+  size_t maxChunks = 0;
+  for (size_t group = 0; group + 1 < firstChunk.size(); ++group)
+    maxChunks = std::max(maxChunks, firstChunk[group + 1] - firstChunk[group]);
+
+  const int numberOfChunks = static_cast<int>(chunks.size());
+  for (size_t step = 1; step < maxChunks; step *= 2) {
+    PARALLEL_FOR_IF(parallel)
+    for (int i = 0; i < numberOfChunks; ++i) {
+      const size_t chunk = static_cast<size_t>(i);
+      const size_t group = chunks[chunk].group;
+      if ((chunk - firstChunk[group]) % (2 * step) == 0 &&
+          chunk + step < firstChunk[group + 1])
+        add(partials[chunk], partials[chunk + step]);
+    }
+  }
+}
+
+/// The sums of the input spectra of a chunk of a group
+struct PartialHistogram {
+  MantidVec y;
+  /// The sum of the squares of the errors
+  MantidVec e;
+  /// The sum of the weights of the input spectra in each output bin
+  MantidVec weight;
+};
+
+/// Add the sums of the second chunk to the first one
+void addPartialHistogram(PartialHistogram &sum, PartialHistogram &other) {
+  std::transform(sum.y.begin(), sum.y.end(), other.y.begin(), sum.y.begin(),
+                 std::plus<double>());
+  std::transform(sum.e.begin(), sum.e.end(), other.e.begin(), sum.e.begin(),
+                 std::plus<double>());
+  std::transform(sum.weight.begin(), sum.weight.end(), other.weight.begin(),
+                 sum.weight.begin(), std::plus<double>());
+  other = PartialHistogram();
+}
+
+/** Move events to the end of a vector of events. The storage of the moved
+ * events is taken over if the vector is empty, and freed otherwise.
+ * @param events :: The events of the output list
+ * @param more :: The events of a chunk, left empty
+ */
+template <class T>
+void moveEvents(std::vector<T> &events, std::vector<T> &more) {
+  if (events.empty()) {
+    events.swap(more);
+  } else {
+    events.insert(events.end(), std::make_move_iterator(more.begin()),
+                  std::make_move_iterator(more.end()));
+  }
+  std::vector<T>().swap(more);
+}
+
+/// Move the events of a chunk to the end of the list of its group
+void movePartialEventList(EventList &sum, EventList &other) {
+  switch (other.getEventType()) {
+  case TOF:
+    moveEvents(sum.getEvents(), other.getEvents());
+    break;
+  case WEIGHTED:
+    moveEvents(sum.getWeightedEvents(), other.getWeightedEvents());
+    break;
+  case WEIGHTED_NOTIME:
+    moveEvents(sum.getWeightedEventsNoTime(), other.getWeightedEventsNoTime());
+    break;
+  }
+  sum.addDetectorIDs(other.getDetectorIDs());
+  other.clear();
+}
+}
+
 /** Initialisation method. Declares properties to be used in algorithm.
  *
  */
@@ -171,42 +307,35 @@ void DiffractionFocussing2::exec() {
   prog = new API::Progress(this, 0.2, 1.00,
                            static_cast<int>(totalHistProcess) + nGroups);
 
-  PARALLEL_FOR_IF(Kernel::threadSafe(*m_matrixInputW, *out))
-  for (int outWorkspaceIndex = 0;
-       outWorkspaceIndex < static_cast<int>(m_validGroups.size());
-       outWorkspaceIndex++) {
+  // Sum the input spectra in chunks, so that the spectra of a group are
+  // summed in parallel as well as the groups
+  std::vector<size_t> firstChunk;
+  const auto chunks = splitIntoChunks(m_validGroups, m_wsIndices, firstChunk);
+  std::vector<PartialHistogram> partials(chunks.size());
+  const bool parallel = Kernel::threadSafe(*m_matrixInputW, *out);
+
+  // cppcheck-suppress syntaxError
+  PRAGMA_OMP(parallel for schedule(dynamic, 1) if (parallel))
+  for (int chunkIndex = 0; chunkIndex < static_cast<int>(chunks.size());
+       chunkIndex++) {
     PARALLEL_START_INTERUPT_REGION
-    int group = m_validGroups[outWorkspaceIndex];
-
-    // Get the group
-    auto it = group2xvector.find(group);
-    auto dif = std::distance(group2xvector.begin(), it);
-    auto &Xout = it->second;
-
-    // Assign the new X axis only once (i.e when this group is encountered the
-    // first time)
-    out->setBinEdges(static_cast<int64_t>(dif), Xout);
-
-    // This is the output spectrum
-    auto &outSpec = out->getSpectrum(outWorkspaceIndex);
-
-    // Also set the spectrum number to the group number
-    outSpec.setSpectrumNo(group);
-    outSpec.clearDetectorIDs();
-
-    // Get the references to Y and E output and rebin
-    // TODO can only be changed once rebin implemented in HistogramData
-    auto &Yout = outSpec.dataY();
-    auto &Eout = outSpec.dataE();
-
-    // Initialize the group's weight vector here and the dummy vector used for
-    // accumulating errors.
-    MantidVec groupWgt(nPoints, 0.0);
+    const Chunk &chunk = chunks[chunkIndex];
+    const int group = m_validGroups[chunk.group];
+    const auto &Xout = group2xvector.find(group)->second;
+
+    // The sums of this chunk, which are added to the other chunks of the
+    // group below
+    auto &partial = partials[chunkIndex];
+    partial.y.assign(nPoints, 0.0);
+    partial.e.assign(nPoints, 0.0);
+    partial.weight.assign(nPoints, 0.0);
+    auto &Yout = partial.y;
+    auto &Eout = partial.e;
+    auto &groupWgt = partial.weight;
 
     // loop through the contributing histograms
-    std::vector<size_t> indices = m_wsIndices[group];
-    const size_t groupSize = indices.size();
-    for (size_t i = 0; i < groupSize; i++) {
+    const std::vector<size_t> &indices = m_wsIndices[group];
+    for (size_t i = chunk.begin; i < chunk.end; i++) {
       size_t inWorkspaceIndex = indices[i];
       // This is the input spectrum
       const auto &inSpec = m_matrixInputW->getSpectrum(inWorkspaceIndex);
@@ -215,7 +344,6 @@ void DiffractionFocussing2::exec() {
       auto &Yin = inSpec.y();
       auto &Ein = inSpec.e();
 
-      outSpec.addDetectorIDs(inSpec.getDetectorIDs());
       try {
         // TODO This should be implemented in Histogram as rebin
         Mantid::Kernel::VectorHelper::rebinHistogram(
@@ -285,6 +413,52 @@ void DiffractionFocussing2::exec() {
       }
       prog->report();
     } // end of loop for input spectra
+    PARALLEL_END_INTERUPT_REGION
+  } // end of loop for chunks
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Add up the chunks of each group in a tree
+  reduceChunks(chunks, firstChunk, partials, parallel, addPartialHistogram);
+
+  PARALLEL_FOR_IF(parallel)
+  for (int outWorkspaceIndex = 0;
+       outWorkspaceIndex < static_cast<int>(m_validGroups.size());
+       outWorkspaceIndex++) {
+    PARALLEL_START_INTERUPT_REGION
+    int group = m_validGroups[outWorkspaceIndex];
+
+    // Get the group
+    auto it = group2xvector.find(group);
+    auto dif = std::distance(group2xvector.begin(), it);
+    auto &Xout = it->second;
+
+    // Assign the new X axis only once (i.e when this group is encountered the
+    // first time)
+    out->setBinEdges(static_cast<int64_t>(dif), Xout);
+
+    // This is the output spectrum
+    auto &outSpec = out->getSpectrum(outWorkspaceIndex);
+
+    // Also set the spectrum number to the group number
+    outSpec.setSpectrumNo(group);
+    outSpec.clearDetectorIDs();
+    const std::vector<size_t> &indices = m_wsIndices[group];
+    for (const auto inWorkspaceIndex : indices) {
+      outSpec.addDetectorIDs(
+          m_matrixInputW->getSpectrum(inWorkspaceIndex).getDetectorIDs());
+    }
+    const size_t groupSize = indices.size();
+
+    // The sums of all the chunks of the group
+    auto &partial = partials[firstChunk[outWorkspaceIndex]];
+    const MantidVec &groupWgt = partial.weight;
+
+    // Get the references to Y and E output
+    // TODO can only be changed once rebin implemented in HistogramData
+    auto &Yout = outSpec.dataY();
+    auto &Eout = outSpec.dataE();
+    Yout.swap(partial.y);
+    Eout.swap(partial.e);
 
     // Calculate the bin widths
     std::vector<double> widths(Xout.size());
@@ -372,12 +546,11 @@ void DiffractionFocussing2::execEvent() {
   delete prog;
   prog = new Progress(this, 0.25, 0.3, totalHistProcess);
 
-  // This creates and reserves the space required
+  // This creates the lists, which take over the events of the chunks below
   for (size_t iGroup = 0; iGroup < this->m_validGroups.size(); iGroup++) {
     const int group = this->m_validGroups[iGroup];
     EventList &groupEL = out->getSpectrum(iGroup);
     groupEL.switchTo(eventWtype);
-    groupEL.reserve(size_required[iGroup]);
     groupEL.clearDetectorIDs();
     groupEL.setSpectrumNo(group);
     prog->reportIncrement(1, "Allocating");
@@ -387,73 +560,65 @@ void DiffractionFocussing2::execEvent() {
   delete prog;
   prog = new Progress(this, 0.3, 0.9, totalHistProcess);
 
-  if (this->m_validGroups.size() == 1) {
-    g_log.information() << "Performing focussing on a single group\n";
-    // Special case of a single group - parallelize differently
-    EventList &groupEL = out->getSpectrum(0);
-    const int group = m_validGroups[0];
+  // Accumulate the events in chunks, so that the spectra of a group are
+  // added in parallel as well as the groups
+  std::vector<size_t> firstChunk;
+  const auto chunks = splitIntoChunks(m_validGroups, m_wsIndices, firstChunk);
+  std::vector<EventList> partials(chunks.size());
+  const bool parallel = Kernel::threadSafe(*m_eventW);
+
+  // cppcheck-suppress syntaxError
+  PRAGMA_OMP(parallel for schedule(dynamic, 1) if (parallel))
+  for (int chunkIndex = 0; chunkIndex < static_cast<int>(chunks.size());
+       chunkIndex++) {
+    PARALLEL_START_INTERUPT_REGION
+    const Chunk &chunk = chunks[chunkIndex];
+    const int group = this->m_validGroups[chunk.group];
     const std::vector<size_t> &indices = this->m_wsIndices[group];
 
-    int chunkSize = 200;
-
-    int end = (totalHistProcess / chunkSize) + 1;
-    // cppcheck-suppress syntaxError
-    PRAGMA_OMP(parallel for schedule(dynamic, 1) )
-    for (int wiChunk = 0; wiChunk < end; wiChunk++) {
-      PARALLEL_START_INTERUPT_REGION
-
-      // Perform in chunks for more efficiency
-      int max = (wiChunk + 1) * chunkSize;
-      if (max > totalHistProcess)
-        max = totalHistProcess;
-
-      // Make a blank EventList that will accumulate the chunk.
-      EventList chunkEL;
-      chunkEL.switchTo(eventWtype);
-      // chunkEL.reserve(numEventsInChunk);
-
-      // process the chunk
-      for (int i = wiChunk * chunkSize; i < max; i++) {
-        // Accumulate the chunk
-        size_t wi = indices[i];
-        chunkEL += m_eventW->getSpectrum(wi);
-      }
+    // Make a blank EventList that will accumulate the chunk. The list of
+    // the first chunk of a group becomes the output list, and makes room for
+    // the events of the other chunks to be appended to it.
+    EventList &chunkEL = partials[chunkIndex];
+    chunkEL.switchTo(eventWtype);
+    if (static_cast<size_t>(chunkIndex) == firstChunk[chunk.group]) {
+      chunkEL.reserve(size_required[chunk.group]);
+    } else {
+      size_t numEventsInChunk = 0;
+      for (size_t i = chunk.begin; i < chunk.end; i++)
+        numEventsInChunk +=
+            m_eventW->getSpectrum(indices[i]).getNumberEvents();
+      chunkEL.reserve(numEventsInChunk);
+    }
 
-      // Rejoin the chunk with the rest.
-      PARALLEL_CRITICAL(DiffractionFocussing2_JoinChunks) {
-        groupEL += chunkEL;
-      }
+    for (size_t i = chunk.begin; i < chunk.end; i++) {
+      // Accumulate the chunk
+      const size_t wi = indices[i];
+      chunkEL += m_eventW->getSpectrum(wi);
 
-      PARALLEL_END_INTERUPT_REGION
-    }
-    PARALLEL_CHECK_INTERUPT_REGION
-  } else {
-    // ------ PARALLELIZE BY GROUPS -------------------------
-
-    int nValidGroups = static_cast<int>(this->m_validGroups.size());
-    PARALLEL_FOR_IF(Kernel::threadSafe(*m_eventW))
-    for (int iGroup = 0; iGroup < nValidGroups; iGroup++) {
-      PARALLEL_START_INTERUPT_REGION
-      const int group = this->m_validGroups[iGroup];
-      const std::vector<size_t> &indices = this->m_wsIndices[group];
-      for (auto wi : indices) {
-        // In workspace index iGroup, put what was in the OLD workspace index wi
-        out->getSpectrum(iGroup) += m_eventW->getSpectrum(wi);
-
-        prog->reportIncrement(1, "Appending Lists");
-
-        // When focussing in place, you can clear out old memory from the input
-        // one!
-        if (inPlace) {
-          boost::const_pointer_cast<EventWorkspace>(m_eventW)
-              ->getSpectrum(wi)
-              .clear();
-        }
+      prog->reportIncrement(1, "Appending Lists");
+
+      // When focussing in place, you can clear out old memory from the input
+      // one!
+      if (inPlace) {
+        boost::const_pointer_cast<EventWorkspace>(m_eventW)
+            ->getSpectrum(wi)
+            .clear();
       }
-      PARALLEL_END_INTERUPT_REGION
     }
-    PARALLEL_CHECK_INTERUPT_REGION
-  } // (done with parallel by groups)
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Move the chunks of each group to the output, without copying the first
+  const int nValidGroups = static_cast<int>(this->m_validGroups.size());
+  PARALLEL_FOR_IF(parallel)
+  for (int iGroup = 0; iGroup < nValidGroups; iGroup++) {
+    EventList &groupEL = out->getSpectrum(iGroup);
+    for (size_t chunk = firstChunk[iGroup]; chunk < firstChunk[iGroup + 1];
+         ++chunk)
+      movePartialEventList(groupEL, partials[chunk]);
+  }
 
   // Now that the data is cleaned up, go through it and set the X vectors to the
   // input workspace we first talked about.
@@ -1,6 +1,7 @@
 #include "MantidAlgorithms/FilterEvents.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/FileProperty.h"
+#include "MantidAPI/Progress.h"
 #include "MantidAPI/TableRow.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/Run.h"
@@ -800,27 +801,32 @@ void FilterEvents::setupCustomizedTOFCorrection() {
 void FilterEvents::filterEventsBySplitters(double progressamount) {
   size_t numberOfSpectra = m_eventWS->getNumberHistograms();
 
+  // Index the splitters once for all the spectra. The output workspaces are
+  // kept in the order of the splitter's destination indices.
+  const Kernel::SplitterIndex splitterIndex(
+      m_splitters, std::vector<int>(m_workGroupIndexes.begin(),
+                                    m_workGroupIndexes.end()));
+  std::vector<DataObjects::EventWorkspace_sptr> outputWorkspaces;
+  outputWorkspaces.reserve(splitterIndex.indices().size());
+  for (const auto index : splitterIndex.indices())
+    outputWorkspaces.push_back(m_outputWS.at(index));
+
   // Loop over the histograms (detector spectra) to do split from 1 event list
   // to N event list
   g_log.debug() << "Number of spectra in input/source EventWorkspace = "
                 << numberOfSpectra << ".\n";
 
-  // FIXME - Turn on parallel:
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
     // Filter the non-skipped
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      std::map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWS) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
+      // Get the output event lists (should be empty), one per destination
+      std::vector<DataObjects::EventList *> outputs;
+      outputs.reserve(outputWorkspaces.size());
+      for (const auto &ws : outputWorkspaces)
+        outputs.push_back(&ws->getSpectrum(iws));
 
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
@@ -828,12 +834,12 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
       // Perform the filtering (using the splitting function and just one
       // output)
       if (m_FilterByPulseTime) {
-        input_el.splitByPulseTime(m_splitters, outputs);
+        input_el.splitByPulseTime(splitterIndex, outputs);
       } else if (m_tofCorrType != NoneCorrect) {
-        input_el.splitByFullTime(m_splitters, outputs, true,
+        input_el.splitByFullTime(splitterIndex, outputs, true,
                                  m_detTofFactors[iws], m_detTofOffsets[iws]);
       } else {
-        input_el.splitByFullTime(m_splitters, outputs, false, 1.0, 0.0);
+        input_el.splitByFullTime(splitterIndex, outputs, false, 1.0, 0.0);
       }
     }
 
@@ -855,38 +861,43 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
                 << lognames.size() << " to " << m_outputWS.size()
                 << " outptu workspaces. \n";
 
-  double numws = static_cast<double>(m_outputWS.size());
-  double outwsindex = 0.;
-  for (auto &ws : m_outputWS) {
-    int wsindex = ws.first;
-    DataObjects::EventWorkspace_sptr opws = ws.second;
+  // Generate the list of splitters of each output workspace in one pass
+  std::vector<Kernel::TimeSplitterType> splitters(outputWorkspaces.size());
+  for (const auto &splitter : m_splitters)
+    splitters[splitterIndex.position(splitter.index())].push_back(splitter);
 
-    // Generate a list of splitters for current output workspace
-    Kernel::TimeSplitterType splitters = generateSplitters(wsindex);
+  // Each output workspace has its own copy of the logs, so they are split in
+  // parallel
+  const int64_t numws = static_cast<int64_t>(outputWorkspaces.size());
+  Progress prog(this, 0.1 + progressamount, 0.3 + progressamount, numws);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numws; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const int wsindex = splitterIndex.indices()[i];
+    const DataObjects::EventWorkspace_sptr &opws = outputWorkspaces[i];
 
     g_log.debug() << "[FilterEvents D1215]: Output workspace Index " << wsindex
                   << ": Name = " << opws->name()
-                  << "; Number of splitters = " << splitters.size() << ".\n";
+                  << "; Number of splitters = " << splitters[i].size()
+                  << ".\n";
 
     // Skip output workspace has ZERO splitters
-    if (splitters.empty()) {
+    if (splitters[i].empty()) {
       g_log.warning() << "[FilterEvents] Workspace " << opws->name()
                       << " Indexed @ " << wsindex
                       << " won't have logs splitted due to zero splitter size. "
                       << ".\n";
-      continue;
-    }
-
-    // Split log
-    size_t numlogs = lognames.size();
-    for (size_t ilog = 0; ilog < numlogs; ++ilog) {
-      this->splitLog(opws, lognames[ilog], splitters);
+    } else {
+      // Split log
+      for (const auto &logname : lognames)
+        this->splitLog(opws, logname, splitters[i]);
+      opws->mutableRun().integrateProtonCharge();
     }
-    opws->mutableRun().integrateProtonCharge();
 
-    progress(0.1 + progressamount + outwsindex / numws * 0.2, "Splitting logs");
-    outwsindex += 1.;
+    prog.report("Splitting logs");
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
 }
 
 /** Split events by splitters represented by vector
@@ -908,12 +919,10 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
     if (!m_vecSkip[iws]) {
       // Get the output event lists (should be empty) to be a map
       map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWS) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
+      for (auto &ws : m_outputWS) {
+        int index = ws.first;
+        auto &output_el = ws.second->getSpectrum(iws);
+        outputs.emplace_hint(outputs.end(), index, &output_el);
       }
 
       // Get a holder on input workspace's event list of this spectrum
@@ -954,20 +963,6 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
                "split sample logs. ");
 }
 
-/** Generate splitters for specified workspace index as a subset of
- * m_splitters
- */
-Kernel::TimeSplitterType FilterEvents::generateSplitters(int wsindex) {
-  Kernel::TimeSplitterType splitters;
-  for (const auto &splitter : m_splitters) {
-    int index = splitter.index();
-    if (index == wsindex) {
-      splitters.push_back(splitter);
-    }
-  }
-  return splitters;
-}
-
 /** Split a log by splitters
  */
 void FilterEvents::splitLog(EventWorkspace_sptr eventws, std::string logname,
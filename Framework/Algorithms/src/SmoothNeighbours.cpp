@@ -17,6 +17,8 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/regex.hpp>
 
+#include <algorithm>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
@@ -333,6 +335,37 @@ void SmoothNeighbours::findNeighboursUbiqutious() {
   RadiusFilter radiusFilter(Radius);
 
   IDetector_const_sptr det;
+  // Find the pixels to skip, i.e. monitors and missing detectors, the masked
+  // ones and the ones whose neighbours are needed
+  enum class Pixel : char { Skipped, Masked, Smoothed };
+  const size_t numberOfSpectra = inWS->getNumberHistograms();
+  std::vector<Pixel> pixels(numberOfSpectra, Pixel::Skipped);
+  std::vector<specnum_t> spectra;
+  std::vector<size_t> neighbourIndex(numberOfSpectra, 0);
+  for (size_t wi = 0; wi < numberOfSpectra; wi++) {
+    try {
+      // Get the list of detectors in this pixel
+      const auto &dets = inWS->getSpectrum(wi).getDetectorIDs();
+      det = inst->getDetector(*dets.begin());
+      if (det->isMonitor())
+        continue; // skip monitor
+    } catch (Kernel::Exception::NotFoundError &) {
+      continue; // skip missing detector
+    }
+    if (det->isMasked()) {
+      pixels[wi] = Pixel::Masked;
+    } else {
+      pixels[wi] = Pixel::Smoothed;
+      neighbourIndex[wi] = spectra.size();
+      spectra.push_back(inWS->getSpectrum(wi).getSpectrumNo());
+    }
+  }
+  // The neighbours are found for chunks of pixels at once, which is faster
+  // than one at a time and does not hold all of them in memory
+  const size_t chunkSize = 10000;
+  size_t chunkStart = 0;
+  std::vector<SpectraDistanceMap> chunk;
+
   // Go through every input workspace pixel
   outWI = 0;
   int sum = getProperty("SumNumberOfNeighbours");
@@ -347,33 +380,34 @@ void SmoothNeighbours::findNeighboursUbiqutious() {
     if (sum > 1)
       if (used[wi])
         continue;
-    // We want to skip monitors
-    try {
-      // Get the list of detectors in this pixel
+    if (pixels[wi] == Pixel::Skipped)
+      continue; // skip monitors and missing detectors
+    if (pixels[wi] == Pixel::Masked) {
+      // Calibration masks many detectors, but there should be 0s after
+      // smoothing
+      if (sum == 1)
+        outWI++;
+      continue; // skip masked detectors
+    }
+    if (sum > 1) {
       const auto &dets = inWS->getSpectrum(wi).getDetectorIDs();
       det = inst->getDetector(*dets.begin());
-      if (det->isMonitor())
-        continue; // skip monitor
-      if (det->isMasked()) {
-        // Calibration masks many detectors, but there should be 0s after
-        // smoothing
-        if (sum == 1)
-          outWI++;
-        continue; // skip masked detectors
-      }
-      if (sum > 1) {
-        parent = det->getParent();
-        if (parent)
-          grandparent = parent->getParent();
-      }
-    } catch (Kernel::Exception::NotFoundError &) {
-      continue; // skip missing detector
+      parent = det->getParent();
+      if (parent)
+        grandparent = parent->getParent();
     }
 
     specnum_t inSpec = inWS->getSpectrum(wi).getSpectrumNo();
 
     // Step one - Get the number of specified neighbours
-    SpectraDistanceMap insideGrid = neighbourInfo.getNeighboursExact(inSpec);
+    const size_t position = neighbourIndex[wi];
+    if (position < chunkStart || position >= chunkStart + chunk.size()) {
+      chunkStart = position;
+      const size_t chunkEnd = std::min(spectra.size(), position + chunkSize);
+      chunk = neighbourInfo.getNeighboursExact(std::vector<specnum_t>(
+          spectra.begin() + position, spectra.begin() + chunkEnd));
+    }
+    SpectraDistanceMap &insideGrid = chunk[position - chunkStart];
 
     // Step two - Filter the results by the radius cut off.
     SpectraDistanceMap neighbSpectra = radiusFilter.apply(insideGrid);
@@ -11,7 +11,7 @@
 #include "MantidKernel/RebinParamsValidator.h"
 #include "MantidKernel/VectorHelper.h"
 
-#include <numeric>
+#include <algorithm>
 
 namespace Mantid {
 namespace Algorithms {
@@ -270,16 +270,17 @@ void SumEventsByLogValue::filterEventList(
   if (log->realSize() == 0)
     return;
 
-  const auto pulseTimes = eventList.getPulseTimes();
-  for (auto pulseTime : pulseTimes) {
-    // Find the value of the log at the time of this event
-    // This algorithm is really concerned with 'slow' logs so we don't care
-    // about
-    // the time of the event within the pulse.
-    // NB: If the pulse time is before the first log entry, we get the first
-    // value.
-    const int logValue = log->getSingleValue(pulseTime);
-
+  // Find the value of the log at the time of each event
+  // This algorithm is really concerned with 'slow' logs so we don't care
+  // about
+  // the time of the event within the pulse.
+  // NB: If the pulse time is before the first log entry, we get the first
+  // value.
+  // The order of the events does not matter, so sort the times and look them
+  // up in one pass over the log.
+  auto pulseTimes = eventList.getPulseTimes();
+  std::sort(pulseTimes.begin(), pulseTimes.end());
+  for (const int logValue : log->getSingleValues(pulseTimes)) {
     if (logValue >= minVal && logValue <= maxVal) {
       // In this scenario it's easy to know what bin to increment
       PARALLEL_ATOMIC
@@ -377,13 +378,8 @@ SumEventsByLogValue::getNumberSeriesLogs() {
 double SumEventsByLogValue::sumProtonCharge(
     const Kernel::TimeSeriesProperty<double> *protonChargeLog,
     const Kernel::TimeSplitterType &filter) {
-  // Clone the proton charge log and filter the clone on this log value
-  auto protonChargeLogClone(protonChargeLog->clone());
-  protonChargeLogClone->filterByTimes(filter);
-  // Seems like the only way to sum this is to yank out the values
-  const std::vector<double> pcValues = protonChargeLogClone->valuesAsVector();
-
-  return std::accumulate(pcValues.begin(), pcValues.end(), 0.0);
+  // Sums the values a filtered clone of the log would have, without the clone
+  return protonChargeLog->sumValuesInFilter(filter);
 }
 
 /** Create a single-spectrum Workspace2D containing the integrated counts versus
@@ -422,10 +418,11 @@ void SumEventsByLogValue::createBinnedOutput(
   for (int spec = 0; spec < numSpec; ++spec) {
     PARALLEL_START_INTERUPT_REGION
     const IEventList &eventList = m_inputWorkspace->getSpectrum(spec);
-    const auto pulseTimes = eventList.getPulseTimes();
-    for (auto pulseTime : pulseTimes) {
-      // Find the value of the log at the time of this event
-      const double logValue = log->getSingleValue(pulseTime);
+    // Find the value of the log at the time of each event
+    auto pulseTimes = eventList.getPulseTimes();
+    std::sort(pulseTimes.begin(), pulseTimes.end());
+    for (const T value : log->getSingleValues(pulseTimes)) {
+      const double logValue = static_cast<double>(value);
       if (logValue >= XValues.front() && logValue < XValues.back()) {
         PARALLEL_ATOMIC
         ++Y[VectorHelper::getBinIndex(XValues, logValue)];
@@ -96,6 +96,15 @@ public:
     dotestEventWorkspace(false, 1, false);
   }
 
+  void test_EventWorkspace_TwoGroups_summedInManyChunks() {
+    // 1600 pixels in a bank are summed in several chunks that are added up
+    dotestEventWorkspace(false, 2, true, 40);
+  }
+
+  void test_EventWorkspace_TwoGroups_summedInManyChunks_dontPreserveEvents() {
+    dotestEventWorkspace(false, 2, false, 40);
+  }
+
   void dotestEventWorkspace(bool inplace, size_t numgroups,
                             bool preserveEvents = true,
                             int bankWidthInPixels = 16) {
@@ -296,12 +305,21 @@ public:
     alg->setPropertyValue("GroupNames", "bank1,bank2,bank3,bank4,bank5,bank6");
     alg->setPropertyValue("OutputWorkspace", "SNAP_group_several");
     alg->execute();
+
+    alg = AlgorithmFactory::Instance().create("CreateGroupingWorkspace", 1);
+    alg->initialize();
+    alg->setPropertyValue("InputWorkspace", "SNAP_empty");
+    alg->setPropertyValue("FixedGroupCount", "100");
+    alg->setPropertyValue("ComponentName", "bank1");
+    alg->setPropertyValue("OutputWorkspace", "SNAP_group_hundred");
+    alg->execute();
   }
 
   ~DiffractionFocussing2TestPerformance() override {
     AnalysisDataService::Instance().remove("SNAP_empty");
     AnalysisDataService::Instance().remove("SNAP_group_bank1");
     AnalysisDataService::Instance().remove("SNAP_group_several");
+    AnalysisDataService::Instance().remove("SNAP_group_hundred");
   }
 
   void test_SNAP_event_one_group() {
@@ -373,6 +391,42 @@ public:
     TS_ASSERT_EQUALS(outWS->getNumberHistograms(), 6);
     AnalysisDataService::Instance().remove("SNAP_focus");
   }
+
+  void test_SNAP_event_hundred_groups() {
+    IAlgorithm_sptr alg =
+        AlgorithmFactory::Instance().create("DiffractionFocussing", 2);
+    alg->initialize();
+    alg->setPropertyValue("InputWorkspace", "SNAP_empty");
+    alg->setPropertyValue("GroupingWorkspace", "SNAP_group_hundred");
+    alg->setPropertyValue("OutputWorkspace", "SNAP_focus");
+    alg->setPropertyValue("PreserveEvents", "1");
+    alg->execute();
+    EventWorkspace_sptr outWS =
+        AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+            "SNAP_focus");
+
+    TS_ASSERT_EQUALS(outWS->getNumberHistograms(), 100);
+    // 65536 pixels do not divide into 100 groups, the last 36 are left out
+    TS_ASSERT_EQUALS(outWS->getNumberEvents(), 20 * 65500);
+    AnalysisDataService::Instance().remove("SNAP_focus");
+  }
+
+  void test_SNAP_event_hundred_groups_dontPreserveEvents() {
+    IAlgorithm_sptr alg =
+        AlgorithmFactory::Instance().create("DiffractionFocussing", 2);
+    alg->initialize();
+    alg->setPropertyValue("InputWorkspace", "SNAP_empty");
+    alg->setPropertyValue("GroupingWorkspace", "SNAP_group_hundred");
+    alg->setPropertyValue("OutputWorkspace", "SNAP_focus");
+    alg->setPropertyValue("PreserveEvents", "0");
+    alg->execute();
+    MatrixWorkspace_sptr outWS =
+        AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(
+            "SNAP_focus");
+
+    TS_ASSERT_EQUALS(outWS->getNumberHistograms(), 100);
+    AnalysisDataService::Instance().remove("SNAP_focus");
+  }
 };
 
 #endif /*DIFFRACTIONFOCUSSING2TEST_H_*/
@@ -1076,4 +1076,94 @@ public:
   }
 };
 
+class FilterEventsTestPerformance : public CxxTest::TestSuite {
+public:
+  static FilterEventsTestPerformance *createSuite() {
+    return new FilterEventsTestPerformance();
+  }
+  static void destroySuite(FilterEventsTestPerformance *suite) {
+    delete suite;
+  }
+
+  FilterEventsTestPerformance()
+      : m_runStart("2010-01-01T00:00:00") {
+    m_inputWS =
+        WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(2, 5,
+                                                                        true);
+    // A 100 second run with a pulse every 1/60th of a second, three events
+    // per pulse in each spectrum and logs to split
+    const int64_t numberOfPulses = 6000;
+    std::vector<Kernel::DateAndTime> pulseTimes;
+    for (int64_t pulse = 0; pulse < numberOfPulses; ++pulse)
+      pulseTimes.push_back(m_runStart + pulse * PULSE_LENGTH);
+
+    for (size_t i = 0; i < m_inputWS->getNumberHistograms(); ++i) {
+      auto &events = m_inputWS->getSpectrum(i);
+      events.reserve(3 * pulseTimes.size());
+      for (size_t pulse = 0; pulse < pulseTimes.size(); ++pulse) {
+        for (size_t e = 0; e < 3; ++e) {
+          const double tof =
+              static_cast<double>((pulse * 7 + e * 5000 + i * 13) % 16000);
+          events.addEventQuickly(TofEvent(tof + 100.0, pulseTimes[pulse]));
+        }
+      }
+    }
+
+    auto protonCharge =
+        Kernel::make_unique<Kernel::TimeSeriesProperty<double>>(
+            "proton_charge");
+    protonCharge->addValues(pulseTimes,
+                            std::vector<double>(pulseTimes.size(), 1.0));
+    auto temperature =
+        Kernel::make_unique<Kernel::TimeSeriesProperty<double>>("temperature");
+    for (size_t pulse = 0; pulse < pulseTimes.size(); pulse += 6)
+      temperature->addValue(pulseTimes[pulse],
+                            300.0 + static_cast<double>(pulse % 60));
+    auto &run = m_inputWS->mutableRun();
+    run.addProperty("run_start", m_runStart.toISO8601String(), true);
+    run.addLogData(protonCharge.release());
+    run.addLogData(temperature.release());
+  }
+
+  void tearDown() override { AnalysisDataService::Instance().clear(); }
+
+  void test_10_targets() { filterIntoSlices(10); }
+
+  void test_1000_targets() { filterIntoSlices(1000); }
+
+  void test_10000_targets() { filterIntoSlices(10000); }
+
+private:
+  /// Split the run into equal time slices, each into its own workspace
+  void filterIntoSlices(const int numberOfTargets) {
+    auto splitters = boost::make_shared<SplittersWorkspace>();
+    const int64_t sliceLength = RUN_LENGTH / numberOfTargets;
+    for (int i = 0; i < numberOfTargets; ++i) {
+      splitters->addSplitter(Kernel::SplittingInterval(
+          m_runStart + i * sliceLength, m_runStart + (i + 1) * sliceLength,
+          i));
+    }
+
+    FilterEvents filter;
+    filter.initialize();
+    filter.setProperty("InputWorkspace", m_inputWS);
+    filter.setProperty("SplitterWorkspace",
+                       boost::static_pointer_cast<Workspace>(splitters));
+    filter.setProperty("OutputWorkspaceBaseName", "FilteredSlices");
+    filter.setProperty("OutputTOFCorrectionWorkspace", "CorrectionWS");
+    TS_ASSERT_THROWS_NOTHING(filter.execute());
+    TS_ASSERT(filter.isExecuted());
+    const int numberOfOutputs = filter.getProperty("NumberOutputWS");
+    TS_ASSERT_EQUALS(numberOfOutputs, numberOfTargets);
+  }
+
+  /// The time between pulses in nanoseconds
+  static const int64_t PULSE_LENGTH = 1000000000 / 60;
+  /// The length of the run in nanoseconds
+  static const int64_t RUN_LENGTH = 100000000000;
+
+  Kernel::DateAndTime m_runStart;
+  EventWorkspace_sptr m_inputWS;
+};
+
 #endif /* MANTID_ALGORITHMS_FILTEREVENTSTEST_H_ */
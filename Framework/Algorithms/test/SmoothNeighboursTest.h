@@ -3,6 +3,9 @@
 
 #include "MantidAlgorithms/SmoothNeighbours.h"
 #include "MantidAPI/FrameworkManager.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 
 #include <cxxtest/TestSuite.h>
@@ -434,7 +437,10 @@ public:
     AnalysisDataService::Instance().clear();
     delete suite;
   }
-  SmoothNeighboursTestPerformance() { FrameworkManager::Instance(); }
+  SmoothNeighboursTestPerformance() {
+    FrameworkManager::Instance();
+    m_millionPixels = createPanelWorkspace(1000);
+  }
 
   void setUp() override {
     inWS =
@@ -458,8 +464,61 @@ public:
     alg.execute();
   }
 
+  void testMillionPixels() { smoothEightNeighbours(m_millionPixels); }
+
+  void testMillionPixelsReusingNeighbourIndex() {
+    // The k-d tree built by the previous test is kept with the instrument
+    smoothEightNeighbours(m_millionPixels);
+  }
+
 private:
+  void smoothEightNeighbours(MatrixWorkspace_sptr ws) {
+    SmoothNeighbours alg;
+    alg.initialize();
+    alg.setProperty("InputWorkspace", ws);
+    alg.setProperty("OutputWorkspace", "testMillionPixels");
+    alg.setProperty("WeightedSum", "Flat");
+    alg.setProperty("NumberOfNeighbours", 8);
+    alg.setProperty("Radius", 1.5);
+    alg.setProperty("RadiusUnits", "NumberOfPixels");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+  }
+
+  /// A workspace with a flat panel of n x n pixels. The panel is not a
+  /// RectangularDetector, so the neighbours are found in the k-d tree.
+  static MatrixWorkspace_sptr createPanelWorkspace(const int n) {
+    using namespace Mantid::Geometry;
+    const double pixelSize = 0.004;
+    MatrixWorkspace_sptr ws =
+        WorkspaceCreationHelper::create2DWorkspaceBinned(n * n, 2);
+    auto instrument = boost::make_shared<Instrument>("panel");
+    ws->setInstrument(instrument);
+
+    Object_sptr shape = ComponentCreationHelper::createCuboid(pixelSize / 2.0);
+    for (int i = 0; i < n * n; ++i) {
+      auto pixel = new Detector("pixel", i + 1, shape, instrument.get());
+      pixel->setPos((i % n) * pixelSize, (i / n) * pixelSize, 5.0);
+      instrument->add(pixel);
+      instrument->markAsDetector(pixel);
+      ws->getSpectrum(i).setDetectorID(i + 1);
+    }
+
+    auto source = new ObjComponent(
+        "moderator", ComponentCreationHelper::createSphere(0.1),
+        instrument.get());
+    source->setPos(V3D(0.0, 0.0, -20.0));
+    instrument->add(source);
+    instrument->markAsSource(source);
+    auto sample = new ObjComponent(
+        "samplePos", ComponentCreationHelper::createSphere(0.1),
+        instrument.get());
+    instrument->add(sample);
+    instrument->markAsSamplePos(sample);
+    return ws;
+  }
+
   MatrixWorkspace_sptr inWS;
+  MatrixWorkspace_sptr m_millionPixels;
 };
 
 #endif /*SMOOTHNEIGHBOURSTEST_H_*/
@@ -40,6 +40,9 @@ public:
   /// Constructor
   Cluster(const size_t &label);
 
+  /// Constructor taking the indexes belonging to the cluster
+  Cluster(const size_t &label, std::vector<size_t> indexes);
+
   /// integrate the cluster
   ClusterIntegratedValues
   integrate(boost::shared_ptr<const Mantid::API::IMDHistoWorkspace> ws)
@@ -58,9 +58,10 @@ private:
 
   void setStructureFactorCalculatorFromSample(const API::Sample &sample);
 
-  void calculateQAndAddToOutput(const Kernel::V3D &hkl,
-                                const Kernel::DblMatrix &orientedUB,
-                                const Kernel::DblMatrix &goniometerMatrix);
+  double getTubeGap() const;
+
+  void addPeakToOutput(DataObjects::Peak &peak, const Kernel::V3D &hkl,
+                       const Kernel::DblMatrix &goniometerMatrix);
 
 private:
   /// Reflection conditions possible
@@ -17,6 +17,15 @@ Cluster::Cluster(const size_t &label)
   m_indexes.reserve(1000);
 }
 
+/**
+ * Constructor
+ * @param label : Label (taken as original) for Cluster
+ * @param indexes : Linear indexes of the image belonging to the cluster
+ */
+Cluster::Cluster(const size_t &label, std::vector<size_t> indexes)
+    : m_originalLabel(label), m_indexes(std::move(indexes)),
+      m_rootCluster(this) {}
+
 /**
  * Get the label
  * @return : Return label.
@@ -7,7 +7,12 @@
 #include "MantidCrystal/BackgroundStrategy.h"
 #include "MantidCrystal/ICluster.h"
 #include "MantidCrystal/Cluster.h"
-#include "MantidCrystal/ClusterRegister.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
 
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
@@ -16,44 +21,6 @@ using namespace Mantid::Crystal::ConnectedComponentMappingTypes;
 namespace Mantid {
 namespace Crystal {
 namespace {
-/**
- * Perform integer power to determine the maximum number of face and edge
- * connected
- * neighbours for a given dimensionality
- * @param ws : Workspace with dimensionality
- * @return : Maximum number of possible neighbours
- */
-size_t calculateMaxNeighbours(IMDHistoWorkspace const *const ws) {
-  const size_t ndims = ws->getNumDims();
-  size_t maxNeighbours = 3;
-  for (size_t i = 1; i < ndims; ++i) {
-    maxNeighbours *= 3;
-  }
-  maxNeighbours -= 1;
-  return maxNeighbours;
-}
-
-/**
- * Get the maximum number of clusters possible in an MD space. For use as an
- * offset.
- * @param ws : Workspace to interogate
- * @param nIterators : number of equally sized iterators working on the
- * workspace
- * @return Maximum number of clusters.
- */
-size_t calculateMaxClusters(IMDHistoWorkspace const *const ws,
-                            size_t nIterators) {
-  size_t maxClusters = 1;
-  for (size_t i = 0; i < ws->getNumDims(); ++i) {
-    maxClusters *= ws->getDimension(i)->getNBins() / 2;
-  }
-  maxClusters /= nIterators;
-  if (maxClusters == 0) {
-    maxClusters = ws->getNPoints();
-  }
-  return maxClusters;
-}
-
 /**
  * Helper non-member to clone the input workspace
  * @param inWS: To clone
@@ -88,116 +55,205 @@ T reportEvery(const T &maxReports, const T &maxIterations) {
   return frequency;
 }
 
-// Helper function for determining if a set contains a specific value.
-template <typename Container>
-bool does_contain_key(const Container &container,
-                      const typename Container::key_type &value) {
-  return container.find(value) != container.end();
-}
+/// Parent of the elements that are not part of any cluster
+const size_t EMPTY = std::numeric_limits<size_t>::max();
+
+/**
+ * Lock-free disjoint set over the linear indexes of an image. Each element
+ * holds the index of its parent, roots are their own parent and background
+ * elements hold EMPTY. Two sets are always joined under the smaller of their
+ * roots, so the root of a set is its smallest index and no cycles can form
+ * while several threads join sets at the same time.
+ */
+class ConcurrentDisjointSet {
+public:
+  explicit ConcurrentDisjointSet(const size_t size) : m_parents(size) {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < static_cast<int64_t>(size); ++i) {
+      m_parents[i].store(EMPTY, std::memory_order_relaxed);
+    }
+  }
+
+  /// Number of elements
+  size_t size() const { return m_parents.size(); }
+
+  /// Make the element a set of its own
+  void add(const size_t index) { m_parents[index].store(index); }
+
+  /// Is the element the root of its set
+  bool isRoot(const size_t index) const {
+    return m_parents[index].load() == index;
+  }
+
+  /// Is the element part of no set
+  bool isEmpty(const size_t index) const {
+    return m_parents[index].load() == EMPTY;
+  }
+
+  /// Find the root of the set of a non-empty element, halving the path to it
+  size_t find(size_t index) {
+    size_t parent = m_parents[index].load();
+    while (parent != index) {
+      const size_t grandParent = m_parents[parent].load();
+      if (grandParent != parent) {
+        // Fails harmlessly if another thread has moved the element already
+        size_t expected = parent;
+        m_parents[index].compare_exchange_weak(expected, grandParent);
+      }
+      index = parent;
+      parent = grandParent;
+    }
+    return index;
+  }
+
+  /// Join the sets of two non-empty elements
+  void unite(size_t a, size_t b) {
+    while (true) {
+      a = find(a);
+      b = find(b);
+      if (a == b) {
+        return;
+      }
+      if (a < b) {
+        std::swap(a, b);
+      }
+      // Only succeeds if a is still a root, otherwise start again from there
+      size_t expected = a;
+      if (m_parents[a].compare_exchange_strong(expected, b)) {
+        return;
+      }
+    }
+  }
+
+private:
+  std::vector<std::atomic<size_t>> m_parents;
+};
 
 typedef boost::tuple<size_t, size_t> EdgeIndexPair;
 typedef std::vector<EdgeIndexPair> VecEdgeIndexPair;
 
 /**
  * Free function performing the CCL implementation over a range defined by the
- *iterator.
+ *iterator. Neighbours within the range are joined straight away, neighbours
+ *outside it are recorded to be joined once all the ranges are done.
  *
  * @param iterator : Iterator giving access the the image
  * @param strategy : Strategy for identifying background
- * @param neighbourElements : Grid of DisjointElements the same size as the
- *image
+ * @param disjointSet : Disjoint set over all the elements of the image
  * @param progress : Progress object to update
- * @param maxNeighbours : Maximum number of neighbours each element may have.
- *Determined by dimensionality.
- * @param startLabelId : Start label index to increment
  * @param edgeIndexVec : Vector of edge index pairs. To identify elements across
  *iterator boundaries to resolve later.
- * @return
  */
-size_t doConnectedComponentLabeling(IMDIterator *iterator,
-                                    BackgroundStrategy *const strategy,
-                                    VecElements &neighbourElements,
-                                    Progress &progress, size_t maxNeighbours,
-                                    size_t startLabelId,
-                                    VecEdgeIndexPair &edgeIndexVec) {
-  size_t currentLabelCount = startLabelId;
+void doConnectedComponentLabeling(IMDIterator *iterator,
+                                  BackgroundStrategy *const strategy,
+                                  ConcurrentDisjointSet &disjointSet,
+                                  Progress &progress,
+                                  VecEdgeIndexPair &edgeIndexVec) {
   strategy->configureIterator(
       iterator); // Set up such things as desired Normalization.
   do {
     if (!strategy->isBackground(iterator)) {
-
-      size_t currentIndex = iterator->getLinearIndex();
+      const size_t currentIndex = iterator->getLinearIndex();
       progress.report();
-      // Linear indexes of neighbours
-      VecIndexes neighbourIndexes = iterator->findNeighbourIndexes();
-      VecIndexes nonEmptyNeighbourIndexes;
-      nonEmptyNeighbourIndexes.reserve(maxNeighbours);
-      SetIds neighbourIds;
-      // Discover non-empty neighbours
-      for (auto neighIndex : neighbourIndexes) {
+      disjointSet.add(currentIndex);
+      // Each connection is made from the element with the larger index, as
+      // the neighbours after it in the range have not been visited yet.
+      for (auto neighIndex : iterator->findNeighbourIndexes()) {
+        if (neighIndex > currentIndex) {
+          continue;
+        }
         if (!iterator->isWithinBounds(neighIndex)) {
-          /* Record labels which appear to belong to the same cluster, but
-           cannot be combined in this
-           pass and will later need to be conjoined and resolved. As Labels
-           cannot be guarnteed to be
-           correcly provided for all neighbours until the end. We must store
-           indexes instead.
-           */
+          // Whether the neighbour is background is only known once the range
+          // holding it has been labeled.
           edgeIndexVec.emplace_back(currentIndex, neighIndex);
-          continue;
+        } else if (!disjointSet.isEmpty(neighIndex)) {
+          disjointSet.unite(currentIndex, neighIndex);
         }
+      }
+    }
+  } while (iterator->next());
+}
 
-        const DisjointElement &neighbourElement = neighbourElements[neighIndex];
+/**
+ * Split the linear indexes of an image into contiguous chunks
+ * @param size : Number of indexes
+ * @param nChunks : Number of chunks
+ * @param chunk : Chunk to get
+ * @return The first index of the chunk and the index after its last one
+ */
+std::pair<size_t, size_t> chunkRange(const size_t size, const size_t nChunks,
+                                     const size_t chunk) {
+  return std::make_pair(chunk * size / nChunks, (chunk + 1) * size / nChunks);
+}
 
-        if (!neighbourElement.isEmpty()) {
-          nonEmptyNeighbourIndexes.push_back(neighIndex);
-          neighbourIds.insert(neighbourElement.getId());
-        }
+/**
+ * Number the sets of a fully joined disjoint set in order of their roots and
+ * gather the indexes of each of them.
+ * @param disjointSet : Disjoint set no longer being joined
+ * @param nChunks : Number of chunks to process in parallel
+ * @return The indexes of each cluster in increasing order, clusters ordered by
+ * their smallest index
+ */
+std::vector<VecIndexes> collectClusters(ConcurrentDisjointSet &disjointSet,
+                                        const int nChunks) {
+  const size_t nPoints = disjointSet.size();
+  std::vector<VecIndexes> chunkRoots(nChunks);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int chunk = 0; chunk < nChunks; ++chunk) {
+    const auto range = chunkRange(nPoints, nChunks, chunk);
+    for (size_t i = range.first; i < range.second; ++i) {
+      if (disjointSet.isRoot(i)) {
+        chunkRoots[chunk].push_back(i);
       }
+    }
+  }
+  VecIndexes roots;
+  for (const auto &localRoots : chunkRoots) {
+    roots.insert(roots.end(), localRoots.begin(), localRoots.end());
+  }
 
-      if (nonEmptyNeighbourIndexes.empty()) {
-        DisjointElement &element = neighbourElements[currentIndex];
-        element.setId(static_cast<int>(currentLabelCount));
-        ++currentLabelCount;
-      } else if (neighbourIds.size() ==
-                 1) // Do we have a single unique id amongst all neighbours.
-      {
-        neighbourElements[currentIndex] =
-            neighbourElements[nonEmptyNeighbourIndexes.front()]; // Copy
-                                                                 // non-empty
-                                                                 // neighbour
-      } else {
-        // Choose the lowest neighbour index as the parent.
-        size_t candidateSourceParentIndex = nonEmptyNeighbourIndexes[0];
-        for (size_t i = 1; i < nonEmptyNeighbourIndexes.size(); ++i) {
-          size_t neighIndex = nonEmptyNeighbourIndexes[i];
-          if (neighbourElements[neighIndex].getRoot() <
-              neighbourElements[candidateSourceParentIndex].getRoot()) {
-            candidateSourceParentIndex = neighIndex;
-          }
-        }
-        // Get the chosen parent
-        DisjointElement &parentElement =
-            neighbourElements[candidateSourceParentIndex];
-        // Union remainder parents with the chosen parent
-        for (auto neighIndex : nonEmptyNeighbourIndexes) {
-          if (neighIndex != candidateSourceParentIndex) {
-            neighbourElements[neighIndex].unionWith(&parentElement);
-          }
-        }
-
-        neighbourElements[currentIndex].unionWith(&parentElement);
+  // Position of the cluster of each element, in order of the elements
+  typedef std::pair<size_t, size_t> ClusterIndexPair;
+  std::vector<std::vector<ClusterIndexPair>> chunkMembers(nChunks);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int chunk = 0; chunk < nChunks; ++chunk) {
+    const auto range = chunkRange(nPoints, nChunks, chunk);
+    auto &members = chunkMembers[chunk];
+    for (size_t i = range.first; i < range.second; ++i) {
+      if (!disjointSet.isEmpty(i)) {
+        const auto root = std::lower_bound(roots.begin(), roots.end(),
+                                           disjointSet.find(i));
+        members.emplace_back(
+            static_cast<size_t>(std::distance(roots.begin(), root)), i);
       }
     }
-  } while (iterator->next());
+  }
 
-  return currentLabelCount;
+  VecIndexes clusterSizes(roots.size(), 0);
+  for (const auto &members : chunkMembers) {
+    for (const auto &member : members) {
+      ++clusterSizes[member.first];
+    }
+  }
+  std::vector<VecIndexes> clusters(roots.size());
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    clusters[i].reserve(clusterSizes[i]);
+  }
+  for (auto &members : chunkMembers) {
+    for (const auto &member : members) {
+      clusters[member.first].push_back(member.second);
+    }
+    std::vector<ClusterIndexPair>().swap(members);
+  }
+  return clusters;
 }
 
 Logger g_log("ConnectedComponentLabeling");
 
 void memoryCheck(size_t nPoints) {
-  size_t sizeOfElement = (3 * sizeof(signal_t)) + sizeof(bool);
+  // Output image and the parent of each element in the disjoint set
+  size_t sizeOfElement =
+      (3 * sizeof(signal_t)) + sizeof(bool) + sizeof(size_t);
 
   MemoryStats memoryStats;
   const size_t freeMemory = memoryStats.availMem();         // in kB
@@ -263,8 +319,9 @@ int ConnectedComponentLabeling::getNThreads() const {
 
 /**
  * Perform the work of the CCL algorithm
- * - Pre filtering of background
- * - Labeling using DisjointElements
+ * - Labeling of the ranges of the iterators in parallel
+ * - Joining of clusters across the boundaries of the ranges in parallel
+ * - Numbering of the clusters in order of their smallest index
  *
  * @param ws : MDHistoWorkspace to run CCL algorithm on
  * @param baseStrategy : Background strategy
@@ -274,120 +331,66 @@ int ConnectedComponentLabeling::getNThreads() const {
 ClusterMap ConnectedComponentLabeling::calculateDisjointTree(
     IMDHistoWorkspace_sptr ws, BackgroundStrategy *const baseStrategy,
     Progress &progress) const {
-  std::map<size_t, boost::shared_ptr<ICluster>> clusterMap;
-  VecElements neighbourElements(ws->getNPoints());
-
-  const size_t maxNeighbours = calculateMaxNeighbours(ws.get());
+  ConcurrentDisjointSet disjointSet(ws->getNPoints());
 
   progress.doReport("Identifying clusters");
   size_t frequency = reportEvery<size_t>(10000, ws->getNPoints());
   progress.resetNumSteps(frequency, 0.0, 0.8);
 
-  // For each process maintains pair of index from within process bounds to
-  // index outside process bounds
   const int nThreadsToUse = getNThreads();
 
+  std::vector<std::unique_ptr<API::IMDIterator>> iterators;
   if (nThreadsToUse > 1) {
-    std::vector<API::IMDIterator *> iterators =
-        ws->createIterators(nThreadsToUse);
-
-    const size_t maxClustersPossible =
-        calculateMaxClusters(ws.get(), nThreadsToUse);
-
-    std::vector<VecEdgeIndexPair> parallelEdgeVec(nThreadsToUse);
-
-    std::vector<std::map<size_t, boost::shared_ptr<Cluster>>>
-        parallelClusterMapVec(nThreadsToUse);
-
-    // ------------- Stage One. Local CCL in parallel.
-    g_log.debug("Parallel solve local CCL");
-    // PARALLEL_FOR_NO_WSP_CHECK()
-    for (int i = 0; i < nThreadsToUse; ++i) {
-      API::IMDIterator *iterator = iterators[i];
-      boost::scoped_ptr<BackgroundStrategy> strategy(
-          baseStrategy->clone());                     // local strategy
-      VecEdgeIndexPair &edgeVec = parallelEdgeVec[i]; // local edge indexes
-
-      const size_t startLabel =
-          m_startId + (i * maxClustersPossible); // Ensure that label ids are
-                                                 // totally unique within each
-                                                 // parallel unit.
-      const size_t endLabel = doConnectedComponentLabeling(
-          iterator, strategy.get(), neighbourElements, progress, maxNeighbours,
-          startLabel, edgeVec);
-
-      // Create clusters from labels.
-      std::map<size_t, boost::shared_ptr<Cluster>> &localClusterMap =
-          parallelClusterMapVec[i]; // local cluster map.
-      for (size_t labelId = startLabel; labelId != endLabel; ++labelId) {
-        auto cluster = boost::make_shared<Cluster>(
-            labelId); // Create a cluster for the label and key it by the label.
-        localClusterMap[labelId] = cluster;
-      }
-
-      // Associate the member DisjointElements with a cluster. Involves looping
-      // back over iterator.
-      iterator->jumpTo(0); // Reset
-      do {
-        if (!baseStrategy->isBackground(iterator)) {
-          // Second pass smoothing step
-          const size_t currentIndex = iterator->getLinearIndex();
-
-          const size_t &labelAtIndex =
-              neighbourElements[currentIndex].getRoot();
-          localClusterMap[labelAtIndex]->addIndex(currentIndex);
-        }
-      } while (iterator->next());
+    for (auto iterator : ws->createIterators(nThreadsToUse)) {
+      iterators.emplace_back(iterator);
     }
+  } else {
+    iterators.emplace_back(ws->createIterator(nullptr));
+  }
+  const int nIterators = static_cast<int>(iterators.size());
 
-    // -------------------- Stage 2 --- Preparation stage for combining
-    // equivalent clusters. Must be done in sequence.
-    // Combine cluster maps processed by each thread.
-    ClusterRegister clusterRegister;
-    for (const auto &parallelClusterMap : parallelClusterMapVec) {
-      for (const auto &cluster : parallelClusterMap) {
-        clusterRegister.add(cluster.first, cluster.second);
-      }
+  // Each range works with its own strategy if there are several of them
+  std::vector<std::unique_ptr<BackgroundStrategy>> localStrategies;
+  if (nIterators > 1) {
+    for (int i = 0; i < nIterators; ++i) {
+      localStrategies.emplace_back(baseStrategy->clone());
     }
+  }
 
-    // Percolate minimum label across boundaries for indexes where there is
-    // ambiguity.
-    g_log.debug("Percolate minimum label across boundaries");
+  // For each range maintains pairs of index from within the range to index
+  // outside the range
+  std::vector<VecEdgeIndexPair> parallelEdgeVec(nIterators);
 
-    for (auto &indexPairVec : parallelEdgeVec) {
-      for (auto &iit : indexPairVec) {
-        DisjointElement &a = neighbourElements[iit.get<0>()];
-        DisjointElement &b = neighbourElements[iit.get<1>()];
-        clusterRegister.merge(a, b);
-      }
-    }
-    clusterMap = clusterRegister.clusters(neighbourElements);
+  // ------------- Stage One. Local CCL in parallel.
+  g_log.debug("Parallel solve local CCL");
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < nIterators; ++i) {
+    BackgroundStrategy *strategy =
+        localStrategies.empty() ? baseStrategy : localStrategies[i].get();
+    doConnectedComponentLabeling(iterators[i].get(), strategy, disjointSet,
+                                 progress, parallelEdgeVec[i]);
+  }
 
-  } else {
-    API::IMDIterator *iterator = ws->createIterator(nullptr);
-    VecEdgeIndexPair edgeIndexPair; // This should never get filled in a single
-                                    // threaded situation.
-    size_t endLabelId = doConnectedComponentLabeling(
-        iterator, baseStrategy, neighbourElements, progress, maxNeighbours,
-        m_startId, edgeIndexPair);
-
-    // Create clusters from labels.
-    for (size_t labelId = m_startId; labelId != endLabelId; ++labelId) {
-      auto cluster = boost::make_shared<Cluster>(
-          labelId); // Create a cluster for the label and key it by the label.
-      clusterMap[labelId] = cluster;
+  // ------------- Stage Two. Join clusters across the range boundaries.
+  g_log.debug("Join clusters across boundaries");
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < nIterators; ++i) {
+    for (const auto &edge : parallelEdgeVec[i]) {
+      if (!disjointSet.isEmpty(edge.get<1>())) {
+        disjointSet.unite(edge.get<0>(), edge.get<1>());
+      }
     }
+  }
 
-    // Associate the member DisjointElements with a cluster. Involves looping
-    // back over iterator.
-    iterator->jumpTo(0); // Reset
-    do {
-      const size_t currentIndex = iterator->getLinearIndex();
-      if (!baseStrategy->isBackground(iterator)) {
-        const int labelAtIndex = neighbourElements[currentIndex].getRoot();
-        clusterMap[labelAtIndex]->addIndex(currentIndex);
-      }
-    } while (iterator->next());
+  // ------------- Stage Three. Number the clusters from the start id.
+  std::vector<VecIndexes> clusterIndexes =
+      collectClusters(disjointSet, std::max(nThreadsToUse, 1));
+  ClusterMap clusterMap;
+  for (size_t i = 0; i < clusterIndexes.size(); ++i) {
+    const size_t label = m_startId + i;
+    clusterMap.emplace_hint(
+        clusterMap.end(), label,
+        boost::make_shared<Cluster>(label, std::move(clusterIndexes[i])));
   }
   return clusterMap;
 }
@@ -4,12 +4,16 @@
 #include "MantidAPI/Run.h"
 #include "MantidAPI/Sample.h"
 #include "MantidGeometry/Crystal/BasicHKLFilters.h"
-#include "MantidGeometry/Crystal/HKLFilterWavelength.h"
 #include "MantidGeometry/Crystal/HKLGenerator.h"
 #include "MantidGeometry/Crystal/StructureFactorCalculatorSummation.h"
+#include "MantidGeometry/ICompAssembly.h"
+#include "MantidGeometry/IDetector.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Objects/BoundingBox.h"
 #include "MantidGeometry/Objects/InstrumentRayTracer.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/EnabledWhenProperty.h"
+#include "MantidKernel/MultiThreaded.h"
 
 using Mantid::Kernel::EnabledWhenProperty;
 
@@ -34,6 +38,265 @@ double get_factor_for_q_convention(const std::string &convention) {
 
   return 1.0;
 }
+
+/**
+ * The directions from the sample in which a ray may hit a detector, on a grid
+ * of polar and azimuthal angles.
+ *
+ * The ray tracer only finds a detector inside the bounding boxes of all of
+ * its parent components, so a ray that misses the bounding boxes of the
+ * components added here cannot hit a detector and need not be traced. Each
+ * box is covered by the cone around the direction of its centre that contains
+ * all of its corners.
+ */
+class DetectorCoverage {
+public:
+  DetectorCoverage(const Instrument_const_sptr &instrument, double margin);
+  bool covers(const V3D &direction) const;
+
+private:
+  void addComponent(const IComponent_const_sptr &component);
+  static bool hasFewSubassemblies(const ICompAssembly &assembly);
+  double coneAngle(const BoundingBox &box, const V3D &axis) const;
+  void addCone(const V3D &axis, double halfAngle);
+  size_t polarBin(double polar) const;
+  size_t azimuthBin(double azimuth) const;
+
+  /// Number of bins of the polar angle between 0 and pi
+  static const size_t POLAR_BINS = 360;
+  /// Number of bins of the azimuthal angle between -pi and pi
+  static const size_t AZIMUTH_BINS = 720;
+  /// Assemblies with a wider cone and at most this many subassemblies are
+  /// replaced by their children
+  static const int MAX_CHILDREN = 256;
+  /// Cones are widened by this angle to allow for rounding errors
+  static constexpr double ANGLE_TOLERANCE = 1e-6;
+  /// Assemblies with a cone wider than this are replaced by their children
+  static constexpr double MAX_CONE_ANGLE = 10.0 * M_PI / 180.0;
+
+  V3D m_samplePos;
+  /// Widens every cone, e.g. for detectors found next to the ray
+  double m_margin;
+  /// True if every direction may hit a detector
+  bool m_coversAll;
+  /// The covered bins, by polar and then azimuthal angle
+  std::vector<bool> m_covered;
+};
+
+/**
+ * @param instrument :: The instrument whose detectors are covered
+ * @param margin :: Angle by which all cones are widened
+ */
+DetectorCoverage::DetectorCoverage(const Instrument_const_sptr &instrument,
+                                   const double margin)
+    : m_samplePos(instrument->getSample()->getPos()),
+      m_margin(margin + ANGLE_TOLERANCE), m_coversAll(false),
+      m_covered(POLAR_BINS * AZIMUTH_BINS, false) {
+  for (int i = 0; i < instrument->nelements(); ++i)
+    addComponent(instrument->getChild(i));
+}
+
+/**
+ * @param direction :: A direction from the sample
+ * @return false if a ray in this direction cannot hit a detector
+ */
+bool DetectorCoverage::covers(const V3D &direction) const {
+  if (m_coversAll)
+    return true;
+  const double length = direction.norm();
+  if (length == 0.0)
+    return true;
+  const double polar =
+      std::acos(std::max(-1.0, std::min(1.0, direction.Z() / length)));
+  const double azimuth = std::atan2(direction.Y(), direction.X());
+  return m_covered[polarBin(polar) * AZIMUTH_BINS + azimuthBin(azimuth)];
+}
+
+/// Add a component that may contain detectors, or its children
+void DetectorCoverage::addComponent(const IComponent_const_sptr &component) {
+  if (m_coversAll)
+    return;
+  const auto assembly =
+      boost::dynamic_pointer_cast<const ICompAssembly>(component);
+  // Only detectors are looked for along the ray
+  if (!assembly && !boost::dynamic_pointer_cast<const IDetector>(component))
+    return;
+  BoundingBox box;
+  component->getBoundingBox(box);
+  if (box.isNull())
+    return;
+
+  const V3D axis = box.centrePoint() - m_samplePos;
+  const double halfAngle = coneAngle(box, axis);
+  const bool unbounded = halfAngle < 0.0;
+  if (assembly && (unbounded || (halfAngle > MAX_CONE_ANGLE &&
+                                 hasFewSubassemblies(*assembly)))) {
+    for (int i = 0; i < assembly->nelements(); ++i)
+      addComponent(assembly->getChild(i));
+  } else if (unbounded) {
+    m_coversAll = true;
+  } else {
+    addCone(axis, halfAngle + m_margin);
+  }
+}
+
+/**
+ * The largest angle between the axis and a corner of the box, seen from the
+ * sample. The angle to the axis is quasi-convex in the forward half space, so
+ * no point of the box is at a larger angle.
+ * @return The angle or -1 if a corner is not in front of the sample
+ */
+double DetectorCoverage::coneAngle(const BoundingBox &box,
+                                   const V3D &axis) const {
+  const double axisLength = axis.norm();
+  if (axisLength == 0.0)
+    return -1.0;
+  double minCosine = 1.0;
+  for (const double x : {box.xMin(), box.xMax()}) {
+    for (const double y : {box.yMin(), box.yMax()}) {
+      for (const double z : {box.zMin(), box.zMax()}) {
+        const V3D corner = V3D(x, y, z) - m_samplePos;
+        const double cornerLength = corner.norm();
+        if (cornerLength == 0.0)
+          return -1.0;
+        minCosine = std::min(minCosine, axis.scalar_prod(corner) /
+                                            (axisLength * cornerLength));
+      }
+    }
+  }
+  if (minCosine <= 0.0)
+    return -1.0;
+  return std::acos(minCosine);
+}
+
+/// Whether the children of a wide assembly should be added instead of it.
+/// Tubes or columns of pixels are not split up into single pixels.
+bool DetectorCoverage::hasFewSubassemblies(const ICompAssembly &assembly) {
+  return assembly.nelements() > 0 && assembly.nelements() <= MAX_CHILDREN &&
+         boost::dynamic_pointer_cast<const ICompAssembly>(assembly.getChild(0));
+}
+
+/// Mark the bins that overlap a cone around the axis
+void DetectorCoverage::addCone(const V3D &axis, const double halfAngle) {
+  const double polar =
+      std::acos(std::max(-1.0, std::min(1.0, axis.Z() / axis.norm())));
+  const double azimuth = std::atan2(axis.Y(), axis.X());
+  const double polarMin = polar - halfAngle;
+  const double polarMax = polar + halfAngle;
+  // Half the range of azimuths in a cone that does not contain a pole
+  double azimuthWidth = M_PI;
+  if (polarMin > 0.0 && polarMax < M_PI) {
+    const double ratio = std::sin(halfAngle) / std::sin(polar);
+    if (ratio < 1.0)
+      azimuthWidth = std::asin(ratio);
+  }
+
+  const size_t firstPolar = polarBin(std::max(0.0, polarMin));
+  const size_t lastPolar = polarBin(std::min(M_PI, polarMax));
+  for (size_t polarIndex = firstPolar; polarIndex <= lastPolar; ++polarIndex) {
+    auto row = m_covered.begin() + polarIndex * AZIMUTH_BINS;
+    if (azimuthWidth >= M_PI) {
+      std::fill(row, row + AZIMUTH_BINS, true);
+      continue;
+    }
+    const double step = 2.0 * M_PI / static_cast<double>(AZIMUTH_BINS);
+    const auto first = static_cast<long>(
+        std::floor((azimuth - azimuthWidth + M_PI) / step));
+    const auto last = static_cast<long>(
+        std::floor((azimuth + azimuthWidth + M_PI) / step));
+    const auto bins = static_cast<long>(AZIMUTH_BINS);
+    for (long bin = first; bin <= last; ++bin)
+      row[((bin % bins) + bins) % bins] = true;
+  }
+}
+
+/// The bin of a polar angle between 0 and pi
+size_t DetectorCoverage::polarBin(const double polar) const {
+  const auto bin = static_cast<size_t>(
+      std::max(0.0, polar) * static_cast<double>(POLAR_BINS) / M_PI);
+  return std::min(bin, POLAR_BINS - 1);
+}
+
+/// The bin of an azimuthal angle between -pi and pi
+size_t DetectorCoverage::azimuthBin(const double azimuth) const {
+  const auto bin =
+      static_cast<size_t>(std::max(0.0, azimuth + M_PI) *
+                          static_cast<double>(AZIMUTH_BINS) / (2.0 * M_PI));
+  return std::min(bin, AZIMUTH_BINS - 1);
+}
+
+/// An HKL whose peak may hit a detector
+struct PeakCandidate {
+  /// Index of the goniometer setting
+  size_t goniometer;
+  /// Index of the HKL in the list of possible HKLs
+  size_t hkl;
+  /// UB * HKL for this goniometer setting, without the factor 2 pi
+  V3D q;
+};
+
+/**
+ * Find the HKLs whose peaks are within the wavelength limits and are
+ * scattered towards a detector for one goniometer setting. Q is computed for
+ * all HKLs in a single loop over the matrix elements, as in
+ * HKLFilterWavelength.
+ *
+ * @param orientedUB :: Goniometer matrix * UB
+ * @param goniometer :: Index of the goniometer setting
+ * @param possibleHKLs :: The HKLs to check
+ * @param lambdaMin :: Minimum wavelength
+ * @param lambdaMax :: Maximum wavelength
+ * @param beamIndex :: The axis pointing along the beam
+ * @param coverage :: The directions in which detectors may be hit
+ * @param candidates :: The HKLs that may hit a detector are appended
+ * @return The number of HKLs within the wavelength limits
+ */
+size_t addPeakCandidates(const DblMatrix &orientedUB, const size_t goniometer,
+                         const std::vector<V3D> &possibleHKLs,
+                         const double lambdaMin, const double lambdaMax,
+                         const size_t beamIndex,
+                         const DetectorCoverage &coverage,
+                         std::vector<PeakCandidate> &candidates) {
+  const double ub00 = orientedUB[0][0], ub01 = orientedUB[0][1],
+               ub02 = orientedUB[0][2];
+  const double ub10 = orientedUB[1][0], ub11 = orientedUB[1][1],
+               ub12 = orientedUB[1][2];
+  const double ub20 = orientedUB[2][0], ub21 = orientedUB[2][1],
+               ub22 = orientedUB[2][2];
+  auto calculateQ = [&](const V3D &hkl) {
+    return V3D(ub00 * hkl.X() + ub01 * hkl.Y() + ub02 * hkl.Z(),
+               ub10 * hkl.X() + ub11 * hkl.Y() + ub12 * hkl.Z(),
+               ub20 * hkl.X() + ub21 * hkl.Y() + ub22 * hkl.Z());
+  };
+
+  enum : char { REJECTED, MISSES_DETECTORS, CANDIDATE };
+  std::vector<char> status(possibleHKLs.size());
+  const auto numberOfHKLs = static_cast<int64_t>(possibleHKLs.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numberOfHKLs; ++i) {
+    const V3D q = calculateQ(possibleHKLs[i]);
+    const double qSquared = q.X() * q.X() + q.Y() * q.Y() + q.Z() * q.Z();
+    const double lambda = (2.0 * q.Z()) / qSquared;
+    if (!(lambda >= lambdaMin && lambda <= lambdaMax)) {
+      status[i] = REJECTED;
+      continue;
+    }
+    // The direction of the scattered beam, as in Peak::setQLabFrame
+    V3D direction = q * -1.0;
+    direction[beamIndex] = qSquared / (2.0 * q[beamIndex]) - q[beamIndex];
+    status[i] = coverage.covers(direction) ? CANDIDATE : MISSES_DETECTORS;
+  }
+
+  size_t allowedPeakCount = 0;
+  for (size_t i = 0; i < possibleHKLs.size(); ++i) {
+    if (status[i] == REJECTED)
+      continue;
+    ++allowedPeakCount;
+    if (status[i] == CANDIDATE)
+      candidates.push_back({goniometer, i, calculateQ(possibleHKLs[i])});
+  }
+  return allowedPeakCount;
+}
 }
 
 /** Constructor
@@ -238,29 +501,62 @@ void PredictPeaks::exec() {
    */
   double lambdaMin = getProperty("WavelengthMin");
   double lambdaMax = getProperty("WavelengthMax");
-
-  Progress prog(this, 0.0, 1.0, possibleHKLs.size() * gonioVec.size());
-  prog.setNotifyStep(0.01);
-
-  for (auto &goniometerMatrix : gonioVec) {
+  // Same checks of the wavelength limits as in HKLFilterWavelength
+  if (lambdaMin <= 0.0)
+    throw std::range_error("LambdaMin cannot be <= 0.");
+  if (lambdaMax <= lambdaMin)
+    throw std::range_error("LambdaMax cannot be smaller than LambdaMin.");
+
+  /* Only the peaks that are within the wavelength limits and scattered towards
+   * a detector for any goniometer setting are traced through the instrument.
+   */
+  const DetectorCoverage coverage(m_inst,
+                                  std::asin(std::min(1.0, getTubeGap())));
+  const size_t beamIndex = m_inst->getReferenceFrame()->pointingAlongBeam();
+  std::vector<PeakCandidate> candidates;
+  std::vector<size_t> allowedPeakCounts;
+  std::vector<size_t> candidatesEnd;
+  for (size_t i = 0; i < gonioVec.size(); ++i) {
     // Final transformation matrix (HKL to Q in lab frame)
-    DblMatrix orientedUB = goniometerMatrix * ub;
-
-    /* Because of the additional filtering step it's better to keep track of the
-     * allowed peaks with a counter. */
-    HKLFilterWavelength lambdaFilter(orientedUB, lambdaMin, lambdaMax);
-
-    size_t allowedPeakCount = 0;
+    const DblMatrix orientedUB = gonioVec[i] * ub;
+    allowedPeakCounts.push_back(
+        addPeakCandidates(orientedUB, i, possibleHKLs, lambdaMin, lambdaMax,
+                          beamIndex, coverage, candidates));
+    candidatesEnd.push_back(candidates.size());
+  }
 
-    for (auto &possibleHKL : possibleHKLs) {
-      if (lambdaFilter.isAllowed(possibleHKL)) {
-        ++allowedPeakCount;
-        calculateQAndAddToOutput(possibleHKL, orientedUB, goniometerMatrix);
+  // Trace the candidates of all goniometer settings in parallel
+  Progress prog(this, 0.0, 1.0, candidates.size());
+  prog.setNotifyStep(0.01);
+  std::vector<std::unique_ptr<Peak>> peaks(candidates.size());
+  const auto numberOfCandidates = static_cast<int64_t>(candidates.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numberOfCandidates; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    // Create the peak using the Q in the lab frame with all its info
+    auto peak = make_unique<Peak>(
+        m_inst, candidates[i].q * (2.0 * M_PI * m_qConventionFactor));
+    /* The constructor calls setQLabFrame, which already calls findDetector,
+       so it's enough to check whether a detector has been set. */
+    if (peak->getDetector())
+      peaks[i] = std::move(peak);
+    prog.report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Add the peaks in the order of the goniometer settings and HKLs
+  size_t candidate = 0;
+  for (size_t i = 0; i < gonioVec.size(); ++i) {
+    for (; candidate < candidatesEnd[i]; ++candidate) {
+      if (peaks[candidate]) {
+        addPeakToOutput(*peaks[candidate],
+                        possibleHKLs[candidates[candidate].hkl], gonioVec[i]);
+        peaks[candidate].reset();
       }
-      prog.report();
     }
 
-    g_log.notice() << "Out of " << allowedPeakCount
+    g_log.notice() << "Out of " << allowedPeakCounts[i]
                    << " allowed peaks within parameters, "
                    << m_pw->getNumberPeaks()
                    << " were found to hit a detector.\n";
@@ -400,47 +696,42 @@ void PredictPeaks::setStructureFactorCalculatorFromSample(
   }
 }
 
+/// The tube-gap parameter of the instrument, or 0 if it is not set. Peaks
+/// with a detector on both sides of a gap are found up to this distance
+/// off the scattered beam direction (of unit length).
+double PredictPeaks::getTubeGap() const {
+  if (!m_inst->hasParameter("tube-gap"))
+    return 0.0;
+  const std::vector<double> gaps =
+      m_inst->getNumberParameter("tube-gap", true);
+  return gaps.empty() ? 0.0 : std::fabs(gaps.front());
+}
+
 /**
- * @brief Calculates Q from HKL and adds a peak to the output workspace
+ * @brief Adds a peak that hits a detector to the output workspace
  *
- * This method takes HKL and uses the oriented UB matrix (UB multiplied by the
- * goniometer matrix) to calculate Q. It then creates a Peak-object using
- * that Q-vector and the internally stored instrument. If the corresponding
- * diffracted beam intersects with a detector, the peak is added to the output-
- * workspace.
+ * The peak was created from the Q of the HKL in the lab frame, which is
+ * the oriented UB matrix (UB multiplied by the goniometer matrix) times HKL.
+ * The goniometer matrix, run number, HKL and the structure factor, if it is
+ * calculated, are set before it is added.
  *
+ * @param peak
  * @param hkl
- * @param orientedUB
  * @param goniometerMatrix
  */
-void PredictPeaks::calculateQAndAddToOutput(const V3D &hkl,
-                                            const DblMatrix &orientedUB,
-                                            const DblMatrix &goniometerMatrix) {
-  // The q-vector direction of the peak is = goniometer * ub * hkl_vector
-  // This is in inelastic convention: momentum transfer of the LATTICE!
-  // Also, q does have a 2pi factor = it is equal to 2pi/wavelength.
-  V3D q = orientedUB * hkl * (2.0 * M_PI * m_qConventionFactor);
-
-  // Create the peak using the Q in the lab framewith all its info:
-  Peak p(m_inst, q);
-
-  /* The constructor calls setQLabFrame, which already calls findDetector, which
-     is expensive. It's not necessary to call it again, instead it's enough to
-     check whether a detector has already been set. */
-  if (p.getDetector()) {
-    // Only add peaks that hit the detector
-    p.setGoniometerMatrix(goniometerMatrix);
-    // Save the run number found before.
-    p.setRunNumber(m_runNumber);
-    p.setHKL(hkl * m_qConventionFactor);
-
-    if (m_sfCalculator) {
-      p.setIntensity(m_sfCalculator->getFSquared(hkl));
-    }
+void PredictPeaks::addPeakToOutput(Peak &peak, const V3D &hkl,
+                                   const DblMatrix &goniometerMatrix) {
+  peak.setGoniometerMatrix(goniometerMatrix);
+  // Save the run number found before.
+  peak.setRunNumber(m_runNumber);
+  peak.setHKL(hkl * m_qConventionFactor);
+
+  if (m_sfCalculator) {
+    peak.setIntensity(m_sfCalculator->getFSquared(hkl));
+  }
 
-    // Add it to the workspace
-    m_pw->addPeak(p);
-  } // Detector was found
+  // Add it to the workspace
+  m_pw->addPeak(peak);
 }
 
 } // namespace Mantid
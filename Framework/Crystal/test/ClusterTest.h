@@ -23,6 +23,14 @@ public:
     TS_ASSERT_EQUALS(cluster.getLabel(), label);
   }
 
+  void test_construction_with_indexes() {
+    const size_t label = 3;
+    Cluster cluster(label, {4, 5, 7});
+    TS_ASSERT_EQUALS(cluster.getLabel(), label);
+    TS_ASSERT_EQUALS(cluster.size(), 3);
+    TS_ASSERT_EQUALS(cluster.getRepresentitiveIndex(), 4);
+  }
+
   void test_do_integration() {
     IMDHistoWorkspace_sptr inWS = MDEventsTestHelper::makeFakeMDHistoWorkspace(
         1, 1, 6); // Makes a 1 by 6 md ws with identical signal values.
@@ -48,6 +48,25 @@ connection_workspace_to_set_of_labels(IMDHistoWorkspace const *const ws) {
   }
   return unique_values;
 }
+
+// Helper function for making a 3D workspace of raised cubes of 3 by 3 by 3
+// elements, each separated from the others by background.
+IMDHistoWorkspace_sptr make_separated_cubes(const size_t nBins) {
+  const double backgroundSignal = 0;
+  const double raisedSignal = 1;
+  IMDHistoWorkspace_sptr ws =
+      MDEventsTestHelper::makeFakeMDHistoWorkspace(backgroundSignal, 3, nBins);
+  for (size_t z = 0; z < nBins; ++z) {
+    for (size_t y = 0; y < nBins; ++y) {
+      for (size_t x = 0; x < nBins; ++x) {
+        if (x % 4 != 3 && y % 4 != 3 && z % 4 != 3) {
+          ws->setSignalAt(x + nBins * (y + nBins * z), raisedSignal);
+        }
+      }
+    }
+  }
+  return ws;
+}
 }
 
 //=====================================================================================
@@ -90,7 +109,7 @@ public:
 
     MockBackgroundStrategy mockStrategy;
     EXPECT_CALL(mockStrategy, isBackground(_))
-        .Times(static_cast<int>(inWS->getNPoints()) * 2)
+        .Times(static_cast<int>(inWS->getNPoints()))
         .WillRepeatedly(Return(false)); // A filter that passes everything.
     EXPECT_CALL(mockStrategy, configureIterator(_)).Times(1);
     size_t labelingId = 1;
@@ -114,7 +133,7 @@ public:
 
     MockBackgroundStrategy mockStrategy;
     EXPECT_CALL(mockStrategy, isBackground(_))
-        .Times(static_cast<int>(inWS->getNPoints()) * 2)
+        .Times(static_cast<int>(inWS->getNPoints()))
         .WillRepeatedly(Return(false)); // A filter that passes everything.
     EXPECT_CALL(mockStrategy, configureIterator(_)).Times(1);
     size_t labelingId = 2;
@@ -154,13 +173,6 @@ public:
         .WillOnce(Return(false))
         .WillOnce(Return(false))
         .WillOnce(Return(false))
-        // And because we are calling it twice. Repeat pattern
-        .WillOnce(Return(false))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true)) // is background
-        .WillOnce(Return(false))
-        .WillOnce(Return(false))
-        .WillOnce(Return(false))
 
         .WillRepeatedly(Return(false));
 
@@ -190,12 +202,6 @@ public:
     /*
      * We use the is background strategy to set up three disconected blocks for us.
      * */ EXPECT_CALL(mockStrategy, isBackground(_))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true)) // is background
-        .WillOnce(Return(false))
-        .WillOnce(Return(true)) // is background
-        .WillOnce(Return(false))
-        // Repeat pattern because we are calling twice
         .WillOnce(Return(false))
         .WillOnce(Return(true)) // is background
         .WillOnce(Return(false))
@@ -251,16 +257,6 @@ public:
     /*
      * We treat alternate cells as background, which actually should result in a single object. Think of a chequered flag.
      * */ EXPECT_CALL(mockStrategy, isBackground(_))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        // Repeat because called twice
         .WillOnce(Return(true))
         .WillOnce(Return(false))
         .WillOnce(Return(true))
@@ -296,34 +292,6 @@ public:
     /*
      * We treat alternate cells as background, which actually should result in a single object. Think of a chequered flag.
      * */ EXPECT_CALL(mockStrategy, isBackground(_))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        .WillOnce(Return(false))
-        .WillOnce(Return(true))
-        // Repeat because called twice.
         .WillOnce(Return(true))
         .WillOnce(Return(false))
         .WillOnce(Return(true))
@@ -617,6 +585,49 @@ public:
   void test_brige_link_schenario_multi_threaded() {
     do_test_brige_link_schenario(3);
   }
+
+  void test_labels_do_not_depend_on_number_of_threads() {
+    // The ranges of the threads cut through the cubes
+    IMDHistoWorkspace_sptr inWS = make_separated_cubes(12);
+    HardThresholdBackground strategy(0, NoNormalization);
+    Progress prog;
+
+    ConnectedComponentLabeling singleThreaded(1, 1);
+    auto expectedWS = singleThreaded.execute(inWS, &strategy, prog);
+    ConnectedComponentLabeling multiThreaded(1, 5);
+    auto outWS = multiThreaded.execute(inWS, &strategy, prog);
+
+    size_t nDifferent = 0;
+    for (size_t i = 0; i < outWS->getNPoints(); ++i) {
+      if (outWS->getSignalAt(i) != expectedWS->getSignalAt(i)) {
+        ++nDifferent;
+      }
+    }
+    TS_ASSERT_EQUALS(0, nDifferent);
+  }
+
+  void test_clusters_numbered_from_start_label_id() {
+    IMDHistoWorkspace_sptr inWS = make_separated_cubes(12);
+    HardThresholdBackground strategy(0, NoNormalization);
+    const size_t labelingId = 5;
+    ConnectedComponentLabeling ccl(labelingId, 4);
+    Progress prog;
+    auto result = ccl.executeAndFetchClusters(inWS, &strategy, prog);
+
+    const auto &clusters = result.get<1>();
+    TSM_ASSERT_EQUALS("Should have 3 by 3 by 3 cubes", 27, clusters.size());
+    size_t expectedLabel = labelingId;
+    for (const auto &cluster : clusters) {
+      TS_ASSERT_EQUALS(expectedLabel, cluster.first);
+      TS_ASSERT_EQUALS(expectedLabel, cluster.second->getLabel());
+      TSM_ASSERT_EQUALS("Each cube has 3 by 3 by 3 elements", 27,
+                        cluster.second->size());
+      ++expectedLabel;
+    }
+    // Clusters are numbered in order of their first element
+    TS_ASSERT_EQUALS(labelingId, result.get<0>()->getSignalAt(0));
+    TS_ASSERT_EQUALS(labelingId + 1, result.get<0>()->getSignalAt(4));
+  }
 };
 
 //=====================================================================================
@@ -627,6 +638,8 @@ private:
   IMDHistoWorkspace_sptr m_inWS;
   const double m_backgroundSignal;
   boost::scoped_ptr<BackgroundStrategy> m_backgroundStrategy;
+  IMDHistoWorkspace_sptr m_cubes100;
+  IMDHistoWorkspace_sptr m_cubes200;
 
 public:
   // This pair of boilerplate methods prevent the suite being created statically
@@ -658,6 +671,9 @@ public:
         m_inWS->setSignalAt(*it, raisedSignal);
       }
     }
+
+    m_cubes100 = make_separated_cubes(100);
+    m_cubes200 = make_separated_cubes(200);
   }
 
   void testPerformance() {
@@ -674,6 +690,33 @@ public:
     TS_ASSERT(does_set_contain(uniqueEntries, size_t(0)));
     TS_ASSERT(does_set_contain(uniqueEntries, size_t(1)));
   }
+
+  void do_test_separated_cubes(IMDHistoWorkspace_sptr inWS,
+                               boost::optional<int> nThreads) {
+    ConnectedComponentLabeling ccl(1, nThreads);
+    Progress prog;
+    auto result =
+        ccl.executeAndFetchClusters(inWS, m_backgroundStrategy.get(), prog);
+    const size_t cubesPerDim = inWS->getDimension(0)->getNBins() / 4;
+    TS_ASSERT_EQUALS(cubesPerDim * cubesPerDim * cubesPerDim,
+                     result.get<1>().size());
+  }
+
+  void test_100_cubed_single_threaded() {
+    do_test_separated_cubes(m_cubes100, 1);
+  }
+
+  void test_100_cubed_multi_threaded() {
+    do_test_separated_cubes(m_cubes100, boost::none);
+  }
+
+  void test_200_cubed_single_threaded() {
+    do_test_separated_cubes(m_cubes200, 1);
+  }
+
+  void test_200_cubed_multi_threaded() {
+    do_test_separated_cubes(m_cubes200, boost::none);
+  }
 };
 
 #endif /* MANTID_CRYSTAL_CONNECTEDCOMPONENTLABELINGTEST_H_ */
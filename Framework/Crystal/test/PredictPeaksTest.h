@@ -179,6 +179,63 @@ public:
 
   void test_manual_U_and_gonio() { do_test_manual(22.5, 22.5); }
 
+  /** Peaks that are not traced because they are scattered away from the
+   * detectors are the ones that would have missed them */
+  void test_same_peaks_as_tracing_every_hkl() {
+    MatrixWorkspace_sptr inWS =
+        WorkspaceCreationHelper::create2DWorkspace(10000, 1);
+    Instrument_sptr inst =
+        ComponentCreationHelper::createTestInstrumentRectangular2(1, 100);
+    inWS->setInstrument(inst);
+    WorkspaceCreationHelper::setOrientedLattice(inWS, 10.0, 10.0, 10.0);
+    WorkspaceCreationHelper::setGoniometer(inWS, 30.0, 10.0, 0.);
+
+    std::vector<V3D> hkls;
+    for (int h = -6; h <= 6; ++h)
+      for (int k = -6; k <= 6; ++k)
+        for (int l = -6; l <= 6; ++l)
+          if (h != 0 || k != 0 || l != 0)
+            hkls.emplace_back(h, k, l);
+
+    PredictPeaks alg;
+    alg.setChild(true);
+    alg.initialize();
+    alg.setProperty("InputWorkspace",
+                    boost::dynamic_pointer_cast<Workspace>(inWS));
+    alg.setPropertyValue("OutputWorkspace", "dummy");
+    alg.setProperty("HKLPeaksWorkspace", getHKLpw(inst, hkls, 0));
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    PeaksWorkspace_sptr ws = alg.getProperty("OutputWorkspace");
+
+    // Trace the peaks of all HKLs within the default wavelength limits
+    const double factor = Kernel::ConfigService::Instance().getString(
+                              "Q.convention") == "Crystallography"
+                              ? -1.0
+                              : 1.0;
+    const DblMatrix orientedUB =
+        inWS->run().getGoniometerMatrix() *
+        inWS->sample().getOrientedLattice().getUB();
+    std::vector<std::pair<V3D, int>> expected;
+    for (const auto &hkl : hkls) {
+      const V3D q = orientedUB * hkl;
+      const double lambda = 2.0 * q.Z() / q.norm2();
+      if (lambda < 0.1 || lambda > 100.0)
+        continue;
+      Peak peak(inWS->getInstrument(), q * (2.0 * M_PI * factor));
+      if (peak.getDetector())
+        expected.emplace_back(hkl, peak.getDetectorID());
+    }
+
+    TS_ASSERT(expected.size() > 1);
+    TS_ASSERT_EQUALS(ws->getNumberPeaks(), static_cast<int>(expected.size()));
+    for (int i = 0; i < std::min(ws->getNumberPeaks(),
+                                 static_cast<int>(expected.size()));
+         ++i) {
+      TS_ASSERT_EQUALS(ws->getPeak(i).getHKL(), expected[i].first);
+      TS_ASSERT_EQUALS(ws->getPeak(i).getDetectorID(), expected[i].second);
+    }
+  }
+
   void test_crystallography() {
     Kernel::ConfigService::Instance().setString("Q.convention",
                                                 "Crystallography");
@@ -186,4 +243,39 @@ public:
   }
 };
 
+class PredictPeaksTestPerformance : public CxxTest::TestSuite {
+public:
+  static PredictPeaksTestPerformance *createSuite() {
+    return new PredictPeaksTestPerformance();
+  }
+  static void destroySuite(PredictPeaksTestPerformance *suite) {
+    delete suite;
+  }
+
+  PredictPeaksTestPerformance() {
+    m_inWS = WorkspaceCreationHelper::create2DWorkspace(10000, 1);
+    m_inWS->setInstrument(
+        ComponentCreationHelper::createTestInstrumentRectangular2(1, 100));
+    WorkspaceCreationHelper::setOrientedLattice(m_inWS, 20.0, 20.0, 20.0);
+    WorkspaceCreationHelper::setGoniometer(m_inWS, 30.0, 10.0, 0.);
+  }
+
+  void test_small_d_spacing() {
+    PredictPeaks alg;
+    alg.setChild(true);
+    alg.initialize();
+    alg.setProperty("InputWorkspace",
+                    boost::dynamic_pointer_cast<Workspace>(m_inWS));
+    alg.setPropertyValue("OutputWorkspace", "dummy");
+    alg.setPropertyValue("MinDSpacing", "0.5");
+    alg.setPropertyValue("WavelengthMax", "10.0");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    PeaksWorkspace_sptr ws = alg.getProperty("OutputWorkspace");
+    TS_ASSERT_LESS_THAN(0, ws->getNumberPeaks());
+  }
+
+private:
+  MatrixWorkspace_sptr m_inWS;
+};
+
 #endif /* MANTID_CRYSTAL_PREDICTPEAKSTEST_H_ */
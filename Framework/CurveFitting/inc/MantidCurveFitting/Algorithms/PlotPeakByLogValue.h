@@ -78,6 +78,19 @@ class DLLExport PlotPeakByLogValue : public API::Algorithm {
     std::vector<int> indx; ///< a list of ws indices to fit if i and spec < 0
   };
 
+  /** A single spectrum to fit and the results of its fit
+    */
+  struct SpectrumFit {
+    std::string name;             ///< Name of the workspace or file
+    API::MatrixWorkspace_sptr ws; ///< Workspace containing the spectrum
+    int index;                    ///< Workspace index of the spectrum
+    double logValue;              ///< Value to plot the parameters against
+    std::string minimizer;        ///< Minimizer string for this spectrum
+    std::vector<double> parameters; ///< Fitted parameter values
+    std::vector<double> errors;     ///< Errors of the fitted parameters
+    double chi2;                    ///< Chi squared over degrees of freedom
+  };
+
 public:
   /// Algorithm's name for identification overriding a virtual method
   const std::string name() const override { return "PlotPeakByLogValue"; }
@@ -105,6 +118,15 @@ private:
   /// Create a list of input workspace names
   std::vector<InputData> makeNames() const;
 
+  /// Fit a single spectrum, starting from the parameters of fun
+  void fitSpectrum(SpectrumFit &spectrum, API::IFunction_sptr &fun) const;
+
+  /// Fit independent spectra concurrently
+  void fitSpectraInParallel(std::vector<SpectrumFit> &spectra,
+                            const API::IFunction &fun,
+                            const std::vector<double> &initialParams,
+                            bool individual);
+
   /// Create a minimizer string based on template string provided
   std::string getMinimizerString(const std::string &wsName,
                                  const std::string &wsIndex);
@@ -81,6 +81,11 @@ protected:
                           API::FunctionDomain_sptr domain,
                           API::FunctionValues_sptr values,
                           bool evalDeriv = true, bool evalHessian = true) const;
+  void addValDerivHessian(API::IFunction_sptr function,
+                          API::FunctionDomain_sptr domain,
+                          API::FunctionValues_sptr values, bool evalDeriv,
+                          bool evalHessian, double &value, GSLVector &der,
+                          GSLMatrix &hessian) const;
 
   /// Get mapped weights from FunctionValues
   virtual std::vector<double>
@@ -3,6 +3,8 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <map>
+#include <mutex>
 #include <MantidKernel/StringTokenizer.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string/replace.hpp>
@@ -25,8 +27,12 @@
 #include "MantidAPI/BinEdgeAxis.h"
 #include "MantidAPI/Run.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadScheduler.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 
 namespace {
 Mantid::Kernel::Logger g_log("PlotPeakByLogValue");
@@ -136,6 +142,13 @@ void PlotPeakByLogValue::init() {
           new Kernel::ListValidator<std::string>(evaluationTypes)),
       "The way the function is evaluated: CentrePoint or Histogram.",
       Kernel::Direction::Input);
+
+  declareProperty("Parallel", false,
+                  "If true the spectra are fitted concurrently. With FitType "
+                  "'Individual' the results are the same as with serial "
+                  "fits.\n"
+                  "With FitType 'Sequential' each fit starts with the "
+                  "parameters of the nearest spectrum fitted so far.");
 }
 
 /**
@@ -150,10 +163,8 @@ void PlotPeakByLogValue::exec() {
   // int wi = getProperty("WorkspaceIndex");
   std::string logName = getProperty("LogValue");
   bool individual = getPropertyValue("FitType") == "Individual";
-  bool passWSIndexToFunction = getProperty("PassWSIndexToFunction");
+  bool parallel = getProperty("Parallel");
   bool createFitOutput = getProperty("CreateOutput");
-  bool outputCompositeMembers = getProperty("OutputCompositeMembers");
-  bool outputConvolvedMembers = getProperty("ConvolveMembers");
   m_baseName = getPropertyValue("OutputWorkspace");
 
   bool isDataName = false; // if true first output column is of type string and
@@ -177,12 +188,10 @@ void PlotPeakByLogValue::exec() {
     throw std::invalid_argument("Fitting function failed to initialize");
   }
 
-  // for inidividual fittings store the initial parameters
+  // store the initial parameters for individual or parallel fittings
   std::vector<double> initialParams(ifun->nParams());
-  if (individual) {
-    for (size_t i = 0; i < initialParams.size(); ++i) {
-      initialParams[i] = ifun->getParameter(i);
-    }
+  for (size_t i = 0; i < initialParams.size(); ++i) {
+    initialParams[i] = ifun->getParameter(i);
   }
 
   for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
@@ -193,12 +202,8 @@ void PlotPeakByLogValue::exec() {
 
   setProperty("OutputWorkspace", result);
 
-  std::vector<std::string> covariance_workspaces;
-  std::vector<std::string> fit_workspaces;
-  std::vector<std::string> parameter_workspaces;
-
-  double dProg = 1. / static_cast<double>(wsNames.size());
-  double Prog = 0.;
+  // Collect the spectra to fit in the order of the output table
+  std::vector<SpectrumFit> spectra;
   for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
     InputData data = getWorkspace(wsNames[i]);
 
@@ -222,13 +227,6 @@ void PlotPeakByLogValue::exec() {
       jend = data.indx.back() + 1;
     }
 
-    if (createFitOutput) {
-      covariance_workspaces.reserve(covariance_workspaces.size() + jend);
-      fit_workspaces.reserve(fit_workspaces.size() + jend);
-      parameter_workspaces.reserve(parameter_workspaces.size() + jend);
-    }
-
-    dProg /= abs(jend - j);
     for (; j < jend; ++j) {
 
       // Find the log value: it is either a log-file value or simply the
@@ -257,89 +255,29 @@ void PlotPeakByLogValue::exec() {
         logValue = logp->lastValue();
       }
 
-      double chi2;
-
-      try {
-        if (passWSIndexToFunction) {
-          setWorkspaceIndexAttribute(ifun, j);
-        }
-
-        g_log.debug() << "Fitting " << data.ws->name() << " index " << j
-                      << " with \n";
-        g_log.debug() << ifun->asString() << '\n';
-
-        const std::string spectrum_index = std::to_string(j);
-        std::string wsBaseName;
-
-        if (createFitOutput)
-          wsBaseName = wsNames[i].name + "_" + spectrum_index;
-
-        bool histogramFit = getPropertyValue("EvaluationType") == "Histogram";
-
-        // Fit the function
-        API::IAlgorithm_sptr fit =
-            AlgorithmManager::Instance().createUnmanaged("Fit");
-        fit->initialize();
-        fit->setPropertyValue("EvaluationType",
-                              getPropertyValue("EvaluationType"));
-        fit->setProperty("Function", ifun);
-        fit->setProperty("InputWorkspace", data.ws);
-        fit->setProperty("WorkspaceIndex", j);
-        fit->setPropertyValue("StartX", getPropertyValue("StartX"));
-        fit->setPropertyValue("EndX", getPropertyValue("EndX"));
-        fit->setPropertyValue(
-            "Minimizer", getMinimizerString(wsNames[i].name, spectrum_index));
-        fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
-        fit->setPropertyValue("MaxIterations",
-                              getPropertyValue("MaxIterations"));
-        fit->setProperty("CalcErrors", true);
-        fit->setProperty("CreateOutput", createFitOutput);
-        if (!histogramFit) {
-          fit->setProperty("OutputCompositeMembers", outputCompositeMembers);
-          fit->setProperty("ConvolveMembers", outputConvolvedMembers);
-        }
-        fit->setProperty("Output", wsBaseName);
-        fit->execute();
-
-        if (!fit->isExecuted()) {
-          throw std::runtime_error("Fit child algorithm failed: " +
-                                   data.ws->name());
-        }
-
-        ifun = fit->getProperty("Function");
-        chi2 = fit->getProperty("OutputChi2overDoF");
-
-        if (createFitOutput) {
-          covariance_workspaces.push_back(wsBaseName +
-                                          "_NormalisedCovarianceMatrix");
-          parameter_workspaces.push_back(wsBaseName + "_Parameters");
-          fit_workspaces.push_back(wsBaseName + "_Workspace");
-        }
-
-        g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
-                      << ' ' << chi2 << '\n';
-
-      } catch (...) {
-        g_log.error("Error in Fit ChildAlgorithm");
-        throw;
-      }
-
-      // Extract the fitted parameters and put them into the result table
-      TableRow row = result->appendRow();
-      if (isDataName) {
-        row << wsNames[i].name;
-      } else {
-        row << logValue;
-      }
+      SpectrumFit spectrum;
+      spectrum.name = wsNames[i].name;
+      spectrum.ws = data.ws;
+      spectrum.index = j;
+      spectrum.logValue = logValue;
+      spectrum.minimizer =
+          getMinimizerString(wsNames[i].name, std::to_string(j));
+      spectrum.chi2 = 0.0;
+      spectra.push_back(spectrum);
+    }
+  }
 
-      for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
-        row << ifun->getParameter(iPar) << ifun->getError(iPar);
-      }
-      row << chi2;
+  if (parallel && spectra.size() > 1) {
+    fitSpectraInParallel(spectra, *ifun, initialParams, individual);
+  } else {
+    double dProg =
+        1. / static_cast<double>(std::max<size_t>(spectra.size(), 1));
+    double Prog = 0.;
+    for (auto &spectrum : spectra) {
+      fitSpectrum(spectrum, ifun);
 
       Prog += dProg;
-      std::string current = std::to_string(i);
-      progress(Prog, ("Fitting Workspace: (" + current + ") - "));
+      progress(Prog, ("Fitting Workspace: (" + spectrum.name + ") - "));
       interruption_point();
 
       if (individual) {
@@ -347,8 +285,35 @@ void PlotPeakByLogValue::exec() {
           ifun->setParameter(i, initialParams[i]);
         }
       }
+    }
+  }
+
+  std::vector<std::string> covariance_workspaces;
+  std::vector<std::string> fit_workspaces;
+  std::vector<std::string> parameter_workspaces;
+
+  // Extract the fitted parameters and put them into the result table
+  for (const auto &spectrum : spectra) {
+    TableRow row = result->appendRow();
+    if (isDataName) {
+      row << spectrum.name;
+    } else {
+      row << spectrum.logValue;
+    }
 
-    } // for(;j < jend;++j)
+    for (size_t iPar = 0; iPar < spectrum.parameters.size(); ++iPar) {
+      row << spectrum.parameters[iPar] << spectrum.errors[iPar];
+    }
+    row << spectrum.chi2;
+
+    if (createFitOutput) {
+      const std::string wsBaseName =
+          spectrum.name + "_" + std::to_string(spectrum.index);
+      covariance_workspaces.push_back(wsBaseName +
+                                      "_NormalisedCovarianceMatrix");
+      parameter_workspaces.push_back(wsBaseName + "_Parameters");
+      fit_workspaces.push_back(wsBaseName + "_Workspace");
+    }
   }
 
   if (createFitOutput) {
@@ -518,6 +483,157 @@ void PlotPeakByLogValue::setWorkspaceIndexAttribute(IFunction_sptr fun,
   }
 }
 
+/**
+ * Fit a single spectrum and store the fitted parameters in the SpectrumFit.
+ *
+ * @param spectrum :: The spectrum to fit, receives the results of the fit
+ * @param fun :: The fitting function, holding the starting parameters. It is
+ * set to the fitted function on return.
+ */
+void PlotPeakByLogValue::fitSpectrum(SpectrumFit &spectrum,
+                                     IFunction_sptr &fun) const {
+  bool passWSIndexToFunction = getProperty("PassWSIndexToFunction");
+  bool createFitOutput = getProperty("CreateOutput");
+  bool outputCompositeMembers = getProperty("OutputCompositeMembers");
+  bool outputConvolvedMembers = getProperty("ConvolveMembers");
+
+  try {
+    if (passWSIndexToFunction) {
+      setWorkspaceIndexAttribute(fun, spectrum.index);
+    }
+
+    g_log.debug() << "Fitting " << spectrum.ws->name() << " index "
+                  << spectrum.index << " with \n";
+    g_log.debug() << fun->asString() << '\n';
+
+    std::string wsBaseName;
+    if (createFitOutput)
+      wsBaseName = spectrum.name + "_" + std::to_string(spectrum.index);
+
+    bool histogramFit = getPropertyValue("EvaluationType") == "Histogram";
+
+    // Fit the function
+    API::IAlgorithm_sptr fit =
+        AlgorithmManager::Instance().createUnmanaged("Fit");
+    fit->initialize();
+    fit->setPropertyValue("EvaluationType", getPropertyValue("EvaluationType"));
+    fit->setProperty("Function", fun);
+    fit->setProperty("InputWorkspace", spectrum.ws);
+    fit->setProperty("WorkspaceIndex", spectrum.index);
+    fit->setPropertyValue("StartX", getPropertyValue("StartX"));
+    fit->setPropertyValue("EndX", getPropertyValue("EndX"));
+    fit->setPropertyValue("Minimizer", spectrum.minimizer);
+    fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
+    fit->setPropertyValue("MaxIterations", getPropertyValue("MaxIterations"));
+    fit->setProperty("CalcErrors", true);
+    fit->setProperty("CreateOutput", createFitOutput);
+    if (!histogramFit) {
+      fit->setProperty("OutputCompositeMembers", outputCompositeMembers);
+      fit->setProperty("ConvolveMembers", outputConvolvedMembers);
+    }
+    fit->setProperty("Output", wsBaseName);
+    fit->execute();
+
+    if (!fit->isExecuted()) {
+      throw std::runtime_error("Fit child algorithm failed: " +
+                               spectrum.ws->name());
+    }
+
+    fun = fit->getProperty("Function");
+    spectrum.chi2 = fit->getProperty("OutputChi2overDoF");
+
+    g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
+                  << ' ' << spectrum.chi2 << '\n';
+
+  } catch (...) {
+    g_log.error("Error in Fit ChildAlgorithm");
+    throw;
+  }
+
+  spectrum.parameters.resize(fun->nParams());
+  spectrum.errors.resize(fun->nParams());
+  for (size_t iPar = 0; iPar < fun->nParams(); ++iPar) {
+    spectrum.parameters[iPar] = fun->getParameter(iPar);
+    spectrum.errors[iPar] = fun->getError(iPar);
+  }
+}
+
+/**
+ * Fit the spectra concurrently on a thread pool. Every worker thread reuses
+ * its own copy of the fitting function, as cloning has to parse the function
+ * string again. In individual mode each fit starts from the initial
+ * parameters, so the results are the same as those of the serial fits. In
+ * sequential mode a fit starts from the results of the nearest spectrum that
+ * has been fitted already, or from the initial parameters if there is none.
+ *
+ * @param spectra :: The spectra to fit, receive the results of the fits
+ * @param fun :: The fitting function with the initial parameters
+ * @param initialParams :: The initial parameter values
+ * @param individual :: Whether every fit starts from the initial parameters
+ */
+void PlotPeakByLogValue::fitSpectraInParallel(
+    std::vector<SpectrumFit> &spectra, const IFunction &fun,
+    const std::vector<double> &initialParams, bool individual) {
+  std::mutex functionsMutex;
+  // Functions not in use by a running fit
+  std::vector<IFunction_sptr> idleFunctions;
+  // Fitted parameters by position in spectra, guarded by functionsMutex
+  std::map<size_t, std::vector<double>> finished;
+
+  Progress prog(this, 0.0, 1.0, spectra.size());
+  auto fitOne = [&](size_t k) {
+    IFunction_sptr workerFun;
+    std::vector<double> startParams;
+    bool reused = false;
+    {
+      std::lock_guard<std::mutex> lock(functionsMutex);
+      if (idleFunctions.empty()) {
+        workerFun = fun.clone();
+      } else {
+        workerFun = idleFunctions.back();
+        idleFunctions.pop_back();
+        reused = true;
+      }
+      if (!individual && !finished.empty()) {
+        // Prefer the preceding spectrum if both neighbours are equally near
+        auto next = finished.lower_bound(k);
+        if (next == finished.end() ||
+            (next != finished.begin() &&
+             k - std::prev(next)->first <= next->first - k))
+          --next;
+        startParams = next->second;
+      }
+    }
+    if (reused && startParams.empty())
+      startParams = initialParams;
+    for (size_t i = 0; i < startParams.size(); ++i) {
+      workerFun->setParameter(i, startParams[i]);
+    }
+
+    fitSpectrum(spectra[k], workerFun);
+
+    {
+      std::lock_guard<std::mutex> lock(functionsMutex);
+      if (!individual)
+        finished.emplace(k, spectra[k].parameters);
+      idleFunctions.push_back(workerFun);
+    }
+    prog.report("Fitting Workspace: (" + spectra[k].name + ") - ");
+    interruption_point();
+  };
+
+  ThreadScheduler *scheduler;
+  if (ThreadPool::useWorkStealing())
+    scheduler = new ThreadSchedulerWorkStealing();
+  else
+    scheduler = new ThreadSchedulerFIFO();
+  ThreadPool pool(scheduler);
+  for (size_t k = 0; k < spectra.size(); ++k) {
+    pool.schedule(new FunctionTask([&fitOne, k]() { fitOne(k); }));
+  }
+  pool.joinAll();
+}
+
 /// Create a list of input workspace names
 std::vector<PlotPeakByLogValue::InputData>
 PlotPeakByLogValue::makeNames() const {
@@ -10,12 +10,18 @@
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MultiThreaded.h"
 
+#include <gsl/gsl_blas.h>
+
+#include <algorithm>
+
 namespace Mantid {
 namespace CurveFitting {
 namespace CostFunctions {
 namespace {
 /// static logger
 Kernel::Logger g_log("CostFuncLeastSquares");
+/// Number of data points packed into a weighted Jacobian block
+const size_t JACOBIAN_BLOCK_SIZE = 512;
 }
 
 DECLARE_COSTFUNCTION(CostFuncLeastSquares, Least squares)
@@ -224,6 +230,32 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
                                               API::FunctionValues_sptr values,
                                               bool evalDeriv,
                                               bool evalHessian) const {
+  addValDerivHessian(function, domain, values, evalDeriv, evalHessian, m_value,
+                     m_der, m_hessian);
+}
+
+/**
+ * Add the value, derivatives and hessian calculated on a domain to the given
+ * accumulators. Does not modify the cost function itself, so it can be called
+ * concurrently with different accumulators.
+ *
+ * The weighted Jacobian of the active parameters is packed into a dense block
+ * with one contiguous row per parameter, a block of data points at a time.
+ * The derivatives and the lower triangle of the hessian are then updated with
+ * BLAS matrix-vector and rank-k updates.
+ * @param function :: Function to use to calculate the value and the derivatives
+ * @param domain :: The domain.
+ * @param values :: The fit function values
+ * @param evalDeriv :: Flag to evaluate the derivatives
+ * @param evalHessian :: Flag to evaluate the Hessian
+ * @param value :: The value to add the cost function value to
+ * @param der :: The vector to add the derivatives to
+ * @param hessian :: The matrix to add the hessian to
+ */
+void CostFuncLeastSquares::addValDerivHessian(
+    API::IFunction_sptr function, API::FunctionDomain_sptr domain,
+    API::FunctionValues_sptr values, bool evalDeriv, bool evalHessian,
+    double &value, GSLVector &der, GSLMatrix &hessian) const {
   UNUSED_ARG(evalDeriv);
   function->function(*domain, *values);
   size_t np = function->nParams(); // number of parameters
@@ -231,63 +263,51 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
   Jacobian jacobian(ny, np);
   function->functionDeriv(*domain, jacobian);
 
-  size_t iActiveP = 0;
-  double fVal = 0.0;
   std::vector<double> weights = getFitWeights(values);
+  // weighted residuals
+  std::vector<double> residuals(ny);
+  double fVal = 0.0;
+  for (size_t i = 0; i < ny; ++i) {
+    double y = (values->getCalculated(i) - values->getFitData(i)) * weights[i];
+    residuals[i] = y;
+    fVal += y * y;
+  }
+  value += 0.5 * fVal;
 
+  std::vector<size_t> activeParams;
   for (size_t ip = 0; ip < np; ++ip) {
-    if (!function->isActive(ip))
-      continue;
-    double d = 0.0;
-    for (size_t i = 0; i < ny; ++i) {
-      double calc = values->getCalculated(i);
-      double obs = values->getFitData(i);
-      double w = weights[i];
-      double y = (calc - obs) * w;
-      d += y * jacobian.get(i, ip) * w;
-      if (iActiveP == 0) {
-        fVal += y * y;
-      }
-    }
-    PARALLEL_CRITICAL(der_set) {
-      double der = m_der.get(iActiveP);
-      m_der.set(iActiveP, der + d);
-    }
-    ++iActiveP;
+    if (function->isActive(ip))
+      activeParams.push_back(ip);
   }
-
-  PARALLEL_ATOMIC
-  m_value += 0.5 * fVal;
-
-  if (!evalHessian)
+  const size_t na = activeParams.size();
+  if (na == 0 || ny == 0)
     return;
 
-  size_t i1 = 0;                  // active parameter index
-  for (size_t i = 0; i < np; ++i) // over parameters
-  {
-    if (!function->isActive(i))
-      continue;
-    size_t i2 = 0;                  // active parameter index
-    for (size_t j = 0; j <= i; ++j) // over ~ half of parameters
-    {
-      if (!function->isActive(j))
-        continue;
-      double d = 0.0;
-      for (size_t k = 0; k < ny; ++k) // over fitting data
-      {
-        double w = weights[k];
-        d += jacobian.get(k, i) * jacobian.get(k, j) * w * w;
-      }
-      PARALLEL_CRITICAL(hessian_set) {
-        double h = m_hessian.get(i1, i2);
-        m_hessian.set(i1, i2, h + d);
-        if (i1 != i2) {
-          m_hessian.set(i2, i1, h + d);
-        }
-      }
-      ++i2;
+  const size_t blockSize = std::min(ny, JACOBIAN_BLOCK_SIZE);
+  GSLMatrix block(na, blockSize);
+  for (size_t start = 0; start < ny; start += blockSize) {
+    const size_t count = std::min(blockSize, ny - start);
+    for (size_t ia = 0; ia < na; ++ia) {
+      const size_t ip = activeParams[ia];
+      double *row = gsl_matrix_ptr(block.gsl(), ia, 0);
+      for (size_t k = 0; k < count; ++k)
+        row[k] = jacobian.get(start + k, ip) * weights[start + k];
     }
-    ++i1;
+    auto weightedJacobian = gsl_matrix_submatrix(block.gsl(), 0, 0, na, count);
+    auto residualsView =
+        gsl_vector_const_view_array(residuals.data() + start, count);
+    gsl_blas_dgemv(CblasNoTrans, 1.0, &weightedJacobian.matrix,
+                   &residualsView.vector, 1.0, der.gsl());
+    if (evalHessian)
+      gsl_blas_dsyrk(CblasLower, CblasNoTrans, 1.0, &weightedJacobian.matrix,
+                     1.0, hessian.gsl());
+  }
+
+  if (evalHessian) {
+    // dsyrk only updates the lower triangle
+    for (size_t i = 0; i < na; ++i)
+      for (size_t j = i + 1; j < na; ++j)
+        hessian.set(i, j, hessian.get(j, i));
   }
 }
 
@@ -60,6 +60,15 @@ void ParDomain::leastSquaresValDerivHessian(
   const int n = static_cast<int>(getNDomains());
   PARALLEL_SET_DYNAMIC(0);
   std::vector<API::IFunction_sptr> funs;
+  // Each thread accumulates into its own value, derivatives and hessian,
+  // which are summed up after the loop
+  const size_t nThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  const size_t nActive = leastSquares.nParams();
+  std::vector<double> threadValues(nThreads, 0.0);
+  std::vector<GSLVector> threadDers(nThreads, GSLVector(nActive));
+  std::vector<GSLMatrix> threadHessians(nThreads);
+  if (evalHessian)
+    threadHessians.assign(nThreads, GSLMatrix(nActive, nActive));
   // funs.push_back( leastSquares.getFittingFunction()->clone() );
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int i = 0; i < n; ++i) {
@@ -81,7 +90,15 @@ void ParDomain::leastSquaresValDerivHessian(
       }
     }
     leastSquares.addValDerivHessian(funs[k], domain, simpleValues, evalDeriv,
-                                    evalHessian);
+                                    evalHessian, threadValues[k], threadDers[k],
+                                    threadHessians[k]);
+  }
+
+  for (size_t k = 0; k < nThreads; ++k) {
+    leastSquares.m_value += threadValues[k];
+    leastSquares.m_der += threadDers[k];
+    if (evalHessian)
+      leastSquares.m_hessian += threadHessians[k];
   }
 }
 
@@ -253,6 +253,24 @@ public:
     WorkspaceCreationHelper::removeWS("PlotPeakResult");
   }
 
+  void test_parallel_individual_fits_match_serial_fits() {
+    createData();
+
+    auto serial = runIndividualFits(false);
+    auto parallel = runIndividualFits(true);
+    TS_ASSERT_EQUALS(parallel->rowCount(), 3);
+    TS_ASSERT_EQUALS(parallel->rowCount(), serial->rowCount());
+    TS_ASSERT_EQUALS(parallel->columnCount(), serial->columnCount());
+    for (size_t row = 0; row < serial->rowCount(); ++row) {
+      for (size_t col = 0; col < serial->columnCount(); ++col) {
+        TS_ASSERT_EQUALS(parallel->Double(row, col), serial->Double(row, col));
+      }
+    }
+
+    deleteData();
+    WorkspaceCreationHelper::removeWS("PlotPeakResult");
+  }
+
   void testSpectraList_plotting_against_bin_edge_axis() {
     auto ws = createTestWorkspace();
     AnalysisDataService::Instance().add("PLOTPEAKBYLOGVALUETEST_WS", ws);
@@ -641,6 +659,24 @@ private:
     }
   }
 
+  TWS_type runIndividualFits(bool parallel) {
+    PlotPeakByLogValue alg;
+    alg.initialize();
+    alg.setPropertyValue("Input",
+                         "PlotPeakGroup_0;PlotPeakGroup_1;PlotPeakGroup_2");
+    alg.setPropertyValue("OutputWorkspace", "PlotPeakResult");
+    alg.setPropertyValue("WorkspaceIndex", "1");
+    alg.setPropertyValue("LogValue", "var");
+    alg.setPropertyValue("FitType", "Individual");
+    alg.setProperty("Parallel", parallel);
+    alg.setPropertyValue("Function", "name=LinearBackground,A0=1,A1=0.3;name="
+                                     "Gaussian,PeakCentre=5,Height=2,Sigma=0."
+                                     "1");
+    alg.execute();
+    TS_ASSERT(alg.isExecuted());
+    return WorkspaceCreationHelper::getWS<TableWorkspace>("PlotPeakResult");
+  }
+
   MatrixWorkspace_sptr createTestWorkspace() {
     const int numHists(2);
     const int numBins(2000);
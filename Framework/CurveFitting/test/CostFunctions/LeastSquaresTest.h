@@ -15,6 +15,8 @@
 #include "MantidCurveFitting/Functions/Gaussian.h"
 #include "MantidCurveFitting/Functions/UserFunction.h"
 #include "MantidCurveFitting/Functions/ExpDecay.h"
+#include "MantidCurveFitting/Functions/Polynomial.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include <gsl/gsl_blas.h>
 #include <sstream>
@@ -267,6 +269,69 @@ public:
     TS_ASSERT_EQUALS(s.getError(), "success");
   }
 
+  void test_hessian_matches_jacobian_product() {
+    // More data points than fit into one Jacobian block
+    API::FunctionDomain1D_sptr domain(
+        new API::FunctionDomain1DVector(79000., 80000., 2000));
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    std::vector<double> y(domain->size());
+    for (size_t i = 0; i < y.size(); ++i) {
+      const double dx = ((*domain)[i] - 79430.) / 27.;
+      y[i] = 10.0 + 200.0 * std::exp(-dx * dx);
+      values->setFitWeight(i, 1.0 / (1.0 + 0.001 * static_cast<double>(i)));
+    }
+    values->setFitData(y);
+
+    API::CompositeFunction_sptr fun(new API::CompositeFunction());
+    auto bk = boost::make_shared<LinearBackground>();
+    bk->initialize();
+    bk->setParameter("A0", 5.0);
+    bk->setParameter("A1", 0.0);
+    bk->fix(1);
+    auto gauss = boost::make_shared<Gaussian>();
+    gauss->initialize();
+    gauss->setParameter("PeakCentre", 79450.0);
+    gauss->setParameter("Height", 180.0);
+    gauss->setParameter("Sigma", 30.0);
+    fun->addFunction(bk);
+    fun->addFunction(gauss);
+
+    auto costFun = boost::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, domain, values);
+    costFun->valDerivHessian();
+    const GSLVector &der = costFun->getDeriv();
+    const GSLMatrix &hessian = costFun->getHessian();
+
+    // Straightforward sums over the data points
+    const size_t np = fun->nParams();
+    CurveFitting::Jacobian jacobian(domain->size(), np);
+    fun->function(*domain, *values);
+    fun->functionDeriv(*domain, jacobian);
+    std::vector<size_t> active;
+    for (size_t ip = 0; ip < np; ++ip)
+      if (fun->isActive(ip))
+        active.push_back(ip);
+    TS_ASSERT_EQUALS(active.size(), costFun->nParams());
+    for (size_t i = 0; i < active.size(); ++i) {
+      double d = 0.0;
+      for (size_t k = 0; k < domain->size(); ++k) {
+        double w = values->getFitWeight(k);
+        d += (values->getCalculated(k) - values->getFitData(k)) * w * w *
+             jacobian.get(k, active[i]);
+      }
+      TS_ASSERT_DELTA(der.get(i), d, 1e-9 * std::max(1.0, std::fabs(d)));
+      for (size_t j = 0; j < active.size(); ++j) {
+        double h = 0.0;
+        for (size_t k = 0; k < domain->size(); ++k) {
+          double w = values->getFitWeight(k);
+          h += jacobian.get(k, active[i]) * jacobian.get(k, active[j]) * w * w;
+        }
+        TS_ASSERT_DELTA(hessian.get(i, j), h,
+                        1e-9 * std::max(1.0, std::fabs(h)));
+      }
+    }
+  }
+
   void testDerivatives() {
     API::FunctionDomain1D_sptr domain(
         new API::FunctionDomain1DVector(79300., 79600., 41));
@@ -338,4 +403,37 @@ public:
   }
 };
 
+class LeastSquaresTestPerformance : public CxxTest::TestSuite {
+public:
+  static LeastSquaresTestPerformance *createSuite() {
+    return new LeastSquaresTestPerformance();
+  }
+  static void destroySuite(LeastSquaresTestPerformance *suite) {
+    delete suite;
+  }
+
+  LeastSquaresTestPerformance()
+      : m_domain(new API::FunctionDomain1DVector(-1.0, 1.0, 1000000)),
+        m_values(new API::FunctionValues(*m_domain)) {
+    m_values->setFitData(std::vector<double>(m_domain->size(), 1.0));
+    m_values->setFitWeights(1.0);
+  }
+
+  /// 200 parameters and a million data points
+  void test_hessian_200_parameters() {
+    auto fun = boost::make_shared<Polynomial>();
+    fun->setAttributeValue("n", 199);
+    for (size_t i = 0; i < fun->nParams(); ++i)
+      fun->setParameter(i, 1.0 / static_cast<double>(i + 1));
+    auto costFun = boost::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, m_domain, m_values);
+    TS_ASSERT_THROWS_NOTHING(costFun->valDerivHessian());
+    TS_ASSERT_EQUALS(costFun->getHessian().size1(), 200);
+  }
+
+private:
+  API::FunctionDomain1D_sptr m_domain;
+  API::FunctionValues_sptr m_values;
+};
+
 #endif /*CURVEFITTING_LEASTSQUARESTEST_H_*/
@@ -105,6 +105,23 @@ template <typename NumT>
 void writeArray1D(H5::Group &group, const std::string &name,
                   const std::vector<NumT> &values);
 
+/**
+ * Write a 1D array with the shuffle and deflate filters. The chunks are
+ * filtered by parallel threads and written with direct chunk writes by a
+ * single thread, while the next chunks are being filtered.
+ * @param group :: group to create the data set in
+ * @param name :: name of the data set
+ * @param values :: the values to write
+ * @param length :: number of values
+ * @param chunkLength :: number of values in a chunk
+ * @param deflateLevel :: zlib compression level
+ */
+template <typename NumT>
+void writeArray1DParallel(H5::Group &group, const std::string &name,
+                          const NumT *values, const std::size_t length,
+                          const std::size_t chunkLength,
+                          const int deflateLevel = 1);
+
 MANTID_DATAHANDLING_DLL std::string readString(H5::H5File &file,
                                                const std::string &path);
 
@@ -91,6 +91,20 @@ public:
    * @param value :: true if you want to precount. */
   void setPrecount(bool value) { precount = value; }
 
+  /** Sets the number of events read at a time from banks large enough to be
+   * read in slabs, overlapping the reading with the processing.
+   * @param value :: number of events per slab. */
+  void setEventsPerSlab(size_t value) { eventsPerSlab = value; }
+
+  /** Sets how the events of a bank are split to fill precounted event lists,
+   * instead of one sub-range of at least a million events per idle core.
+   * @param numRanges :: maximum number of sub-ranges.
+   * @param minEvents :: minimum number of events in a sub-range. */
+  void setScatterRanges(size_t numRanges, size_t minEvents) {
+    m_requestedScatterRanges = numRanges;
+    minEventsPerScatterRange = minEvents;
+  }
+
   template <typename T>
   static boost::shared_ptr<BankPulseTimes> runLoadNexusLogs(
       const std::string &nexusfilename, T localWorkspace, Algorithm &alg,
@@ -158,7 +172,7 @@ public:
   /// number of chunks per bank
   size_t eventsPerChunk;
 
-  /// Mutex protecting tof limits
+  /// Mutex protecting tof limits and timings
   std::mutex m_tofMutex;
 
   /// Limits found to tof
@@ -171,6 +185,10 @@ public:
   /// A count of events discarded because they came from a pixel that's not in
   /// the IDF
   size_t discarded_events;
+  /// Time spent reading events from disk, summed over all the tasks
+  double disk_read_time;
+  /// Time spent filling the event lists, summed over all the tasks
+  double process_time;
 
   /// Do we pre-count the # of events in each pixel ID?
   bool precount;
@@ -211,6 +229,20 @@ public:
   /// whether or not to launch multiple ProcessBankData jobs per bank
   bool splitProcessing;
 
+  /// Maximum number of sub-ranges the events of a ProcessBankData job are
+  /// split into to fill precounted event lists
+  size_t numScatterRanges;
+
+  /// Minimum number of events in each of those sub-ranges
+  size_t minEventsPerScatterRange;
+
+  /// Whether the sub-ranges are filled by several threads. Only done when a
+  /// single bank is loaded, as the banks already run in parallel otherwise.
+  bool parallelScatter;
+
+  /// Number of events read at a time from the banks read in slabs
+  size_t eventsPerSlab;
+
   /// Flag for dealing with a simulated file
   bool m_haveWeights;
 
@@ -283,6 +315,9 @@ private:
 
   /// True if the event_id is spectrum no not pixel ID
   bool event_id_is_spec;
+
+  /// Sub-ranges requested with setScatterRanges, 0 to use the idle cores
+  size_t m_requestedScatterRanges;
 };
 
 //-----------------------------------------------------------------------------
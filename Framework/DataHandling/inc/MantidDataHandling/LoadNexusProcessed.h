@@ -19,6 +19,9 @@ class File;
 }
 
 namespace Mantid {
+namespace DataObjects {
+class LazyWorkspace2D;
+}
 
 namespace DataHandling {
 
@@ -202,6 +205,10 @@ private:
   std::size_t calculateWorkspaceSize(const std::size_t numberofspectra,
                                      bool gen_filtered_list = false);
 
+  /// Read the data of a workspace from the file on demand
+  void readDataOnDemand(DataObjects::LazyWorkspace2D &local_workspace,
+                        Mantid::NeXus::NXEntry &mtd_entry);
+
   /// Accellerated multiperiod loading
   Mantid::API::Workspace_sptr doAccelleratedMultiPeriodLoading(
       Mantid::NeXus::NXRoot &root, const std::string &entryName,
@@ -52,7 +52,25 @@ public:
 
   void run() override;
 
+  /// Record the touched pixels instead of compressing them in this task
+  void deferCompression(std::vector<bool> &touchedDetIds);
+
+  /// Compress the event lists of the touched pixels
+  static void compressEvents(LoadEventNexus *alg,
+                             const std::vector<bool> &usedDetIds,
+                             detid_t firstId, detid_t minId, detid_t maxId);
+
 private:
+  /// Fill the event lists with a two-pass, counting-sort style scatter
+  template <class EventType>
+  void scatterEvents(std::vector<std::vector<EventType> *> &eventVectors);
+  /// Index of the pulse containing the event at the given array position
+  size_t findPulseIndex(size_t eventIndex, size_t numPulses) const;
+  /// Compress the touched pixels and merge the tof limits into the algorithm
+  void finalizeBank(const std::vector<bool> &usedDetIds, double shortestTof,
+                    double longestTof, size_t badTofs, size_t discardedEvents,
+                    bool pulseTimesIncreasing);
+
   /// Algorithm being run
   LoadEventNexus *alg;
   /// NXS path to bank
@@ -84,6 +102,8 @@ private:
   detid_t m_min_id;
   /// Maximum pixel id
   detid_t m_max_id;
+  /// Touched pixels (index = pixel ID) when compressing after the whole bank
+  std::vector<bool> *m_deferredDetIds;
   /// timer for performance
   Mantid::Kernel::Timer m_timer;
 }; // ENDDEF-CLASS ProcessBankData
@@ -9,6 +9,7 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidNexus/NexusFileIO.h"
 #include <climits>
+#include <memory>
 
 namespace Mantid {
 namespace DataHandling {
@@ -80,12 +81,13 @@ private:
                        Mantid::API::MatrixWorkspace_const_sptr matrixWorkspace);
 
   template <class T>
-  static void appendEventListData(std::vector<T> events, size_t offset,
+  static void appendEventListData(const std::vector<T> &events, size_t offset,
                                   double *tofs, float *weights,
                                   float *errorSquareds, int64_t *pulsetimes);
 
   void execEvent(Mantid::NeXus::NexusFileIO *nexusFile,
                  const bool uniformSpectra, const std::vector<int> spec);
+  void writeEventColumns(Mantid::NeXus::NexusFileIO_sptr &nexusFile);
   /// sets non workspace properties for the algorithm
   void setOtherProperties(IAlgorithm *alg, const std::string &propertyName,
                           const std::string &propertyValue,
@@ -111,6 +113,18 @@ private:
   double m_timeProgInit;
   /// Progress bar
   API::Progress *prog;
+
+  /// The combined event lists of an EventWorkspace, one column per field
+  struct EventColumns {
+    /// Path of the event_workspace group in the file
+    std::string group;
+    std::vector<double> tofs;
+    std::vector<float> weights;
+    std::vector<float> errorSquareds;
+    std::vector<int64_t> pulsetimes;
+  };
+  /// Columns to write once the NeXus API has closed the file
+  std::unique_ptr<EventColumns> m_eventColumns;
 };
 
 } // namespace DataHandling
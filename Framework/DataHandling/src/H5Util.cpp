@@ -1,11 +1,16 @@
 #include "MantidDataHandling/H5Util.h"
 #include "MantidKernel/System.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidAPI/LogManager.h"
 
 #include <H5Cpp.h>
+#include <hdf5_hl.h>
+#include <zlib.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <boost/numeric/conversion/cast.hpp>
+#include <future>
 #include <iostream>
 
 using namespace H5;
@@ -20,6 +25,38 @@ Mantid::Kernel::Logger g_log("H5Util");
 
 const std::string NX_ATTR_CLASS("NX_class");
 const std::string CAN_SAS_ATTR_CLASS("canSAS_class");
+
+/**
+ * Apply the shuffle and deflate filters to a chunk, giving the bytes that
+ * HDF5 would store for it. The last chunk of a data set is padded with zeros.
+ * @param values :: the values of the chunk
+ * @param length :: number of values
+ * @param chunkLength :: number of values in a full chunk
+ * @param elementSize :: size of a value in bytes
+ * @param deflateLevel :: zlib compression level
+ * @param compressed :: output, the filtered chunk
+ * @return true on success
+ */
+bool filterChunk(const char *values, const size_t length,
+                 const size_t chunkLength, const size_t elementSize,
+                 const int deflateLevel,
+                 std::vector<unsigned char> &compressed) {
+  // The shuffle filter stores the first byte of every value, then the second
+  // byte of every value, etc.
+  std::vector<unsigned char> shuffled(chunkLength * elementSize, 0);
+  for (size_t i = 0; i < length; ++i)
+    for (size_t j = 0; j < elementSize; ++j)
+      shuffled[j * chunkLength + i] =
+          static_cast<unsigned char>(values[i * elementSize + j]);
+
+  uLongf compressedSize = compressBound(static_cast<uLong>(shuffled.size()));
+  compressed.resize(compressedSize);
+  if (compress2(compressed.data(), &compressedSize, shuffled.data(),
+                static_cast<uLong>(shuffled.size()), deflateLevel) != Z_OK)
+    return false;
+  compressed.resize(compressedSize);
+  return true;
+}
 }
 
 // -------------------------------------------------------------------
@@ -196,6 +233,59 @@ void writeArray1D(Group &group, const std::string &name,
   data.write(values.data(), dataType);
 }
 
+template <typename NumT>
+void writeArray1DParallel(Group &group, const std::string &name,
+                          const NumT *values, const size_t length,
+                          const size_t chunkLength, const int deflateLevel) {
+  DataType dataType(getType<NumT>());
+  DataSpace dataSpace = getDataSpace(length);
+  // A chunk cannot be larger than a fixed size data set
+  const size_t chunk = std::max<size_t>(std::min(chunkLength, length), 1);
+  DSetCreatPropList propList;
+  hsize_t chunkDims[1] = {chunk};
+  propList.setChunk(1, chunkDims);
+  // The order of the filters must match filterChunk()
+  propList.setShuffle();
+  propList.setDeflate(deflateLevel);
+  auto data = group.createDataSet(name, dataType, dataSpace, propList);
+
+  const auto bytes = reinterpret_cast<const char *>(values);
+  const size_t numChunks = (length + chunk - 1) / chunk;
+  const size_t batchSize = 4 * static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  std::vector<std::vector<unsigned char>> batches[2];
+  std::future<void> writer;
+  for (size_t first = 0; first < numChunks; first += batchSize) {
+    // The writer still uses the other batch meanwhile
+    auto &batch = batches[(first / batchSize) % 2];
+    batch.resize(std::min(batchSize, numChunks - first));
+    std::atomic<bool> failed{false};
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < static_cast<int>(batch.size()); ++i) {
+      const size_t offset = (first + i) * chunk;
+      const size_t count = std::min(chunk, length - offset);
+      if (!filterChunk(bytes + offset * sizeof(NumT), count, chunk,
+                       sizeof(NumT), deflateLevel, batch[i]))
+        failed = true;
+    }
+    if (writer.valid())
+      writer.get();
+    if (failed)
+      throw std::runtime_error("Failed to compress data set " + name);
+
+    writer = std::async(std::launch::async, [&data, &batch, first, chunk]() {
+      for (size_t i = 0; i < batch.size(); ++i) {
+        hsize_t offset[1] = {(first + i) * chunk};
+        if (H5DOwrite_chunk(data.getId(), H5P_DEFAULT, 0, offset,
+                            batch[i].size(), batch[i].data()) < 0)
+          throw DataSetIException("writeArray1DParallel",
+                                  "Failed to write a chunk");
+      }
+    });
+  }
+  if (writer.valid())
+    writer.get();
+}
+
 // -------------------------------------------------------------------
 // read methods
 // -------------------------------------------------------------------
@@ -586,6 +676,22 @@ template MANTID_DATAHANDLING_DLL void
 writeArray1D(H5::Group &group, const std::string &name,
              const std::vector<uint64_t> &values);
 
+// -------------------------------------------------------------------
+// instantiations for writeArray1DParallel
+// -------------------------------------------------------------------
+template MANTID_DATAHANDLING_DLL void
+writeArray1DParallel(H5::Group &group, const std::string &name,
+                     const float *values, const std::size_t length,
+                     const std::size_t chunkLength, const int deflateLevel);
+template MANTID_DATAHANDLING_DLL void
+writeArray1DParallel(H5::Group &group, const std::string &name,
+                     const double *values, const std::size_t length,
+                     const std::size_t chunkLength, const int deflateLevel);
+template MANTID_DATAHANDLING_DLL void
+writeArray1DParallel(H5::Group &group, const std::string &name,
+                     const int64_t *values, const std::size_t length,
+                     const std::size_t chunkLength, const int deflateLevel);
+
 // -------------------------------------------------------------------
 // Instantiations for writeScalarWithStrAttributes
 // -------------------------------------------------------------------
@@ -13,9 +13,11 @@
 #include "MantidGeometry/Instrument/RectangularDetector.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ThreadSchedulerMutexes.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/UnitFactory.h"
@@ -27,6 +29,13 @@
 #include <boost/shared_array.hpp>
 #include <boost/function.hpp>
 
+#include <Poco/RunnableAdapter.h>
+#include <Poco/Thread.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
 
 using std::map;
@@ -68,12 +77,134 @@ void copyLogs(const Mantid::DataHandling::EventWorkspaceCollection_sptr &from,
 }
 }
 
+//==============================================================================================
+// Class SlabQueue
+//==============================================================================================
+/** A bounded queue handing the slabs of a bank from the thread reading them to
+ * the task processing them. With a capacity of two, the reader fills one
+ * buffer while the other is processed.
+ */
+template <class T> class SlabQueue {
+public:
+  explicit SlabQueue(size_t capacity) : m_capacity(capacity), m_closed(false) {}
+
+  /** Add an item, waiting while the queue is full.
+   * @param item :: the item to add
+   * @return false if the queue was closed and the item dropped */
+  bool push(T item) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock,
+                   [this] { return m_closed || m_items.size() < m_capacity; });
+    if (m_closed)
+      return false;
+    m_items.push_back(std::move(item));
+    m_changed.notify_all();
+    return true;
+  }
+
+  /** Take the oldest item, waiting while the queue is empty.
+   * @param item :: set to the oldest item
+   * @return false if the queue is closed and empty */
+  bool pop(T &item) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock, [this] { return m_closed || !m_items.empty(); });
+    if (m_items.empty())
+      return false;
+    item = std::move(m_items.front());
+    m_items.pop_front();
+    m_changed.notify_all();
+    return true;
+  }
+
+  /// No more items will be added; wakes up all the waiting threads
+  void close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closed = true;
+    m_changed.notify_all();
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_changed;
+  std::deque<T> m_items;
+  const size_t m_capacity;
+  bool m_closed;
+};
+
+/** Run a group of tasks on the thread pool with the help of the calling task,
+ * and return once all of them are done.
+ *
+ * Every task is pushed to the scheduler, and whichever thread gets to it first
+ * runs it. The caller runs the tasks no pool thread has started yet and then
+ * waits only for those already running. It never waits for a task that is
+ * still queued, so this cannot deadlock, even if the caller holds the only
+ * thread of the pool.
+ *
+ * @param scheduler :: the scheduler of the pool running the caller
+ * @param tasks :: the tasks to run; they are deleted once done
+ * @throw the first exception thrown by any of the tasks
+ */
+void runTaskGroup(ThreadScheduler &scheduler, std::vector<Task *> tasks) {
+  struct Group {
+    explicit Group(const std::vector<Task *> &groupTasks)
+        : tasks(groupTasks.begin(), groupTasks.end()),
+          started(groupTasks.size()), remaining(groupTasks.size()) {}
+    /// Run a task unless another thread has already started it
+    void runOnce(size_t index) {
+      if (started[index].exchange(true))
+        return;
+      try {
+        tasks[index]->run();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+          error = std::current_exception();
+      }
+      tasks[index].reset();
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--remaining == 0)
+        done.notify_all();
+    }
+    std::vector<std::unique_ptr<Task>> tasks;
+    std::vector<std::atomic<bool>> started;
+    size_t remaining;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable done;
+  };
+  auto group = boost::make_shared<Group>(tasks);
+
+  const size_t numTasks = group->tasks.size();
+  for (size_t i = 0; i < numTasks; ++i) {
+    boost::function<void()> runOnce = [group, i] { group->runOnce(i); };
+    scheduler.push(new FunctionTask(runOnce, group->tasks[i]->cost()));
+  }
+  for (size_t i = 0; i < numTasks; ++i)
+    group->runOnce(i);
+
+  std::unique_lock<std::mutex> lock(group->mutex);
+  group->done.wait(lock, [&group] { return group->remaining == 0; });
+  if (group->error)
+    std::rethrow_exception(group->error);
+}
+
 //==============================================================================================
 // Class LoadBankFromDiskTask
 //==============================================================================================
 /** This task does the disk IO from loading the NXS file,
 * and so will be on a disk IO mutex */
 class LoadBankFromDiskTask : public Task {
+  /// Events of (part of) the bank, ready to be processed
+  struct Slab {
+    boost::shared_array<uint32_t> event_id;
+    boost::shared_array<float> event_time_of_flight;
+    boost::shared_array<float> event_weight;
+    bool have_weight = false;
+    size_t startAt = 0;
+    size_t numEvents = 0;
+    uint32_t min_id = 0;
+    uint32_t max_id = 0;
+  };
 
 public:
   //---------------------------------------------------------------------------------------------------
@@ -88,6 +219,8 @@ public:
   * @param ioMutex :: a mutex shared for all Disk I-O tasks
   * @param scheduler :: the ThreadScheduler that runs this task.
   * @param framePeriodNumbers :: Period numbers corresponding to each frame
+  * @param eventsPerSlab :: if non-zero, read the bank in slabs of this many
+  * events, processing each slab while the next one is read
   */
   LoadBankFromDiskTask(LoadEventNexus *alg, const std::string &entry_name,
                        const std::string &entry_type,
@@ -95,16 +228,21 @@ public:
                        const bool oldNeXusFileNames, Progress *prog,
                        boost::shared_ptr<std::mutex> ioMutex,
                        ThreadScheduler *scheduler,
-                       const std::vector<int> &framePeriodNumbers)
+                       const std::vector<int> &framePeriodNumbers,
+                       const std::size_t eventsPerSlab = 0)
       : Task(), alg(alg), entry_name(entry_name), entry_type(entry_type),
         // prog(prog), scheduler(scheduler), thisBankPulseTimes(NULL),
         // m_loadError(false),
         prog(prog), scheduler(scheduler), m_loadError(false),
         m_oldNexusFileNames(oldNeXusFileNames), m_loadStart(), m_loadSize(),
         m_event_id(nullptr), m_event_time_of_flight(nullptr),
-        m_have_weight(false), m_event_weight(nullptr),
-        m_framePeriodNumbers(framePeriodNumbers) {
-    setMutex(ioMutex);
+        m_event_weight(nullptr),
+        m_framePeriodNumbers(framePeriodNumbers), m_ioMutex(ioMutex),
+        m_eventsPerSlab(eventsPerSlab), m_slabsStart(0), m_slabsStop(0),
+        m_slabFile(nullptr), m_slabQueue(nullptr) {
+    // A bank read in slabs only holds the disk mutex while reading
+    if (m_eventsPerSlab == 0)
+      setMutex(ioMutex);
     m_cost = static_cast<double>(numEvents);
     m_min_id = std::numeric_limits<uint32_t>::max();
     m_max_id = 0;
@@ -292,14 +430,9 @@ public:
           m_max_id = temp;
       }
 
-      if (m_min_id > static_cast<uint32_t>(alg->eventid_max)) {
-        // All the detector IDs in the bank are higher than the highest 'known'
-        // (from the IDF)
-        // ID. Setting this will abort the loading of the bank.
-        m_loadError = true;
-      }
       // fixup the maximum pixel id in the case that it's higher than the
-      // highest 'known' id
+      // highest 'known' id. If all the detector IDs are higher, the maximum
+      // drops below the minimum and no events are processed.
       if (m_max_id > static_cast<uint32_t>(alg->eventid_max))
         m_max_id = static_cast<uint32_t>(alg->eventid_max);
     }
@@ -362,11 +495,10 @@ public:
       file.openData("event_weight");
     } catch (::NeXus::Exception &) {
       // Field not found error is most likely.
-      m_have_weight = false;
+      delete[] m_event_weight;
+      m_event_weight = nullptr;
       return;
     }
-    // OK, we've got them
-    m_have_weight = true;
 
     // Allocate the array
     auto temp = new float[m_loadSize[0]];
@@ -397,8 +529,292 @@ public:
     }
   }
 
+  //---------------------------------------------------------------------------------------------------
+  /** Load the event_id, time-of-flight and (optionally) weight fields for the
+  * events given by m_loadStart and m_loadSize. The bank group must be open.
+  * The time-of-flight and weights are skipped when none of the pixel IDs is
+  * known.
+  *
+  * @param file :: File handle for the NeXus file
+  */
+  void loadEventSlab(::NeXus::File &file) {
+    m_min_id = std::numeric_limits<uint32_t>::max();
+    m_max_id = 0;
+    if (m_oldNexusFileNames)
+      file.openData("event_pixel_id");
+    else
+      file.openData("event_id");
+    // Load pixel IDs
+    this->loadEventId(file);
+    if (alg->getCancel())
+      m_loadError = true; // To allow cancelling the algorithm
+
+    // And TOF.
+    if (!m_loadError && m_min_id <= m_max_id) {
+      this->loadTof(file);
+      if (alg->m_haveWeights) {
+        this->loadEventWeights(file);
+      }
+    }
+  }
+
+  //---------------------------------------------------------------------------------------------------
+  /** Hand the arrays that were just loaded over to a slab
+  * @return the loaded events
+  */
+  Slab takeLoadedEvents() {
+    Slab slab;
+    // convert things to shared_arrays
+    slab.event_id.reset(m_event_id);
+    slab.event_time_of_flight.reset(m_event_time_of_flight);
+    slab.event_weight.reset(m_event_weight);
+    slab.have_weight = (m_event_weight != nullptr);
+    slab.startAt = m_loadStart[0];
+    slab.numEvents = m_loadSize[0];
+    slab.min_id = m_min_id;
+    slab.max_id = m_max_id;
+    m_event_id = nullptr;
+    m_event_time_of_flight = nullptr;
+    m_event_weight = nullptr;
+    return slab;
+  }
+
+  //---------------------------------------------------------------------------------------------------
+  /** Create the tasks processing a slab of events
+  *
+  * @param slab :: the loaded events
+  * @param event_index :: the event_index field of the bank
+  * @param allowSplit :: whether the pixel range may be split between two tasks
+  * @return the tasks to run (none if the events are outside the spectra to
+  * load)
+  */
+  std::vector<ProcessBankData *>
+  makeProcessTasks(const Slab &slab,
+                   boost::shared_ptr<std::vector<uint64_t>> event_index,
+                   bool allowSplit) {
+    std::vector<ProcessBankData *> tasks;
+    uint32_t min_id = slab.min_id;
+    uint32_t max_id = slab.max_id;
+    const auto bank_size = max_id - min_id;
+    const uint32_t minSpectraToLoad = static_cast<uint32_t>(alg->m_specMin);
+    const uint32_t maxSpectraToLoad = static_cast<uint32_t>(alg->m_specMax);
+    const uint32_t emptyInt = static_cast<uint32_t>(EMPTY_INT());
+    // check that if a range of spectra were requested that these fit within
+    // this bank
+    if (minSpectraToLoad != emptyInt && min_id < minSpectraToLoad) {
+      if (minSpectraToLoad > max_id) { // the minimum spectra to load is more
+                                       // than the max of this bank
+        return tasks;
+      }
+      // the min spectra to load is higher than the min for this bank
+      min_id = minSpectraToLoad;
+    }
+    if (maxSpectraToLoad != emptyInt && max_id > maxSpectraToLoad) {
+      if (maxSpectraToLoad < min_id) {
+        // the maximum spectra to load is less than the minimum of this bank
+        return tasks;
+      }
+      // the max spectra to load is lower than the max for this bank
+      max_id = maxSpectraToLoad;
+    }
+    if (min_id > max_id) {
+      // the min is now larger than the max, this means the entire block of
+      // spectra to load is outside this bank
+      return tasks;
+    }
+
+    // schedule the job to generate the event lists
+    auto mid_id = max_id;
+    if (allowSplit && alg->splitProcessing &&
+        max_id > (min_id + (bank_size / 4)))
+      // only split if told to and the section to load is at least 1/4 the size
+      // of the whole bank
+      mid_id = (max_id + min_id) / 2;
+
+    // No error? Launch a new task to process that data.
+    tasks.push_back(new ProcessBankData(
+        alg, entry_name, prog, slab.event_id, slab.event_time_of_flight,
+        slab.numEvents, slab.startAt, event_index, thisBankPulseTimes,
+        slab.have_weight, slab.event_weight, min_id, mid_id));
+    if (mid_id < max_id) {
+      tasks.push_back(new ProcessBankData(
+          alg, entry_name, prog, slab.event_id, slab.event_time_of_flight,
+          slab.numEvents, slab.startAt, event_index, thisBankPulseTimes,
+          slab.have_weight, slab.event_weight, (mid_id + 1), max_id));
+    }
+    return tasks;
+  }
+
+  //---------------------------------------------------------------------------------------------------
+  /** Add time spent reading from disk to the total of the algorithm
+  * @param seconds :: time spent reading
+  */
+  void addDiskReadTime(double seconds) {
+    std::lock_guard<std::mutex> _lock(alg->m_tofMutex);
+    alg->disk_read_time += seconds;
+  }
+
+  //---------------------------------------------------------------------------------------------------
+  /** Read the slabs of the bank one after another, holding the disk mutex
+  * only while reading, and queue them for processing. Runs in its own thread.
+  */
+  void readSlabs() {
+    for (size_t slabStart = m_slabsStart;
+         slabStart < m_slabsStop && !alg->getCancel();
+         slabStart += m_eventsPerSlab) {
+      m_loadStart[0] = static_cast<int>(slabStart);
+      m_loadSize[0] =
+          static_cast<int>(std::min(m_eventsPerSlab, m_slabsStop - slabStart));
+      {
+        std::lock_guard<std::mutex> ioLock(*m_ioMutex);
+        Timer timer;
+        try {
+          this->loadEventSlab(*m_slabFile);
+        } catch (std::exception &e) {
+          alg->getLogger().error() << "Error while loading bank " << entry_name
+                                   << ":\n";
+          alg->getLogger().error() << e.what() << '\n';
+          m_loadError = true;
+        }
+        addDiskReadTime(timer.elapsed());
+      }
+      if (m_loadError) {
+        delete[] m_event_id;
+        delete[] m_event_time_of_flight;
+        delete[] m_event_weight;
+        m_event_id = nullptr;
+        m_event_time_of_flight = nullptr;
+        m_event_weight = nullptr;
+        break;
+      }
+      if (!m_slabQueue->push(takeLoadedEvents()))
+        break; // processing was aborted
+    }
+    m_slabQueue->close();
+  }
+
+  //---------------------------------------------------------------------------------------------------
+  /** Load the bank in slabs of m_eventsPerSlab events. A separate thread reads
+  * the slabs into a double buffer while this task processes them in file
+  * order, so that reading the bank overlaps with filling the event lists.
+  * The pixel ranges of a slab, and the final compression, are spread over
+  * the thread pool.
+  */
+  void runInSlabs() {
+    auto event_index = boost::make_shared<std::vector<uint64_t>>();
+    m_loadStart.resize(1, 0);
+    m_loadSize.resize(1, 0);
+    m_loadError = false;
+    m_slabsStart = 0;
+    m_slabsStop = 0;
+
+    prog->report(entry_name + ": load from disk");
+
+    std::unique_ptr<::NeXus::File> file;
+    {
+      std::lock_guard<std::mutex> ioLock(*m_ioMutex);
+      Timer timer;
+      file = Kernel::make_unique<::NeXus::File>(alg->m_filename);
+      try {
+        file->openGroup(alg->m_top_entry_name, "NXentry");
+        file->openGroup(entry_name, entry_type);
+        this->loadEventIndex(*file, *event_index);
+        if (!m_loadError) {
+          this->loadPulseTimes(*file);
+          if (event_index->size() != thisBankPulseTimes->numPulses)
+            alg->getLogger().warning()
+                << "Bank " << entry_name
+                << " has a mismatch between the number of event_index entries "
+                   "and the number of pulse times in event_time_zero.\n";
+          this->prepareEventId(*file, m_slabsStart, m_slabsStop,
+                               *event_index);
+          file->closeData();
+        }
+      } catch (std::exception &e) {
+        alg->getLogger().error() << "Error while loading bank " << entry_name
+                                 << ":\n";
+        alg->getLogger().error() << e.what() << '\n';
+        m_loadError = true;
+      }
+      addDiskReadTime(timer.elapsed());
+    }
+
+    if (!m_loadError && m_slabsStart < m_slabsStop) {
+      SlabQueue<Slab> queue(2);
+      m_slabFile = file.get();
+      m_slabQueue = &queue;
+      Poco::RunnableAdapter<LoadBankFromDiskTask> reader(
+          *this, &LoadBankFromDiskTask::readSlabs);
+      Poco::Thread readerThread;
+      readerThread.start(reader);
+      // The event lists are compressed once, after the last slab
+      const bool compress = (alg->compressTolerance >= 0);
+      std::vector<bool> usedDetIds;
+      if (compress)
+        usedDetIds.assign(static_cast<size_t>(alg->eventid_max) + 1, false);
+      try {
+        Slab slab;
+        while (queue.pop(slab)) {
+          // A slab is done before the next one starts, which keeps the events
+          // of each pixel in file order; its pixel ranges run in parallel.
+          std::vector<Task *> tasks;
+          for (auto task : this->makeProcessTasks(slab, event_index, true)) {
+            if (compress)
+              task->deferCompression(usedDetIds);
+            tasks.push_back(task);
+          }
+          runTaskGroup(*scheduler, std::move(tasks));
+        }
+      } catch (...) {
+        queue.close();
+        readerThread.join();
+        throw;
+      }
+      readerThread.join();
+      if (compress && !alg->getCancel())
+        compressInParallel(usedDetIds);
+    }
+
+    // Close up the file even if errors occured.
+    std::lock_guard<std::mutex> ioLock(*m_ioMutex);
+    file->closeGroup();
+    file->close();
+  }
+
+  //---------------------------------------------------------------------------------------------------
+  /** Compress the event lists of the bank once all the slabs are loaded,
+  * splitting the pixel IDs into one range per core.
+  * @param usedDetIds :: flag for each pixel ID filled by any slab
+  */
+  void compressInParallel(const std::vector<bool> &usedDetIds) {
+    const int64_t numIds = static_cast<int64_t>(usedDetIds.size());
+    const int64_t numRanges = std::min(
+        static_cast<int64_t>(ThreadPool::getNumPhysicalCores()), numIds);
+    std::vector<Task *> tasks;
+    for (int64_t range = 0; range < numRanges; ++range) {
+      const auto minId = static_cast<detid_t>(numIds * range / numRanges);
+      const auto maxId =
+          static_cast<detid_t>(numIds * (range + 1) / numRanges - 1);
+      if (maxId < minId)
+        continue;
+      auto *alg = this->alg;
+      boost::function<void()> compress = [alg, &usedDetIds, minId, maxId] {
+        ProcessBankData::compressEvents(alg, usedDetIds, 0, minId, maxId);
+      };
+      tasks.push_back(
+          new FunctionTask(compress, static_cast<double>(maxId - minId + 1)));
+    }
+    runTaskGroup(*scheduler, std::move(tasks));
+  }
+
   //---------------------------------------------------------------------------------------------------
   void run() override {
+    if (m_eventsPerSlab > 0) {
+      this->runInSlabs();
+      return;
+    }
+    Timer timer;
+
     // The vectors we will be filling
     auto event_index_ptr = new std::vector<uint64_t>();
     std::vector<uint64_t> &event_index = *event_index_ptr;
@@ -414,7 +830,6 @@ public:
     m_event_weight = nullptr;
 
     m_loadError = false;
-    m_have_weight = alg->m_haveWeights;
 
     prog->report(entry_name + ": load from disk");
 
@@ -451,18 +866,9 @@ public:
         m_loadSize[0] = static_cast<int>(stop_event - start_event);
 
         if ((m_loadSize[0] > 0) && (m_loadStart[0] >= 0)) {
-          // Load pixel IDs
-          this->loadEventId(file);
-          if (alg->getCancel())
-            m_loadError = true; // To allow cancelling the algorithm
-
-          // And TOF.
-          if (!m_loadError) {
-            this->loadTof(file);
-            if (m_have_weight) {
-              this->loadEventWeights(file);
-            }
-          }
+          // Load pixel IDs, TOF and weights
+          file.closeData();
+          this->loadEventSlab(file);
         } // Size is at least 1
         else {
           // Found a size that was 0 or less; stop processing
@@ -486,77 +892,22 @@ public:
     // Close up the file even if errors occured.
     file.closeGroup();
     file.close();
+    addDiskReadTime(timer.elapsed());
 
     // Abort if anything failed
     if (m_loadError) {
       delete[] m_event_id;
       delete[] m_event_time_of_flight;
-      if (m_have_weight) {
-        delete[] m_event_weight;
-      }
+      delete[] m_event_weight;
       delete event_index_ptr;
 
       return;
     }
 
-    const auto bank_size = m_max_id - m_min_id;
-    const uint32_t minSpectraToLoad = static_cast<uint32_t>(alg->m_specMin);
-    const uint32_t maxSpectraToLoad = static_cast<uint32_t>(alg->m_specMax);
-    const uint32_t emptyInt = static_cast<uint32_t>(EMPTY_INT());
-    // check that if a range of spectra were requested that these fit within
-    // this bank
-    if (minSpectraToLoad != emptyInt && m_min_id < minSpectraToLoad) {
-      if (minSpectraToLoad > m_max_id) { // the minimum spectra to load is more
-                                         // than the max of this bank
-        return;
-      }
-      // the min spectra to load is higher than the min for this bank
-      m_min_id = minSpectraToLoad;
-    }
-    if (maxSpectraToLoad != emptyInt && m_max_id > maxSpectraToLoad) {
-      if (maxSpectraToLoad < m_min_id) {
-        // the maximum spectra to load is less than the minimum of this bank
-        return;
-      }
-      // the max spectra to load is lower than the max for this bank
-      m_max_id = maxSpectraToLoad;
-    }
-    if (m_min_id > m_max_id) {
-      // the min is now larger than the max, this means the entire block of
-      // spectra to load is outside this bank
-      return;
-    }
-
-    // schedule the job to generate the event lists
-    auto mid_id = m_max_id;
-    if (alg->splitProcessing && m_max_id > (m_min_id + (bank_size / 4)))
-      // only split if told to and the section to load is at least 1/4 the size
-      // of the whole bank
-      mid_id = (m_max_id + m_min_id) / 2;
-
-    // No error? Launch a new task to process that data.
-    size_t numEvents = m_loadSize[0];
-    size_t startAt = m_loadStart[0];
-
-    // convert things to shared_arrays
-    boost::shared_array<uint32_t> event_id_shrd(m_event_id);
-    boost::shared_array<float> event_time_of_flight_shrd(
-        m_event_time_of_flight);
-    boost::shared_array<float> event_weight_shrd(m_event_weight);
     boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
-
-    ProcessBankData *newTask1 = new ProcessBankData(
-        alg, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-        numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-        event_weight_shrd, m_min_id, mid_id);
-    scheduler->push(newTask1);
-    if (alg->splitProcessing && (mid_id < m_max_id)) {
-      ProcessBankData *newTask2 = new ProcessBankData(
-          alg, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-          numEvents, startAt, event_index_shrd, thisBankPulseTimes,
-          m_have_weight, event_weight_shrd, (mid_id + 1), m_max_id);
-      scheduler->push(newTask2);
-    }
+    const Slab slab = takeLoadedEvents();
+    for (auto task : this->makeProcessTasks(slab, event_index_shrd, true))
+      scheduler->push(task);
   }
 
   //---------------------------------------------------------------------------------------------------
@@ -603,12 +954,22 @@ private:
   uint32_t m_max_id;
   /// TOF data
   float *m_event_time_of_flight;
-  /// Flag for simulated data
-  bool m_have_weight;
   /// Event weights
   float *m_event_weight;
   /// Frame period numbers
   const std::vector<int> m_framePeriodNumbers;
+  /// Mutex shared for all Disk I-O tasks
+  boost::shared_ptr<std::mutex> m_ioMutex;
+  /// Number of events per slab when reading the bank in slabs (0 = one read)
+  const std::size_t m_eventsPerSlab;
+  /// First event to read in slabs
+  size_t m_slabsStart;
+  /// One past the last event to read in slabs
+  size_t m_slabsStop;
+  /// File the slabs are read from
+  ::NeXus::File *m_slabFile;
+  /// Queue of slabs waiting to be processed
+  SlabQueue<Slab> *m_slabQueue;
 }; // END-DEF-CLASS LoadBankFromDiskTask
 
 //===============================================================================================
@@ -623,13 +984,17 @@ LoadEventNexus::LoadEventNexus()
       filter_tof_max(0), m_specList(), m_specMin(0), m_specMax(0),
       filter_time_start(), filter_time_stop(), chunk(0), totalChunks(0),
       firstChunkForBank(0), eventsPerChunk(0), m_tofMutex(), longest_tof(0),
-      shortest_tof(0), bad_tofs(0), discarded_events(0), precount(0),
+      shortest_tof(0), bad_tofs(0), discarded_events(0), disk_read_time(0),
+      process_time(0), precount(0),
       compressTolerance(0), eventVectors(), m_eventVectorMutex(),
       eventid_max(0), pixelID_to_wi_vector(), pixelID_to_wi_offset(),
       m_bankPulseTimes(), m_allBanksPulseTimes(), m_top_entry_name(),
-      m_file(nullptr), splitProcessing(false), m_haveWeights(false),
+      m_file(nullptr), splitProcessing(false), numScatterRanges(1),
+      minEventsPerScatterRange(1000000), parallelScatter(false),
+      eventsPerSlab(size_t(1) << 24), m_haveWeights(false),
       weightedEventVectors(), m_instrument_loaded_correctly(false),
-      loadlogs(false), m_logs_loaded_correctly(false), event_id_is_spec(false) {
+      loadlogs(false), m_logs_loaded_correctly(false), event_id_is_spec(false),
+      m_requestedScatterRanges(0) {
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1500,7 +1865,11 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
   longest_tof = 0.;
 
   // Make the thread pool
-  ThreadScheduler *scheduler = new ThreadSchedulerMutexes();
+  ThreadScheduler *scheduler;
+  if (ThreadPool::useWorkStealing())
+    scheduler = new ThreadSchedulerWorkStealing();
+  else
+    scheduler = new ThreadSchedulerMutexes();
   ThreadPool pool(scheduler);
   auto diskIOMutex = boost::make_shared<std::mutex>();
   size_t bank0 = 0;
@@ -1571,10 +1940,38 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
   splitProcessing =
       bool(bankNames.size() * 2 < ThreadPool::getNumPhysicalCores());
 
-  // set up progress bar for the rest of the (multi-threaded) process
+  // A single bank leaves cores idle, which its processing jobs share to fill
+  // the event lists. Several banks already keep all the cores busy.
+  parallelScatter = (bankn - bank0 == 1);
+  if (m_requestedScatterRanges > 0)
+    numScatterRanges = m_requestedScatterRanges;
+  else if (parallelScatter)
+    numScatterRanges = std::max(
+        ThreadPool::getNumPhysicalCores() / (splitProcessing ? 2 : 1),
+        size_t(1));
+  else
+    numScatterRanges = 1;
+
+  // count the progress reports of the rest of the (multi-threaded) process
   size_t numProg = bankNames.size() * (1 + 3); // 1 = disktask, 3 = proc task
   if (splitProcessing)
     numProg += bankNames.size() * 3; // 3 = second proc task
+
+  // Banks holding several slabs worth of events are read in slabs, so that
+  // filling the event lists overlaps with reading the rest of the bank.
+  std::vector<size_t> bankEventsPerSlab(bankNames.size(), 0);
+  for (size_t i = bank0; i < bankn; i++) {
+    if (eventsPerSlab > 0 && bankNumEvents[i] > 2 * eventsPerSlab) {
+      bankEventsPerSlab[i] = eventsPerSlab;
+      // 3 per slab instead of 3 per proc task
+      const size_t numSlabs =
+          (bankNumEvents[i] + eventsPerSlab - 1) / eventsPerSlab;
+      numProg += numSlabs * 3;
+      numProg -= splitProcessing ? 6 : 3;
+    }
+  }
+
+  // set up progress bar for the rest of the (multi-threaded) process
   auto prog2 = new Progress(this, 0.3, 1.0, numProg);
 
   const std::vector<int> periodLogVec = periodLog->valuesAsVector();
@@ -1584,13 +1981,18 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
     if (bankNumEvents[i] > 0)
       pool.schedule(new LoadBankFromDiskTask(
           this, bankNames[i], classType, bankNumEvents[i], oldNeXusFileNames,
-          prog2, diskIOMutex, scheduler, periodLogVec));
+          prog2, diskIOMutex, scheduler, periodLogVec, bankEventsPerSlab[i]));
   }
   // Start and end all threads
   pool.joinAll();
   diskIOMutex.reset();
   delete prog2;
 
+  g_log.information() << "Time spent reading events from disk: "
+                      << disk_read_time
+                      << " s; filling the event lists: " << process_time
+                      << " s (summed over all threads).\n";
+
   // Info reporting
   const std::size_t eventsLoaded = m_ws->getNumberEvents();
   g_log.information() << "Read " << eventsLoaded << " events"
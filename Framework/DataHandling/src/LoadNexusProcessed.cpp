@@ -11,6 +11,7 @@
 #include "MantidAPI/WorkspaceHistory.h"
 #include "MantidDataHandling/LoadNexusProcessed.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/LazyWorkspace2D.h"
 #include "MantidDataObjects/RebinnedOutput.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidDataObjects/PeakNoShapeFactory.h"
@@ -33,6 +34,7 @@
 #include <nexus/NeXusException.hpp>
 
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -167,6 +169,70 @@ bool isMultiPeriodFile(int nWorkspaceEntries, Workspace_sptr sampleWS,
   }
   return isMultiPeriod;
 }
+
+/// Guards reading from the files, as the NeXus API is not thread safe
+std::mutex g_fileMutex;
+
+/**
+* Reads the spectra of the "workspace" group of an entry on demand, see
+* LazyWorkspace2D. The file stays open while a workspace uses the loader.
+*/
+class NexusSpectrumLoader : public LazyWorkspace2D::SpectrumLoader {
+public:
+  NexusSpectrumLoader(const std::string &filename, const std::string &entryName,
+                      std::vector<int> rows,
+                      Kernel::cow_ptr<HistogramData::HistogramX> sharedBins)
+      : m_root(filename),
+        m_data(m_root.openEntry(entryName).openNXData("workspace")),
+        m_values(m_data.openDoubleData()),
+        m_errors(m_data.openNXDouble("errors")),
+        m_xbins(m_data.openNXDouble("axis1")), m_hasXErrors(false),
+        m_xErrors(m_errors), m_rows(std::move(rows)),
+        m_sharedBins(std::move(sharedBins)) {
+    if (m_data.isValid("xerrors")) {
+      m_hasXErrors = true;
+      m_xErrors = m_data.openNXDouble("xerrors");
+    }
+  }
+
+  void load(const size_t index, Histogram1D &spectrum) override {
+    std::lock_guard<std::mutex> lock(g_fileMutex);
+    const int row = m_rows[index];
+    const int nchannels = m_values.dim1();
+    m_values.load(1, row);
+    spectrum.setSharedY(Kernel::make_cow<HistogramData::HistogramY>(
+        m_values(), m_values() + nchannels));
+    m_errors.load(1, row);
+    spectrum.setSharedE(Kernel::make_cow<HistogramData::HistogramE>(
+        m_errors(), m_errors() + nchannels));
+    if (m_sharedBins) {
+      spectrum.setSharedX(m_sharedBins);
+    } else {
+      m_xbins.load(1, row);
+      spectrum.setSharedX(Kernel::make_cow<HistogramData::HistogramX>(
+          m_xbins(), m_xbins() + m_xbins.dim1()));
+    }
+    // Old files store one more Dx value than there are bins, which is dropped
+    if (m_hasXErrors) {
+      m_xErrors.load(1, row);
+      spectrum.setSharedDx(Kernel::make_cow<HistogramData::HistogramDx>(
+          m_xErrors(), m_xErrors() + nchannels));
+    }
+  }
+
+private:
+  NXRoot m_root;
+  NXData m_data;
+  NXDouble m_values;
+  NXDouble m_errors;
+  NXDouble m_xbins;
+  bool m_hasXErrors;
+  NXDouble m_xErrors;
+  /// The row in the file of each workspace index
+  std::vector<int> m_rows;
+  /// The X data of all spectra if they are shared
+  Kernel::cow_ptr<HistogramData::HistogramX> m_sharedBins;
+};
 }
 
 /// Default constructor
@@ -234,6 +300,17 @@ void LoadNexusProcessed::init() {
       "For multiperiod workspaces. Copy instrument, parameter and x-data "
       "rather than loading it directly for each workspace. Y, E and log "
       "information is always loaded.");
+  declareProperty("OnDemand", false,
+                  "If true, the data of a histogram workspace are read from "
+                  "the file when a spectrum is first accessed rather than all "
+                  "at once. The file stays open while the workspace exists.");
+  auto mustBeAtLeastOne = boost::make_shared<BoundedValidator<int>>();
+  mustBeAtLeastOne->setLower(1);
+  declareProperty("OnDemandCacheSize", 1000, mustBeAtLeastOne,
+                  "The maximum number of spectra read on demand as copies, "
+                  "e.g. through histogram(), that are kept in memory. Spectra "
+                  "accessed through references, e.g. y(), or modified are "
+                  "always kept.");
 }
 
 /**
@@ -450,8 +527,9 @@ void LoadNexusProcessed::exec() {
     if (tempMatrixWorkspace) {
       // We only accelerate for simple scenarios for now. Spectrum lists are too
       // complicated to bother with.
+      const bool onDemand = getProperty("OnDemand");
       bAccelleratedMultiPeriodLoading =
-          bIsMultiPeriod && bFastMultiPeriod && !m_list;
+          bIsMultiPeriod && bFastMultiPeriod && !m_list && !onDemand;
       tempMatrixWorkspace->mutableRun().clearLogs(); // Strip out any loaded
                                                      // logs. That way we don't
                                                      // pay for copying that
@@ -1257,10 +1335,17 @@ API::MatrixWorkspace_sptr LoadNexusProcessed::loadNonEventEntry(
     workspaceType = "RebinnedOutput";
   }
 
-  API::MatrixWorkspace_sptr local_workspace =
-      boost::dynamic_pointer_cast<API::MatrixWorkspace>(
-          WorkspaceFactory::Instance().create(workspaceType, total_specs,
-                                              xlength, nchannels));
+  // The data are read by the LazyWorkspace2D, see readDataOnDemand()
+  const bool onDemandProperty = getProperty("OnDemand");
+  const bool onDemand = onDemandProperty && workspaceType == "Workspace2D";
+  API::MatrixWorkspace_sptr local_workspace;
+  if (onDemand) {
+    local_workspace = boost::make_shared<LazyWorkspace2D>();
+    local_workspace->initialize(total_specs, xlength, nchannels);
+  } else {
+    local_workspace = WorkspaceFactory::Instance().create(
+        workspaceType, total_specs, xlength, nchannels);
+  }
   try {
     local_workspace->setTitle(mtd_entry.getString("title"));
   } catch (std::runtime_error &) {
@@ -1276,6 +1361,9 @@ API::MatrixWorkspace_sptr LoadNexusProcessed::loadNonEventEntry(
   local_workspace->setYUnitLabel(unitLabel);
 
   readBinMasking(wksp_cls, local_workspace);
+  if (onDemand)
+    return local_workspace;
+
   NXDataSetTyped<double> errors = wksp_cls.openNXDouble("errors");
   NXDataSetTyped<double> fracarea = errors;
   if (hasFracArea) {
@@ -1501,6 +1589,10 @@ API::Workspace_sptr LoadNexusProcessed::loadEntry(NXRoot &root,
   // --- Load workspace (as event_workspace or workspace2d) ---
   API::MatrixWorkspace_sptr local_workspace;
   if (isEvent) {
+    const bool onDemand = getProperty("OnDemand");
+    if (onDemand)
+      g_log.information("Event workspaces cannot be read on demand, all "
+                        "events are loaded.");
     local_workspace =
         loadEventEntry(wksp_cls, xbins, progressStart, progressRange);
   } else {
@@ -1607,12 +1699,47 @@ API::Workspace_sptr LoadNexusProcessed::loadEntry(NXRoot &root,
                        "history is incomplete\n";
   }
 
+  if (auto lazyWorkspace =
+          boost::dynamic_pointer_cast<LazyWorkspace2D>(local_workspace))
+    readDataOnDemand(*lazyWorkspace, mtd_entry);
+
   progress(progressStart + 0.2 * progressRange,
            "Reading the workspace history...");
 
   return boost::static_pointer_cast<API::Workspace>(local_workspace);
 }
 
+//-------------------------------------------------------------------------------------------------
+/**
+* Start reading the data of a workspace from the file on demand. Must be called
+* once the workspace is set up, as the data of a spectrum are read on their
+* first access from then on.
+*
+* @param local_workspace :: The workspace of the entry
+* @param mtd_entry :: The node for the current workspace
+*/
+void LoadNexusProcessed::readDataOnDemand(LazyWorkspace2D &local_workspace,
+                                          NXEntry &mtd_entry) {
+  // Same spectra as loadNonEventEntry(), see calculateWorkspaceSize()
+  std::vector<int> rows;
+  rows.reserve(local_workspace.getNumberHistograms());
+  for (int spec = m_spec_min; spec < m_spec_max; ++spec)
+    rows.push_back(spec - 1);
+  if (m_list) {
+    for (const auto spec : m_spec_list)
+      rows.push_back(spec - 1);
+  }
+
+  Kernel::cow_ptr<HistogramData::HistogramX> sharedBins(nullptr);
+  if (m_shared_bins)
+    sharedBins = m_xbins.cowData();
+  auto loader = boost::make_shared<NexusSpectrumLoader>(
+      getPropertyValue("Filename"), mtd_entry.name(), std::move(rows),
+      sharedBins);
+  const int cacheSize = getProperty("OnDemandCacheSize");
+  local_workspace.setLoader(loader, static_cast<size_t>(cacheSize));
+}
+
 //-------------------------------------------------------------------------------------------------
 /**
 * Read the instrument group
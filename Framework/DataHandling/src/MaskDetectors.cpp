@@ -111,9 +111,6 @@ void MaskDetectors::exec() {
     return;
   }
 
-  // Is it an event workspace?
-  EventWorkspace_sptr eventWS = boost::dynamic_pointer_cast<EventWorkspace>(WS);
-
   // Is it a Mask Workspace ?
   MaskWorkspace_sptr isMaskWS = boost::dynamic_pointer_cast<MaskWorkspace>(WS);
 
@@ -221,11 +218,6 @@ void MaskDetectors::exec() {
     progress(prog);
   }
 
-  if (eventWS) {
-    // Also clear the MRU for event workspaces.
-    eventWS->clearMRU();
-  }
-
   if (isMaskWS) {
     // If the input was a mask workspace, then extract the mask to ensure
     // we are returning the correct thing.
@@ -1,10 +1,59 @@
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
 
 using namespace Mantid::DataObjects;
 
 namespace Mantid {
 namespace DataHandling {
 
+namespace {
+/// Create an unweighted event
+template <class EventType>
+inline EventType makeEvent(double tof, const Kernel::DateAndTime &pulsetime,
+                           const float * /*event_weight*/, size_t /*i*/) {
+  return EventType(tof, pulsetime);
+}
+
+/// Create a weighted event, taking the weight from the weights array
+template <>
+inline WeightedEvent makeEvent<WeightedEvent>(
+    double tof, const Kernel::DateAndTime &pulsetime, const float *event_weight,
+    size_t i) {
+  const double weight = static_cast<double>(event_weight[i]);
+  return WeightedEvent(tof, pulsetime, weight, weight * weight);
+}
+
+/** Check whether several pixel IDs of a range fill the same event list, in
+ * which case only the event-by-event fill keeps the lists in pulse time order.
+ */
+template <class T>
+bool haveSharedEventLists(const std::vector<T> &eventVectors, detid_t minId,
+                          detid_t maxId) {
+  std::vector<T> lists;
+  lists.reserve(maxId - minId + 1);
+  for (detid_t detId = minId; detId <= maxId; ++detId) {
+    if (eventVectors[detId])
+      lists.push_back(eventVectors[detId]);
+  }
+  std::sort(lists.begin(), lists.end());
+  return std::adjacent_find(lists.begin(), lists.end()) != lists.end();
+}
+
+/// Statistics gathered by one sub-range of the scatter
+struct ScatterStatistics {
+  double shortestTof{static_cast<double>(std::numeric_limits<uint32_t>::max()) *
+                     0.1};
+  double longestTof{0.};
+  size_t badTofs{0};
+  size_t discardedEvents{0};
+  bool pulseTimesIncreasing{true};
+  Kernel::DateAndTime firstPulseTime{0};
+  Kernel::DateAndTime lastPulseTime{0};
+};
+}
+
 ProcessBankData::ProcessBankData(
     LoadEventNexus *alg, std::string entry_name, API::Progress *prog,
     boost::shared_array<uint32_t> event_id,
@@ -20,16 +69,73 @@ ProcessBankData::ProcessBankData(
       numEvents(numEvents), startAt(startAt), event_index(event_index),
       thisBankPulseTimes(thisBankPulseTimes), have_weight(have_weight),
       event_weight(event_weight), m_min_id(min_event_id),
-      m_max_id(max_event_id) {
+      m_max_id(max_event_id), m_deferredDetIds(nullptr) {
   // Cost is approximately proportional to the number of events to process.
   m_cost = static_cast<double>(numEvents);
 }
 
+//----------------------------------------------------------------------------------------------
+/** Leave the compression to the caller, who loads the bank in several parts
+ * and compresses each event list once, after the last part. Compressing in
+ * between would switch the lists to weighted events without time and so
+ * invalidate the cached event vectors.
+ * @param touchedDetIds :: flag for each pixel ID up to the highest of the
+ * bank, set for each pixel this task fills
+ */
+void ProcessBankData::deferCompression(std::vector<bool> &touchedDetIds) {
+  m_deferredDetIds = &touchedDetIds;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Compress the event lists of the pixels that were filled
+ * @param alg :: LoadEventNexus holding the workspace and tolerance
+ * @param usedDetIds :: flag for each pixel ID from firstId on
+ * @param firstId :: pixel ID of the first flag
+ * @param minId :: first pixel ID to compress
+ * @param maxId :: last pixel ID to compress
+ */
+void ProcessBankData::compressEvents(LoadEventNexus *alg,
+                                     const std::vector<bool> &usedDetIds,
+                                     detid_t firstId, detid_t minId,
+                                     detid_t maxId) {
+  auto &outputWS = *(alg->m_ws);
+  for (detid_t pixID = minId; pixID <= maxId; pixID++) {
+    if (usedDetIds[pixID - firstId]) {
+      // Find the the workspace index corresponding to that pixel ID
+      size_t wi =
+          alg->pixelID_to_wi_vector[pixID + alg->pixelID_to_wi_offset];
+      auto &el = outputWS.getSpectrum(wi);
+      el.compressEvents(alg->compressTolerance, &el);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Run the data processing
  * FIXME/TODO - split run() into readable methods
 */
 void ProcessBankData::run() { // override {
+  // Time the processing only, not the wait in the queue
+  m_timer.reset();
+
+  // With a single period the precount doubles as the first pass of a
+  // counting sort, which fills the event lists without any push_back.
+  if (alg->precount && alg->m_ws->nPeriods() == 1) {
+    if (have_weight) {
+      auto &eventVectors = alg->weightedEventVectors[0];
+      if (!haveSharedEventLists(eventVectors, m_min_id, m_max_id)) {
+        scatterEvents(eventVectors);
+        return;
+      }
+    } else {
+      auto &eventVectors = alg->eventVectors[0];
+      if (!haveSharedEventLists(eventVectors, m_min_id, m_max_id)) {
+        scatterEvents(eventVectors);
+        return;
+      }
+    }
+  }
+
   // Local tof limits
   double my_shortest_tof =
       static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
@@ -196,29 +302,226 @@ void ProcessBankData::run() { // override {
     } // valid detector IDs
   }   //(for each event)
 
-  //------------ Compress Events (or set sort order) ------------------
-  // Do it on all the detector IDs we touched
-  if (compress) {
-    for (detid_t pixID = m_min_id; pixID <= m_max_id; pixID++) {
-      if (usedDetIds[pixID - m_min_id]) {
-        // Find the the workspace index corresponding to that pixel ID
-        size_t wi = pixelID_to_wi_vector[pixID + pixelID_to_wi_offset];
-        auto &el = outputWS.getSpectrum(wi);
-        if (compress)
-          el.compressEvents(alg->compressTolerance, &el);
-        else {
-          if (pulsetimesincreasing)
-            el.setSortOrder(DataObjects::PULSETIME_SORT);
-          else
-            el.setSortOrder(DataObjects::UNSORTED);
+  finalizeBank(usedDetIds, my_shortest_tof, my_longest_tof, badTofs,
+               my_discarded_events, pulsetimesincreasing);
+} // END-OF-RUN()
+
+//----------------------------------------------------------------------------------------------
+/** Fill the event lists in two passes. The first pass counts the accepted
+ * events of each pixel in contiguous sub-ranges of the bank, so that every
+ * event list can be sized exactly once. The second pass then writes each
+ * event straight into its final slot; the sub-ranges own disjoint slots, so
+ * they are filled in parallel without locking. The order of the events within
+ * a pixel is the same as in the file.
+ *
+ * @param eventVectors :: vector where index = detector ID, value = pointer to
+ * the events of the corresponding event list (NULL for unknown pixels)
+ */
+template <class EventType>
+void ProcessBankData::scatterEvents(
+    std::vector<std::vector<EventType> *> &eventVectors) {
+  prog->report(entry_name + ": precount");
+
+  const size_t numIds = static_cast<size_t>(m_max_id - m_min_id + 1);
+  // The per-range count arrays must stay small compared to the bank itself
+  size_t numRanges =
+      std::min(alg->numScatterRanges,
+               numEvents / std::max(alg->minEventsPerScatterRange, size_t(1)));
+  numRanges = std::max(std::min(numRanges, numEvents / numIds), size_t(1));
+  std::vector<size_t> rangeStart(numRanges + 1);
+  for (size_t range = 0; range <= numRanges; ++range)
+    rangeStart[range] = numEvents * range / numRanges;
+
+  const double tofMin = alg->filter_tof_min;
+  const double tofMax = alg->filter_tof_max;
+
+  // ---- First pass: histogram the accepted events per pixel ID ----
+  // Only a bank loaded on its own may start threads of its own, the banks
+  // loaded together already share the thread pool.
+  const bool parallel = numRanges > 1 && alg->parallelScatter;
+  std::vector<std::vector<size_t>> offsets(numRanges);
+  PARALLEL_FOR_IF(parallel)
+  for (int64_t range = 0; range < static_cast<int64_t>(numRanges); ++range) {
+    auto &counts = offsets[range];
+    counts.assign(numIds, 0);
+    for (size_t i = rangeStart[range]; i < rangeStart[range + 1]; ++i) {
+      const detid_t detId = event_id[i];
+      if (detId < m_min_id || detId > m_max_id)
+        continue;
+      const double tof = static_cast<double>(event_time_of_flight[i]);
+      if ((tof >= tofMin) && (tof <= tofMax))
+        ++counts[detId - m_min_id];
+    }
+  }
+
+  if (alg->getCancel())
+    return;
+
+  // Size every touched event list once and turn the counts of each range into
+  // the position of its first event in that list.
+  std::vector<bool> usedDetIds(numIds, false);
+  for (size_t index = 0; index < numIds; ++index) {
+    auto eventVector = eventVectors[index + m_min_id];
+    if (!eventVector)
+      continue;
+    size_t end = eventVector->size();
+    for (auto &counts : offsets) {
+      const size_t count = counts[index];
+      counts[index] = end;
+      end += count;
+    }
+    if (end > eventVector->size()) {
+      eventVector->resize(end);
+      usedDetIds[index] = true;
+    }
+  }
+
+  if (alg->getCancel())
+    return;
+
+  prog->report(entry_name + ": filling events");
+
+  // Without a consistent event_index the pulse times cannot be found
+  const size_t numPulses = thisBankPulseTimes->numPulses;
+  const bool havePulses = numPulses > 0 && numPulses <= event_index->size();
+  if (numPulses > event_index->size()) {
+    alg->getLogger().warning()
+        << "Entry " << entry_name
+        << "'s event_index vector is smaller than the event_time_zero field. "
+           "This is inconsistent, so we cannot find pulse times for this "
+           "entry.\n";
+  }
+
+  // ---- Second pass: scatter the events into their slots ----
+  std::vector<ScatterStatistics> statistics(numRanges);
+  PARALLEL_FOR_IF(parallel)
+  for (int64_t range = 0; range < static_cast<int64_t>(numRanges); ++range) {
+    auto &slots = offsets[range];
+    auto &stats = statistics[range];
+    const size_t last = rangeStart[range + 1];
+    size_t i = rangeStart[range];
+    bool firstPulse = true;
+    while (i < last) {
+      // Resolve the pulse once for all the events it contains
+      Kernel::DateAndTime pulsetime;
+      size_t pulseEnd = last;
+      if (havePulses) {
+        const size_t pulse = findPulseIndex(i, numPulses);
+        pulsetime = thisBankPulseTimes->pulseTimes[pulse];
+        if (pulse + 1 < numPulses) {
+          const size_t nextPulseStart = static_cast<size_t>(
+              event_index->operator[](pulse + 1) - startAt);
+          pulseEnd = std::max(std::min(nextPulseStart, last), i + 1);
         }
+        if (firstPulse) {
+          stats.firstPulseTime = pulsetime;
+          firstPulse = false;
+        } else if (pulsetime < stats.lastPulseTime)
+          stats.pulseTimesIncreasing = false;
+        stats.lastPulseTime = pulsetime;
+      }
+
+      for (; i < pulseEnd; ++i) {
+        const detid_t detId = event_id[i];
+        if (detId < m_min_id || detId > m_max_id)
+          continue;
+        const double tof = static_cast<double>(event_time_of_flight[i]);
+        if (!((tof >= tofMin) && (tof <= tofMax)))
+          continue;
+        // Local tof limits, also for the events of unknown pixels
+        if (tof < stats.shortestTof)
+          stats.shortestTof = tof;
+        // Skip any events that are the cause of bad DAS data (e.g. a negative
+        // number in uint32 -> 2.4 billion * 100 nanosec = 2.4e8 microsec)
+        if (tof < 2e8) {
+          if (tof > stats.longestTof)
+            stats.longestTof = tof;
+        } else
+          stats.badTofs++;
+
+        // NULL eventVector indicates a bad spectrum lookup
+        auto eventVector = eventVectors[detId];
+        if (!eventVector) {
+          ++stats.discardedEvents;
+          continue;
+        }
+        (*eventVector)[slots[detId - m_min_id]++] =
+            makeEvent<EventType>(tof, pulsetime, event_weight.get(), i);
       }
     }
   }
+
+  // Combine the statistics of the sub-ranges, in order
+  ScatterStatistics total;
+  bool firstRange = true;
+  for (const auto &stats : statistics) {
+    total.shortestTof = std::min(total.shortestTof, stats.shortestTof);
+    total.longestTof = std::max(total.longestTof, stats.longestTof);
+    total.badTofs += stats.badTofs;
+    total.discardedEvents += stats.discardedEvents;
+    total.pulseTimesIncreasing &= stats.pulseTimesIncreasing;
+    if (!firstRange && stats.firstPulseTime < total.lastPulseTime)
+      total.pulseTimesIncreasing = false;
+    total.lastPulseTime = stats.lastPulseTime;
+    firstRange = false;
+  }
+
+  finalizeBank(usedDetIds, total.shortestTof, total.longestTof, total.badTofs,
+               total.discardedEvents, total.pulseTimesIncreasing);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Find the pulse an event belongs to with a binary search of event_index.
+ * @param eventIndex :: position of the event in the loaded arrays
+ * @param numPulses :: number of pulses to search
+ * @return the index of the last pulse starting at or before the event
+ */
+size_t ProcessBankData::findPulseIndex(size_t eventIndex,
+                                       size_t numPulses) const {
+  const auto begin = event_index->cbegin();
+  const auto pulse = std::upper_bound(
+      begin, begin + numPulses, static_cast<uint64_t>(eventIndex + startAt));
+  if (pulse == begin)
+    return 0;
+  return static_cast<size_t>(std::distance(begin, pulse)) - 1;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Compress the events of the touched pixels, if requested, and join the
+ * local tof limits and counters back up to the global ones.
+ * @param usedDetIds :: flag for each pixel ID in the range touched by this task
+ * @param shortestTof :: shortest tof found
+ * @param longestTof :: longest valid tof found
+ * @param badTofs :: number of tofs above 2e8 microseconds
+ * @param discardedEvents :: number of events without an event list
+ * @param pulseTimesIncreasing :: true if the pulse times were monotonic
+ */
+void ProcessBankData::finalizeBank(const std::vector<bool> &usedDetIds,
+                                   double shortestTof, double longestTof,
+                                   size_t badTofs, size_t discardedEvents,
+                                   bool pulseTimesIncreasing) {
+  // Will we need to compress?
+  bool compress = (alg->compressTolerance >= 0);
+
+  //------------ Compress Events ------------------
+  // Do it on all the detector IDs we touched, unless the caller compresses
+  // them once the whole bank is loaded
+  if (compress) {
+    if (m_deferredDetIds) {
+      // The flags are packed bits shared with the tasks of the other pixel
+      // ranges, so they are set one task at a time
+      std::lock_guard<std::mutex> _lock(alg->m_tofMutex);
+      for (detid_t pixID = m_min_id; pixID <= m_max_id; pixID++) {
+        if (usedDetIds[pixID - m_min_id])
+          (*m_deferredDetIds)[pixID] = true;
+      }
+    } else
+      compressEvents(alg, usedDetIds, m_min_id, m_min_id, m_max_id);
+  }
   prog->report(entry_name + ": filled events");
 
   alg->getLogger().debug() << entry_name
-                           << (pulsetimesincreasing ? " had "
+                           << (pulseTimesIncreasing ? " had "
                                                     : " DID NOT have ")
                            << "monotonically increasing pulse times\n";
 
@@ -226,21 +529,22 @@ void ProcessBankData::run() { // override {
   // This is not thread safe, so only one thread at a time runs this.
   {
     std::lock_guard<std::mutex> _lock(alg->m_tofMutex);
-    if (my_shortest_tof < alg->shortest_tof) {
-      alg->shortest_tof = my_shortest_tof;
+    if (shortestTof < alg->shortest_tof) {
+      alg->shortest_tof = shortestTof;
     }
-    if (my_longest_tof > alg->longest_tof) {
-      alg->longest_tof = my_longest_tof;
+    if (longestTof > alg->longest_tof) {
+      alg->longest_tof = longestTof;
     }
     alg->bad_tofs += badTofs;
-    alg->discarded_events += my_discarded_events;
+    alg->discarded_events += discardedEvents;
+    alg->process_time += m_timer.elapsed_no_reset();
   }
 
 #ifndef _WIN32
   alg->getLogger().debug() << "Time to process " << entry_name << " " << m_timer
                            << "\n";
 #endif
-} // END-OF-RUN()
+}
 
 } // namespace Mantid{
 } // namespace DataHandling{
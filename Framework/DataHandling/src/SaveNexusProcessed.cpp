@@ -6,6 +6,7 @@
 #include "MantidAPI/IMDHistoWorkspace.h"
 #include "MantidAPI/WorkspaceHistory.h"
 #include "MantidAPI/WorkspaceOpOverloads.h"
+#include "MantidDataHandling/H5Util.h"
 #include "MantidDataHandling/SaveNexusProcessed.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
@@ -17,6 +18,7 @@
 #include <boost/regex.hpp>
 #include <boost/shared_ptr.hpp>
 #include <Poco/File.h>
+#include <H5Cpp.h>
 
 using namespace Mantid::API;
 
@@ -83,7 +85,7 @@ void SaveNexusProcessed::init() {
   declareProperty(
       "CompressNexus", false,
       "For EventWorkspaces, compress the Nexus data field (default False).\n"
-      "This will make smaller files but takes much longer.");
+      "This will make smaller files but takes longer.");
   setPropertySettings("CompressNexus",
                       make_unique<EnabledWhenWorkspaceIsType<EventWorkspace>>(
                           "InputWorkspace", true));
@@ -300,6 +302,7 @@ void SaveNexusProcessed::doExec(Workspace_sptr inputWorkspace,
 
   inputWorkspace->history().saveNexus(cppFile);
   nexusFile->closeGroup();
+  writeEventColumns(nexusFile);
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -327,7 +330,7 @@ void SaveNexusProcessed::exec() {
  *        or NULL if they are not meant to be written to.
  */
 template <class T>
-void SaveNexusProcessed::appendEventListData(std::vector<T> events,
+void SaveNexusProcessed::appendEventListData(const std::vector<T> &events,
                                              size_t offset, double *tofs,
                                              float *weights,
                                              float *errorSquareds,
@@ -382,11 +385,8 @@ void SaveNexusProcessed::execEvent(Mantid::NeXus::NexusFileIO *nexusFile,
   indices.push_back(index);
 
   // Initialize all the arrays
-  int64_t num = index;
-  double *tofs = nullptr;
-  float *weights = nullptr;
-  float *errorSquareds = nullptr;
-  int64_t *pulsetimes = nullptr;
+  size_t num = index;
+  EventColumns columns;
 
   // overall event type.
   EventType type = m_eventWorkspace->getEventType();
@@ -412,13 +412,17 @@ void SaveNexusProcessed::execEvent(Mantid::NeXus::NexusFileIO *nexusFile,
 
   // --- Initialize the combined event arrays ----
   if (writeTOF)
-    tofs = new double[num];
+    columns.tofs.resize(num);
   if (writeWeight)
-    weights = new float[num];
+    columns.weights.resize(num);
   if (writeError)
-    errorSquareds = new float[num];
+    columns.errorSquareds.resize(num);
   if (writePulsetime)
-    pulsetimes = new int64_t[num];
+    columns.pulsetimes.resize(num);
+  double *tofs = writeTOF ? columns.tofs.data() : nullptr;
+  float *weights = writeWeight ? columns.weights.data() : nullptr;
+  float *errorSquareds = writeError ? columns.errorSquareds.data() : nullptr;
+  int64_t *pulsetimes = writePulsetime ? columns.pulsetimes.data() : nullptr;
 
   // --- Fill in the combined event arrays ----
   PARALLEL_FOR_NO_WSP_CHECK()
@@ -454,16 +458,57 @@ void SaveNexusProcessed::execEvent(Mantid::NeXus::NexusFileIO *nexusFile,
   /*Default = DONT compress - much faster*/
   bool CompressNexus = getProperty("CompressNexus");
 
+  // Compressed HDF5 columns are written in parallel chunks once the NeXus API
+  // has closed the file. Only the indices are written through it.
+  if (CompressNexus && num > 0 && H5::H5File::isHdf5(m_filename)) {
+    nexusFile->writeNexusProcessedDataEventCombined(
+        m_eventWorkspace, indices, nullptr, nullptr, nullptr, nullptr,
+        CompressNexus);
+    columns.group = "/" + nexusFile->entryName() + "/event_workspace";
+    m_eventColumns = Kernel::make_unique<EventColumns>(std::move(columns));
+    return;
+  }
+
   // Write out to the NXS file.
   nexusFile->writeNexusProcessedDataEventCombined(m_eventWorkspace, indices,
                                                   tofs, weights, errorSquareds,
                                                   pulsetimes, CompressNexus);
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Write the event columns left by execEvent(), if any. Each column is split
+ * into chunks that are compressed in parallel, while a single thread writes
+ * the chunks that are ready. This closes the NeXus file, it is opened again
+ * by the next call to NexusFileIO::openNexusWrite().
+ *
+ * @param nexusFile :: the file being written
+ */
+void SaveNexusProcessed::writeEventColumns(
+    Mantid::NeXus::NexusFileIO_sptr &nexusFile) {
+  if (!m_eventColumns)
+    return;
+  nexusFile->closeNexusFile();
 
-  // Free mem.
-  delete[] tofs;
-  delete[] weights;
-  delete[] errorSquareds;
-  delete[] pulsetimes;
+  H5::H5File file(m_filename, H5F_ACC_RDWR);
+  H5::Group group = file.openGroup(m_eventColumns->group);
+  const auto &columns = *m_eventColumns;
+  const size_t chunkLength = 1 << 18;
+  if (!columns.tofs.empty())
+    H5Util::writeArray1DParallel(group, "tof", columns.tofs.data(),
+                                 columns.tofs.size(), chunkLength);
+  if (!columns.pulsetimes.empty())
+    H5Util::writeArray1DParallel(group, "pulsetime", columns.pulsetimes.data(),
+                                 columns.pulsetimes.size(), chunkLength);
+  if (!columns.weights.empty())
+    H5Util::writeArray1DParallel(group, "weight", columns.weights.data(),
+                                 columns.weights.size(), chunkLength);
+  if (!columns.errorSquareds.empty())
+    H5Util::writeArray1DParallel(group, "error_squared",
+                                 columns.errorSquareds.data(),
+                                 columns.errorSquareds.size(), chunkLength);
+  group.close();
+  file.close();
+  m_eventColumns.reset();
 }
 
 //-----------------------------------------------------------------------------------------------
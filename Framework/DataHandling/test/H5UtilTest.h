@@ -172,6 +172,52 @@ public:
     removeFile(FILENAME);
   }
 
+  void test_array1d_parallel() {
+    const std::string FILENAME("H5UtilTest_array1d_parallel.h5");
+    const std::string GRP_NAME("array1d");
+    // Several batches of chunks, the last chunk is not full
+    std::vector<double> array1d_double(1000);
+    std::vector<int64_t> array1d_int64(1000);
+    for (size_t i = 0; i < array1d_double.size(); ++i) {
+      array1d_double[i] = 0.5 * static_cast<double>(i);
+      array1d_int64[i] = static_cast<int64_t>(i) * 1000000000000;
+    }
+    const std::vector<float> array1d_float = {0, 1, 2};
+
+    removeFile(FILENAME);
+
+    { // write tests
+      H5File file(FILENAME, H5F_ACC_EXCL);
+      auto group = H5Util::createGroupNXS(file, GRP_NAME, "NXentry");
+      H5Util::writeArray1DParallel(group, "array1d_double",
+                                   array1d_double.data(),
+                                   array1d_double.size(), 7);
+      H5Util::writeArray1DParallel(group, "array1d_int64", array1d_int64.data(),
+                                   array1d_int64.size(), 7, 6);
+      // Shorter than a chunk
+      H5Util::writeArray1DParallel(group, "array1d_float", array1d_float.data(),
+                                   array1d_float.size(), 7);
+      file.close();
+    }
+
+    { // read tests
+      H5File file(FILENAME, H5F_ACC_RDONLY);
+      auto group = file.openGroup(GRP_NAME);
+      TS_ASSERT_EQUALS(
+          H5Util::readArray1DCoerce<double>(group, "array1d_double"),
+          array1d_double);
+      TS_ASSERT_EQUALS(
+          H5Util::readArray1DCoerce<int64_t>(group, "array1d_int64"),
+          array1d_int64);
+      TS_ASSERT_EQUALS(H5Util::readArray1DCoerce<float>(group, "array1d_float"),
+                       array1d_float);
+      file.close();
+    }
+
+    // cleanup
+    removeFile(FILENAME);
+  }
+
 private:
   void do_assert_simple_string_data_set(
       const std::string &filename, const std::string &groupName,
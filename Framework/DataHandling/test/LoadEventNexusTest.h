@@ -13,6 +13,8 @@
 #include "MantidDataHandling/LoadEventNexus.h"
 #include <cxxtest/TestSuite.h>
 
+#include <functional>
+
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
@@ -56,6 +58,57 @@ private:
                      filteredLogEndTime.toSimpleString());
   }
 
+  /** Load bank36 of CNCS_7860 without the logs
+   * @param wsName :: name of the output workspace
+   * @param options :: sets any further properties of the algorithm
+   * @return the loaded workspace
+   */
+  EventWorkspace_sptr
+  loadBank(const std::string &wsName,
+           const std::function<void(LoadEventNexus &)> &options) {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", wsName);
+    ld.setPropertyValue("BankName", "bank36");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    options(ld);
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+    return AnalysisDataService::Instance().retrieveWS<EventWorkspace>(wsName);
+  }
+
+  /// Check that every spectrum holds the same events in the same order
+  void assertSameEvents(const EventWorkspace &ws1, const EventWorkspace &ws2) {
+    TS_ASSERT_EQUALS(ws1.getNumberEvents(), ws2.getNumberEvents());
+    TS_ASSERT_EQUALS(ws1.getNumberHistograms(), ws2.getNumberHistograms());
+    const size_t numHistograms =
+        std::min(ws1.getNumberHistograms(), ws2.getNumberHistograms());
+    for (size_t wi = 0; wi < numHistograms; ++wi) {
+      const auto &list1 = ws1.getSpectrum(wi);
+      const auto &list2 = ws2.getSpectrum(wi);
+      bool same = list1.getEventType() == list2.getEventType();
+      if (same) {
+        switch (list1.getEventType()) {
+        case TOF:
+          same = list1.getEvents() == list2.getEvents();
+          break;
+        case WEIGHTED:
+          same = list1.getWeightedEvents() == list2.getWeightedEvents();
+          break;
+        case WEIGHTED_NOTIME:
+          same = list1.getWeightedEventsNoTime() ==
+                 list2.getWeightedEventsNoTime();
+          break;
+        }
+      }
+      if (!same) {
+        TS_FAIL("Events differ in workspace index " + std::to_string(wi));
+        break;
+      }
+    }
+  }
+
 public:
   void test_SingleBank_PixelsOnlyInThatBank() { doTestSingleBank(true, false); }
 
@@ -122,6 +175,9 @@ public:
     // Memory used should be lower (or the same at worst)
     TS_ASSERT_LESS_THAN_EQUALS(WS2->getMemorySize(), WS->getMemorySize());
 
+    // Filling the precounted lists must keep the events in file order
+    assertSameEvents(*WS, *WS2);
+
     // Longer, more thorough test
     if (false) {
       IAlgorithm_sptr load =
@@ -521,6 +577,89 @@ public:
     doTestSingleBank(true, true);
   }
 
+  void test_SingleBank_read_in_slabs() {
+    Mantid::API::FrameworkManager::Instance();
+    auto slabsOf = [](size_t eventsPerSlab) {
+      return [eventsPerSlab](LoadEventNexus &ld) {
+        ld.setEventsPerSlab(eventsPerSlab);
+      };
+    };
+    EventWorkspace_sptr whole = loadBank("cncs_bank_whole", slabsOf(0));
+    EventWorkspace_sptr slabs = loadBank("cncs_bank_slabs", slabsOf(100));
+    TS_ASSERT(whole);
+    TS_ASSERT(slabs);
+    // The slabs are processed in file order
+    if (whole && slabs)
+      assertSameEvents(*whole, *slabs);
+    AnalysisDataService::Instance().remove("cncs_bank_whole");
+    AnalysisDataService::Instance().remove("cncs_bank_slabs");
+  }
+
+  void test_SingleBank_read_in_slabs_with_compression() {
+    Mantid::API::FrameworkManager::Instance();
+    auto compressed = [](size_t eventsPerSlab) {
+      return [eventsPerSlab](LoadEventNexus &ld) {
+        ld.setPropertyValue("CompressTolerance", "0.05");
+        ld.setEventsPerSlab(eventsPerSlab);
+      };
+    };
+    EventWorkspace_sptr whole = loadBank("cncs_bank_whole", compressed(0));
+    EventWorkspace_sptr slabs = loadBank("cncs_bank_slabs", compressed(100));
+    TS_ASSERT(whole);
+    TS_ASSERT(slabs);
+    if (!whole || !slabs)
+      return;
+
+    // The slabs are compressed once, after the last slab, so that they give
+    // the same weighted events as the whole bank
+    assertSameEvents(*whole, *slabs);
+    double totalWeight = 0.;
+    for (size_t wi = 0; wi < slabs->getNumberHistograms(); ++wi) {
+      const auto &slabsList = slabs->getSpectrum(wi);
+      if (slabsList.getNumberEvents() == 0)
+        continue;
+      if (slabsList.getEventType() != WEIGHTED_NOTIME) {
+        TS_FAIL("Events not compressed in workspace index " +
+                std::to_string(wi));
+        break;
+      }
+      for (const auto &event : slabsList.getWeightedEventsNoTime())
+        totalWeight += event.weight();
+    }
+    // Every event of the bank is kept, with unit weight
+    TS_ASSERT_DELTA(totalWeight, 7274., 1e-6);
+    AnalysisDataService::Instance().remove("cncs_bank_whole");
+    AnalysisDataService::Instance().remove("cncs_bank_slabs");
+  }
+
+  void test_SingleBank_parallel_scatter_matches_serial_fill() {
+    Mantid::API::FrameworkManager::Instance();
+    auto scattered = [](bool precount) {
+      return [precount](LoadEventNexus &ld) {
+        ld.setProperty<bool>("Precount", precount);
+        // Several small sub-ranges, well below the default threshold
+        ld.setScatterRanges(4, 100);
+      };
+    };
+    EventWorkspace_sptr serial =
+        loadBank("cncs_bank_serial", scattered(false));
+    EventWorkspace_sptr scatter =
+        loadBank("cncs_bank_scatter", scattered(true));
+    TS_ASSERT(serial);
+    TS_ASSERT(scatter);
+    if (!serial || !scatter)
+      return;
+
+    TS_ASSERT_EQUALS(serial->getNumberEvents(), 7274);
+    // Both fills keep the events of a pixel in file order
+    assertSameEvents(*serial, *scatter);
+    // The tof limits set the common bin edges
+    TS_ASSERT_EQUALS(serial->x(0).front(), scatter->x(0).front());
+    TS_ASSERT_EQUALS(serial->x(0).back(), scatter->x(0).back());
+    AnalysisDataService::Instance().remove("cncs_bank_serial");
+    AnalysisDataService::Instance().remove("cncs_bank_scatter");
+  }
+
   void test_SingleBank_ThatDoesntExist() {
     doTestSingleBank(false, false, "bankDoesNotExist", true);
   }
@@ -756,6 +895,14 @@ public:
     loader.setPropertyValue("OutputWorkspace", "ws");
     TS_ASSERT(loader.execute());
   }
+  void testLoadWithoutPrecount() {
+    LoadEventNexus loader;
+    loader.initialize();
+    loader.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    loader.setPropertyValue("Precount", "0");
+    loader.setPropertyValue("OutputWorkspace", "ws");
+    TS_ASSERT(loader.execute());
+  }
   void testDefaultLoadBankSplitting() {
     LoadEventNexus loader;
     loader.initialize();
@@ -763,6 +910,14 @@ public:
     loader.setPropertyValue("OutputWorkspace", "ws");
     TS_ASSERT(loader.execute());
   }
+  void testLoadBankSplittingWithoutPrecount() {
+    LoadEventNexus loader;
+    loader.initialize();
+    loader.setPropertyValue("Filename", "OFFSPEC00036416.nxs");
+    loader.setPropertyValue("Precount", "0");
+    loader.setPropertyValue("OutputWorkspace", "ws");
+    TS_ASSERT(loader.execute());
+  }
   void testPartialLoad() {
     LoadEventNexus loader;
     loader.initialize();
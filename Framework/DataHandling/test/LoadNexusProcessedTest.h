@@ -9,12 +9,14 @@
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidAPI/WorkspaceHistory.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/LazyWorkspace2D.h"
 #include "MantidDataObjects/PeakShapeSpherical.h"
 #include "MantidDataObjects/Peak.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidGeometry/IDTypes.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
+#include "MantidKernel/Timer.h"
 #include "MantidDataHandling/LoadNexusProcessed.h"
 #include "MantidDataHandling/SaveNexusProcessed.h"
 #include "MantidDataHandling/Load.h"
@@ -177,6 +179,36 @@ public:
     doSpectrumMinOrMaxTest(alg, 3);
   }
 
+  void testNexusProcessed_OnDemand() {
+    auto eagerWS = loadFocussed(false);
+    auto lazyWS = loadFocussed(true);
+    TS_ASSERT(boost::dynamic_pointer_cast<LazyWorkspace2D>(lazyWS));
+    TS_ASSERT(!boost::dynamic_pointer_cast<LazyWorkspace2D>(eagerWS));
+    compareData(*eagerWS, *lazyWS);
+  }
+
+  void testNexusProcessed_OnDemand_Min_Max_List() {
+    auto eagerWS = loadFocussed(false, "SpectrumMin", "2", "SpectrumMax", "3",
+                                "SpectrumList", "6,1");
+    auto lazyWS = loadFocussed(true, "SpectrumMin", "2", "SpectrumMax", "3",
+                               "SpectrumList", "6,1");
+    TS_ASSERT_EQUALS(lazyWS->getNumberHistograms(), 4);
+    compareData(*eagerWS, *lazyWS);
+  }
+
+  void testNexusProcessed_OnDemand_cache_is_bounded() {
+    auto lazyWS = boost::dynamic_pointer_cast<LazyWorkspace2D>(
+        loadFocussed(true, "OnDemandCacheSize", "1"));
+    TS_ASSERT(lazyWS);
+    if (!lazyWS)
+      return;
+    const MatrixWorkspace &ws = *lazyWS;
+    for (size_t i = 0; i < ws.getNumberHistograms(); ++i)
+      ws.histogram(i);
+    TS_ASSERT_LESS_THAN_EQUALS(lazyWS->numberOfResidentSpectra(),
+                               lazyWS->cacheSize());
+  }
+
   // Saving and reading masking correctly
   void testMasked() {
     LoadNexusProcessed alg;
@@ -233,14 +265,14 @@ public:
       Poco::File(filename).remove();
   }
 
-  void dotest_LoadAnEventFile(EventType type) {
+  void dotest_LoadAnEventFile(EventType type, bool compress = false) {
     std::string filename_root = "LoadNexusProcessed_ExecEvent_";
 
     // Call a function that writes out the file
     std::string outputFile;
     EventWorkspace_sptr origWS =
         SaveNexusProcessedTest::do_testExec_EventWorkspaces(
-            filename_root, type, outputFile, false, false);
+            filename_root, type, outputFile, false, false, true, compress);
 
     LoadNexusProcessed alg;
     TS_ASSERT_THROWS_NOTHING(alg.initialize());
@@ -309,6 +341,18 @@ public:
     dotest_LoadAnEventFile(WEIGHTED_NOTIME);
   }
 
+  void test_LoadEventNexus_TOF_compressed() {
+    dotest_LoadAnEventFile(TOF, true);
+  }
+
+  void test_LoadEventNexus_WEIGHTED_compressed() {
+    dotest_LoadAnEventFile(WEIGHTED, true);
+  }
+
+  void test_LoadEventNexus_WEIGHTED_NOTIME_compressed() {
+    dotest_LoadAnEventFile(WEIGHTED_NOTIME, true);
+  }
+
   void test_loadEventNexus_Min() {
     writeTmpEventNexus();
 
@@ -1150,6 +1194,40 @@ private:
     TS_ASSERT_EQUALS(ews->getHistory().size(), nHistory);
   }
 
+  /// Load focussed.nxs with the given pairs of property names and values
+  template <typename... T>
+  MatrixWorkspace_sptr loadFocussed(const bool onDemand,
+                                    const T &... properties) {
+    LoadNexusProcessed alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setPropertyValue("Filename", "focussed.nxs");
+    alg.setPropertyValue("OutputWorkspace", "dummy");
+    alg.setProperty("OnDemand", onDemand);
+    const std::vector<std::string> values{properties...};
+    for (size_t i = 0; i + 1 < values.size(); i += 2)
+      alg.setPropertyValue(values[i], values[i + 1]);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    Workspace_sptr ws = alg.getProperty("OutputWorkspace");
+    return boost::dynamic_pointer_cast<MatrixWorkspace>(ws);
+  }
+
+  /// Compare the spectra through const access, as done when plotting
+  void compareData(const MatrixWorkspace &expected,
+                   const MatrixWorkspace &actual) {
+    TS_ASSERT_EQUALS(actual.getNumberHistograms(),
+                     expected.getNumberHistograms());
+    TS_ASSERT_EQUALS(actual.blocksize(), expected.blocksize());
+    TS_ASSERT_EQUALS(actual.isDistribution(), expected.isDistribution());
+    for (size_t i = 0; i < expected.getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(actual.getSpectrum(i).getSpectrumNo(),
+                       expected.getSpectrum(i).getSpectrumNo());
+      TS_ASSERT_EQUALS(actual.x(i).rawData(), expected.x(i).rawData());
+      TS_ASSERT_EQUALS(actual.y(i).rawData(), expected.y(i).rawData());
+      TS_ASSERT_EQUALS(actual.e(i).rawData(), expected.e(i).rawData());
+    }
+  }
+
   /*
    * Does a few common checks for using a single spectra property
    * such as spectrumMin or spectrumMax. Expects the algorithm
@@ -1444,6 +1522,53 @@ public:
     loader.setPropertyValue("OutputWorkspace", "ws");
     TS_ASSERT(loader.execute());
   }
+
+  void testHistogramWorkspaceOnDemand() {
+    LoadNexusProcessed loader;
+    loader.initialize();
+    loader.setPropertyValue("Filename", "PG3_733_focussed.nxs");
+    loader.setPropertyValue("OutputWorkspace", "ws");
+    loader.setProperty("OnDemand", true);
+    TS_ASSERT(loader.execute());
+    // Time to first plot
+    auto ws = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("ws");
+    TS_ASSERT_LESS_THAN(0, ws->y(0).size());
+    AnalysisDataService::Instance().remove("ws");
+  }
+
+  void testCompressedEventWorkspaceRoundTrip() {
+    const std::string filename = "LoadNexusProcessedTestPerformance.nxs";
+    // 20 million events
+    auto inputWS =
+        WorkspaceCreationHelper::createEventWorkspace(2000, 100, 10000);
+
+    Mantid::Kernel::Timer timer;
+    SaveNexusProcessed saver;
+    saver.initialize();
+    saver.setProperty<Workspace_sptr>("InputWorkspace", inputWS);
+    saver.setPropertyValue("Filename", filename);
+    saver.setProperty("CompressNexus", true);
+    TS_ASSERT(saver.execute());
+    const std::string savedFile = saver.getPropertyValue("Filename");
+    const double saveTime = timer.elapsed();
+
+    LoadNexusProcessed loader;
+    loader.initialize();
+    loader.setPropertyValue("Filename", savedFile);
+    loader.setPropertyValue("OutputWorkspace", "ws");
+    TS_ASSERT(loader.execute());
+    const double loadTime = timer.elapsed();
+
+    auto outputWS =
+        AnalysisDataService::Instance().retrieveWS<EventWorkspace>("ws");
+    TS_ASSERT_EQUALS(outputWS->getNumberEvents(), inputWS->getNumberEvents());
+    std::cout << "Saved " << inputWS->getNumberEvents() << " events in "
+              << saveTime << " s, loaded them in " << loadTime << " s\n";
+
+    AnalysisDataService::Instance().remove("ws");
+    if (Poco::File(savedFile).exists())
+      Poco::File(savedFile).remove();
+  }
 };
 
 #endif /*LOADNEXUSPROCESSEDTESTRAW_H_*/
@@ -6,8 +6,13 @@
 #include "MantidKernel/DiskBuffer.h"
 #include <nexus/NeXusFile.hpp>
 
+#include <memory>
 #include <mutex>
 
+namespace Poco {
+class SharedMemory;
+}
+
 namespace Mantid {
 namespace DataObjects {
 
@@ -62,6 +67,12 @@ public:
   void loadBlock(std::vector<double> & /* Block */,
                  const uint64_t /*blockPosition*/,
                  const size_t /*BlockSize*/) const override;
+  bool getMappedBlock(const float *& /* Block */,
+                      const uint64_t /*blockPosition*/,
+                      const size_t /*BlockSize*/) const override;
+  bool getMappedBlock(const double *& /* Block */,
+                      const uint64_t /*blockPosition*/,
+                      const size_t /*BlockSize*/) const override;
 
   void flushData() const override;
   void closeFile() override;
@@ -72,6 +83,15 @@ public:
   void setDataType(const size_t blockSize,
                    const std::string &typeName) override;
   void getDataType(size_t &CoordSize, std::string &typeName) const override;
+  /// Memory-map the events of files opened read-only, if possible
+  void setMemoryMapped(bool memoryMapped) { m_MemoryMapped = memoryMapped; }
+  ///@return true if the events of the opened file are memory-mapped
+  bool isMemoryMapped() const { return m_MappedEvents != nullptr; }
+  /// Store the events of a newly created file contiguously, with a fixed
+  /// number of events, so that the file can be memory-mapped when read
+  void setContiguousFileLength(uint64_t nEvents) {
+    m_ContiguousLength = nEvents;
+  }
   //------------------------------------------------------------------------------------------------------------------------
   // Auxiliary functions (non-virtual, used for testing)
   int64_t getNDataColums() const { return m_BlockSize[1]; }
@@ -105,6 +125,14 @@ private:
   std::vector<int64_t> m_BlockSize;
   /// lock Nexus file operations as Nexus is not thread safe
   mutable std::mutex m_fileMutex;
+  /// memory-map the events of read-only files if possible
+  bool m_MemoryMapped;
+  /// the number of events of a contiguous event data set, 0 if extendible
+  uint64_t m_ContiguousLength;
+  /// the file mapped into memory
+  std::unique_ptr<Poco::SharedMemory> m_MappedFile;
+  /// the start of the mapped event data, nullptr if not mapped
+  const char *m_MappedEvents;
 
   // Mainly static information which may be split into different IO classes
   // selected through chein of responsibility.
@@ -142,6 +170,7 @@ private:
   void getDiskBufferFileData();
   void prepareNxSToWrite_CurVersion();
   void prepareNxSdata_CurVersion();
+  void mapEventData();
   // get the event type from event name
   static EventType
   TypeFromString(const std::vector<std::string> &typesSupported,
@@ -161,6 +190,9 @@ private:
   template <typename Type>
   void loadGenericBlock(std::vector<Type> &Block, const uint64_t blockPosition,
                         const size_t nPoints) const;
+  template <typename Type>
+  bool getMappedGenericBlock(const Type *&Block, const uint64_t blockPosition,
+                             const size_t nPoints) const;
 };
 }
 }
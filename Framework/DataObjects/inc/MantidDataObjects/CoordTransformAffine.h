@@ -48,6 +48,8 @@ public:
                           const Mantid::Kernel::VMD &scaling);
 
   void apply(const coord_t *inputVector, coord_t *outVector) const override;
+  void applyBatch(const coord_t *inputVectors, size_t inputStride,
+                  size_t numVectors, coord_t *outVectors) const override;
 
   static CoordTransformAffine *combineTransformations(CoordTransform *first,
                                                       CoordTransform *second);
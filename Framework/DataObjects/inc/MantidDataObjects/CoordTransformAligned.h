@@ -66,6 +66,8 @@ public:
   std::string toXMLString() const override;
   std::string id() const override;
   void apply(const coord_t *inputVector, coord_t *outVector) const override;
+  void applyBatch(const coord_t *inputVectors, size_t inputStride,
+                  size_t numVectors, coord_t *outVectors) const override;
   Mantid::Kernel::Matrix<coord_t> makeAffineMatrix() const override;
 
 protected:
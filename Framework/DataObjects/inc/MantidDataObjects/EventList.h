@@ -117,6 +117,7 @@ public:
   inline void addEventQuickly(const TofEvent &event) {
     this->events.push_back(event);
     this->order = UNSORTED;
+    ++m_version;
   }
 
   // --------------------------------------------------------------------------
@@ -127,6 +128,7 @@ public:
   inline void addEventQuickly(const WeightedEvent &event) {
     this->weightedEvents.push_back(event);
     this->order = UNSORTED;
+    ++m_version;
   }
 
   // --------------------------------------------------------------------------
@@ -137,6 +139,7 @@ public:
   inline void addEventQuickly(const WeightedEventNoTime &event) {
     this->weightedEventsNoTime.push_back(event);
     this->order = UNSORTED;
+    ++m_version;
   }
 
   Mantid::API::EventType getEventType() const override;
@@ -163,16 +166,16 @@ public:
 
   void reserve(size_t num) override;
 
-  void sort(const EventSortType order) const;
+  void sort(const EventSortType order, const size_t numThreads = 1) const;
 
   void setSortOrder(const EventSortType order) const;
 
-  void sortTof() const;
+  void sortTof(const size_t numThreads = 1) const;
   void sortTof2() const;
   void sortTof4() const;
 
-  void sortPulseTime() const;
-  void sortPulseTimeTOF() const;
+  void sortPulseTime(const size_t numThreads = 1) const;
+  void sortPulseTimeTOF(const size_t numThreads = 1) const;
   void sortTimeAtSample(const double &tofFactor, const double &tofShift,
                         bool forceResort = false) const;
 
@@ -313,6 +316,16 @@ public:
   void splitByPulseTime(Kernel::TimeSplitterType &splitter,
                         std::map<int, EventList *> outputs) const;
 
+  /// Split events by full time into one output per destination
+  void splitByFullTime(const Kernel::SplitterIndex &splitter,
+                       const std::vector<EventList *> &outputs,
+                       bool docorrection, double toffactor,
+                       double tofshift) const;
+
+  /// Split events by pulse time into one output per destination
+  void splitByPulseTime(const Kernel::SplitterIndex &splitter,
+                        const std::vector<EventList *> &outputs) const;
+
   void multiply(const double value, const double error = 0.0) override;
   EventList &operator*=(const double value);
 
@@ -361,6 +374,9 @@ private:
   }
   HistogramData::Histogram &mutableHistogramRef() override;
 
+  void cachedHistogram(Kernel::cow_ptr<HistogramData::HistogramY> &yData,
+                       Kernel::cow_ptr<HistogramData::HistogramE> &eData) const;
+
   /// Histogram object holding the histogram data. Currently only X.
   HistogramData::Histogram m_histogram;
 
@@ -385,6 +401,11 @@ private:
   /// Mutex that is locked while sorting an event list
   mutable std::mutex m_sortMutex;
 
+  /// Modification counter, incremented whenever the events or the X binning
+  /// change. Cached histograms are only valid for the version they were made
+  /// from.
+  std::size_t m_version{0};
+
   template <class T>
   static typename std::vector<T>::const_iterator
   findFirstEvent(const std::vector<T> &events, const double seek_tof);
@@ -494,6 +515,12 @@ private:
   void splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
                               std::map<int, EventList *> outputs,
                               typename std::vector<T> &events) const;
+  template <class T, class TimeFunction>
+  void splitByIndexHelper(const Kernel::SplitterIndex &splitter,
+                          const std::vector<EventList *> &outputs,
+                          const std::vector<T> &events,
+                          TimeFunction eventTime) const;
+  void prepareSplitOutputs(const std::vector<EventList *> &outputs) const;
   template <class T>
   std::string splitByFullTimeVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
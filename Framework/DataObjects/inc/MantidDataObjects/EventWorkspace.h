@@ -124,6 +124,10 @@ public:
 
   void clearMRU() const override;
 
+  std::size_t histogramCacheHits() const;
+  std::size_t histogramCacheMisses() const;
+  std::size_t histogramCacheMemory() const;
+
   EventSortType getSortType() const;
 
   // Sort all event lists. Uses a parallelized algorithm
@@ -2,54 +2,47 @@
 #define MANTID_DATAOBJECTS_EVENTWORKSPACEMRU_H_
 
 #include "MantidKernel/System.h"
-#include "MantidKernel/Exception.h"
 #include "MantidKernel/cow_ptr.h"
-#include "MantidKernel/MRUList.h"
 #include "MantidHistogramData/HistogramY.h"
 #include "MantidHistogramData/HistogramE.h"
+#include <atomic>
 #include <cstdint>
-#include <vector>
+#include <limits>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace Mantid {
 namespace DataObjects {
 
 class EventList;
 
-//============================================================================
-//============================================================================
-/**
- * This little class holds data and an index marker that is used for uniqueness.
- * This is used in the MRUList.
- */
-template <class T> class TypeWithMarker {
-public:
-  /**
-   * Constructor.
-   * @param the_index :: unique index into the workspace of this data
-   */
-  TypeWithMarker(const uintptr_t the_index) : m_index(the_index) {}
-  TypeWithMarker(const TypeWithMarker &other) = delete;
-  TypeWithMarker &operator=(const TypeWithMarker &other) = delete;
-
-public:
-  /// Unique index value.
-  uintptr_t m_index;
-
-  /// Pointer to a vector of data
-  T m_data;
-
-  /// Function returns a unique index, used for hashing for MRU list
-  uintptr_t hashIndexFunction() const { return m_index; }
-
-  /// Set the unique index value.
-  void setIndex(const uintptr_t the_index) { m_index = the_index; }
-};
-
-//============================================================================
-//============================================================================
-/** This is a container for the MRU (most-recently-used) list
- * of generated histograms.
+/** This is a container for the histograms generated from the event lists of
+ * an EventWorkspace.
+ *
+ * The cache is a least-recently-used list, split into shards by event list
+ * so that threads working on different spectra rarely wait for each other.
+ * Its size is bounded by a memory budget rather than by a number of entries.
+ * The caches of all EventWorkspaces share one budget, read once from the
+ * "EventWorkspace.HistogramCacheMB" configuration key, and evict the least
+ * recently used entries across all of them. Each entry records the
+ * modification counter of its EventList and the X binning it was generated
+ * with, so that entries which are still valid survive between algorithms and
+ * stale entries are never returned.
+ *
+ * The counter is bumped by every EventList method that modifies the events or
+ * hands out a non-const reference to them. Events written through such a
+ * reference after a histogram has been read are not noticed, so algorithms
+ * doing that (e.g. UnaryOperation, CorrectKiKf, He3TubeEfficiency,
+ * DiffractionFocussing2 and the PreNexus loaders) still call
+ * IEventWorkspace::clearMRU() once they are done.
+ *
+ * Every thread also keeps the last histograms it was handed alive (50 per
+ * thread), so that references returned by EventList::y() and EventList::e()
+ * remain valid while the thread works on them, even if another thread evicts
+ * their entries.
 
   Copyright &copy; 2011-2 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
  National Laboratory & European Spallation Source
@@ -72,45 +65,102 @@ public:
   File change history is stored at: <https://github.com/mantidproject/mantid>
   Code Documentation is available at: <http://doxygen.mantidproject.org>
 */
+
 class DLLExport EventWorkspaceMRU {
 public:
   using YType = Kernel::cow_ptr<HistogramData::HistogramY>;
   using EType = Kernel::cow_ptr<HistogramData::HistogramE>;
-  using YWithMarker = TypeWithMarker<YType>;
-  using EWithMarker = TypeWithMarker<EType>;
-  // Typedef for a Most-Recently-Used list of Data objects.
-  using mru_listY = Kernel::MRUList<YWithMarker>;
-  using mru_listE = Kernel::MRUList<EWithMarker>;
 
+  EventWorkspaceMRU();
+  EventWorkspaceMRU(size_t memoryLimit, size_t minimumEntries,
+                    size_t numberOfShards = 1);
   ~EventWorkspaceMRU();
 
-  void ensureEnoughBuffersY(size_t thread_num) const;
-  void ensureEnoughBuffersE(size_t thread_num) const;
-
-  void clear();
-
-  YType findY(size_t thread_num, const EventList *index);
-  EType findE(size_t thread_num, const EventList *index);
-  void insertY(size_t thread_num, YType data, const EventList *index);
-  void insertE(size_t thread_num, EType data, const EventList *index);
-
+  bool find(const EventList *index, size_t version, const void *x, YType &y,
+            EType &e);
+  void insert(const EventList *index, size_t version, const void *x, YType &y,
+              EType &e);
   void deleteIndex(const EventList *index);
+  void clear();
 
-  /** Return how many entries in the Y MRU list are used.
-   * Only used in tests. It only returns the 0-th MRU list size.
-   * @return :: number of entries in the MRU list. */
-  size_t MRUSize() const { return this->m_bufferedDataY[0]->size(); }
-
-protected:
-  /// The most-recently-used list of dataY histograms
-  mutable std::vector<mru_listY *> m_bufferedDataY;
-
-  /// The most-recently-used list of dataE histograms
-  mutable std::vector<mru_listE *> m_bufferedDataE;
-
-  /// Mutex when adding entries in the MRU list
-  mutable std::mutex m_changeMruListsMutexE;
-  mutable std::mutex m_changeMruListsMutexY;
+  void copyEntries(const EventWorkspaceMRU &other,
+                   const std::vector<EventList *> &otherIndices,
+                   const std::vector<EventList *> &indices);
+
+  void setMemoryLimit(size_t memoryLimit);
+  size_t memoryLimit() const;
+
+  size_t MRUSize() const;
+  size_t memorySize() const;
+  size_t totalMemorySize() const;
+  /// @return the number of histograms found in the cache
+  size_t hits() const { return m_hits; }
+  /// @return the number of histograms that had to be generated
+  size_t misses() const { return m_misses; }
+
+private:
+  /// A cached histogram of one event list
+  struct Entry {
+    const EventList *index;
+    /// Modification counter of the event list when the entry was made
+    size_t version;
+    /// Identity of the X binning the histogram was generated with
+    const void *x;
+    YType y;
+    EType e;
+    /// Memory used by y and e
+    size_t bytes;
+    /// Time of the last use, in ticks of the clock of the budget
+    uint64_t lastUsed;
+  };
+
+  /// Part of the cache with its own lock, holding the entries of a subset of
+  /// the event lists
+  struct Shard {
+    /// Entries, most recently used first
+    std::list<Entry> entries;
+    /// Position of the entry of each event list in entries
+    std::unordered_map<const EventList *, std::list<Entry>::iterator> lookup;
+    /// Memory used by all entries in bytes
+    size_t memorySize{0};
+    /// Last use of the least recently used entry that may be evicted, so that
+    /// the budget can find it without taking the mutex
+    std::atomic<uint64_t> oldest{std::numeric_limits<uint64_t>::max()};
+    /// Mutex guarding the entries
+    std::mutex mutex;
+  };
+
+  /// Histograms recently handed out to one thread
+  struct Pins {
+    std::vector<std::pair<YType, EType>> histograms;
+    /// Position of the next histogram to replace
+    size_t next{0};
+    std::mutex mutex;
+  };
+
+  struct Budget;
+
+  EventWorkspaceMRU(std::shared_ptr<Budget> budget, size_t minimumEntries,
+                    size_t numberOfShards);
+  static std::shared_ptr<Budget> sharedBudget();
+
+  Shard &shardOf(const EventList *index) const;
+  void addEntry(Shard &shard, Entry entry);
+  void removeEntry(Shard &shard, std::list<Entry>::iterator entry);
+  void updateOldest(Shard &shard);
+  void evict();
+  void pin(const YType &y, const EType &e);
+
+  /// Shards of the cache
+  std::vector<std::unique_ptr<Shard>> m_shards;
+  /// Histograms kept alive for each thread
+  std::vector<std::unique_ptr<Pins>> m_pins;
+  /// Memory budget, shared with the other caches using it
+  std::shared_ptr<Budget> m_budget;
+  /// Number of entries of each shard that are kept irrespective of the budget
+  size_t m_minimumEntries;
+  std::atomic<size_t> m_hits{0};
+  std::atomic<size_t> m_misses{0};
 };
 
 } // namespace DataObjects
@@ -44,7 +44,7 @@ public:
   Histogram1D(Histogram1D &&) = default;
   Histogram1D(const ISpectrum &other);
 
-  Histogram1D &operator=(const Histogram1D &) = default;
+  Histogram1D &operator=(const Histogram1D &rhs);
   Histogram1D &operator=(Histogram1D &&) = default;
   Histogram1D &operator=(const ISpectrum &rhs);
 
@@ -84,7 +84,7 @@ public:
             sizeof(double));
   }
 
-private:
+protected:
   const HistogramData::Histogram &histogramRef() const override {
     return m_histogram;
   }
@@ -0,0 +1,137 @@
+#ifndef MANTID_DATAOBJECTS_LAZYWORKSPACE2D_H_
+#define MANTID_DATAOBJECTS_LAZYWORKSPACE2D_H_
+
+#include "MantidDataObjects/Workspace2D.h"
+
+#include <list>
+#include <mutex>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** LazyWorkspace2D : A Workspace2D whose X, Y, E and Dx data are read from a
+  file when they are first accessed, rather than when it is created.
+
+  The workspace is set up like any other Workspace2D, i.e. the axes,
+  instrument, logs and spectrum numbers are filled in eagerly, and behaves
+  like one until setLoader() is called. From then on the data of a spectrum
+  are read through the SpectrumLoader on the first access to them, e.g.
+  through x(), y(), e() or histogram(). Accessing the spectrum numbers,
+  detector IDs or other metadata of a spectrum does not read its data.
+
+  Spectra handed out as copies, through histogram(), sharedY() or sharedE(),
+  are kept in a cache holding the given number of the most recently used
+  spectra. When it is full the least recently used spectrum falls back to
+  placeholder data and is read again on its next access. The callers own
+  their copies, so eviction never invalidates them. Spectra accessed through
+  references, e.g. x(), y(), e() or readX(), and spectra whose data are
+  written, e.g. through mutableY() or setHistogram(), stay resident for the
+  lifetime of the workspace, so references remain valid as long as for any
+  Workspace2D.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport LazyWorkspace2D : public Workspace2D {
+public:
+  /// Reads the data of a spectrum on demand
+  class DLLExport SpectrumLoader {
+  public:
+    virtual ~SpectrumLoader() = default;
+    /** Set the X, Y, E and Dx data of a spectrum. Calls are serialized by
+     * the workspace.
+     * @param index :: The workspace index of the spectrum
+     * @param spectrum :: The spectrum to fill, holding placeholder data of
+     * the right size
+     */
+    virtual void load(const size_t index, Histogram1D &spectrum) = 0;
+  };
+
+  LazyWorkspace2D() = default;
+  LazyWorkspace2D &operator=(const LazyWorkspace2D &other) = delete;
+
+  /// Returns a clone of the workspace
+  std::unique_ptr<LazyWorkspace2D> clone() const {
+    return std::unique_ptr<LazyWorkspace2D>(doClone());
+  }
+
+  void setLoader(boost::shared_ptr<SpectrumLoader> loader,
+                 const size_t cacheSize);
+  /// The maximum number of spectra kept in the cache
+  size_t cacheSize() const { return m_cacheSize; }
+  bool isResident(const size_t index) const;
+  size_t numberOfResidentSpectra() const;
+
+  std::size_t blocksize() const override;
+  size_t getMemorySize() const override;
+
+protected:
+  /// Protected copy constructor. May be used by childs for cloning.
+  LazyWorkspace2D(const LazyWorkspace2D &other);
+
+  void init(const std::size_t &NVectors, const std::size_t &XLength,
+            const std::size_t &YLength) override;
+
+private:
+  LazyWorkspace2D(const LazyWorkspace2D &other,
+                  std::unique_lock<std::mutex> &&lock);
+  LazyWorkspace2D *doClone() const override {
+    return new LazyWorkspace2D(*this);
+  }
+
+  class LazySpectrum;
+
+  enum class State : char { Unloaded, Cached, Resident };
+
+  void makeSpectraLazy();
+  LazySpectrum &lazySpectrum(const size_t index) const;
+  void makeResident(const size_t index, const bool replace) const;
+  HistogramData::Histogram copy(const size_t index) const;
+  void load(const size_t index) const;
+  void evict(const size_t index) const;
+
+  /// Reads the data, shared with the clones of this workspace
+  boost::shared_ptr<SpectrumLoader> m_loader;
+  /// The maximum number of spectra in the cache
+  size_t m_cacheSize{0};
+  /// The placeholder data of the spectra that are not resident
+  Kernel::cow_ptr<HistogramData::HistogramX> m_unloadedX{nullptr};
+  Kernel::cow_ptr<HistogramData::HistogramY> m_unloadedY{nullptr};
+  Kernel::cow_ptr<HistogramData::HistogramE> m_unloadedE{nullptr};
+  /// The state of each spectrum
+  mutable std::vector<State> m_state;
+  /// The cached spectra, most recently used first
+  mutable std::list<size_t> m_cache;
+  /// The position of each cached spectrum in m_cache
+  mutable std::vector<std::list<size_t>::iterator> m_cachePosition;
+  /// The number of spectra that stay resident
+  mutable size_t m_numberResident{0};
+  /// Guards the loader and the cache
+  mutable std::mutex m_mutex;
+};
+
+/// shared pointer to the LazyWorkspace2D class
+typedef boost::shared_ptr<LazyWorkspace2D> LazyWorkspace2D_sptr;
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_LAZYWORKSPACE2D_H_ */
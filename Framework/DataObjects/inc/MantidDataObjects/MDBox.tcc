@@ -874,6 +874,13 @@ TMDE(void MDBox)::loadAndAddFrom(API::IBoxControllerIO *const FileSaver,
 
   std::lock_guard<std::mutex> _lock(this->m_dataMutex);
 
+  // Memory-mapped files are parsed in place, without reading into a buffer
+  const coord_t *mappedData(nullptr);
+  if (FileSaver->getMappedBlock(mappedData, filePosition, nEvents)) {
+    MDE::dataToEvents(mappedData, nEvents, data, false);
+    return;
+  }
+
   std::vector<coord_t> TableData;
   FileSaver->loadBlock(TableData, filePosition, nEvents);
 
@@ -233,6 +233,23 @@ public:
                                   "lean events, suspected column data for "
                                   "different dimensions/(type of) events "));
 
+    dataToEvents(data.data(), numEvents, events, reserveMemory);
+  }
+
+  /* static method used to convert a block of data, e.g. in a memory-mapped
+   file, into vector of events
+   @param data    -- pointer to the events coordinates, their signal and error
+   casted to coord_t type
+   @param numEvents -- number of events in the block
+   @param events    -- vector of events
+   @param reserveMemory -- reserve memory for events copying. Set to false if
+   one wants to add new events to the existing one.
+  */
+  static inline void dataToEvents(const coord_t *data, size_t numEvents,
+                                  std::vector<MDEvent<nd>> &events,
+                                  bool reserveMemory = true) {
+    // Number of columns = number of dimensions + 4 (signal/error)+detId+runID
+    const size_t numColumns = (nd + 4);
     if (reserveMemory) // Reserve the amount of space needed. Significant speed
                        // up (~30% thanks to this)
     {
@@ -5,13 +5,23 @@
 #include "MantidDataObjects/MDBoxFlatTree.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/make_unique.h"
 #include "MantidAPI/FileFinder.h"
 #include "MantidDataObjects/MDEvent.h"
 
+#include <H5Cpp.h>
+#include <Poco/File.h>
+#include <Poco/SharedMemory.h>
+
 #include <string>
 
 namespace Mantid {
 namespace DataObjects {
+namespace {
+/// static logger
+Kernel::Logger g_log("BoxControllerNeXusIO");
+}
 // Default headers(attributes) describing the contents of the data, written by
 // this class
 const char *EventHeaders[] = {
@@ -26,7 +36,9 @@ std::string BoxControllerNeXusIO::g_DBDataName("free_space_blocks");
 */
 BoxControllerNeXusIO::BoxControllerNeXusIO(API::BoxController *const bc)
     : m_File(nullptr), m_ReadOnly(true), m_dataChunk(DATA_CHUNK), m_bc(bc),
-      m_BlockStart(2, 0), m_BlockSize(2, 0), m_CoordSize(sizeof(coord_t)),
+      m_BlockStart(2, 0), m_BlockSize(2, 0), m_MemoryMapped(false),
+      m_ContiguousLength(0), m_MappedEvents(nullptr),
+      m_CoordSize(sizeof(coord_t)),
       m_EventType(FatEvent), m_EventsVersion("1.0"),
       m_ReadConversion(noConversion) {
   m_BlockSize[1] = 4 + m_bc->getNDims();
@@ -138,6 +150,10 @@ bool BoxControllerNeXusIO::openFile(const std::string &fileName,
       throw Kernel::Exception::FileError("Can not open file to read ",
                                          m_fileName);
   }
+  // HDF5 has to locate the events before NeXus opens the file
+  if (m_ReadOnly && m_MemoryMapped)
+    mapEventData();
+
   int nDims = static_cast<int>(this->m_bc->getNDims());
 
   bool group_exists;
@@ -213,17 +229,21 @@ void BoxControllerNeXusIO::prepareNxSToWrite_CurVersion() {
     // Prepare the event data array for writing operations:
     m_BlockSize[0] = NX_UNLIMITED;
 
-    // Now the chunk size.
-    std::vector<int64_t> chunk(m_BlockSize);
-    chunk[0] = static_cast<int64_t>(m_dataChunk);
-
-    // Make and open the data
-    if (m_CoordSize == 4)
-      m_File->makeCompData("event_data", ::NeXus::FLOAT32, m_BlockSize,
-                           ::NeXus::NONE, chunk, true);
-    else
-      m_File->makeCompData("event_data", ::NeXus::FLOAT64, m_BlockSize,
-                           ::NeXus::NONE, chunk, true);
+    const auto type = m_CoordSize == 4 ? ::NeXus::FLOAT32 : ::NeXus::FLOAT64;
+    if (m_ContiguousLength > 0) {
+      // A fixed size and no chunking makes HDF5 store the events in one
+      // contiguous block, which can be memory-mapped when reading.
+      m_BlockSize[0] = static_cast<int64_t>(m_ContiguousLength);
+      m_File->makeData("event_data", type, m_BlockSize, true);
+    } else {
+      // Now the chunk size.
+      std::vector<int64_t> chunk(m_BlockSize);
+      chunk[0] = static_cast<int64_t>(m_dataChunk);
+
+      // Make and open the data
+      m_File->makeCompData("event_data", type, m_BlockSize, ::NeXus::NONE,
+                           chunk, true);
+    }
 
     // A little bit of description for humans to read later
     m_File->putAttr("description", m_EventsTypeHeaders[m_EventType]);
@@ -289,6 +309,43 @@ void BoxControllerNeXusIO::prepareNxSdata_CurVersion() {
   uint64_t nFilePoints = info.dims[0];
   this->setFileLength(nFilePoints);
 }
+/** Map the events of the file into memory. This is only possible if HDF5
+ * stores them contiguously and in the format of the requested event
+ * coordinates; otherwise the events are read through NeXus as usual.
+ * Has to be called before NeXus opens the file. */
+void BoxControllerNeXusIO::mapEventData() {
+  haddr_t offset = HADDR_UNDEF;
+  try {
+    // NeXus opens files with a strong close degree, which has to match
+    H5::FileAccPropList access;
+    access.setFcloseDegree(H5F_CLOSE_STRONG);
+    H5::H5File file(m_fileName, H5F_ACC_RDONLY,
+                    H5::FileCreatPropList::DEFAULT, access);
+    H5::DataSet data = file.openDataSet("/MDEventWorkspace/" +
+                                        g_EventGroupName + "/event_data");
+    const H5::PredType &nativeType = m_CoordSize == 4
+                                         ? H5::PredType::NATIVE_FLOAT
+                                         : H5::PredType::NATIVE_DOUBLE;
+    if (data.getDataType() == nativeType)
+      offset = data.getOffset();
+  } catch (H5::Exception &) {
+    // Not an event file we can map, NeXus will report any real problem
+  }
+
+  if (offset == HADDR_UNDEF || offset % m_CoordSize != 0) {
+    g_log.warning() << "The events in " << m_fileName
+                    << " are not stored contiguously and can not be "
+                       "memory-mapped. Save the workspace with SaveMD "
+                       "MemoryMappable to make them mappable.\n";
+    return;
+  }
+  m_MappedFile = Kernel::make_unique<Poco::SharedMemory>(
+      Poco::File(m_fileName), Poco::SharedMemory::AM_READ);
+  m_MappedEvents = m_MappedFile->begin() + offset;
+  g_log.information() << "Memory-mapped the events in " << m_fileName
+                      << "\n";
+}
+
 /** Load free space blocks from the data file or create the NeXus place to
  * read/write them*/
 void BoxControllerNeXusIO::getDiskBufferFileData() {
@@ -454,6 +511,49 @@ void BoxControllerNeXusIO::loadBlock(std::vector<double> &Block,
   }
 }
 
+/** Get a pointer to a data block in the memory-mapped file
+  *@param Block         -- set to the start of the block
+  *@param blockPosition -- The starting place of the block
+  *@param nPoints       -- number of data points (events) in the block
+
+  *@returns false if the file is not mapped or has a different data type
+*/
+template <typename Type>
+bool BoxControllerNeXusIO::getMappedGenericBlock(const Type *&Block,
+                                                 const uint64_t blockPosition,
+                                                 const size_t nPoints) const {
+  if (!m_MappedEvents || sizeof(Type) != m_CoordSize)
+    return false;
+  if (blockPosition + nPoints > this->getFileLength())
+    throw Kernel::Exception::FileError("Attemtp to read behind the file end",
+                                       m_fileName);
+
+  Block = reinterpret_cast<const Type *>(m_MappedEvents) +
+          blockPosition * m_BlockSize[1];
+  return true;
+}
+
+/** Get a pointer to a float data block in the memory-mapped file
+  *@param Block         -- set to the start of the block
+  *@param blockPosition -- The starting place of the block
+  *@param nPoints       -- number of data points (events) in the block
+  *@returns false if the block is not mapped  */
+bool BoxControllerNeXusIO::getMappedBlock(const float *&Block,
+                                          const uint64_t blockPosition,
+                                          const size_t nPoints) const {
+  return getMappedGenericBlock(Block, blockPosition, nPoints);
+}
+/** Get a pointer to a double data block in the memory-mapped file
+  *@param Block         -- set to the start of the block
+  *@param blockPosition -- The starting place of the block
+  *@param nPoints       -- number of data points (events) in the block
+  *@returns false if the block is not mapped  */
+bool BoxControllerNeXusIO::getMappedBlock(const double *&Block,
+                                          const uint64_t blockPosition,
+                                          const size_t nPoints) const {
+  return getMappedGenericBlock(Block, blockPosition, nPoints);
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------
 
 /// Clear NeXus internal cache
@@ -488,6 +588,9 @@ void BoxControllerNeXusIO::closeFile() {
 
     delete m_File;
     m_File = nullptr;
+
+    m_MappedEvents = nullptr;
+    m_MappedFile.reset();
   }
 }
 
@@ -10,6 +10,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
+#include <algorithm>
 
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
@@ -278,6 +279,58 @@ void CoordTransformAffine::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to many vectors.
+ *
+ * The vectors are processed in blocks. The coordinates of a block are
+ * gathered into one contiguous column per input dimension, so that the
+ * matrix-vector products run over contiguous memory and can be vectorised.
+ * The sums are accumulated in the same order as apply(), giving identical
+ * results.
+ *
+ * @param inputVectors :: the first input vector, of size inD
+ * @param inputStride :: distance in bytes between consecutive input vectors
+ * @param numVectors :: number of vectors to transform
+ * @param outVectors :: contiguous array of numVectors * outD output
+ *        coordinates
+ */
+void CoordTransformAffine::applyBatch(const coord_t *inputVectors,
+                                      size_t inputStride, size_t numVectors,
+                                      coord_t *outVectors) const {
+  // Small enough for the columns to stay in the L1 cache
+  const size_t blockSize = 256;
+  std::vector<coord_t> columns(inD * blockSize);
+  std::vector<coord_t> result(blockSize);
+  const char *input = reinterpret_cast<const char *>(inputVectors);
+
+  for (size_t start = 0; start < numVectors; start += blockSize) {
+    const size_t n = std::min(blockSize, numVectors - start);
+    // Gather the block, one column per input dimension
+    for (size_t i = 0; i < n; ++i) {
+      const coord_t *inputVector =
+          reinterpret_cast<const coord_t *>(input + (start + i) * inputStride);
+      for (size_t in = 0; in < inD; ++in)
+        columns[in * blockSize + i] = inputVector[in];
+    }
+
+    for (size_t out = 0; out < outD; ++out) {
+      const coord_t *rawMatrixRow = m_rawMatrix[out];
+      std::fill_n(result.begin(), n, coord_t(0.0));
+      for (size_t in = 0; in < inD; ++in) {
+        const coord_t factor = rawMatrixRow[in];
+        const coord_t *column = columns.data() + in * blockSize;
+        for (size_t i = 0; i < n; ++i)
+          result[i] += factor * column[i];
+      }
+      // The homogenous coordinate
+      const coord_t offset = rawMatrixRow[inD];
+      coord_t *outColumn = outVectors + start * outD + out;
+      for (size_t i = 0; i < n; ++i)
+        outColumn[i * outD] = result[i] + offset;
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Serialize the coordinate transform
 *
@@ -133,6 +133,30 @@ void CoordTransformAligned::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to many vectors, without a virtual
+ * call per vector.
+ *
+ * @param inputVectors :: the first input vector, of size inD
+ * @param inputStride :: distance in bytes between consecutive input vectors
+ * @param numVectors :: number of vectors to transform
+ * @param outVectors :: contiguous array of numVectors * outD output
+ *        coordinates
+ */
+void CoordTransformAligned::applyBatch(const coord_t *inputVectors,
+                                       size_t inputStride, size_t numVectors,
+                                       coord_t *outVectors) const {
+  const char *input = reinterpret_cast<const char *>(inputVectors);
+  for (size_t i = 0; i < numVectors; ++i, input += inputStride) {
+    const coord_t *inputVector = reinterpret_cast<const coord_t *>(input);
+    coord_t *outVector = outVectors + i * outD;
+    for (size_t out = 0; out < outD; ++out)
+      outVector[out] =
+          (inputVector[m_dimensionToBinFrom[out]] - m_origin[out]) *
+          m_scaling[out];
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Create an equivalent affine transformation matrix out of the
  * parameters of this axis-aligned transformation.
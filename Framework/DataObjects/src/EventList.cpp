@@ -4,10 +4,13 @@
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Unit.h"
 #include <cfloat>
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <functional>
 #include <limits>
 #include <stdexcept>
@@ -73,6 +76,196 @@ public:
     return (tAtSample1 < tAtSample2);
   }
 };
+
+/**
+ * Finds the bin containing a value directly from the bin boundaries when
+ * these are linearly or logarithmically spaced, as produced by Rebin, so that
+ * events can be histogrammed without sorting them first. The estimated bin
+ * is corrected against the actual boundaries so the result is always exact.
+ *
+ * Checking the spacing of the boundaries costs O(bins), so the result is
+ * remembered per thread for the last boundaries seen. The spectra of a
+ * workspace are usually histogrammed in turn on the same shared X, which is
+ * then checked only once. As the estimate is corrected, boundaries that
+ * change in place between two lookups still give the exact bin as long as
+ * they stay sorted.
+ */
+class DirectBinFinder {
+public:
+  explicit DirectBinFinder(const MantidVec &X)
+      : m_X(X), m_numBins(X.empty() ? 0 : X.size() - 1) {
+    if (m_numBins == 0)
+      return;
+    m_front = X.front();
+    m_back = X.back();
+    thread_local Spacing lastSpacing;
+    if (lastSpacing.data != X.data() || lastSpacing.size != X.size() ||
+        lastSpacing.front != m_front || lastSpacing.back != m_back) {
+      lastSpacing = checkSpacing(X);
+    }
+    m_spacing = lastSpacing;
+  }
+
+  /// @return true if bins can be found directly for these boundaries
+  bool isValid() const { return m_numBins > 0 && m_spacing.valid; }
+
+  /**
+   * @param value :: the value to look up
+   * @return the index of the bin with X[i] <= value < X[i+1], or the number
+   * of bins if the value is outside of the boundaries
+   */
+  size_t bin(const double value) const {
+    if (!(value >= m_front && value < m_back))
+      return m_numBins;
+    const double position =
+        m_spacing.logarithmic ? std::log(value / m_front) * m_spacing.invStep
+                              : (value - m_front) * m_spacing.invStep;
+    size_t index =
+        position > 0.
+            ? std::min(static_cast<size_t>(position), m_numBins - 1)
+            : 0;
+    while (value < m_X[index])
+      --index;
+    while (value >= m_X[index + 1])
+      ++index;
+    return index;
+  }
+
+private:
+  /// The spacing of a set of bin boundaries
+  struct Spacing {
+    const double *data = nullptr;
+    size_t size = 0;
+    double front = 0.;
+    double back = 0.;
+    bool valid = false;
+    bool logarithmic = false;
+    double invStep = 0.;
+  };
+
+  /// Find out whether the boundaries are linearly spaced, allowing a shorter
+  /// last bin, or logarithmically spaced
+  static Spacing checkSpacing(const MantidVec &X) {
+    Spacing spacing;
+    spacing.data = X.data();
+    spacing.size = X.size();
+    spacing.front = X.front();
+    spacing.back = X.back();
+    const size_t numBins = X.size() - 1;
+    for (size_t i = 0; i < numBins; ++i) {
+      if (!(X[i] < X[i + 1]))
+        return spacing;
+    }
+    const double step = X[1] - X[0];
+    if (isEvenlySpaced(numBins, [&X, step](size_t i) {
+          return (X[i] - X[0]) / step - static_cast<double>(i);
+        })) {
+      spacing.invStep = 1. / step;
+      spacing.valid = true;
+      return spacing;
+    }
+    if (X[0] > 0.) {
+      const double logStep = std::log(X[1] / X[0]);
+      if (isEvenlySpaced(numBins, [&X, logStep](size_t i) {
+            return std::log(X[i] / X[0]) / logStep - static_cast<double>(i);
+          })) {
+        spacing.invStep = 1. / logStep;
+        spacing.logarithmic = true;
+        spacing.valid = true;
+      }
+    }
+    return spacing;
+  }
+
+  /// Check that every boundary but the last is within half a bin of the
+  /// position predicted by offset(i) == 0
+  template <class Offset>
+  static bool isEvenlySpaced(const size_t numBins, const Offset &offset) {
+    for (size_t i = 1; i < numBins; ++i) {
+      if (!(std::abs(offset(i)) < 0.5))
+        return false;
+    }
+    return true;
+  }
+
+  const MantidVec &m_X;
+  const size_t m_numBins;
+  double m_front = 0.;
+  double m_back = 0.;
+  Spacing m_spacing;
+};
+
+/**
+ * Histogram events by TOF in a single pass without sorting them.
+ * @param events :: the events to histogram, in any order
+ * @param finder :: the bin finder for the X boundaries
+ * @param Y :: the histogram to add the weights to, sized to the number of bins
+ * @param E :: the histogram of errors sized as Y, or nullptr to skip errors
+ */
+template <class T>
+void histogramWithoutSorting(const std::vector<T> &events,
+                             const DirectBinFinder &finder, MantidVec &Y,
+                             MantidVec *E) {
+  const size_t numBins = Y.size();
+  for (const auto &event : events) {
+    const size_t bin = finder.bin(event.tof());
+    if (bin == numBins)
+      continue;
+    Y[bin] += event.weight();
+    if (E)
+      (*E)[bin] += event.errorSquared();
+  }
+  if (E)
+    std::transform(E->begin(), E->end(), E->begin(),
+                   static_cast<double (*)(double)>(sqrt));
+}
+
+/**
+ * Integrate the events with minX <= tof <= maxX in a single pass without
+ * sorting them.
+ * @param events :: the events to integrate, in any order
+ * @param minX :: minimum TOF to include
+ * @param maxX :: maximum TOF to include
+ * @param sum :: the summed weights
+ * @param error :: the error of the sum
+ */
+template <class T>
+void integrateWithoutSorting(const std::vector<T> &events, const double minX,
+                             const double maxX, double &sum, double &error) {
+  sum = 0;
+  error = 0;
+  if (maxX < minX)
+    return;
+  for (const auto &event : events) {
+    const double tof = event.tof();
+    if (tof >= minX && tof <= maxX) {
+      sum += event.weight();
+      error += event.errorSquared();
+    }
+  }
+  error = std::sqrt(error);
+}
+
+/**
+ * Remove the events with tofMin <= tof <= tofMax in a single pass, keeping
+ * the remaining events in their current order.
+ * @param events :: the events to mask, in any order
+ * @param tofMin :: lower bound of TOF to filter out
+ * @param tofMax :: upper bound of TOF to filter out
+ * @returns The number of events deleted.
+ */
+template <class T>
+size_t maskTofWithoutSorting(std::vector<T> &events, const double tofMin,
+                             const double tofMax) {
+  auto newEnd = std::remove_if(events.begin(), events.end(),
+                               [tofMin, tofMax](const T &event) {
+                                 return event.tof() >= tofMin &&
+                                        event.tof() <= tofMax;
+                               });
+  const size_t numDel = std::distance(newEnd, events.end());
+  events.erase(newEnd, events.end());
+  return numDel;
+}
 }
 //==========================================================================
 /// --------------------- TofEvent Comparators
@@ -277,6 +470,8 @@ void EventList::createFromHistogram(const ISpectrum *inSpec, bool GenerateZeros,
  * */
 EventList &EventList::operator=(const EventList &rhs) {
   // Note that we are NOT copying the MRU pointer.
+  if (mru)
+    mru->deleteIndex(this);
   IEventList::operator=(rhs);
   m_histogram = rhs.m_histogram;
   events = rhs.events;
@@ -284,6 +479,7 @@ EventList &EventList::operator=(const EventList &rhs) {
   weightedEventsNoTime = rhs.weightedEventsNoTime;
   eventType = rhs.eventType;
   order = rhs.order;
+  m_version = rhs.m_version;
   return *this;
 }
 
@@ -293,7 +489,7 @@ EventList &EventList::operator=(const EventList &rhs) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const TofEvent &event) {
-
+  ++m_version;
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -321,6 +517,7 @@ EventList &EventList::operator+=(const TofEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
+  ++m_version;
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -361,6 +558,7 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const WeightedEvent &event) {
+  ++m_version;
   this->switchTo(WEIGHTED);
   this->weightedEvents.push_back(event);
   this->order = UNSORTED;
@@ -377,6 +575,7 @@ EventList &EventList::operator+=(const WeightedEvent &event) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEvent> &more_events) {
+  ++m_version;
   switch (this->eventType) {
   case TOF:
     // Need to switch to weighted
@@ -414,6 +613,7 @@ operator+=(const std::vector<WeightedEvent> &more_events) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEventNoTime> &more_events) {
+  ++m_version;
   switch (this->eventType) {
   case TOF:
   case WEIGHTED:
@@ -507,6 +707,7 @@ void EventList::minusHelper(std::vector<T1> &events,
  * @return reference to this
  * */
 EventList &EventList::operator-=(const EventList &more_events) {
+  ++m_version;
   if (this == &more_events) {
     // Special case, ticket #3844 part 2.
     // When doing this = this - this,
@@ -636,6 +837,7 @@ EventType EventList::getEventType() const { return eventType; }
  * WEIGHTED_NOTIME)
  */
 void EventList::switchTo(EventType newType) {
+  ++m_version;
   switch (newType) {
   case TOF:
     if (eventType != TOF)
@@ -769,6 +971,7 @@ const std::vector<TofEvent> &EventList::getEvents() const {
  * @return a reference to the list of non-weighted events
  * */
 std::vector<TofEvent> &EventList::getEvents() {
+  ++m_version;
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -784,6 +987,7 @@ std::vector<TofEvent> &EventList::getEvents() {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEvent> &EventList::getWeightedEvents() {
+  ++m_version;
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -812,6 +1016,7 @@ const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
+  ++m_version;
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEventNoTime. Use "
@@ -837,6 +1042,7 @@ EventList::getWeightedEventsNoTime() const {
  * associated detector ID's.
  * */
 void EventList::clear(const bool removeDetIDs) {
+  ++m_version;
   if (mru)
     mru->deleteIndex(this);
   this->events.clear();
@@ -899,16 +1105,17 @@ void EventList::reserve(size_t num) { this->events.reserve(num); }
 // --------------------------------------------------------------------------
 /** Sort events by TOF or Frame
  * @param order :: Order by which to sort.
+ * @param numThreads :: number of threads to use for sorting a long list
  * */
-void EventList::sort(const EventSortType order) const {
+void EventList::sort(const EventSortType order, const size_t numThreads) const {
   if (order == UNSORTED) {
     return; // don't bother doing anything. Why did you ask to unsort?
   } else if (order == TOF_SORT) {
-    this->sortTof();
+    this->sortTof(numThreads);
   } else if (order == PULSETIME_SORT) {
-    this->sortPulseTime();
+    this->sortPulseTime(numThreads);
   } else if (order == PULSETIMETOF_SORT) {
-    this->sortPulseTimeTOF();
+    this->sortPulseTimeTOF(numThreads);
   } else if (order == TIMEATSAMPLE_SORT) {
     throw std::invalid_argument("sorting by time at sample requires extra "
                                 "parameters. call sortTimeAtSample instead.");
@@ -926,250 +1133,197 @@ void EventList::setSortOrder(const EventSortType order) const {
   this->order = order;
 }
 
-//  // MergeSort from:
-//  http://en.literateprograms.org/Merge_sort_%28C_Plus_Plus%29#chunk%20def:merge
-//  template<typename IT, typename VT> void insert(IT begin, IT end, const VT
-//  &v)
-//  {
-//    while(begin+1!=end && *(begin+1)<v) {
-//      std::swap(*begin, *(begin+1));
-//      ++begin;
-//    }
-//    *begin=v;
-//  }
-//
-//  template<typename IT> void merge(IT begin, IT begin_right, IT end)
-//  {
-//    for(;begin<begin_right; ++begin) {
-//      if(*begin>*begin_right) {
-//        typename std::iterator_traits<IT>::value_type v(*begin);
-//        *begin=*begin_right;
-//        insert(begin_right, end, v);
-//      }
-//    }
-//  }
-//
-//  template<typename IT> void mergesort(IT begin, IT end)
-//  {
-//    size_t size(end-begin);
-//    //std::cout << "mergesort called on " << size << "\n";
-//    if(size<2) return;
-//
-//    IT begin_right=begin+size/2;
-//
-//    mergesort(begin, begin_right);
-//    mergesort(begin_right, end);
-//    merge(begin, begin_right, end);
-//  }
-
-//----------------------------------------------------------------------------------------------------
-/** Merge two sorted lists into one sorted vector.
- *
- * @tparam T :: the type in the vector.
- * @param begin1 :: iterator at the start of the first list.
- * @param end1 :: iterator at the end of the first list.
- * @param begin2 :: iterator at the start of the second list.
- * @param end2 :: iterator at the end of the second list.
- * @param result_vector :: a vector (by reference) that will be filled with the
- *result.
- * */
-template <typename T>
-void merge(typename std::vector<T>::iterator begin1,
-           typename std::vector<T>::iterator end1,
-           typename std::vector<T>::iterator begin2,
-           typename std::vector<T>::iterator end2,
-           typename std::vector<T> &result_vector) {
-  auto it1 = begin1;
-  auto it2 = begin2;
-  while (!((it1 == end1) && (it2 == end2))) {
-    if (it1 == end1) {
-      // Only it2 makes sense
-      result_vector.push_back(*it2);
-      it2++;
-    } else if (it2 == end2) {
-      // Only it1 makes sense
-      result_vector.push_back(*it1);
-      it1++;
-    } else {
-      // Both iterators are valid. Which is smaller?
-      if (*it1 < *it2) {
-        result_vector.push_back(*it1);
-        it1++;
-      } else {
-        result_vector.push_back(*it2);
-        it2++;
-      }
-    }
+namespace {
+/// Lists with fewer events than this are sorted with std::sort rather than
+/// with a radix sort.
+const size_t RADIX_SORT_THRESHOLD = 1024;
+/// Number of key bits sorted in each pass of the radix sort.
+const int RADIX_BITS = 11;
+/// Number of buckets of each radix sort pass.
+const size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+/// Number of passes needed to sort a 64 bit key.
+const int RADIX_PASSES = (64 + RADIX_BITS - 1) / RADIX_BITS;
+/// Minimum number of events for each thread of a parallel sort.
+const size_t MIN_EVENTS_PER_SORT_THREAD = 100000;
+/// The sign bit of a 64 bit key.
+const uint64_t SIGN_BIT = uint64_t(1) << 63;
+
+/// Map a double to an unsigned integer sorting in the same order.
+inline uint64_t radixKey(const double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & SIGN_BIT) ? ~bits : (bits | SIGN_BIT);
+}
+
+/// Map a signed integer to an unsigned integer sorting in the same order.
+inline uint64_t radixKey(const int64_t value) {
+  return static_cast<uint64_t>(value) ^ SIGN_BIT;
+}
+
+/// Radix key of an event's TOF.
+struct TofKey {
+  template <class T> uint64_t operator()(const T &event) const {
+    return radixKey(event.tof());
   }
-}
+};
 
-//----------------------------------------------------------------------------------------------------
-/** Perform a parallelized sort on a provided vector, using 2 threads.
- * NOTE: Will temporarily use twice the memory used by the incoming vector.
- *
- * @param vec :: a vector, by refe/rence, that will be sorted-in place.
- */
-template <typename T> void parallel_sort2(typename std::vector<T> &vec) {
-  size_t size = vec.size();
-
-  auto begin = vec.begin();
-  auto middle = begin + size / 2;
-  auto end = vec.end();
-
-  PRAGMA_OMP(parallel sections) {
-    PRAGMA_OMP(section) {
-      std::sort(begin, middle);
-      // std::cout << " ----------- Part 1 --------------\n"; for (typename
-      // std::vector<T>::iterator it = begin; it != middle; it++) std::cout <<
-      // *it << "\n";
-    }
-    PRAGMA_OMP(section) {
-      std::sort(middle, end);
-      // std::cout << " ----------- Part 2 --------------\n";for (typename
-      // std::vector<T>::iterator it = middle; it != end; it++) std::cout << *it
-      // << "\n";
-    }
+/// Radix key of an event's pulse time.
+struct PulseTimeKey {
+  template <class T> uint64_t operator()(const T &event) const {
+    return radixKey(event.pulseTime().totalNanoseconds());
   }
+};
 
-  // Now merge back
-  typename std::vector<T> temp;
-  merge(begin, middle, middle, end, temp);
-
-  // std::cout << " ----------- Part 1+2 --------------\n"; for (typename
-  // std::vector<T>::iterator it = temp.begin(); it != temp.end(); it++)
-  // std::cout << *it << "\n";
-  // Swap storage with the temp vector
-  vec.swap(temp);
-  // Which we can now clear
-  temp.clear();
-}
-
-//----------------------------------------------------------------------------------------------------
-/** Perform a parallelized sort on a provided vector, using 4 threads.
- * NOTE: Will temporarily use twice the memory used by the incoming vector.
+/**
+ * Stable least-significant-digit radix sort of a range of events by a 64 bit
+ * key. All digit histograms are built in a single pass and passes in which
+ * every event falls into the same bucket (e.g. the shared exponent bits of
+ * the TOF) are skipped.
+ * NOTE: Will temporarily use twice the memory used by the range.
  *
- * @param vec :: a vector, by reference, that will be sorted-in place.
+ * @param begin :: start of the range to sort
+ * @param end :: end of the range to sort
+ * @param key :: functor returning the key of an event
  */
-template <typename T> void parallel_sort4(std::vector<T> &vec) {
-  // int num_cores = PARALLEL_NUMBER_OF_THREADS;
-  size_t size = vec.size();
-
-  auto begin = vec.begin();
-  auto middle1 = begin + size / 4;
-  auto middle2 = begin + size / 2;
-  auto middle3 = begin + 3 * size / 4;
-  auto end = vec.end();
-
-  PRAGMA_OMP(parallel sections) {
-    PRAGMA_OMP(section) { std::sort(begin, middle1); }
-    PRAGMA_OMP(section) { std::sort(middle1, middle2); }
-    PRAGMA_OMP(section) { std::sort(middle2, middle3); }
-    PRAGMA_OMP(section) { std::sort(middle3, end); }
-  }
+template <class Iterator, class Key>
+void radixSort(Iterator begin, Iterator end, const Key &key) {
+  using T = typename std::iterator_traits<Iterator>::value_type;
+  const size_t size = std::distance(begin, end);
+  if (size < 2)
+    return;
 
-  // Now merge back
-  typename std::vector<T> temp1, temp2;
-  // PRAGMA_OMP(parallel sections)
-  {
-    // PRAGMA_OMP(section)
-    { merge(begin, middle1, middle1, middle2, temp1); }
-    // PRAGMA_OMP(section)
-    { merge(middle2, middle3, middle3, end, temp2); }
+  std::vector<size_t> counts(RADIX_PASSES * RADIX_BUCKETS, 0);
+  for (auto it = begin; it != end; ++it) {
+    const uint64_t value = key(*it);
+    for (int pass = 0; pass < RADIX_PASSES; ++pass)
+      ++counts[pass * RADIX_BUCKETS +
+               ((value >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1))];
   }
 
-  // We can clear the incoming vector to free up memory now,
-  //  because it is copied already in temp1, temp2
-  vec.clear();
-
-  // Final merge
-  std::vector<T> temp;
-  merge(temp1.begin(), temp1.end(), temp2.begin(), temp2.end(), temp);
-
-  // Clear out this temporary storage
-  temp1.clear();
-  temp2.clear();
-  std::vector<T>().swap(temp1);
-  std::vector<T>().swap(temp2);
-
-  // Swap storage with the temp vector
-  vec.swap(temp);
-  // Which we can now clear
-  temp.clear();
+  T *const data = &(*begin);
+  std::vector<T> scratch(size);
+  T *from = data;
+  T *to = scratch.data();
+  for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+    size_t *passCounts = counts.data() + pass * RADIX_BUCKETS;
+    const int shift = pass * RADIX_BITS;
+    if (passCounts[(key(*from) >> shift) & (RADIX_BUCKETS - 1)] == size)
+      continue;
+    // Turn the counts into the start of each bucket
+    size_t offset = 0;
+    for (size_t bucket = 0; bucket < RADIX_BUCKETS; ++bucket) {
+      const size_t count = passCounts[bucket];
+      passCounts[bucket] = offset;
+      offset += count;
+    }
+    for (size_t i = 0; i < size; ++i)
+      to[passCounts[(key(from[i]) >> shift) & (RADIX_BUCKETS - 1)]++] =
+          from[i];
+    std::swap(from, to);
+  }
+  if (from != data)
+    std::copy(from, from + size, data);
 }
 
-// --------------------------------------------------------------------------
-/** Sort events by TOF in one thread */
-void EventList::sortTof() const {
-  if (this->order == TOF_SORT)
-    return; // nothing to do
+/// Sort a range of events by TOF.
+template <class Iterator> void sortRangeByTof(Iterator begin, Iterator end) {
+  using T = typename std::iterator_traits<Iterator>::value_type;
+  if (static_cast<size_t>(std::distance(begin, end)) < RADIX_SORT_THRESHOLD)
+    std::sort(begin, end, compareEventTof<T>);
+  else
+    radixSort(begin, end, TofKey());
+}
 
-  // Avoid sorting from multiple threads
-  std::lock_guard<std::mutex> _lock(m_sortMutex);
-  // If the list was sorted while waiting for the lock, return.
-  if (this->order == TOF_SORT)
-    return;
+/// Sort a range of events by pulse time.
+template <class Iterator>
+void sortRangeByPulseTime(Iterator begin, Iterator end) {
+  if (static_cast<size_t>(std::distance(begin, end)) < RADIX_SORT_THRESHOLD)
+    std::sort(begin, end, compareEventPulseTime);
+  else
+    radixSort(begin, end, PulseTimeKey());
+}
 
-  switch (eventType) {
-  case TOF:
-    std::sort(events.begin(), events.end(), compareEventTof<TofEvent>);
-    break;
-  case WEIGHTED:
-    std::sort(weightedEvents.begin(), weightedEvents.end(),
-              compareEventTof<WeightedEvent>);
-    break;
-  case WEIGHTED_NOTIME:
-    std::sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end(),
-              compareEventTof<WeightedEventNoTime>);
-    break;
+/// Sort a range of events by pulse time, then TOF.
+template <class Iterator>
+void sortRangeByPulseTimeTOF(Iterator begin, Iterator end) {
+  if (static_cast<size_t>(std::distance(begin, end)) < RADIX_SORT_THRESHOLD) {
+    std::sort(begin, end, compareEventPulseTimeTOF);
+  } else {
+    // Radix sort is stable, so sorting by the minor key first gives the order
+    // of both keys.
+    radixSort(begin, end, TofKey());
+    radixSort(begin, end, PulseTimeKey());
   }
-  // Save the order to avoid unnecessary re-sorting.
-  this->order = TOF_SORT;
 }
 
-// --------------------------------------------------------------------------
-/** Sort events by TOF, using two threads.
+/**
+ * Sort a vector of events using several threads: the vector is split into one
+ * chunk per thread, the chunks are sorted in parallel and then merged pairwise,
+ * the merges of each round also running in parallel.
+ * NOTE: Will temporarily use twice the memory used by the incoming vector.
  *
- * Performance for 5e7 events:
- *  - 40.5 secs with sortTof() (one thread)
- *  - 21.1 secs with sortTof2() (two threads)
- *  - 18.2 secs with sortTof4() (four threads)
- * Performance gain tends to go up with longer event lists.
- * */
-void EventList::sortTof2() const {
-  if (this->order == TOF_SORT)
-    return; // nothing to do
-
-  // Avoid sorting from multiple threads
-  std::lock_guard<std::mutex> _lock(m_sortMutex);
-  // If the list was sorted while waiting for the lock, return.
-  if (this->order == TOF_SORT)
+ * @param vec :: a vector, by reference, that will be sorted in place.
+ * @param numThreads :: the number of threads to sort with
+ * @param sortRange :: function sorting a range of the vector
+ * @param compare :: comparison defining the order produced by sortRange
+ */
+template <class T, class SortRange, class Compare>
+void parallelSort(std::vector<T> &vec, size_t numThreads,
+                  const SortRange &sortRange, const Compare &compare) {
+  const size_t size = vec.size();
+  // Chunks of fewer events are not worth a thread
+  numThreads = std::min(numThreads, size / MIN_EVENTS_PER_SORT_THREAD);
+  if (numThreads < 2) {
+    sortRange(vec.begin(), vec.end());
     return;
+  }
 
-  switch (eventType) {
-  case TOF:
-    parallel_sort2(events);
-    break;
-  case WEIGHTED:
-    parallel_sort2(weightedEvents);
-    break;
-  case WEIGHTED_NOTIME:
-    parallel_sort2(weightedEventsNoTime);
-    break;
+  std::vector<size_t> bounds(numThreads + 1);
+  for (size_t i = 0; i <= numThreads; ++i)
+    bounds[i] = size * i / numThreads;
+
+  const int numChunks = static_cast<int>(numThreads);
+  PRAGMA_OMP(parallel for num_threads(numChunks))
+  for (int i = 0; i < numChunks; ++i)
+    sortRange(vec.begin() + bounds[i], vec.begin() + bounds[i + 1]);
+
+  std::vector<T> scratch(size);
+  T *from = vec.data();
+  T *to = scratch.data();
+  while (bounds.size() > 2) {
+    const int numMerges = static_cast<int>(bounds.size() - 1) / 2;
+    PRAGMA_OMP(parallel for num_threads(numMerges))
+    for (int i = 0; i < numMerges; ++i) {
+      std::merge(from + bounds[2 * i], from + bounds[2 * i + 1],
+                 from + bounds[2 * i + 1], from + bounds[2 * i + 2],
+                 to + bounds[2 * i], compare);
+    }
+    // An odd chunk out is carried over to the next round
+    if ((bounds.size() - 1) % 2 == 1)
+      std::copy(from + bounds[bounds.size() - 2], from + size,
+                to + bounds[bounds.size() - 2]);
+
+    std::vector<size_t> merged;
+    for (size_t i = 0; i < bounds.size(); i += 2)
+      merged.push_back(bounds[i]);
+    if (merged.back() != size)
+      merged.push_back(size);
+    bounds.swap(merged);
+    std::swap(from, to);
   }
-  // Save the order to avoid unnecessary re-sorting.
-  this->order = TOF_SORT;
+  if (from != vec.data())
+    vec.swap(scratch);
+}
 }
 
 // --------------------------------------------------------------------------
-/** Sort events by TOF, using two threads.
+/** Sort events by TOF.
  *
- * Performance for 5e7 events:
- *  - 40.5 secs with sortTof() (one thread)
- *  - 21.1 secs with sortTof2() (two threads)
- *  - 18.2 secs with sortTof4() (four threads)
- * Performance gain tends to go up with longer event lists.
- * */
-void EventList::sortTof4() const {
+ * Lists of more than RADIX_SORT_THRESHOLD events are radix sorted, in O(n).
+ *
+ * @param numThreads :: number of threads to use for sorting a long list
+ */
+void EventList::sortTof(const size_t numThreads) const {
   if (this->order == TOF_SORT)
     return; // nothing to do
 
@@ -1181,19 +1335,33 @@ void EventList::sortTof4() const {
 
   switch (eventType) {
   case TOF:
-    parallel_sort4(events);
+    parallelSort(events, numThreads,
+                 sortRangeByTof<std::vector<TofEvent>::iterator>,
+                 compareEventTof<TofEvent>);
     break;
   case WEIGHTED:
-    parallel_sort4(weightedEvents);
+    parallelSort(weightedEvents, numThreads,
+                 sortRangeByTof<std::vector<WeightedEvent>::iterator>,
+                 compareEventTof<WeightedEvent>);
     break;
   case WEIGHTED_NOTIME:
-    parallel_sort4(weightedEventsNoTime);
+    parallelSort(weightedEventsNoTime, numThreads,
+                 sortRangeByTof<std::vector<WeightedEventNoTime>::iterator>,
+                 compareEventTof<WeightedEventNoTime>);
     break;
   }
   // Save the order to avoid unnecessary re-sorting.
   this->order = TOF_SORT;
 }
 
+// --------------------------------------------------------------------------
+/** Sort events by TOF, using two threads. */
+void EventList::sortTof2() const { this->sortTof(2); }
+
+// --------------------------------------------------------------------------
+/** Sort events by TOF, using four threads. */
+void EventList::sortTof4() const { this->sortTof(4); }
+
 // --------------------------------------------------------------------------
 /**
  * Sort events by time at sample
@@ -1237,8 +1405,10 @@ void EventList::sortTimeAtSample(const double &tofFactor,
 }
 
 // --------------------------------------------------------------------------
-/** Sort events by Frame */
-void EventList::sortPulseTime() const {
+/** Sort events by Frame
+ * @param numThreads :: number of threads to use for sorting a long list
+ */
+void EventList::sortPulseTime(const size_t numThreads) const {
   if (this->order == PULSETIME_SORT)
     return; // nothing to do
 
@@ -1251,11 +1421,14 @@ void EventList::sortPulseTime() const {
   // Perform sort.
   switch (eventType) {
   case TOF:
-    std::sort(events.begin(), events.end(), compareEventPulseTime);
+    parallelSort(events, numThreads,
+                 sortRangeByPulseTime<std::vector<TofEvent>::iterator>,
+                 compareEventPulseTime);
     break;
   case WEIGHTED:
-    std::sort(weightedEvents.begin(), weightedEvents.end(),
-              compareEventPulseTime);
+    parallelSort(weightedEvents, numThreads,
+                 sortRangeByPulseTime<std::vector<WeightedEvent>::iterator>,
+                 compareEventPulseTime);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1268,8 +1441,9 @@ void EventList::sortPulseTime() const {
 /*
  * Sort events by pulse time + TOF
  * (the absolute time)
+ * @param numThreads :: number of threads to use for sorting a long list
  */
-void EventList::sortPulseTimeTOF() const {
+void EventList::sortPulseTimeTOF(const size_t numThreads) const {
   if (this->order == PULSETIMETOF_SORT)
     return; // already ordered.
 
@@ -1281,11 +1455,14 @@ void EventList::sortPulseTimeTOF() const {
 
   switch (eventType) {
   case TOF:
-    std::sort(events.begin(), events.end(), compareEventPulseTimeTOF);
+    parallelSort(events, numThreads,
+                 sortRangeByPulseTimeTOF<std::vector<TofEvent>::iterator>,
+                 compareEventPulseTimeTOF);
     break;
   case WEIGHTED:
-    std::sort(weightedEvents.begin(), weightedEvents.end(),
-              compareEventPulseTimeTOF);
+    parallelSort(weightedEvents, numThreads,
+                 sortRangeByPulseTimeTOF<std::vector<WeightedEvent>::iterator>,
+                 compareEventPulseTimeTOF);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1412,16 +1589,14 @@ size_t EventList::histogram_size() const {
  */
 void EventList::setX(const Kernel::cow_ptr<HistogramData::HistogramX> &X) {
   m_histogram.setX(X);
-  if (mru)
-    mru->deleteIndex(this);
+  ++m_version;
 }
 
 /** Deprecated, use mutableX() instead. Returns a reference to the x data.
  *  @return a reference to the X (bin) vector.
  */
 MantidVec &EventList::dataX() {
-  if (mru)
-    mru->deleteIndex(this);
+  ++m_version;
   return m_histogram.dataX();
 }
 
@@ -1520,59 +1695,44 @@ const HistogramData::HistogramE &EventList::e() const {
   return *sharedE();
 }
 Kernel::cow_ptr<HistogramData::HistogramY> EventList::sharedY() const {
-  // This is the thread number from which this function was called.
-  int thread = PARALLEL_THREAD_NUMBER;
-
   Kernel::cow_ptr<HistogramData::HistogramY> yData(nullptr);
-
-  // Is the data in the mrulist?
-  if (mru) {
-    mru->ensureEnoughBuffersY(thread);
-    yData = mru->findY(thread, this);
-  }
-
-  if (!yData) {
-    MantidVec Y;
-    MantidVec E;
-    this->generateHistogram(readX(), Y, E);
-
-    // Create the MRU object
-    yData = Kernel::make_cow<HistogramData::HistogramY>(std::move(Y));
-
-    // Lets save it in the MRU
-    if (mru) {
-      mru->insertY(thread, yData, this);
-      auto eData = Kernel::make_cow<HistogramData::HistogramE>(std::move(E));
-      mru->ensureEnoughBuffersE(thread);
-      mru->insertE(thread, eData, this);
-    }
-  }
+  Kernel::cow_ptr<HistogramData::HistogramE> eData(nullptr);
+  cachedHistogram(yData, eData);
   return yData;
 }
 Kernel::cow_ptr<HistogramData::HistogramE> EventList::sharedE() const {
-  // This is the thread number from which this function was called.
-  int thread = PARALLEL_THREAD_NUMBER;
-
+  Kernel::cow_ptr<HistogramData::HistogramY> yData(nullptr);
   Kernel::cow_ptr<HistogramData::HistogramE> eData(nullptr);
+  cachedHistogram(yData, eData);
+  return eData;
+}
+
+/** Get the Y and E histograms from the MRU of the parent workspace, or
+ * generate them and save them in the MRU if they are not found.
+ * Both are generated in one pass and cached together.
+ *
+ * @param yData :: set to the Y histogram
+ * @param eData :: set to the E histogram
+ */
+void EventList::cachedHistogram(
+    Kernel::cow_ptr<HistogramData::HistogramY> &yData,
+    Kernel::cow_ptr<HistogramData::HistogramE> &eData) const {
+  // The X binning is identified by the address of the shared X data
+  const void *x = &m_histogram.x();
 
   // Is the data in the mrulist?
-  if (mru) {
-    mru->ensureEnoughBuffersE(thread);
-    eData = mru->findE(thread, this);
-  }
+  if (mru && mru->find(this, m_version, x, yData, eData))
+    return;
 
-  if (!eData) {
-    // Now use that to get E -- Y values are generated from another function
-    MantidVec Y_ignored;
-    MantidVec E;
-    this->generateHistogram(readX(), Y_ignored, E);
-    eData = Kernel::make_cow<HistogramData::HistogramE>(std::move(E));
+  MantidVec Y;
+  MantidVec E;
+  this->generateHistogram(readX(), Y, E);
+  yData = Kernel::make_cow<HistogramData::HistogramY>(std::move(Y));
+  eData = Kernel::make_cow<HistogramData::HistogramE>(std::move(E));
 
-    // Lets save it in the MRU
-    if (mru)
-      mru->insertE(thread, eData, this);
-  }
-  return eData;
+  // Lets save it in the MRU
+  if (mru)
+    mru->insert(this, m_version, x, yData, eData);
 }
 /** Look in the MRU to see if the Y histogram has been generated before.
  * If so, return that. If not, calculate, cache and return it.
@@ -1778,9 +1938,10 @@ void EventList::compressEventsParallelHelper(
  */
 void EventList::compressEvents(double tolerance, EventList *destination,
                                bool parallel) {
+  ++destination->m_version;
   // Must have a sorted list
   if (parallel)
-    this->sortTof4();
+    this->sortTof(PARALLEL_GET_MAX_THREADS);
   else
     this->sortTof();
   switch (eventType) {
@@ -2114,19 +2275,36 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
                                   MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
-
-  size_t numEvents = getNumberEvents();
-  if (numEvents > NUM_EVENTS_PARALLEL_THRESHOLD &&
-      PARALLEL_GET_MAX_THREADS >= 4)
-    // Four-core sort
-    this->sortTof4();
-  else if (numEvents > NUM_EVENTS_PARALLEL_THRESHOLD &&
-           PARALLEL_GET_MAX_THREADS >= 2)
-    // Two-core sort
-    this->sortTof2();
+  // Unsorted events on regular bins are histogrammed in one pass instead
+  if (this->order != TOF_SORT && X.size() > 1) {
+    DirectBinFinder finder(X);
+    if (finder.isValid()) {
+      std::lock_guard<std::mutex> _lock(m_sortMutex);
+      Y.assign(X.size() - 1, 0.0);
+      switch (eventType) {
+      case TOF:
+        if (!skipError)
+          E.assign(Y.size(), 0.0);
+        histogramWithoutSorting(this->events, finder, Y,
+                                skipError ? nullptr : &E);
+        break;
+      case WEIGHTED:
+        E.assign(Y.size(), 0.0);
+        histogramWithoutSorting(this->weightedEvents, finder, Y, &E);
+        break;
+      case WEIGHTED_NOTIME:
+        E.assign(Y.size(), 0.0);
+        histogramWithoutSorting(this->weightedEventsNoTime, finder, Y, &E);
+        break;
+      }
+      return;
+    }
+  }
+
+  // Otherwise all types of weights need to be sorted by TOF
+  if (getNumberEvents() > NUM_EVENTS_PARALLEL_THRESHOLD)
+    this->sortTof(PARALLEL_GET_MAX_THREADS);
   else
-    // One-core sort
     this->sortTof();
 
   switch (eventType) {
@@ -2350,6 +2528,16 @@ void EventList::generateCountsHistogram(const MantidVec &X,
     return;
   }
 
+  if (this->order != TOF_SORT) {
+    DirectBinFinder finder(X);
+    if (finder.isValid()) {
+      std::lock_guard<std::mutex> _lock(m_sortMutex);
+      Y.assign(x_size - 1, 0.0);
+      histogramWithoutSorting(this->events, finder, Y, nullptr);
+      return;
+    }
+  }
+
   // Sort the events by tof
   this->sortTof();
   // Clear the Y data, assign all to 0.
@@ -2519,9 +2707,21 @@ void EventList::integrate(const double minX, const double maxX,
                           double &error) const {
   sum = 0;
   error = 0;
-  if (!entireRange) {
-    // The event list must be sorted by TOF!
-    this->sortTof();
+  if (!entireRange && this->order != TOF_SORT) {
+    // A single pass is cheaper than sorting the list
+    std::lock_guard<std::mutex> _lock(m_sortMutex);
+    switch (eventType) {
+    case TOF:
+      integrateWithoutSorting(this->events, minX, maxX, sum, error);
+      return;
+    case WEIGHTED:
+      integrateWithoutSorting(this->weightedEvents, minX, maxX, sum, error);
+      return;
+    case WEIGHTED_NOTIME:
+      integrateWithoutSorting(this->weightedEventsNoTime, minX, maxX, sum,
+                              error);
+      return;
+    }
   }
 
   // Convert the list
@@ -2554,6 +2754,7 @@ void EventList::integrate(const double minX, const double maxX,
  */
 void EventList::convertTof(std::function<double(double)> func,
                            const int sorting) {
+  ++m_version;
   // fix the histogram parameter
   MantidVec &x = dataX();
   transform(x.begin(), x.end(), x.begin(), func);
@@ -2603,6 +2804,7 @@ void EventList::convertTofHelper(std::vector<T> &events,
  * @param offset :: The value to shift the time-of-flight by
  */
 void EventList::convertTof(const double factor, const double offset) {
+  ++m_version;
   // fix the histogram parameter
   MantidVec &x = dataX();
   for (double &iter : x)
@@ -2722,7 +2924,7 @@ std::size_t EventList::maskTofHelper(std::vector<T> &events,
   // Find the index of the first tofMin
   auto it_first = std::lower_bound(events.begin(), events.end(), tofMin,
                                    compareEventTof<T>);
-  if ((it_first != events.end()) && (it_first->tof() < tofMax)) {
+  if ((it_first != events.end()) && (it_first->tof() <= tofMax)) {
     // Something was found
     // Look for the first one > tofMax
     auto it_last =
@@ -2752,6 +2954,7 @@ std::size_t EventList::maskTofHelper(std::vector<T> &events,
  * @param tofMax :: upper bound of TOF to filter out
  */
 void EventList::maskTof(const double tofMin, const double tofMax) {
+  ++m_version;
   if (tofMax <= tofMin)
     throw std::runtime_error("EventList::maskTof: tofMax must be > tofMin");
 
@@ -2759,25 +2962,34 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
   if (this->getNumberEvents() == 0)
     return;
 
-  // Start by sorting by tof
-  this->sortTof();
-
-  // Convert the list
-  size_t numOrig = 0;
+  size_t numOrig = this->getNumberEvents();
   size_t numDel = 0;
-  switch (eventType) {
-  case TOF:
-    numOrig = this->events.size();
-    numDel = this->maskTofHelper(this->events, tofMin, tofMax);
-    break;
-  case WEIGHTED:
-    numOrig = this->weightedEvents.size();
-    numDel = this->maskTofHelper(this->weightedEvents, tofMin, tofMax);
-    break;
-  case WEIGHTED_NOTIME:
-    numOrig = this->weightedEventsNoTime.size();
-    numDel = this->maskTofHelper(this->weightedEventsNoTime, tofMin, tofMax);
-    break;
+  if (this->order != TOF_SORT) {
+    // Unsorted lists are masked in one pass rather than sorted first
+    switch (eventType) {
+    case TOF:
+      numDel = maskTofWithoutSorting(this->events, tofMin, tofMax);
+      break;
+    case WEIGHTED:
+      numDel = maskTofWithoutSorting(this->weightedEvents, tofMin, tofMax);
+      break;
+    case WEIGHTED_NOTIME:
+      numDel =
+          maskTofWithoutSorting(this->weightedEventsNoTime, tofMin, tofMax);
+      break;
+    }
+  } else {
+    switch (eventType) {
+    case TOF:
+      numDel = this->maskTofHelper(this->events, tofMin, tofMax);
+      break;
+    case WEIGHTED:
+      numDel = this->maskTofHelper(this->weightedEvents, tofMin, tofMax);
+      break;
+    case WEIGHTED_NOTIME:
+      numDel = this->maskTofHelper(this->weightedEventsNoTime, tofMin, tofMax);
+      break;
+    }
   }
 
   if (numDel >= numOrig)
@@ -3328,6 +3540,7 @@ void EventList::setTofsHelper(std::vector<T> &events,
  * @param tofs :: The vector of doubles to set the tofs to.
  */
 void EventList::setTofs(const MantidVec &tofs) {
+  ++m_version;
   this->order = UNSORTED;
 
   // Convert the list
@@ -3430,6 +3643,7 @@ EventList &EventList::operator*=(const double value) {
  * @param error: error on 'value'. Can be 0.
  */
 void EventList::multiply(const double value, const double error) {
+  ++m_version;
   // Do nothing if multiplying by exactly one and there is no error
   if ((value == 1.0) && (error == 0.0))
     return;
@@ -3553,6 +3767,7 @@ void EventList::multiplyHistogramHelper(std::vector<T> &events,
  */
 void EventList::multiply(const MantidVec &X, const MantidVec &Y,
                          const MantidVec &E) {
+  ++m_version;
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3690,6 +3905,7 @@ void EventList::divideHistogramHelper(std::vector<T> &events,
  */
 void EventList::divide(const MantidVec &X, const MantidVec &Y,
                        const MantidVec &E) {
+  ++m_version;
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3738,6 +3954,7 @@ EventList &EventList::operator/=(const double value) {
  * @throw std::invalid_argument if value == 0; cannot divide by zero.
  */
 void EventList::divide(const double value, const double error) {
+  ++m_version;
   if (value == 0.0)
     throw std::invalid_argument(
         "EventList::divide() called with value of 0.0. Cannot divide by zero.");
@@ -3972,6 +4189,7 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
  *     that will be kept. Any other events will be deleted.
  */
 void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
+  ++m_version;
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
 
@@ -4490,6 +4708,172 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Split the events of a vector of either TofEvent's or WeightedEvent's into
+ * the outputs. The intervals and the events sorted by pulse time are walked
+ * through together, as in splitByFullTimeHelper, so the events go to the
+ * same outputs. The destination of every event is found first, so that each
+ * output is reserved once to its final size.
+ *
+ * @param splitter :: The sorted intervals and their destinations
+ * @param outputs :: One output per destination index of the splitter
+ * @param events :: either this->events or this->weightedEvents.
+ * @param eventTime :: Gives the time of an event in nanoseconds
+ */
+template <class T, class TimeFunction>
+void EventList::splitByIndexHelper(const Kernel::SplitterIndex &splitter,
+                                   const std::vector<EventList *> &outputs,
+                                   const std::vector<T> &events,
+                                   TimeFunction eventTime) const {
+  const auto &starts = splitter.starts();
+  const auto &stops = splitter.stops();
+  const auto &intervalDestinations = splitter.destinations();
+  const size_t numIntervals = splitter.size();
+  // Events after the last interval are not copied anywhere
+  const size_t nowhere = outputs.size();
+
+  std::vector<size_t> destinations(events.size(), nowhere);
+  std::vector<size_t> counts(outputs.size(), 0);
+  size_t interval = 0;
+  bool inside = false;
+  for (size_t i = 0; i < events.size() && interval < numIntervals; ++i) {
+    const int64_t time = eventTime(events[i]);
+    while (interval < numIntervals) {
+      if (!inside) {
+        // Before the start of the interval: record to index = -1
+        if (time < starts[interval]) {
+          destinations[i] = splitter.unfiltered();
+          break;
+        }
+        inside = true;
+      }
+      if (time < stops[interval]) {
+        destinations[i] = intervalDestinations[interval];
+        break;
+      }
+      // Go to the next interval
+      inside = false;
+      ++interval;
+    }
+    if (destinations[i] != nowhere)
+      ++counts[destinations[i]];
+  }
+
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (counts[i] > 0)
+      outputs[i]->reserve(counts[i]);
+  }
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (destinations[i] != nowhere)
+      outputs[destinations[i]]->addEventQuickly(events[i]);
+  }
+}
+
+/** Clear the outputs of a split and give them the detector IDs, the X values
+ * and the event type of this list
+ * @param outputs :: The outputs of the split
+ */
+void EventList::prepareSplitOutputs(
+    const std::vector<EventList *> &outputs) const {
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::splitByTime() called on an EventList "
+                             "that no longer has time information.");
+  for (auto output : outputs) {
+    output->clear();
+    output->setDetectorIDs(this->getDetectorIDs());
+    output->setHistogram(m_histogram);
+    // Match the output event type.
+    output->switchTo(eventType);
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Split the event list into one output per destination by event's full time
+ * (tof + pulse time). Gives the same result as the version taking a
+ * TimeSplitterType, without looking up the outputs in a map.
+ *
+ * @param splitter :: The sorted intervals and their destinations
+ * @param outputs :: One output per destination index of the splitter, in the
+ * order of splitter.indices()
+ * @param docorrection :: a boolean to indiciate whether it is need to do
+ *correction
+ * @param toffactor:  a correction factor for each TOF to multiply with
+ * @param tofshift:  a correction shift for each TOF to add with
+ */
+void EventList::splitByFullTime(const Kernel::SplitterIndex &splitter,
+                                const std::vector<EventList *> &outputs,
+                                bool docorrection, double toffactor,
+                                double tofshift) const {
+  if (outputs.size() != splitter.indices().size())
+    throw std::invalid_argument("EventList::splitByFullTime() needs one "
+                                "output per destination of the splitter.");
+  prepareSplitOutputs(outputs);
+  this->sortPulseTimeTOF();
+
+  if (splitter.size() == 0) {
+    // Copy all events to group workspace = -1
+    *outputs[splitter.unfiltered()] = *this;
+    return;
+  }
+
+  auto fullTime = [docorrection, toffactor, tofshift](const TofEvent &event) {
+    const int64_t pulseTime = event.pulseTime().totalNanoseconds();
+    if (docorrection)
+      return calculateCorrectedFullTime(pulseTime, event.tof(), toffactor,
+                                        tofshift);
+    return pulseTime + static_cast<int64_t>(event.tof() * 1000);
+  };
+  switch (eventType) {
+  case TOF:
+    splitByIndexHelper(splitter, outputs, this->events, fullTime);
+    break;
+  case WEIGHTED:
+    splitByIndexHelper(splitter, outputs, this->weightedEvents, fullTime);
+    break;
+  case WEIGHTED_NOTIME:
+    break;
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Split the event list into one output per destination by pulse time.
+ * Gives the same result as the version taking a TimeSplitterType, without
+ * looking up the outputs in a map.
+ *
+ * @param splitter :: The sorted intervals and their destinations
+ * @param outputs :: One output per destination index of the splitter, in the
+ * order of splitter.indices()
+ */
+void EventList::splitByPulseTime(
+    const Kernel::SplitterIndex &splitter,
+    const std::vector<EventList *> &outputs) const {
+  if (outputs.size() != splitter.indices().size())
+    throw std::invalid_argument("EventList::splitByPulseTime() needs one "
+                                "output per destination of the splitter.");
+  prepareSplitOutputs(outputs);
+  this->sortPulseTimeTOF();
+
+  if (splitter.size() == 0) {
+    // No splitter: copy all events to group workspace = -1
+    *outputs[splitter.unfiltered()] = *this;
+    return;
+  }
+
+  auto pulseTime = [](const TofEvent &event) {
+    return event.pulseTime().totalNanoseconds();
+  };
+  switch (eventType) {
+  case TOF:
+    splitByIndexHelper(splitter, outputs, this->events, pulseTime);
+    break;
+  case WEIGHTED:
+    splitByIndexHelper(splitter, outputs, this->weightedEvents, pulseTime);
+    break;
+  case WEIGHTED_NOTIME:
+    break;
+  }
+}
+
 //--------------------------------------------------------------------------
 /** Get the vector of events contained in an EventList;
  * this is overloaded by event type.
@@ -4555,13 +4939,18 @@ template <class T>
 void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
                                          Mantid::Kernel::Unit *fromUnit,
                                          Mantid::Kernel::Unit *toUnit) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  for (; itev != itev_end; itev++) {
-    // Conver to TOF
-    double tof = fromUnit->singleToTOF(itev->m_tof);
-    // And back from TOF to whatever
-    itev->m_tof = toUnit->singleFromTOF(tof);
+  // Convert blocks of values through a contiguous buffer, so that the units
+  // can use their array conversions
+  const size_t blockSize = 1024;
+  double x[blockSize];
+  const size_t numEvents = events.size();
+  for (size_t start = 0; start < numEvents; start += blockSize) {
+    const size_t count = std::min(blockSize, numEvents - start);
+    for (size_t i = 0; i < count; ++i)
+      x[i] = events[start + i].m_tof;
+    fromUnit->convertViaTOF(*toUnit, x, x, count);
+    for (size_t i = 0; i < count; ++i)
+      events[start + i].m_tof = x[i];
   }
 }
 
@@ -4575,6 +4964,7 @@ void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
  */
 void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
                                    Mantid::Kernel::Unit *toUnit) {
+  ++m_version;
   // Check for initialized
   if (!fromUnit || !toUnit)
     throw std::runtime_error(
@@ -4623,6 +5013,7 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
  *  @param power :: the Power b to apply to the conversion
  */
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+  ++m_version;
   switch (eventType) {
   case TOF:
     convertUnitsQuicklyHelper(this->events, factor, power);
@@ -4637,8 +5028,7 @@ void EventList::convertUnitsQuickly(const double &factor, const double &power) {
 }
 
 HistogramData::Histogram &EventList::mutableHistogramRef() {
-  if (mru)
-    mru->deleteIndex(this);
+  ++m_version;
   return m_histogram;
 }
 
@@ -46,6 +46,8 @@ EventWorkspace::EventWorkspace(const EventWorkspace &other)
     newel->setMRU(this->mru);
     this->data.push_back(newel);
   }
+  // The copied event lists have the same histograms, keep them cached.
+  mru->copyEntries(*other.mru, other.data, this->data);
 }
 
 EventWorkspace::~EventWorkspace() {
@@ -392,21 +394,29 @@ void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
 /// @returns If the data is a histogram - always true for an eventWorkspace
 bool EventWorkspace::isHistogramData() const { return true; }
 
-/** Return how many entries in the Y MRU list are used.
- * Only used in tests. It only returns the 0-th MRU list size.
- * @return :: number of entries in the MRU list.
+/** Return how many histograms are held in the MRU.
+ * @return :: number of entries in the MRU.
  */
 size_t EventWorkspace::MRUSize() const { return mru->MRUSize(); }
 
 /** Clears the MRU lists */
 void EventWorkspace::clearMRU() const { mru->clear(); }
 
+/// @return the number of histograms that were found in the MRU
+size_t EventWorkspace::histogramCacheHits() const { return mru->hits(); }
+
+/// @return the number of histograms that were not found in the MRU
+size_t EventWorkspace::histogramCacheMisses() const { return mru->misses(); }
+
+/// @return the memory used by the histograms in the MRU in bytes
+size_t EventWorkspace::histogramCacheMemory() const {
+  return mru->memorySize();
+}
+
 /// Returns the amount of memory used in bytes
 size_t EventWorkspace::getMemorySize() const {
-  // TODO: Add the MRU buffer
-
   // Add the memory from all the event lists
-  size_t total = std::accumulate(data.begin(), data.end(), size_t{0},
+  size_t total = std::accumulate(data.begin(), data.end(), mru->memorySize(),
                                  [](size_t total, EventList *list) {
                                    return total + list->getMemorySize();
                                  });
@@ -561,9 +571,8 @@ public:
       m_cost += n * log(n);
     }
 
-    if (!((m_howManyCores == 1) || (m_howManyCores == 2) ||
-          (m_howManyCores == 4)))
-      throw std::invalid_argument("howManyCores should be 1,2 or 4.");
+    if (m_howManyCores < 1)
+      throw std::invalid_argument("howManyCores should be at least 1.");
   }
 
   // Execute the sort as specified.
@@ -571,17 +580,7 @@ public:
     if (!m_WS)
       return;
     for (size_t wi = m_wiStart; wi < m_wiStop; wi++) {
-      if (m_sortType != TOF_SORT)
-        m_WS->getSpectrum(wi).sort(m_sortType);
-      else {
-        if (m_howManyCores == 1) {
-          m_WS->getSpectrum(wi).sort(m_sortType);
-        } else if (m_howManyCores == 2) {
-          m_WS->getSpectrum(wi).sortTof2();
-        } else if (m_howManyCores == 4) {
-          m_WS->getSpectrum(wi).sortTof4();
-        }
-      }
+      m_WS->getSpectrum(wi).sort(m_sortType, m_howManyCores);
       // Report progress
       if (prog)
         prog->report("Sorting");
@@ -647,15 +646,11 @@ void EventWorkspace::sortAll(EventSortType sortType,
   size_t howManyThreads = 0;
 #ifdef _OPENMP
   if (data.size() < num_threads * 10) {
-    // If you have few vectors, sort with 2 cores.
-    chunk_size = 1;
-    howManyCores = 2;
-    howManyThreads = num_threads / 2 + 1;
-  } else if (data.size() < num_threads) {
-    // If you have very few vectors, sort with 4 cores.
+    // If you have few vectors, share the cores between them, with at least 2
+    // cores per vector.
     chunk_size = 1;
-    howManyCores = 4;
-    howManyThreads = num_threads / 4 + 1;
+    howManyCores = std::max<size_t>(num_threads / data.size(), 2);
+    howManyThreads = num_threads / howManyCores + 1;
   }
 #endif
   g_log.debug() << "Performing sort with " << howManyCores
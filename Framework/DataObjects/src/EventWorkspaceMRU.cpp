@@ -1,152 +1,392 @@
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
+#include "MantidKernel/make_unique.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 
 namespace Mantid {
 namespace DataObjects {
 
+namespace {
+/// Memory budget in megabytes if none is configured
+const size_t DEFAULT_MEMORY_LIMIT_MB = 256;
+/// Number of histograms each thread keeps alive after it was handed them
+const size_t PINNED_HISTOGRAMS_PER_THREAD = 50;
+/// Number of shards of the cache per thread
+const size_t SHARDS_PER_THREAD = 4;
+/// Value of Shard::oldest when none of the entries of a shard may be evicted
+const uint64_t NOTHING_TO_EVICT = std::numeric_limits<uint64_t>::max();
+
+/// Read the memory budget in bytes from the configuration
+size_t configuredMemoryLimit() {
+  int megabytes(0);
+  if (Kernel::ConfigService::Instance().getValue(
+          "EventWorkspace.HistogramCacheMB", megabytes) > 0 &&
+      megabytes >= 0)
+    return static_cast<size_t>(megabytes) * 1024 * 1024;
+  return DEFAULT_MEMORY_LIMIT_MB * 1024 * 1024;
+}
+}
+
+/// Memory budget shared by several caches
+struct EventWorkspaceMRU::Budget {
+  explicit Budget(size_t memoryLimit) : limit(memoryLimit) {}
+  /// Memory budget in bytes
+  std::atomic<size_t> limit;
+  /// Memory used by the entries of all the caches in bytes
+  std::atomic<size_t> used{0};
+  /// Clock giving the time of the last use of the entries
+  std::atomic<uint64_t> clock{0};
+  /// Caches sharing the budget
+  std::vector<EventWorkspaceMRU *> caches;
+  /// Mutex guarding the caches. It is taken before the mutex of any shard.
+  std::mutex mutex;
+};
+
+/// Constructor using the memory budget shared by all the EventWorkspaces
+EventWorkspaceMRU::EventWorkspaceMRU()
+    : EventWorkspaceMRU(sharedBudget(), 0,
+                        SHARDS_PER_THREAD *
+                            static_cast<size_t>(PARALLEL_GET_MAX_THREADS)) {}
+
+/** Constructor of a cache with a budget of its own
+ * @param memoryLimit :: memory budget in bytes
+ * @param minimumEntries :: number of most recently used entries that are kept
+ * even if they exceed the budget, split between the shards
+ * @param numberOfShards :: number of independently locked parts of the cache
+ */
+EventWorkspaceMRU::EventWorkspaceMRU(size_t memoryLimit, size_t minimumEntries,
+                                     size_t numberOfShards)
+    : EventWorkspaceMRU(std::make_shared<Budget>(memoryLimit), minimumEntries,
+                        numberOfShards) {}
+
+/** Constructor
+ * @param budget :: memory budget the cache takes part in
+ * @param minimumEntries :: number of most recently used entries that are kept
+ * even if they exceed the budget, split between the shards
+ * @param numberOfShards :: number of independently locked parts of the cache
+ */
+EventWorkspaceMRU::EventWorkspaceMRU(std::shared_ptr<Budget> budget,
+                                     size_t minimumEntries,
+                                     size_t numberOfShards)
+    : m_budget(std::move(budget)) {
+  numberOfShards = std::max(numberOfShards, size_t(1));
+  m_minimumEntries = (minimumEntries + numberOfShards - 1) / numberOfShards;
+  for (size_t i = 0; i < numberOfShards; ++i)
+    m_shards.push_back(Kernel::make_unique<Shard>());
+  const auto numberOfThreads =
+      std::max(static_cast<size_t>(PARALLEL_GET_MAX_THREADS), size_t(1));
+  for (size_t i = 0; i < numberOfThreads; ++i)
+    m_pins.push_back(Kernel::make_unique<Pins>());
+  std::lock_guard<std::mutex> _lock(m_budget->mutex);
+  m_budget->caches.push_back(this);
+}
+
+/// Destructor. Returns the memory of the entries to the budget.
 EventWorkspaceMRU::~EventWorkspaceMRU() {
-  // Make sure you free up the memory in the MRUs
-  for (auto &data : m_bufferedDataY) {
-    if (data) {
-      data->clear();
-      delete data;
-    }
+  {
+    std::lock_guard<std::mutex> _lock(m_budget->mutex);
+    auto &caches = m_budget->caches;
+    caches.erase(std::remove(caches.begin(), caches.end(), this),
+                 caches.end());
   }
+  clear();
+}
 
-  for (auto &data : m_bufferedDataE) {
-    if (data) {
-      data->clear();
-      delete data;
-    }
-  }
+/** The budget shared by the caches of all the EventWorkspaces, read from the
+ * configuration when it is first used. Each cache holds on to it, so that it
+ * outlives workspaces destroyed at exit.
+ */
+std::shared_ptr<EventWorkspaceMRU::Budget> EventWorkspaceMRU::sharedBudget() {
+  static auto budget = std::make_shared<Budget>(configuredMemoryLimit());
+  return budget;
 }
 
 //---------------------------------------------------------------------------
-/** This function makes sure that there are enough data
- * buffers (MRU's) for E for the number of threads requested.
- * @param thread_num :: thread number that wants a MRU buffer
+/** Find the histogram of an event list in the cache. Entries that were
+ * generated from an older version of the event list or with different X
+ * binning are dropped.
+ *
+ * @param index :: event list whose histogram is wanted
+ * @param version :: current modification counter of the event list
+ * @param x :: identity of the current X binning of the event list
+ * @param y :: set to the cached Y histogram if found
+ * @param e :: set to the cached E histogram if found
+ * @return true if a valid entry was found
  */
-void EventWorkspaceMRU::ensureEnoughBuffersE(size_t thread_num) const {
-  std::lock_guard<std::mutex> _lock(m_changeMruListsMutexE);
-  if (m_bufferedDataE.size() <= thread_num) {
-    m_bufferedDataE.resize(thread_num + 1, nullptr);
-    for (auto &data : m_bufferedDataE) {
-      if (!data)
-        data = new mru_listE(50); // Create a MRU list with this many entries.
+bool EventWorkspaceMRU::find(const EventList *index, size_t version,
+                             const void *x, YType &y, EType &e) {
+  bool found = false;
+  {
+    auto &shard = shardOf(index);
+    std::lock_guard<std::mutex> _lock(shard.mutex);
+    auto it = shard.lookup.find(index);
+    if (it != shard.lookup.end()) {
+      auto entry = it->second;
+      if (entry->version == version && entry->x == x) {
+        // Move to the front of the list
+        entry->lastUsed = ++m_budget->clock;
+        shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+        updateOldest(shard);
+        y = entry->y;
+        e = entry->e;
+        found = true;
+      } else {
+        // Stale, free the memory now
+        removeEntry(shard, entry);
+      }
     }
   }
+  if (found) {
+    ++m_hits;
+    pin(y, e);
+  } else
+    ++m_misses;
+  return found;
 }
-//---------------------------------------------------------------------------
-/** This function makes sure that there are enough data
- * buffers (MRU's) for Y for the number of threads requested.
- * @param thread_num :: thread number that wants a MRU buffer
+
+/** Insert a new histogram into the cache. If another thread has inserted a
+ * valid histogram for the same event list in the meantime that one is kept,
+ * and returned through y and e, so that references to it remain valid.
+ *
+ * @param index :: event list the histogram was generated from
+ * @param version :: modification counter of the event list
+ * @param x :: identity of the X binning used
+ * @param y :: the new Y histogram
+ * @param e :: the new E histogram
  */
-void EventWorkspaceMRU::ensureEnoughBuffersY(size_t thread_num) const {
-  std::lock_guard<std::mutex> _lock(m_changeMruListsMutexY);
-  if (m_bufferedDataY.size() <= thread_num) {
-    m_bufferedDataY.resize(thread_num + 1, nullptr);
-    for (auto &data : m_bufferedDataY) {
-      if (!data)
-        data = new mru_listY(50); // Create a MRU list with this many entries.
+void EventWorkspaceMRU::insert(const EventList *index, size_t version,
+                               const void *x, YType &y, EType &e) {
+  bool keepExisting = false;
+  {
+    auto &shard = shardOf(index);
+    std::lock_guard<std::mutex> _lock(shard.mutex);
+    auto it = shard.lookup.find(index);
+    if (it != shard.lookup.end()) {
+      auto entry = it->second;
+      if (entry->version == version && entry->x == x) {
+        y = entry->y;
+        e = entry->e;
+        keepExisting = true;
+      } else
+        removeEntry(shard, entry);
+    }
+    if (!keepExisting) {
+      const size_t bytes =
+          sizeof(Entry) + (y->size() + e->size()) * sizeof(double);
+      addEntry(shard, Entry{index, version, x, y, e, bytes, 0});
     }
   }
+  if (!keepExisting)
+    evict();
+  pin(y, e);
+}
+
+/** Delete the entry of an event list, if any
+ *
+ * @param index :: event list to delete.
+ */
+void EventWorkspaceMRU::deleteIndex(const EventList *index) {
+  auto &shard = shardOf(index);
+  std::lock_guard<std::mutex> _lock(shard.mutex);
+  auto it = shard.lookup.find(index);
+  if (it != shard.lookup.end())
+    removeEntry(shard, it->second);
 }
 
 //---------------------------------------------------------------------------
-/// Clear all the data in the MRU buffers
+/// Clear all the data in the cache, including the histograms kept alive for
+/// the threads
 void EventWorkspaceMRU::clear() {
-  // Make sure you free up the memory in the MRUs
-  for (auto &data : m_bufferedDataY)
-    if (data) {
-      data->clear();
-    };
-
-  for (auto &data : m_bufferedDataE)
-    if (data) {
-      data->clear();
-    };
+  for (auto &shard : m_shards) {
+    std::lock_guard<std::mutex> _lock(shard->mutex);
+    m_budget->used -= shard->memorySize;
+    shard->entries.clear();
+    shard->lookup.clear();
+    shard->memorySize = 0;
+    updateOldest(*shard);
+  }
+  for (auto &pins : m_pins) {
+    std::lock_guard<std::mutex> _lock(pins->mutex);
+    pins->histograms.clear();
+    pins->next = 0;
+  }
 }
 
-//---------------------------------------------------------------------------
-/** Find a Y histogram in the MRU
+/** Copy the entries of another cache, e.g. when copying a workspace. The
+ * entries of otherIndices[i] become entries of indices[i]. Validity is still
+ * checked on lookup, so copying entries of event lists that differ is safe.
  *
- * @param thread_num :: number of the thread in which this is run
- * @param index :: index of the data to return
- * @return pointer to the TypeWithMarker that has the data; NULL if not found.
+ * @param other :: cache to copy from
+ * @param otherIndices :: event lists the entries of other belong to
+ * @param indices :: event lists that take over the entries
  */
-Kernel::cow_ptr<HistogramData::HistogramY>
-EventWorkspaceMRU::findY(size_t thread_num, const EventList *index) {
-  std::lock_guard<std::mutex> _lock(m_changeMruListsMutexY);
-  auto result = m_bufferedDataY[thread_num]->find(
-      reinterpret_cast<const std::uintptr_t>(index));
-  if (result)
-    return result->m_data;
-  return YType(nullptr);
+void EventWorkspaceMRU::copyEntries(const EventWorkspaceMRU &other,
+                                    const std::vector<EventList *> &otherIndices,
+                                    const std::vector<EventList *> &indices) {
+  std::unordered_map<const EventList *, const EventList *> newIndex;
+  for (size_t i = 0; i < otherIndices.size() && i < indices.size(); ++i)
+    newIndex.emplace(otherIndices[i], indices[i]);
+
+  for (const auto &otherShard : other.m_shards) {
+    // Take a snapshot first, so that only one lock is held at a time
+    std::vector<Entry> entries;
+    {
+      std::lock_guard<std::mutex> _lock(otherShard->mutex);
+      // Least recently used first, so that the order is preserved
+      entries.assign(otherShard->entries.rbegin(), otherShard->entries.rend());
+    }
+    for (auto &entry : entries) {
+      auto index = newIndex.find(entry.index);
+      if (index == newIndex.end())
+        continue;
+      auto &shard = shardOf(index->second);
+      std::lock_guard<std::mutex> _lock(shard.mutex);
+      if (shard.lookup.count(index->second))
+        continue;
+      entry.index = index->second;
+      addEntry(shard, std::move(entry));
+    }
+  }
+  evict();
 }
 
-/** Find a Y histogram in the MRU
- *
- * @param thread_num :: number of the thread in which this is run
- * @param index :: index of the data to return
- * @return pointer to the TypeWithMarker that has the data; NULL if not found.
+/** Set the memory budget, evicting entries if necessary. This applies to
+ * all the caches sharing the budget.
+ * @param memoryLimit :: memory budget in bytes
  */
-Kernel::cow_ptr<HistogramData::HistogramE>
-EventWorkspaceMRU::findE(size_t thread_num, const EventList *index) {
-  std::lock_guard<std::mutex> _lock(m_changeMruListsMutexE);
-  auto result = m_bufferedDataE[thread_num]->find(
-      reinterpret_cast<const std::uintptr_t>(index));
-  if (result)
-    return result->m_data;
-  return EType(nullptr);
+void EventWorkspaceMRU::setMemoryLimit(size_t memoryLimit) {
+  m_budget->limit = memoryLimit;
+  evict();
 }
 
-/** Insert a new histogram into the MRU
- *
- * @param thread_num :: thread being accessed
- * @param data :: the new data
- * @param index :: index of the data to insert
- */
-void EventWorkspaceMRU::insertY(size_t thread_num, YType data,
-                                const EventList *index) {
-  std::lock_guard<std::mutex> _lock(m_changeMruListsMutexY);
-  auto yWithMarker =
-      new TypeWithMarker<YType>(reinterpret_cast<const std::uintptr_t>(index));
-  yWithMarker->m_data = std::move(data);
-  auto oldData = m_bufferedDataY[thread_num]->insert(yWithMarker);
-  // And clear up the memory of the old one, if it is dropping out.
-  delete oldData;
-}
-
-/** Insert a new histogram into the MRU
- *
- * @param thread_num :: thread being accessed
- * @param data :: the new data
- * @param index :: index of the data to insert
+/// @return the memory budget of the cache in bytes
+size_t EventWorkspaceMRU::memoryLimit() const { return m_budget->limit; }
+
+/// @return the number of entries in the cache
+size_t EventWorkspaceMRU::MRUSize() const {
+  size_t size = 0;
+  for (const auto &shard : m_shards) {
+    std::lock_guard<std::mutex> _lock(shard->mutex);
+    size += shard->entries.size();
+  }
+  return size;
+}
+
+/// @return the memory used by the cached histograms in bytes
+size_t EventWorkspaceMRU::memorySize() const {
+  size_t size = 0;
+  for (const auto &shard : m_shards) {
+    std::lock_guard<std::mutex> _lock(shard->mutex);
+    size += shard->memorySize;
+  }
+  return size;
+}
+
+/// @return the memory used by all the caches sharing the budget in bytes
+size_t EventWorkspaceMRU::totalMemorySize() const { return m_budget->used; }
+
+/// @return the shard holding the entry of the given event list
+EventWorkspaceMRU::Shard &
+EventWorkspaceMRU::shardOf(const EventList *index) const {
+  // Event lists are allocated separately, drop the low bits that are the same
+  // for all of them
+  const auto address = reinterpret_cast<std::uintptr_t>(index) >> 4;
+  return *m_shards[address % m_shards.size()];
+}
+
+/// Add an entry as the most recently used one of a shard. The caller must
+/// hold the mutex of the shard.
+void EventWorkspaceMRU::addEntry(Shard &shard, Entry entry) {
+  entry.lastUsed = ++m_budget->clock;
+  shard.memorySize += entry.bytes;
+  m_budget->used += entry.bytes;
+  shard.entries.push_front(std::move(entry));
+  shard.lookup.emplace(shard.entries.front().index, shard.entries.begin());
+  updateOldest(shard);
+}
+
+/// Remove an entry from a shard. The caller must hold the mutex of the shard.
+void EventWorkspaceMRU::removeEntry(Shard &shard,
+                                   std::list<Entry>::iterator entry) {
+  shard.memorySize -= entry->bytes;
+  m_budget->used -= entry->bytes;
+  shard.lookup.erase(entry->index);
+  shard.entries.erase(entry);
+  updateOldest(shard);
+}
+
+/// Publish the last use of the least recently used entry of a shard that may
+/// be evicted. The caller must hold the mutex of the shard.
+void EventWorkspaceMRU::updateOldest(Shard &shard) {
+  shard.oldest = shard.entries.size() > m_minimumEntries
+                     ? shard.entries.back().lastUsed
+                     : NOTHING_TO_EVICT;
+}
+
+/** Drop the least recently used entries of all the caches sharing the budget
+ * until it is met. The caller must not hold the mutex of any shard.
  */
-void EventWorkspaceMRU::insertE(size_t thread_num, EType data,
-                                const EventList *index) {
-  std::lock_guard<std::mutex> _lock(m_changeMruListsMutexE);
-  auto eWithMarker =
-      new TypeWithMarker<EType>(reinterpret_cast<const std::uintptr_t>(index));
-  eWithMarker->m_data = std::move(data);
-  auto oldData = m_bufferedDataE[thread_num]->insert(eWithMarker);
-  // And clear up the memory of the old one, if it is dropping out.
-  delete oldData;
-}
-
-/** Delete any entries in the MRU at the given index
- *
- * @param index :: index to delete.
+void EventWorkspaceMRU::evict() {
+  auto &budget = *m_budget;
+  if (budget.used <= budget.limit)
+    return;
+  std::lock_guard<std::mutex> _lock(budget.mutex);
+  while (budget.used > budget.limit) {
+    // Find the shard with the oldest entry, and the age of the runner-up
+    EventWorkspaceMRU *cache = nullptr;
+    Shard *shard = nullptr;
+    uint64_t oldest = NOTHING_TO_EVICT;
+    uint64_t next = NOTHING_TO_EVICT;
+    for (auto candidate : budget.caches) {
+      for (auto &candidateShard : candidate->m_shards) {
+        const uint64_t lastUsed = candidateShard->oldest;
+        if (lastUsed < oldest) {
+          next = oldest;
+          oldest = lastUsed;
+          cache = candidate;
+          shard = candidateShard.get();
+        } else if (lastUsed < next) {
+          next = lastUsed;
+        }
+      }
+    }
+    if (!shard)
+      return;
+    // Evict from this shard as long as it holds the oldest entries
+    std::lock_guard<std::mutex> _shardLock(shard->mutex);
+    bool first = true;
+    while (budget.used > budget.limit &&
+           shard->entries.size() > cache->m_minimumEntries &&
+           (first || shard->entries.back().lastUsed < next)) {
+      cache->removeEntry(*shard, std::prev(shard->entries.end()));
+      first = false;
+    }
+  }
+}
+
+/** Keep the histograms handed out to the calling thread alive until it has
+ * been handed PINNED_HISTOGRAMS_PER_THREAD more, so that references to them
+ * stay valid when their entry is evicted by another thread.
+ * @param y :: Y histogram handed out
+ * @param e :: E histogram handed out
  */
-void EventWorkspaceMRU::deleteIndex(const EventList *index) {
-  std::lock_guard<std::mutex> _lock1(m_changeMruListsMutexE);
-  for (auto &data : m_bufferedDataE)
-    if (data)
-      data->deleteIndex(reinterpret_cast<const std::uintptr_t>(index));
-  std::lock_guard<std::mutex> _lock2(m_changeMruListsMutexY);
-  for (auto &data : m_bufferedDataY)
-    if (data)
-      data->deleteIndex(reinterpret_cast<const std::uintptr_t>(index));
+void EventWorkspaceMRU::pin(const YType &y, const EType &e) {
+  const auto thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
+  auto &pins = *m_pins[thread % m_pins.size()];
+  // Only contended if threads outside OpenMP share a thread number
+  std::lock_guard<std::mutex> _lock(pins.mutex);
+  if (pins.histograms.size() < PINNED_HISTOGRAMS_PER_THREAD) {
+    pins.histograms.emplace_back(y, e);
+    return;
+  }
+  pins.histograms[pins.next] = std::make_pair(y, e);
+  pins.next = (pins.next + 1) % PINNED_HISTOGRAMS_PER_THREAD;
 }
 
 } // namespace Mantid
@@ -24,10 +24,18 @@ Histogram1D::Histogram1D(HistogramData::Histogram::XMode xmode,
 Histogram1D::Histogram1D(const ISpectrum &other)
     : ISpectrum(other), m_histogram(other.histogram()) {}
 
+/// Copy assignment. The data are set through setHistogram(), so that
+/// derived spectra see them being replaced.
+Histogram1D &Histogram1D::operator=(const Histogram1D &rhs) {
+  ISpectrum::operator=(rhs);
+  setHistogram(rhs.histogramRef());
+  return *this;
+}
+
 /// Assignment from ISpectrum.
 Histogram1D &Histogram1D::operator=(const ISpectrum &rhs) {
   ISpectrum::operator=(rhs);
-  m_histogram = rhs.histogram();
+  setHistogram(rhs.histogram());
   return *this;
 }
 
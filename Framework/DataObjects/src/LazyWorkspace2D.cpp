@@ -0,0 +1,266 @@
+#include "MantidDataObjects/LazyWorkspace2D.h"
+#include "MantidAPI/Run.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** A spectrum of a LazyWorkspace2D. Access to its data goes through the
+ * workspace, which reads them if necessary, while the metadata are held as in
+ * any Histogram1D.
+ */
+class LazyWorkspace2D::LazySpectrum : public Histogram1D {
+public:
+  LazySpectrum(const LazyWorkspace2D &workspace, const size_t index,
+               Histogram1D &&spectrum)
+      : Histogram1D(std::move(spectrum)), m_workspace(workspace),
+        m_index(index) {}
+
+  /// The data of the spectrum as they are in memory, without reading them
+  HistogramData::Histogram &storage() {
+    return Histogram1D::mutableHistogramRef();
+  }
+
+  void setX(const Kernel::cow_ptr<HistogramData::HistogramX> &X) override {
+    mutableHistogramRef().setX(X);
+  }
+  MantidVec &dataX() override { return mutableHistogramRef().dataX(); }
+  const MantidVec &dataX() const override { return histogramRef().dataX(); }
+  const MantidVec &readX() const override { return histogramRef().readX(); }
+  Kernel::cow_ptr<HistogramData::HistogramX> ptrX() const override {
+    return histogramRef().ptrX();
+  }
+
+  MantidVec &dataDx() override { return mutableHistogramRef().dataDx(); }
+  const MantidVec &dataDx() const override { return histogramRef().dataDx(); }
+  const MantidVec &readDx() const override { return histogramRef().readDx(); }
+
+  const MantidVec &dataY() const override { return histogramRef().dataY(); }
+  const MantidVec &dataE() const override { return histogramRef().dataE(); }
+  MantidVec &dataY() override { return mutableHistogramRef().dataY(); }
+  MantidVec &dataE() override { return mutableHistogramRef().dataE(); }
+
+  std::size_t size() const override { return histogramRef().readY().size(); }
+
+  HistogramData::Histogram histogram() const override {
+    return m_workspace.copy(m_index);
+  }
+  Kernel::cow_ptr<HistogramData::HistogramY> sharedY() const override {
+    return m_workspace.copy(m_index).sharedY();
+  }
+  Kernel::cow_ptr<HistogramData::HistogramE> sharedE() const override {
+    return m_workspace.copy(m_index).sharedE();
+  }
+
+protected:
+  /// setHistogram() replaces all the data, so they are not read before
+  void checkAndSanitizeHistogram(HistogramData::Histogram &) override {
+    m_workspace.makeResident(m_index, true);
+  }
+
+private:
+  const HistogramData::Histogram &histogramRef() const override {
+    m_workspace.makeResident(m_index, false);
+    return Histogram1D::histogramRef();
+  }
+  HistogramData::Histogram &mutableHistogramRef() override {
+    m_workspace.makeResident(m_index, false);
+    return storage();
+  }
+
+  const LazyWorkspace2D &m_workspace;
+  const size_t m_index;
+};
+
+/** Copy constructor. The copy shares the loader but has its own cache.
+ * @param other :: The workspace to copy
+ */
+LazyWorkspace2D::LazyWorkspace2D(const LazyWorkspace2D &other)
+    : LazyWorkspace2D(other, std::unique_lock<std::mutex>(other.m_mutex)) {}
+
+/** Copy the workspace while holding its lock, so that no spectrum is read or
+ * evicted while the data are copied.
+ * @param other :: The workspace to copy
+ */
+LazyWorkspace2D::LazyWorkspace2D(const LazyWorkspace2D &other,
+                                 std::unique_lock<std::mutex> &&)
+    : Workspace2D(other), m_loader(other.m_loader),
+      m_cacheSize(other.m_cacheSize), m_unloadedX(other.m_unloadedX),
+      m_unloadedY(other.m_unloadedY), m_unloadedE(other.m_unloadedE),
+      m_state(other.m_state), m_cachePosition(other.m_state.size()),
+      m_numberResident(other.m_numberResident) {
+  makeSpectraLazy();
+  for (auto it = other.m_cache.rbegin(); it != other.m_cache.rend(); ++it) {
+    m_cache.push_front(*it);
+    m_cachePosition[*it] = m_cache.begin();
+  }
+}
+
+/** Sets the size of the workspace and initializes arrays to zero. The data
+ * of the spectra are placeholders until they are loaded.
+ *
+ * @param NVectors :: The number of vectors/histograms/detectors in the
+ * workspace
+ * @param XLength :: The number of X data points/bin boundaries in each vector
+ * @param YLength :: The number of data/error points in each vector
+ */
+void LazyWorkspace2D::init(const std::size_t &NVectors,
+                           const std::size_t &XLength,
+                           const std::size_t &YLength) {
+  Workspace2D::init(NVectors, XLength, YLength);
+  m_state.assign(NVectors, State::Unloaded);
+  m_cachePosition.resize(NVectors);
+  // All spectra share the same data after init()
+  if (!data.empty()) {
+    m_unloadedX = data[0]->sharedX();
+    m_unloadedY = data[0]->sharedY();
+    m_unloadedE = data[0]->sharedE();
+  }
+  makeSpectraLazy();
+}
+
+/// Replace the spectra created by Workspace2D by spectra reading on demand
+void LazyWorkspace2D::makeSpectraLazy() {
+  for (size_t i = 0; i < data.size(); ++i) {
+    auto spectrum = new LazySpectrum(*this, i, std::move(*data[i]));
+    delete data[i];
+    data[i] = spectrum;
+  }
+}
+
+/** Start reading the data of the spectra on demand. The workspace should be
+ * fully set up before, as the data of a spectrum are read on their first
+ * access from then on.
+ *
+ * @param loader :: Reads the data of the spectra
+ * @param cacheSize :: The maximum number of spectra handed out as copies that
+ * are kept in memory
+ */
+void LazyWorkspace2D::setLoader(boost::shared_ptr<SpectrumLoader> loader,
+                                const size_t cacheSize) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_loader = std::move(loader);
+  m_cacheSize = std::max(cacheSize, size_t(1));
+  while (m_cache.size() > m_cacheSize)
+    evict(m_cache.back());
+}
+
+/** Whether the data of a spectrum are in memory
+ * @param index :: The workspace index of the spectrum
+ * @return true if there is no loader or the spectrum has been read and not
+ * been evicted since
+ */
+bool LazyWorkspace2D::isResident(const size_t index) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return !m_loader || m_state.at(index) != State::Unloaded;
+}
+
+/// The number of spectra whose data are in memory
+size_t LazyWorkspace2D::numberOfResidentSpectra() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cache.size() + m_numberResident;
+}
+
+/// The number of bins, without reading the first spectrum to find it
+std::size_t LazyWorkspace2D::blocksize() const {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_loader && !data.empty() && m_state[0] == State::Unloaded)
+      return m_unloadedY->size();
+  }
+  return Workspace2D::blocksize();
+}
+
+/// The memory used by the resident spectra and the logs
+size_t LazyWorkspace2D::getMemorySize() const {
+  if (data.empty())
+    return run().getMemorySize();
+  if (!m_loader)
+    return getNumberHistograms() * data[0]->getMemorySize() +
+           run().getMemorySize();
+  const size_t spectrumSize =
+      (m_unloadedX->size() + m_unloadedY->size() + m_unloadedE->size()) *
+      sizeof(double);
+  return numberOfResidentSpectra() * spectrumSize + run().getMemorySize();
+}
+
+/// The spectrum at a workspace index
+LazyWorkspace2D::LazySpectrum &
+LazyWorkspace2D::lazySpectrum(const size_t index) const {
+  return static_cast<LazySpectrum &>(*data[index]);
+}
+
+/** Keep the data of a spectrum in memory for the lifetime of the workspace,
+ * as a reference to them is handed out. They are read if necessary.
+ * @param index :: The workspace index
+ * @param replace :: If true all the data are about to be replaced, so they
+ * are not read
+ */
+void LazyWorkspace2D::makeResident(const size_t index,
+                                   const bool replace) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_loader || m_state[index] == State::Resident)
+    return;
+
+  if (m_state[index] == State::Cached)
+    m_cache.erase(m_cachePosition[index]);
+  else if (!replace)
+    load(index);
+  m_state[index] = State::Resident;
+  ++m_numberResident;
+}
+
+/** Return a copy of the data of a spectrum. They are read if necessary and
+ * the spectrum becomes the most recently used one in the cache, unless it is
+ * resident.
+ * @param index :: The workspace index
+ * @return the data of the spectrum, sharing their storage
+ */
+HistogramData::Histogram LazyWorkspace2D::copy(const size_t index) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto &storage = lazySpectrum(index).storage();
+  if (!m_loader || m_state[index] == State::Resident)
+    return storage;
+
+  if (m_state[index] == State::Unloaded) {
+    load(index);
+    if (m_cache.size() >= m_cacheSize)
+      evict(m_cache.back());
+  } else {
+    m_cache.erase(m_cachePosition[index]);
+  }
+  m_cache.push_front(index);
+  m_cachePosition[index] = m_cache.begin();
+  m_state[index] = State::Cached;
+  return storage;
+}
+
+/** Read the data of a spectrum through the loader. Must be called with the
+ * lock held. The spectrum keeps its placeholders if the loader throws.
+ * @param index :: The workspace index
+ */
+void LazyWorkspace2D::load(const size_t index) const {
+  auto &storage = lazySpectrum(index).storage();
+  Histogram1D spectrum(storage.xMode(), storage.yMode());
+  spectrum.setHistogram(storage);
+  m_loader->load(index, spectrum);
+  storage = spectrum.histogram();
+}
+
+/** Replace the data of a cached spectrum by the placeholders. Must be called
+ * with the lock held. Copies of the data handed out stay valid.
+ * @param index :: The workspace index of a cached spectrum
+ */
+void LazyWorkspace2D::evict(const size_t index) const {
+  m_cache.erase(m_cachePosition[index]);
+  m_state[index] = State::Unloaded;
+  auto &spectrum = lazySpectrum(index).storage();
+  spectrum.setSharedX(m_unloadedX);
+  spectrum.setSharedY(m_unloadedY);
+  spectrum.setSharedE(m_unloadedE);
+  spectrum.setSharedDx(Kernel::cow_ptr<HistogramData::HistogramDx>(nullptr));
+}
+
+} // namespace DataObjects
+} // namespace Mantid
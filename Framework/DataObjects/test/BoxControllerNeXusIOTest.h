@@ -226,6 +226,72 @@ public:
 
   void test_WriteFloatReadDouble() { this->WriteReadRead<float, double>(); }
 
+  void test_contiguous_file_is_memory_mapped() {
+    using Mantid::DataObjects::BoxControllerNeXusIO;
+    std::unique_ptr<BoxControllerNeXusIO> pSaver(createTestBoxController());
+    pSaver->setDataType(sizeof(float), "MDEvent");
+    const size_t nEvents = 20;
+    pSaver->setContiguousFileLength(100 + nEvents);
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    std::string FullPathFile = pSaver->getFileName();
+    TS_ASSERT(!pSaver->isMemoryMapped());
+
+    const size_t nColumns = pSaver->getNDataColums();
+    std::vector<float> toWrite(nColumns * nEvents);
+    for (size_t i = 0; i < toWrite.size(); i++)
+      toWrite[i] = static_cast<float>(i);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 100));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    pSaver->setMemoryMapped(true);
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    TS_ASSERT(pSaver->isMemoryMapped());
+    const float *mapped(nullptr);
+    TS_ASSERT(pSaver->getMappedBlock(mapped, 100, nEvents));
+    std::vector<float> toRead;
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 100, nEvents));
+    TS_ASSERT_EQUALS(toRead.size(), toWrite.size());
+    for (size_t i = 0; i < toWrite.size(); i++) {
+      TS_ASSERT_EQUALS(mapped[i], toWrite[i]);
+      TS_ASSERT_EQUALS(toRead[i], toWrite[i]);
+    }
+    // Other data type or behind the end of the file
+    const double *mappedDouble(nullptr);
+    TS_ASSERT(!pSaver->getMappedBlock(mappedDouble, 100, nEvents));
+    TS_ASSERT_THROWS_ANYTHING(pSaver->getMappedBlock(mapped, 110, nEvents));
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+    TS_ASSERT(!pSaver->isMemoryMapped());
+    pSaver.reset();
+    if (Poco::File(FullPathFile).exists())
+      Poco::File(FullPathFile).remove();
+  }
+
+  void test_chunked_file_is_not_memory_mapped() {
+    using Mantid::DataObjects::BoxControllerNeXusIO;
+    std::unique_ptr<BoxControllerNeXusIO> pSaver(createTestBoxController());
+    pSaver->setDataType(sizeof(float), "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    std::string FullPathFile = pSaver->getFileName();
+    std::vector<float> toWrite(pSaver->getNDataColums() * 10, 1.f);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 0));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    pSaver->setMemoryMapped(true);
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    TS_ASSERT(!pSaver->isMemoryMapped());
+    const float *mapped(nullptr);
+    TS_ASSERT(!pSaver->getMappedBlock(mapped, 0, 10));
+    std::vector<float> toRead;
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 0, 10));
+    TS_ASSERT_EQUALS(toRead, toWrite);
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+    pSaver.reset();
+    if (Poco::File(FullPathFile).exists())
+      Poco::File(FullPathFile).remove();
+  }
+
 private:
   /// Create a test box controller. Ownership is passed to the caller
   Mantid::DataObjects::BoxControllerNeXusIO *createTestBoxController() {
@@ -159,6 +159,35 @@ public:
     compare(3, out, expected);
   }
 
+  /** applyBatch gives the same result as apply for the centers of a vector
+   * of events, across several blocks */
+  void test_applyBatch_matches_apply() {
+    CoordTransformAffine ct(4, 3);
+    Matrix<coord_t> transform(4, 5);
+    for (size_t row = 0; row < 3; ++row)
+      for (size_t col = 0; col < 5; ++col)
+        transform[row][col] = static_cast<coord_t>(row + 1) * 0.5f -
+                              static_cast<coord_t>(col) * 0.25f;
+    transform[3][4] = 1.0;
+    ct.setMatrix(transform);
+
+    std::vector<MDLeanEvent<4>> events;
+    for (size_t i = 0; i < 1000; ++i) {
+      coord_t center[4] = {static_cast<coord_t>(i), 0.5f * i, -1.0f * i, 7.0f};
+      events.emplace_back(1.0f, 1.0f, center);
+    }
+    std::vector<coord_t> out(events.size() * 3);
+    ct.applyBatch(events[0].getCenter(), sizeof(MDLeanEvent<4>), events.size(),
+                  out.data());
+
+    coord_t expected[3];
+    for (size_t i = 0; i < events.size(); ++i) {
+      ct.apply(events[i].getCenter(), expected);
+      for (size_t d = 0; d < 3; ++d)
+        TS_ASSERT_EQUALS(out[i * 3 + d], expected[d]);
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Test a case of a rotation 0.1 radians around +Z,
    * and a projection into the XY plane */
@@ -418,6 +447,18 @@ public:
       ct.apply(in, out);
     }
   }
+  void test_applyBatch_4D_performance() {
+    CoordTransformAffine ct(4, 4);
+    coord_t translation[4] = {2.0, 3.0, 4.0, 5.0};
+    ct.addTranslation(translation);
+    std::vector<MDLeanEvent<4>> events(1000 * 1000);
+    std::vector<coord_t> out(events.size() * 4);
+
+    for (size_t i = 0; i < 10; ++i) {
+      ct.applyBatch(events[0].getCenter(), sizeof(MDLeanEvent<4>),
+                    events.size(), out.data());
+    }
+  }
 };
 
 #endif /* MANTID_DATAOBJECTS_COORDTRANSFORMAFFINETEST_H_ */
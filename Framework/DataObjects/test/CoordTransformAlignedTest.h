@@ -8,6 +8,7 @@
 #include "MantidDataObjects/CoordTransformAligned.h"
 #include "MantidKernel/Matrix.h"
 #include "MantidDataObjects/CoordTransformAffine.h"
+#include "MantidDataObjects/MDEvent.h"
 
 #include <boost/scoped_ptr.hpp>
 
@@ -70,6 +71,28 @@ public:
     TS_ASSERT_DELTA(output[2], 3.0, 1e-6);
   }
 
+  void test_applyBatch() {
+    size_t dimToBinFrom[3] = {3, 1, 0};
+    coord_t origin[3] = {5, 10, 15};
+    coord_t scaling[3] = {1, 2, 3};
+    CoordTransformAligned ct(4, 3, dimToBinFrom, origin, scaling);
+
+    // Full events, with run index and detector ID after the centers
+    std::vector<MDEvent<4>> events;
+    for (size_t i = 0; i < 10; ++i) {
+      coord_t center[4] = {16.0f + i, 11.0f, 0.0f, 6.0f};
+      events.emplace_back(1.0f, 1.0f, uint16_t(1), int32_t(i), center);
+    }
+    std::vector<coord_t> output(events.size() * 3);
+    ct.applyBatch(events[0].getCenter(), sizeof(MDEvent<4>), events.size(),
+                  output.data());
+    for (size_t i = 0; i < events.size(); ++i) {
+      TS_ASSERT_DELTA(output[i * 3], 1.0, 1e-6);
+      TS_ASSERT_DELTA(output[i * 3 + 1], 2.0, 1e-6);
+      TS_ASSERT_DELTA(output[i * 3 + 2], 3.0 * (1.0 + i), 1e-5);
+    }
+  }
+
   /// Clone the transform, check that it still works
   void test_clone() {
     size_t dimToBinFrom[3] = {3, 1, 0};
@@ -173,5 +196,18 @@ public:
       ct.apply(in, out);
     }
   }
+  void test_applyBatch_4D_performance() {
+    size_t dimToBinFrom[4] = {0, 1, 2, 3};
+    coord_t origin[4] = {5, 10, 15, 20};
+    coord_t scaling[4] = {1, 2, 3, 4};
+    CoordTransformAligned ct(4, 4, dimToBinFrom, origin, scaling);
+    std::vector<MDLeanEvent<4>> events(1000 * 1000);
+    std::vector<coord_t> out(events.size() * 4);
+
+    for (size_t i = 0; i < 10; ++i) {
+      ct.applyBatch(events[0].getCenter(), sizeof(MDLeanEvent<4>),
+                    events.size(), out.data());
+    }
+  }
 };
 #endif /* MANTID_DATAOBJECTS_COORDTRANSFORMALIGNEDTEST_H_ */
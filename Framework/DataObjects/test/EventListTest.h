@@ -6,10 +6,12 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Unit.h"
 
 #include <boost/scoped_ptr.hpp>
 #include <cmath>
+#include <numeric>
 
 using namespace Mantid;
 using namespace Mantid::API;
@@ -1153,6 +1155,87 @@ public:
     TS_ASSERT_EQUALS(this->el.ptrX()->size(), NUMBINS + 1);
   }
 
+  void test_histogram_unsorted_matches_sorted() {
+    // Linear, linear with a shorter last bin, logarithmic and irregular bins
+    std::vector<MantidVec> binnings(4);
+    for (double tof = 0; tof <= MAX_TOF; tof += BIN_DELTA)
+      binnings[0].push_back(tof);
+    for (double tof = 0; tof < MAX_TOF; tof += BIN_DELTA * 3)
+      binnings[1].push_back(tof);
+    binnings[1].push_back(MAX_TOF);
+    for (double tof = 1000; tof < MAX_TOF * 1.05; tof *= 1.05)
+      binnings[2].push_back(tof);
+    for (double tof = 1000; tof < MAX_TOF; tof = tof * 2 + 500)
+      binnings[3].push_back(tof);
+
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      if (this_type != TOF)
+        el *= 2.5;
+      EventList sorted(el);
+      sorted.sortTof();
+
+      for (size_t i = 0; i < binnings.size(); ++i) {
+        EventList unsorted(el);
+        TS_ASSERT_EQUALS(unsorted.getSortType(), UNSORTED);
+        MantidVec Y, E, sortedY, sortedE;
+        unsorted.generateHistogram(binnings[i], Y, E);
+        sorted.generateHistogram(binnings[i], sortedY, sortedE);
+        TS_ASSERT_EQUALS(Y.size(), binnings[i].size() - 1);
+        TS_ASSERT_EQUALS(E.size(), binnings[i].size() - 1);
+        TS_ASSERT_DELTA(std::accumulate(Y.begin(), Y.end(), 0.0),
+                        std::accumulate(sortedY.begin(), sortedY.end(), 0.0),
+                        1e-6);
+        for (size_t bin = 0; bin < Y.size(); ++bin) {
+          TSM_ASSERT_DELTA(this_type, Y[bin], sortedY[bin], 1e-6);
+          TSM_ASSERT_DELTA(this_type, E[bin], sortedE[bin], 1e-6);
+        }
+        // Regular bins are histogrammed without sorting the events
+        if (i < 3)
+          TS_ASSERT_EQUALS(unsorted.getSortType(), UNSORTED);
+      }
+    }
+  }
+
+  void test_histogram_unsorted_skipping_errors() {
+    this->fake_data();
+    MantidVec X;
+    for (double tof = 1000; tof < MAX_TOF; tof *= 1.1)
+      X.push_back(tof);
+    // Stale values in Y must not be kept
+    MantidVec Y(X.size() - 1, 3.0), E, sortedY, sortedE;
+    el.generateHistogram(X, Y, E, true);
+    TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+    EventList sorted(el);
+    sorted.sortTof();
+    sorted.generateHistogram(X, sortedY, sortedE, true);
+    TS_ASSERT_EQUALS(Y.size(), sortedY.size());
+    for (size_t bin = 0; bin < Y.size(); ++bin)
+      TS_ASSERT_EQUALS(Y[bin], sortedY[bin]);
+  }
+
+  void test_histogram_unsorted_with_bins_changed_in_place() {
+    this->fake_data();
+    MantidVec X;
+    for (double tof = 0; tof <= MAX_TOF; tof += BIN_DELTA)
+      X.push_back(tof);
+    MantidVec Y, E;
+    el.generateHistogram(X, Y, E);
+    // Same vector, same ends, but logarithmic bins in between
+    for (size_t i = 1; i + 1 < X.size(); ++i)
+      X[i] = MAX_TOF * std::pow(1.01, static_cast<double>(i) -
+                                          static_cast<double>(X.size() - 1));
+    MantidVec sortedY, sortedE;
+    el.generateHistogram(X, Y, E);
+    EventList sorted(el);
+    sorted.sortTof();
+    sorted.generateHistogram(X, sortedY, sortedE);
+    TS_ASSERT_EQUALS(Y.size(), sortedY.size());
+    for (size_t bin = 0; bin < Y.size(); ++bin)
+      TS_ASSERT_EQUALS(Y[bin], sortedY[bin]);
+  }
+
   //  void test_histogram_static_function()
   //  {
   //    std::vector<WeightedEvent> events;
@@ -1210,6 +1293,24 @@ public:
     TS_ASSERT_EQUALS(el.integrate(1000, 100, false), 0);
   }
 
+  void test_integrate_unsorted() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      if (this_type != TOF)
+        el *= 2.5;
+      EventList sorted(el);
+      sorted.sortTof();
+      double sum(0), error(0), sortedSum(0), sortedError(0);
+      el.integrate(2e6, 6e6, false, sum, error);
+      sorted.integrate(2e6, 6e6, false, sortedSum, sortedError);
+      TSM_ASSERT_DELTA(this_type, sum, sortedSum, 1e-6);
+      TSM_ASSERT_DELTA(this_type, error, sortedError, 1e-6);
+      TS_ASSERT_EQUALS(el.integrate(1000, 100, false), 0);
+      TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_maskTof_allTypes() {
     // Go through each possible EventType as the input
@@ -1232,6 +1333,58 @@ public:
     }
   }
 
+  void test_maskTof_unsorted() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      EventList sorted(el);
+      sorted.sortTof();
+      el.maskTof(2e6, 6e6);
+      sorted.maskTof(2e6, 6e6);
+      TS_ASSERT_EQUALS(el.getNumberEvents(), sorted.getNumberEvents());
+      // The remaining events keep their order
+      TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+      for (std::size_t i = 0; i < el.getNumberEvents(); i++) {
+        TS_ASSERT((el.getEvent(i).tof() < 2e6) || (el.getEvent(i).tof() > 6e6));
+      }
+      // Masking everything clears the list
+      el.maskTof(0, MAX_TOF);
+      TS_ASSERT_EQUALS(el.getNumberEvents(), 0);
+    }
+  }
+
+  void test_maskTof_same_bounds_for_sorted_and_unsorted() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      EventList unsorted;
+      unsorted += TofEvent(7.0, 1);
+      unsorted += TofEvent(5.0, 2);
+      unsorted += TofEvent(3.0, 3);
+      unsorted.switchTo(static_cast<EventType>(this_type));
+      EventList sorted(unsorted);
+      sorted.sortTof();
+      TS_ASSERT_EQUALS(unsorted.getSortType(), UNSORTED);
+      TS_ASSERT_EQUALS(sorted.getSortType(), TOF_SORT);
+
+      // An empty mask range is refused whatever the order
+      TS_ASSERT_THROWS(unsorted.maskTof(5.0, 5.0), std::runtime_error);
+      TS_ASSERT_THROWS(sorted.maskTof(5.0, 5.0), std::runtime_error);
+      TS_ASSERT_EQUALS(unsorted.getNumberEvents(), 3);
+      TS_ASSERT_EQUALS(sorted.getNumberEvents(), 3);
+
+      // Both bounds are inclusive, even with no event below tofMax
+      unsorted.maskTof(4.0, 5.0);
+      sorted.maskTof(4.0, 5.0);
+      TS_ASSERT_EQUALS(unsorted.getNumberEvents(), 2);
+      TS_ASSERT_EQUALS(sorted.getNumberEvents(), 2);
+      unsorted.maskTof(3.0, 4.0);
+      sorted.maskTof(3.0, 4.0);
+      TS_ASSERT_EQUALS(unsorted.getNumberEvents(), 1);
+      TS_ASSERT_EQUALS(sorted.getNumberEvents(), 1);
+      TS_ASSERT_EQUALS(unsorted.getEvent(0).tof(), 7.0);
+      TS_ASSERT_EQUALS(sorted.getEvent(0).tof(), 7.0);
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_getTofs_and_setTofs() {
     // Go through each possible EventType as the input
@@ -1524,6 +1677,58 @@ public:
     }
   }
 
+  void test_sorting_long_lists() {
+    // Long enough to be radix sorted, and split between threads
+    const size_t numEvents = 250000;
+    for (int this_type = 0; this_type < 3; this_type++) {
+      EventType curType = static_cast<EventType>(this_type);
+      for (size_t numThreads = 1; numThreads <= 3; numThreads += 2) {
+        EventList el;
+        srand(1234);
+        for (size_t i = 0; i < numEvents; i++) {
+          // Include negative and repeated TOFs
+          const double tof = (i % 3 == 0) ? static_cast<double>(rand() % 100)
+                                          : 1e5 * (rand() * 1.0 / RAND_MAX);
+          el += TofEvent(tof - 50., rand() % 1000 - 200);
+        }
+        el.switchTo(curType);
+
+        EventList byTof(el);
+        byTof.sortTof(numThreads);
+        TS_ASSERT_EQUALS(byTof.getNumberEvents(), numEvents);
+        TS_ASSERT(byTof.isSortedByTof());
+        EventList expected(el);
+        std::vector<double> tofs;
+        expected.getTofs(tofs);
+        std::sort(tofs.begin(), tofs.end());
+        for (size_t i = 0; i < numEvents; i++)
+          TS_ASSERT_EQUALS(byTof.getEvent(i).tof(), tofs[i]);
+
+        if (curType == WEIGHTED_NOTIME)
+          continue;
+
+        EventList byPulse(el);
+        byPulse.sortPulseTime(numThreads);
+        TS_ASSERT_EQUALS(byPulse.getSortType(), PULSETIME_SORT);
+        for (size_t i = 1; i < numEvents; i++)
+          TS_ASSERT_LESS_THAN_EQUALS(byPulse.getEvent(i - 1).pulseTime(),
+                                     byPulse.getEvent(i).pulseTime());
+
+        EventList byPulseTof(el);
+        byPulseTof.sortPulseTimeTOF(numThreads);
+        TS_ASSERT_EQUALS(byPulseTof.getSortType(), PULSETIMETOF_SORT);
+        for (size_t i = 1; i < numEvents; i++) {
+          TS_ASSERT_LESS_THAN_EQUALS(byPulseTof.getEvent(i - 1).pulseTime(),
+                                     byPulseTof.getEvent(i).pulseTime());
+          if (byPulseTof.getEvent(i - 1).pulseTime() ==
+              byPulseTof.getEvent(i).pulseTime())
+            TS_ASSERT_LESS_THAN_EQUALS(byPulseTof.getEvent(i - 1).tof(),
+                                       byPulseTof.getEvent(i).tof());
+        }
+      }
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_filterByPulseTime() {
     // Go through each possible EventType (except the no-time one) as the input
@@ -1806,6 +2011,60 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  /** The splits into a vector of outputs with a SplitterIndex give the same
+   * events as the splits into a map of outputs, including for gaps and
+   * overlaps between the intervals and events after the last one
+   */
+  void test_split_with_SplitterIndex_matches_map_of_outputs() {
+    TimeSplitterType split;
+    for (int i = 0; i < 60; i++) {
+      const int64_t start = 10000000 + i * 13700000;
+      split.emplace_back(start, start + 9100000 + (i % 3) * 3000000, i % 7 - 1);
+    }
+    const SplitterIndex index(split, {0, 1, 2, 3, 4, 5});
+
+    for (auto type : {TOF, WEIGHTED}) {
+      fake_uniform_time_sns_data();
+      el.switchTo(type);
+      for (int mode = 0; mode < 3; ++mode) {
+        std::map<int, EventList *> mapOutputs;
+        std::vector<EventList *> vectorOutputs;
+        for (const auto destination : index.indices()) {
+          mapOutputs.emplace(destination, new EventList());
+          vectorOutputs.push_back(new EventList());
+        }
+
+        if (mode == 0) {
+          el.splitByFullTime(split, mapOutputs, false, 1.0, 0.0);
+          el.splitByFullTime(index, vectorOutputs, false, 1.0, 0.0);
+        } else if (mode == 1) {
+          el.splitByFullTime(split, mapOutputs, true, 0.5, 1.0E-4);
+          el.splitByFullTime(index, vectorOutputs, true, 0.5, 1.0E-4);
+        } else {
+          el.splitByPulseTime(split, mapOutputs);
+          el.splitByPulseTime(index, vectorOutputs);
+        }
+
+        size_t total = 0;
+        for (size_t i = 0; i < vectorOutputs.size(); ++i) {
+          const auto &expected = *mapOutputs[index.indices()[i]];
+          TS_ASSERT(*vectorOutputs[i] == expected);
+          total += vectorOutputs[i]->getNumberEvents();
+          delete mapOutputs[index.indices()[i]];
+          delete vectorOutputs[i];
+        }
+        // The events after the last interval are dropped
+        TS_ASSERT_LESS_THAN(0, total);
+        TS_ASSERT_LESS_THAN(total, el.getNumberEvents());
+      }
+    }
+
+    std::vector<EventList *> tooFew(1, &el);
+    TS_ASSERT_THROWS(el.splitByPulseTime(index, tooFew),
+                     std::invalid_argument);
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_splitByTime_allTypes() {
     // Go through each possible EventType as the input
@@ -2658,12 +2917,16 @@ public:
     // Coarse vector, 1000 bins.
     for (double i = 0; i < 100000; i += 100)
       coarseX.push_back(i);
+    // Logarithmic vector, 1% steps
+    for (double i = 1; i < 100000; i *= 1.01)
+      logX.push_back(i);
   }
 
   EventList el_random, el_random_source, el_sorted, el_sorted_original,
       el_sorted_weighted, el4, el5;
   MantidVec fineX;
   MantidVec coarseX;
+  MantidVec logX;
 
   void setUp() override {
     // Reset the random event list
@@ -2683,6 +2946,14 @@ public:
 
   void test_sort_tof4() { el_random.sortTof4(); }
 
+  void test_sort_tof_all_threads() {
+    el_random.sortTof(PARALLEL_GET_MAX_THREADS);
+  }
+
+  void test_sort_pulsetime() { el_random.sortPulseTime(); }
+
+  void test_sort_pulsetime_tof() { el_random.sortPulseTimeTOF(); }
+
   void test_compressEvents() {
     CPUTimer tim;
     EventList out_el;
@@ -2720,6 +2991,27 @@ public:
     el_sorted_weighted.generateHistogram(coarseX, Y, E);
   }
 
+  void test_histogram_fine_unsorted() {
+    MantidVec Y, E;
+    el_random.generateHistogram(fineX, Y, E);
+  }
+
+  void test_histogram_coarse_unsorted() {
+    MantidVec Y, E;
+    el_random.generateHistogram(coarseX, Y, E);
+  }
+
+  void test_histogram_log_unsorted() {
+    MantidVec Y, E;
+    el_random.generateHistogram(logX, Y, E);
+  }
+
+  void test_maskTof_unsorted() { el_random.maskTof(25e3, 75e3); }
+
+  void test_integrate_unsorted() {
+    el_random.integrate(25e3, 75e3, false);
+  }
+
   void test_maskTof() {
     TS_ASSERT_EQUALS(el_sorted.getNumberEvents(), 10000000);
     el_sorted.maskTof(25e3, 75e3);
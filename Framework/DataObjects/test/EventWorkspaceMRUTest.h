@@ -5,13 +5,347 @@
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/System.h"
 
+#include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidHistogramData/BinEdges.h"
+#include "MantidHistogramData/LinearGenerator.h"
+#include "MantidKernel/make_cow.h"
+#include "MantidKernel/MultiThreaded.h"
 
 using namespace Mantid::DataObjects;
+using Mantid::HistogramData::BinEdges;
+using Mantid::HistogramData::HistogramE;
+using Mantid::HistogramData::HistogramY;
+using Mantid::HistogramData::LinearGenerator;
+using Mantid::Kernel::make_cow;
 
 class EventWorkspaceMRUTest : public CxxTest::TestSuite {
 public:
-  void test_Something() {}
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventWorkspaceMRUTest *createSuite() {
+    return new EventWorkspaceMRUTest();
+  }
+  static void destroySuite(EventWorkspaceMRUTest *suite) { delete suite; }
+
+  void test_find_and_insert() {
+    EventWorkspaceMRU mru(1000000, 0);
+    EventList list;
+    EventWorkspaceMRU::YType y(nullptr);
+    EventWorkspaceMRU::EType e(nullptr);
+    TS_ASSERT(!mru.find(&list, 0, &m_x, y, e));
+    TS_ASSERT(!y);
+
+    auto yNew = makeY(10);
+    auto eNew = makeE(10);
+    mru.insert(&list, 0, &m_x, yNew, eNew);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 1);
+    TS_ASSERT(mru.find(&list, 0, &m_x, y, e));
+    TS_ASSERT_EQUALS(y, yNew);
+    TS_ASSERT_EQUALS(e, eNew);
+    TS_ASSERT_EQUALS(mru.hits(), 1);
+    TS_ASSERT_EQUALS(mru.misses(), 1);
+    TS_ASSERT_LESS_THAN_EQUALS(20 * sizeof(double), mru.memorySize());
+
+    mru.deleteIndex(&list);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+    TS_ASSERT_EQUALS(mru.memorySize(), 0);
+  }
+
+  void test_stale_entries_are_not_returned() {
+    EventWorkspaceMRU mru(1000000, 0);
+    EventList list;
+    auto y = makeY(10);
+    auto e = makeE(10);
+    mru.insert(&list, 3, &m_x, y, e);
+
+    // Different version
+    TS_ASSERT(!mru.find(&list, 4, &m_x, y, e));
+    TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+
+    // Different X
+    mru.insert(&list, 4, &m_x, y, e);
+    int otherX;
+    TS_ASSERT(!mru.find(&list, 4, &otherX, y, e));
+    TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+    TS_ASSERT_EQUALS(mru.memorySize(), 0);
+  }
+
+  void test_insert_keeps_valid_entry() {
+    EventWorkspaceMRU mru(1000000, 0);
+    EventList list;
+    auto yFirst = makeY(10);
+    auto eFirst = makeE(10);
+    mru.insert(&list, 0, &m_x, yFirst, eFirst);
+
+    // Another thread generated the same histogram in the meantime
+    auto ySecond = makeY(10);
+    auto eSecond = makeE(10);
+    mru.insert(&list, 0, &m_x, ySecond, eSecond);
+    TS_ASSERT_EQUALS(ySecond, yFirst);
+    TS_ASSERT_EQUALS(eSecond, eFirst);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 1);
+
+    // A newer version replaces it
+    auto yThird = makeY(10);
+    auto eThird = makeE(10);
+    auto yThirdCopy = yThird;
+    mru.insert(&list, 1, &m_x, yThird, eThird);
+    TS_ASSERT_EQUALS(yThird, yThirdCopy);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 1);
+  }
+
+  void test_memory_limit_evicts_least_recently_used() {
+    const size_t bins = 1000;
+    std::vector<EventList> lists(10);
+    // Room for a little more than 5 entries
+    EventWorkspaceMRU mru(11 * bins * sizeof(double), 0);
+    for (auto &list : lists) {
+      auto y = makeY(bins);
+      auto e = makeE(bins);
+      mru.insert(&list, 0, &m_x, y, e);
+      // Keep using the first one
+      TS_ASSERT(mru.find(&lists[0], 0, &m_x, y, e));
+    }
+    TS_ASSERT_EQUALS(mru.MRUSize(), 5);
+    TS_ASSERT_LESS_THAN_EQUALS(mru.memorySize(), mru.memoryLimit());
+
+    EventWorkspaceMRU::YType y(nullptr);
+    EventWorkspaceMRU::EType e(nullptr);
+    TS_ASSERT(mru.find(&lists[0], 0, &m_x, y, e));
+    for (size_t i = 1; i < 6; ++i)
+      TS_ASSERT(!mru.find(&lists[i], 0, &m_x, y, e));
+    for (size_t i = 6; i < 10; ++i)
+      TS_ASSERT(mru.find(&lists[i], 0, &m_x, y, e));
+
+    mru.setMemoryLimit(0);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+  }
+
+  void test_minimum_entries_are_kept() {
+    std::vector<EventList> lists(10);
+    EventWorkspaceMRU mru(0, 3);
+    for (auto &list : lists) {
+      auto y = makeY(10);
+      auto e = makeE(10);
+      mru.insert(&list, 0, &m_x, y, e);
+    }
+    TS_ASSERT_EQUALS(mru.MRUSize(), 3);
+    EventWorkspaceMRU::YType y(nullptr);
+    EventWorkspaceMRU::EType e(nullptr);
+    TS_ASSERT(mru.find(&lists[9], 0, &m_x, y, e));
+    TS_ASSERT(!mru.find(&lists[6], 0, &m_x, y, e));
+  }
+
+  void test_handed_out_histograms_outlive_eviction() {
+    std::vector<EventList> lists(100);
+    // Nothing fits in the budget, every entry is evicted right away
+    EventWorkspaceMRU mru(0, 0);
+    auto y = makeY(10);
+    auto e = makeE(10);
+    mru.insert(&lists[0], 0, &m_x, y, e);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+    // The thread that was handed the histogram still holds a reference to it
+    TS_ASSERT_EQUALS(y.use_count(), 2);
+    for (size_t i = 1; i < 10; ++i) {
+      auto yOther = makeY(10);
+      auto eOther = makeE(10);
+      mru.insert(&lists[i], 0, &m_x, yOther, eOther);
+    }
+    TS_ASSERT_EQUALS(y.use_count(), 2);
+    // Until it has been handed enough other histograms
+    for (size_t i = 10; i < lists.size(); ++i) {
+      auto yOther = makeY(10);
+      auto eOther = makeE(10);
+      mru.insert(&lists[i], 0, &m_x, yOther, eOther);
+    }
+    TS_ASSERT_EQUALS(y.use_count(), 1);
+    TS_ASSERT_EQUALS(e.use_count(), 1);
+  }
+
+  void test_shards() {
+    std::vector<EventList> lists(100);
+    EventWorkspaceMRU mru(1000000, 0, 8);
+    for (auto &list : lists) {
+      auto y = makeY(10);
+      auto e = makeE(10);
+      mru.insert(&list, 0, &m_x, y, e);
+    }
+    TS_ASSERT_EQUALS(mru.MRUSize(), lists.size());
+    EventWorkspaceMRU::YType y(nullptr);
+    EventWorkspaceMRU::EType e(nullptr);
+    for (auto &list : lists)
+      TS_ASSERT(mru.find(&list, 0, &m_x, y, e));
+    TS_ASSERT_EQUALS(mru.hits(), lists.size());
+
+    mru.deleteIndex(&lists[3]);
+    TS_ASSERT(!mru.find(&lists[3], 0, &m_x, y, e));
+    TS_ASSERT_EQUALS(mru.MRUSize(), lists.size() - 1);
+
+    // The shards share the budget
+    mru.setMemoryLimit(0);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+    TS_ASSERT_EQUALS(mru.memorySize(), 0);
+  }
+
+  void test_shards_evict_least_recently_used() {
+    const size_t bins = 1000;
+    std::vector<EventList> lists(10);
+    EventWorkspaceMRU mru(11 * bins * sizeof(double), 0, 4);
+    for (auto &list : lists) {
+      auto y = makeY(bins);
+      auto e = makeE(bins);
+      mru.insert(&list, 0, &m_x, y, e);
+    }
+    TS_ASSERT_EQUALS(mru.MRUSize(), 5);
+    EventWorkspaceMRU::YType y(nullptr);
+    EventWorkspaceMRU::EType e(nullptr);
+    for (size_t i = 5; i < 10; ++i)
+      TS_ASSERT(mru.find(&lists[i], 0, &m_x, y, e));
+  }
+
+  void test_default_caches_share_the_budget() {
+    const size_t bins = 1000;
+    std::vector<EventList> lists(4);
+    EventWorkspaceMRU first;
+    EventWorkspaceMRU second;
+    const size_t memoryLimit = first.memoryLimit();
+    TS_ASSERT_EQUALS(second.memoryLimit(), memoryLimit);
+    const size_t usedBefore = first.totalMemorySize();
+
+    auto y = makeY(bins);
+    auto e = makeE(bins);
+    first.insert(&lists[0], 0, &m_x, y, e);
+    first.insert(&lists[1], 0, &m_x, y, e);
+    second.insert(&lists[2], 0, &m_x, y, e);
+    TS_ASSERT_EQUALS(second.totalMemorySize(),
+                     usedBefore + first.memorySize() + second.memorySize());
+
+    // Room for a little more than 2 entries beyond those of other caches
+    second.setMemoryLimit(usedBefore + 5 * bins * sizeof(double));
+    TS_ASSERT_EQUALS(first.memoryLimit(), second.memoryLimit());
+    TS_ASSERT_EQUALS(first.MRUSize(), 1);
+    TS_ASSERT(!first.find(&lists[0], 0, &m_x, y, e));
+
+    // Inserting into one cache evicts from the other
+    second.insert(&lists[3], 0, &m_x, y, e);
+    TS_ASSERT_EQUALS(first.MRUSize(), 0);
+    TS_ASSERT_EQUALS(second.MRUSize(), 2);
+
+    second.setMemoryLimit(memoryLimit);
+    const size_t used = second.memorySize();
+    {
+      EventWorkspaceMRU third;
+      third.insert(&lists[0], 0, &m_x, y, e);
+    }
+    // Destroyed caches return their memory
+    TS_ASSERT_EQUALS(second.totalMemorySize(), usedBefore + used);
+  }
+
+  void test_copyEntries() {
+    std::vector<EventList> lists(3);
+    std::vector<EventList> copies(3);
+    std::vector<EventList *> from{&lists[0], &lists[1], &lists[2]};
+    std::vector<EventList *> to{&copies[0], &copies[1], &copies[2]};
+    EventWorkspaceMRU mru(1000000, 0);
+    auto y = makeY(10);
+    auto e = makeE(10);
+    mru.insert(&lists[1], 7, &m_x, y, e);
+
+    EventWorkspaceMRU copy(1000000, 0);
+    copy.copyEntries(mru, from, to);
+    TS_ASSERT_EQUALS(copy.MRUSize(), 1);
+    EventWorkspaceMRU::YType yFound(nullptr);
+    EventWorkspaceMRU::EType eFound(nullptr);
+    TS_ASSERT(!copy.find(&lists[1], 7, &m_x, yFound, eFound));
+    TS_ASSERT(copy.find(&copies[1], 7, &m_x, yFound, eFound));
+    TS_ASSERT_EQUALS(yFound, y);
+    // The original is unchanged
+    TS_ASSERT(mru.find(&lists[1], 7, &m_x, yFound, eFound));
+  }
+
+  void test_modifying_EventList_invalidates_histogram() {
+    EventWorkspaceMRU mru;
+    EventList list(&mru, 0);
+    list.setHistogram(BinEdges(11, LinearGenerator(0.0, 1.0)));
+    list += TofEvent(2.5, 0);
+
+    auto y = list.sharedY();
+    TS_ASSERT_DELTA((*y)[2], 1.0, 1e-12);
+    TS_ASSERT_EQUALS(list.sharedY(), y);
+    TS_ASSERT_EQUALS(mru.hits(), 1);
+
+    list += TofEvent(2.5, 0);
+    TS_ASSERT_DIFFERS(list.sharedY(), y);
+    TS_ASSERT_DELTA(list.y()[2], 2.0, 1e-12);
+
+    y = list.sharedY();
+    list.setHistogram(BinEdges(3, LinearGenerator(0.0, 2.0)));
+    TS_ASSERT_DIFFERS(list.sharedY(), y);
+    TS_ASSERT_DELTA(list.y()[1], 2.0, 1e-12);
+
+    y = list.sharedY();
+    list.addEventQuickly(TofEvent(0.5, 0));
+    TS_ASSERT_DIFFERS(list.sharedY(), y);
+    TS_ASSERT_DELTA(list.y()[0], 1.0, 1e-12);
+
+    list.clear();
+    TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+  }
+
+private:
+  EventWorkspaceMRU::YType makeY(size_t size) {
+    return make_cow<HistogramY>(size, 1.0);
+  }
+  EventWorkspaceMRU::EType makeE(size_t size) {
+    return make_cow<HistogramE>(size, 1.0);
+  }
+
+  /// Stands in for the X binning of the event lists
+  int m_x{0};
+};
+
+class EventWorkspaceMRUTestPerformance : public CxxTest::TestSuite {
+public:
+  static EventWorkspaceMRUTestPerformance *createSuite() {
+    return new EventWorkspaceMRUTestPerformance();
+  }
+  static void destroySuite(EventWorkspaceMRUTestPerformance *suite) {
+    delete suite;
+  }
+
+  EventWorkspaceMRUTestPerformance() : m_lists(10000) {}
+
+  void test_repeated_passes_within_budget() {
+    EventWorkspaceMRU mru;
+    run(mru);
+  }
+
+  void test_repeated_passes_over_budget() {
+    EventWorkspaceMRU mru(1000 * 1000 * sizeof(double), 0);
+    run(mru);
+  }
+
+private:
+  /// Five passes over all lists, as done by a chain of algorithms
+  void run(EventWorkspaceMRU &mru) {
+    for (size_t pass = 0; pass < 5; ++pass) {
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int i = 0; i < static_cast<int>(m_lists.size()); ++i) {
+        const EventList *list = &m_lists[i];
+        EventWorkspaceMRU::YType y(nullptr);
+        EventWorkspaceMRU::EType e(nullptr);
+        if (!mru.find(list, 0, &m_lists, y, e)) {
+          y = make_cow<HistogramY>(1000, 1.0);
+          e = make_cow<HistogramE>(1000, 1.0);
+          mru.insert(list, 0, &m_lists, y, e);
+        }
+      }
+    }
+    TS_ASSERT_EQUALS(mru.hits() + mru.misses(), 5 * m_lists.size());
+  }
+
+  std::vector<EventList> m_lists;
 };
 
 #endif /* MANTID_DATAOBJECTS_EVENTWORKSPACEMRUTEST_H_ */
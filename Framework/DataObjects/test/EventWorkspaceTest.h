@@ -324,27 +324,30 @@ public:
     data1 = ew2->dataY(0);
     TS_ASSERT_DELTA(ew2->dataY(0)[1], 2.0, 1e-6);
     TS_ASSERT_DELTA(data1[1], 2.0, 1e-6);
-    // Cache should now be full
-    TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
+    // All of them fit in the memory budget
+    TS_ASSERT_EQUALS(ew2->MRUSize(), 100);
 
     int last = 100;
     // Read more;
     for (int i = last; i < last + 100; i++)
       data1 = ew2->dataY(i);
-
-    // Cache should now be full still
-    TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
+    TS_ASSERT_EQUALS(ew2->MRUSize(), 200);
 
     // Do it some more
     last = 200;
     for (int i = last; i < last + 100; i++)
       data1 = ew2->dataY(i);
 
+    // One miss per spectrum, everything else came from the cache
+    TS_ASSERT_EQUALS(ew2->histogramCacheMisses(), 300);
+    TS_ASSERT_EQUALS(ew2->histogramCacheHits(), 4);
+    TS_ASSERT_LESS_THAN_EQUALS(300 * 2 * (NUMBINS - 1) * sizeof(double),
+                               ew2->histogramCacheMemory());
+
     //----- Now we test that setAllX clears the memory ----
 
-    // Yes, our eventworkspace MRU is full
-    TS_ASSERT_EQUALS(ew->MRUSize(), 50);
-    TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
+    TS_ASSERT_EQUALS(ew->MRUSize(), 300);
+    TS_ASSERT_EQUALS(ew2->MRUSize(), 300);
     ew->setAllX(BinEdges(10, LinearGenerator(0.0, BIN_DELTA)));
 
     // MRU should have been cleared now
@@ -519,16 +522,45 @@ public:
     const MantidVec &e300 = inSpec300.readE();
     TS_ASSERT_EQUALS(data0.size(), NUMBINS - 1);
 
-    // Fill up the MRU to make data0 drop off
+    // Reading other spectra does not make data0 drop off while the cache is
+    // within its memory budget
     for (size_t i = 0; i < 200; i++)
       MantidVec otherData = ew2->readY(i);
-
-    // data0 and e300 are now invalid references!
-    TS_ASSERT_DIFFERS(&data0, &inSpec.readY());
-    TS_ASSERT_DIFFERS(&e300, &inSpec.readE());
-
-    // MRU is full
-    TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
+    TS_ASSERT_EQUALS(&data0, &inSpec.readY());
+    TS_ASSERT_EQUALS(&e300, &inSpec300.readE());
+    TS_ASSERT_EQUALS(ew2->MRUSize(), 201);
+
+    // Changing the events does
+    auto y0 = ew2->sharedY(0);
+    ew->getSpectrum(0).maskTof(0.0, BIN_DELTA);
+    TS_ASSERT_DIFFERS(ew2->sharedY(0), y0);
+    TS_ASSERT_DELTA(inSpec.readY()[0], 0.0, 1e-6);
+    TS_ASSERT_DELTA(inSpec.readY()[1], 2.0, 1e-6);
+    TS_ASSERT_EQUALS(&e300, &inSpec300.readE());
+  }
+
+  void test_histogram_cache_survives_clone() {
+    const auto &y0 = ew->y(0);
+    const auto &y1 = ew->y(1);
+    EventWorkspace_sptr copy(ew->clone());
+    TS_ASSERT_EQUALS(copy->MRUSize(), 2);
+    // The copy shares the cached histograms
+    TS_ASSERT_EQUALS(&copy->y(0), &y0);
+    TS_ASSERT_EQUALS(&copy->y(1), &y1);
+    TS_ASSERT_EQUALS(copy->histogramCacheHits(), 2);
+    TS_ASSERT_EQUALS(copy->histogramCacheMisses(), 0);
+
+    // Changing the copy does not affect the original
+    copy->getSpectrum(0) *= 2.0;
+    TS_ASSERT_DELTA(copy->y(0)[1], 4.0, 1e-6);
+    TS_ASSERT_DELTA(ew->y(0)[1], 2.0, 1e-6);
+    TS_ASSERT_EQUALS(&ew->y(0), &y0);
+
+    // Changing X invalidates the cached histogram
+    copy->getSpectrum(1).setHistogram(
+        BinEdges(10, LinearGenerator(0.0, BIN_DELTA)));
+    TS_ASSERT_EQUALS(copy->y(1).size(), 9);
+    TS_ASSERT_EQUALS(ew->y(1).size(), NUMBINS - 1);
   }
 
   void test_sortAll_TOF() {
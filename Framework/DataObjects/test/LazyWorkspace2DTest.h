@@ -0,0 +1,274 @@
+#ifndef MANTID_DATAOBJECTS_LAZYWORKSPACE2DTEST_H_
+#define MANTID_DATAOBJECTS_LAZYWORKSPACE2DTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/LazyWorkspace2D.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <boost/make_shared.hpp>
+
+using namespace Mantid::DataObjects;
+using namespace Mantid::HistogramData;
+
+namespace {
+/// Fills each spectrum with its workspace index and counts the calls
+class CountingLoader : public LazyWorkspace2D::SpectrumLoader {
+public:
+  void load(const size_t index, Histogram1D &spectrum) override {
+    ++calls;
+    const double value = static_cast<double>(index);
+    spectrum.mutableX().assign(spectrum.x().size(), value);
+    spectrum.mutableY().assign(spectrum.y().size(), value);
+    spectrum.mutableE().assign(spectrum.e().size(), 1.0);
+  }
+  size_t calls{0};
+};
+
+/// Fails for every spectrum
+class FailingLoader : public LazyWorkspace2D::SpectrumLoader {
+public:
+  void load(const size_t, Histogram1D &spectrum) override {
+    spectrum.mutableY().assign(spectrum.y().size(), 1.0);
+    throw std::runtime_error("Cannot read spectrum");
+  }
+};
+}
+
+class LazyWorkspace2DTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LazyWorkspace2DTest *createSuite() {
+    return new LazyWorkspace2DTest();
+  }
+  static void destroySuite(LazyWorkspace2DTest *suite) { delete suite; }
+
+  void test_behaves_like_Workspace2D_without_loader() {
+    LazyWorkspace2D ws;
+    ws.initialize(3, 5, 4);
+    ws.mutableY(1)[2] = 7.0;
+    TS_ASSERT_EQUALS(ws.getNumberHistograms(), 3);
+    TS_ASSERT_EQUALS(ws.blocksize(), 4);
+    TS_ASSERT_EQUALS(ws.y(1)[2], 7.0);
+    TS_ASSERT_EQUALS(ws.y(0)[2], 0.0);
+    TS_ASSERT(ws.isResident(0));
+    TS_ASSERT_EQUALS(ws.id(), "Workspace2D");
+  }
+
+  void test_spectra_are_read_on_first_access() {
+    LazyWorkspace2D ws;
+    ws.initialize(100, 5, 4);
+    auto loader = boost::make_shared<CountingLoader>();
+    ws.setLoader(loader, 100);
+    TS_ASSERT_EQUALS(loader->calls, 0);
+    TS_ASSERT(!ws.isResident(42));
+
+    const auto &constWS = ws;
+    TS_ASSERT_EQUALS(constWS.y(42)[3], 42.0);
+    TS_ASSERT_EQUALS(constWS.x(42)[4], 42.0);
+    TS_ASSERT_EQUALS(constWS.e(42)[0], 1.0);
+    TS_ASSERT_EQUALS(loader->calls, 1);
+    TS_ASSERT(ws.isResident(42));
+    TS_ASSERT_EQUALS(ws.numberOfResidentSpectra(), 1);
+    TS_ASSERT_THROWS(constWS.y(100), std::range_error);
+  }
+
+  void test_least_recently_used_spectra_are_evicted() {
+    LazyWorkspace2D ws;
+    ws.initialize(1000, 5, 4);
+    auto loader = boost::make_shared<CountingLoader>();
+    ws.setLoader(loader, 4);
+    const size_t cacheSize = ws.cacheSize();
+    TS_ASSERT_EQUALS(cacheSize, 4);
+    TS_ASSERT_LESS_THAN(cacheSize + 1, ws.getNumberHistograms());
+
+    const auto &constWS = ws;
+    for (size_t i = 0; i <= cacheSize; ++i) {
+      TS_ASSERT_EQUALS(constWS.histogram(i).y()[0], static_cast<double>(i));
+      // Keep using the first one
+      TS_ASSERT_EQUALS(constWS.histogram(0).y()[0], 0.0);
+    }
+    TS_ASSERT_EQUALS(ws.numberOfResidentSpectra(), cacheSize);
+    TS_ASSERT(ws.isResident(0));
+    TS_ASSERT(!ws.isResident(1));
+    TS_ASSERT(ws.isResident(cacheSize));
+
+    // Evicted spectra are read again
+    TS_ASSERT_EQUALS(loader->calls, cacheSize + 1);
+    TS_ASSERT_EQUALS(constWS.sharedY(1)->front(), 1.0);
+    TS_ASSERT_EQUALS(loader->calls, cacheSize + 2);
+  }
+
+  void test_cache_holds_at_least_one_spectrum() {
+    LazyWorkspace2D ws;
+    ws.initialize(10, 5, 4);
+    ws.setLoader(boost::make_shared<CountingLoader>(), 0);
+    TS_ASSERT_EQUALS(ws.cacheSize(), 1);
+  }
+
+  void test_metadata_access_does_not_read() {
+    LazyWorkspace2D ws;
+    ws.initialize(10, 5, 4);
+    auto loader = boost::make_shared<CountingLoader>();
+    ws.setLoader(loader, 4);
+    const auto &constWS = ws;
+    TS_ASSERT_EQUALS(constWS.getSpectrum(3).getSpectrumNo(), 4);
+    ws.getSpectrum(3).setSpectrumNo(42);
+    ws.getSpectrum(3).addDetectorID(42);
+    TS_ASSERT(constWS.getSpectrum(3).hasDetectorID(42));
+    TS_ASSERT_EQUALS(ws.blocksize(), 4);
+    TS_ASSERT_EQUALS(loader->calls, 0);
+    TS_ASSERT(!ws.isResident(3));
+    TS_ASSERT_EQUALS(ws.numberOfResidentSpectra(), 0);
+  }
+
+  void test_setHistogram_does_not_read() {
+    LazyWorkspace2D ws;
+    ws.initialize(10, 5, 4);
+    auto loader = boost::make_shared<CountingLoader>();
+    ws.setLoader(loader, 4);
+    ws.setHistogram(2, BinEdges{1.0, 2.0, 3.0}, Counts(2, 5.0));
+    TS_ASSERT_EQUALS(loader->calls, 0);
+    TS_ASSERT(ws.isResident(2));
+    const auto &constWS = ws;
+    TS_ASSERT_EQUALS(constWS.y(2).size(), 2);
+    TS_ASSERT_EQUALS(constWS.y(2)[1], 5.0);
+    TS_ASSERT_EQUALS(loader->calls, 0);
+  }
+
+  void test_referenced_spectra_are_never_evicted() {
+    LazyWorkspace2D ws;
+    ws.initialize(100, 5, 4);
+    auto loader = boost::make_shared<CountingLoader>();
+    ws.setLoader(loader, 2);
+    const auto &constWS = ws;
+    const auto &y = constWS.y(1);
+    const auto &x = constWS.readX(1);
+    for (size_t i = 2; i < 12; ++i)
+      TS_ASSERT_EQUALS(constWS.histogram(i).y()[0], static_cast<double>(i));
+    TS_ASSERT(ws.isResident(1));
+    TS_ASSERT_EQUALS(&constWS.y(1), &y);
+    TS_ASSERT_EQUALS(y[3], 1.0);
+    TS_ASSERT_EQUALS(x[4], 1.0);
+    TS_ASSERT_EQUALS(ws.numberOfResidentSpectra(), ws.cacheSize() + 1);
+    TS_ASSERT_EQUALS(loader->calls, 11);
+  }
+
+  void test_copies_outlive_eviction() {
+    LazyWorkspace2D ws;
+    ws.initialize(100, 5, 4);
+    ws.setLoader(boost::make_shared<CountingLoader>(), 1);
+    const auto &constWS = ws;
+    const auto histogram = constWS.histogram(1);
+    const auto y = constWS.sharedY(1);
+    constWS.histogram(2);
+    TS_ASSERT(!ws.isResident(1));
+    TS_ASSERT_EQUALS(histogram.y()[3], 1.0);
+    TS_ASSERT_EQUALS(y->back(), 1.0);
+  }
+
+  void test_written_spectra_stay_resident() {
+    LazyWorkspace2D ws;
+    ws.initialize(1000, 5, 4);
+    auto loader = boost::make_shared<CountingLoader>();
+    ws.setLoader(loader, 4);
+    ws.mutableY(3)[0] = -1.0;
+
+    const auto &constWS = ws;
+    for (size_t i = 10; i < 10 + 2 * ws.cacheSize(); ++i)
+      constWS.histogram(i);
+    TS_ASSERT(ws.isResident(3));
+    TS_ASSERT_EQUALS(constWS.y(3)[0], -1.0);
+    TS_ASSERT_EQUALS(constWS.y(3)[1], 3.0);
+    TS_ASSERT_EQUALS(ws.numberOfResidentSpectra(), ws.cacheSize() + 1);
+    TS_ASSERT_EQUALS(loader->calls, 1 + 2 * ws.cacheSize());
+  }
+
+  void test_assignment_writes_the_spectrum() {
+    LazyWorkspace2D ws;
+    ws.initialize(10, 5, 4);
+    ws.setLoader(boost::make_shared<CountingLoader>(), 1);
+    Histogram1D source(Histogram::XMode::BinEdges, Histogram::YMode::Counts);
+    source.setHistogram(BinEdges{0.0, 1.0, 2.0, 3.0, 4.0}, Counts(4, -1.0));
+    ws.getSpectrum(4) = source;
+    const auto &constWS = ws;
+    for (size_t i = 0; i < 10; ++i)
+      constWS.histogram(i);
+    TS_ASSERT_EQUALS(constWS.y(4)[0], -1.0);
+  }
+
+  void test_failed_read_leaves_spectrum_unloaded() {
+    LazyWorkspace2D ws;
+    ws.initialize(2, 5, 4);
+    ws.setLoader(boost::make_shared<FailingLoader>(), 10);
+    const auto &constWS = ws;
+    TS_ASSERT_THROWS(constWS.y(1), std::runtime_error);
+    TS_ASSERT(!ws.isResident(1));
+    TS_ASSERT_EQUALS(ws.numberOfResidentSpectra(), 0);
+  }
+
+  void test_clone_shares_loader_and_keeps_resident_spectra() {
+    LazyWorkspace2D ws;
+    ws.initialize(100, 5, 4);
+    auto loader = boost::make_shared<CountingLoader>();
+    ws.setLoader(loader, 10);
+    const auto &constWS = ws;
+    constWS.y(5);
+    ws.mutableY(6)[0] = -1.0;
+
+    auto clone = ws.clone();
+    TS_ASSERT_EQUALS(clone->numberOfResidentSpectra(), 2);
+    TS_ASSERT_EQUALS(clone->y(6)[0], -1.0);
+    const auto &constClone = *clone;
+    TS_ASSERT_EQUALS(constClone.y(5)[0], 5.0);
+    TS_ASSERT_EQUALS(loader->calls, 2);
+    TS_ASSERT_EQUALS(constClone.y(7)[0], 7.0);
+    TS_ASSERT_EQUALS(loader->calls, 3);
+    TS_ASSERT(!ws.isResident(7));
+  }
+
+  void test_memory_size_counts_resident_spectra() {
+    LazyWorkspace2D ws;
+    ws.initialize(1000, 5, 4);
+    ws.setLoader(boost::make_shared<CountingLoader>(), 10);
+    const size_t logs = ws.getMemorySize();
+    const auto &constWS = ws;
+    constWS.y(0);
+    constWS.y(1);
+    TS_ASSERT_EQUALS(ws.getMemorySize() - logs, 2 * 13 * sizeof(double));
+  }
+};
+
+class LazyWorkspace2DTestPerformance : public CxxTest::TestSuite {
+public:
+  static LazyWorkspace2DTestPerformance *createSuite() {
+    return new LazyWorkspace2DTestPerformance();
+  }
+  static void destroySuite(LazyWorkspace2DTestPerformance *suite) {
+    delete suite;
+  }
+
+  LazyWorkspace2DTestPerformance() {
+    m_ws.initialize(100000, 1001, 1000);
+    m_ws.setLoader(boost::make_shared<CountingLoader>(), 1000);
+  }
+
+  void test_parallel_passes_over_budget() {
+    const auto &ws = m_ws;
+    for (size_t pass = 0; pass < 2; ++pass) {
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int i = 0; i < static_cast<int>(ws.getNumberHistograms()); ++i) {
+        const auto histogram = ws.histogram(i);
+        TS_ASSERT_EQUALS(histogram.y()[999], static_cast<double>(i));
+      }
+    }
+    TS_ASSERT_LESS_THAN_EQUALS(m_ws.numberOfResidentSpectra(),
+                               m_ws.cacheSize());
+  }
+
+private:
+  LazyWorkspace2D m_ws;
+};
+
+#endif /* MANTID_DATAOBJECTS_LAZYWORKSPACE2DTEST_H_ */
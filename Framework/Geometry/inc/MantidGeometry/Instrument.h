@@ -14,6 +14,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 
 namespace Mantid {
 /// Typedef of a map from detector ID to detector shared pointer.
@@ -25,6 +26,7 @@ namespace Geometry {
 // Forward declarations
 //------------------------------------------------------------------
 class XMLInstrumentParameter;
+class NeighbourIndexCache;
 class ParameterMap;
 class ReferenceFrame;
 /// Convenience typedef
@@ -196,6 +198,9 @@ public:
   /// modified instrument components.
   boost::shared_ptr<ParameterMap> getParameterMap() const;
 
+  /// The nearest neighbour indices built for this instrument
+  NeighbourIndexCache &neighbourIndexCache() const;
+
   /// @return the date from which the instrument definition begins to be valid.
   Kernel::DateAndTime getValidFromDate() const { return m_ValidFrom; }
 
@@ -329,6 +334,9 @@ private:
 
   /// Pointer to the reference frame object.
   boost::shared_ptr<ReferenceFrame> m_referenceFrame;
+
+  /// Nearest neighbour indices, shared by the parametrized instruments
+  std::unique_ptr<NeighbourIndexCache> m_neighbourIndexCache;
 };
 
 } // namespace Geometry
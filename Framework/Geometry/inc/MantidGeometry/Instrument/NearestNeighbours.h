@@ -4,18 +4,18 @@
 #include "MantidGeometry/DllConfig.h"
 #include "MantidGeometry/IDTypes.h"
 #include "MantidKernel/V3D.h"
-// Boost graphing
-#ifndef Q_MOC_RUN
-#include <boost/graph/adjacency_list.hpp>
-#include <unordered_map>
 #include <boost/shared_ptr.hpp>
-#endif
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace Mantid {
 namespace Geometry {
 
 class Instrument;
 class IDetector;
+class NeighbourIndex;
 
 typedef std::unordered_map<specnum_t, std::set<detid_t>>
     ISpectrumDetectorMapping;
@@ -31,11 +31,10 @@ typedef std::unordered_map<specnum_t, std::set<detid_t>>
  * ANN is available from <http://www.cs.umd.edu/~mount/ANN/> and is released
  * under the GNU LGPL.
  *
- * Known potential issue: boost's graph has an issue that may cause compilation
- * errors in some circumstances in the current version of boost used by
- * Mantid (1.43) based on tr1::tie. This issue is fixed in later versions
- * of boost, but should in theory be guarded against by this file only being
- * included in ParameterMap.
+ * The k-d tree is held by a NeighbourIndex. For parametrized instruments the
+ * index is kept in the NeighbourIndexCache of the base instrument, so objects
+ * created for the same instrument, ParameterMap version and spectrum to
+ * detector mapping share it rather than building it again.
  *
  * Copyright &copy; 2010 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
  * National Laboratory & European Spallation Source
@@ -78,6 +77,10 @@ public:
   // Neighbouring spectra by
   std::map<specnum_t, Mantid::Kernel::V3D> neighbours(specnum_t spectrum) const;
 
+  // Neighbouring spectra of many spectra
+  std::vector<std::map<specnum_t, Mantid::Kernel::V3D>>
+  neighbours(const std::vector<specnum_t> &spectra) const;
+
 protected:
   /// Get the spectra associated with all in the instrument
   std::map<specnum_t, boost::shared_ptr<const IDetector>>
@@ -90,39 +93,17 @@ protected:
   const ISpectrumDetectorMapping &m_spectraMap;
 
 private:
-  /// typedef for Graph object used to hold the calculated information
-  typedef boost::adjacency_list<
-      boost::vecS, boost::vecS, boost::directedS,
-      boost::property<boost::vertex_name_t, int64_t>,
-      boost::property<boost::edge_name_t, Mantid::Kernel::V3D>> Graph;
-  /// Vertex descriptor object for Graph
-  typedef boost::graph_traits<Graph>::vertex_descriptor Vertex;
-  /// map object of int to Graph Vertex descriptor
-  typedef std::unordered_map<specnum_t, Vertex> MapIV;
-
-  /// Construct the graph based on the given number of neighbours and the
-  /// current instument and spectra-detector mapping
-  void build(const int noNeighbours);
-  /// Query the graph for the default number of nearest neighbours to specified
-  /// detector
+  /// Get the index for the current instrument and spectra-detector mapping
+  void build();
+  /// Build the index from the current instrument and spectra-detector mapping
+  boost::shared_ptr<const NeighbourIndex> createIndex();
+  /// Convert neighbouring points of the index to the returned map
   std::map<specnum_t, Mantid::Kernel::V3D>
-  defaultNeighbours(const specnum_t spectrum) const;
-  /// The current number of nearest neighbours
+  distances(const size_t index, const std::vector<size_t> &neighbours) const;
+  /// The number of nearest neighbours
   int m_noNeighbours;
-  /// The largest value of the distance to a nearest neighbour
-  double m_cutoff;
-  /// map between the DetectorID and the Graph node descriptor
-  MapIV m_specToVertex;
-  /// boost::graph object
-  Graph m_graph;
-  /// property map holding the node's related DetectorID's
-  boost::property_map<Graph, boost::vertex_name_t>::type m_vertexID;
-  /// property map holding the edge's related Distance value.
-  boost::property_map<Graph, boost::edge_name_t>::type m_edgeLength;
-  /// V3D for scaling
-  Kernel::V3D m_scale;
-  /// Cached radius value. used to avoid uncessary recalculations.
-  mutable double m_radius;
+  /// The k-d tree over the spectra
+  boost::shared_ptr<const NeighbourIndex> m_index;
   /// Flag indicating that masked detectors should be ignored
   bool m_bIgnoreMaskedDetectors;
 };
@@ -0,0 +1,136 @@
+#ifndef MANTID_GEOMETRY_NEIGHBOURINDEX_H_
+#define MANTID_GEOMETRY_NEIGHBOURINDEX_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/IDTypes.h"
+#include "MantidKernel/V3D.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class ANNkd_tree;
+
+namespace Mantid {
+namespace Geometry {
+
+/** NeighbourIndex : A k-d tree over the positions of the spectra of a
+  workspace, answering nearest neighbour and radius queries for many spectra
+  at once.
+
+  The positions are divided by a scale, typically the size of a pixel, before
+  they are added to the tree, so the nearest neighbours are the nearest ones
+  in units of pixels. Radius queries use the distance in real space.
+
+  The index does not change once it is built and may be shared between
+  threads. The ANN library keeps the state of a search in global variables,
+  so searches are serialized across all indices. The batch queries take the
+  lock once for all the points they are given.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL NeighbourIndex {
+public:
+  NeighbourIndex(std::vector<specnum_t> spectra,
+                 const std::vector<Kernel::V3D> &positions,
+                 const Kernel::V3D &scale);
+  ~NeighbourIndex();
+  NeighbourIndex(const NeighbourIndex &) = delete;
+  NeighbourIndex &operator=(const NeighbourIndex &) = delete;
+
+  /// The number of points in the index
+  size_t size() const { return m_spectra.size(); }
+  /// The spectrum number of the point at the given index
+  specnum_t spectrum(const size_t index) const { return m_spectra[index]; }
+  size_t indexOf(const specnum_t spectrum) const;
+  Kernel::V3D position(const size_t index) const;
+
+  std::vector<std::vector<size_t>>
+  nearest(const std::vector<size_t> &indices, const size_t k) const;
+  std::vector<std::vector<size_t>>
+  withinRadius(const std::vector<size_t> &indices, const double radius) const;
+
+private:
+  /// The spectrum number of each point
+  std::vector<specnum_t> m_spectra;
+  /// The index of the point of each spectrum
+  std::unordered_map<specnum_t, size_t> m_indices;
+  /// The scale applied to the positions
+  Kernel::V3D m_scale;
+  /// The scaled positions, owned by the index
+  double **m_points;
+  /// The tree over m_points
+  std::unique_ptr<ANNkd_tree> m_tree;
+};
+
+/** NeighbourIndexCache : Keeps the last few NeighbourIndex objects built for
+  an instrument, so that algorithms looking for neighbours in the same
+  workspace, or in copies of it, build the tree once.
+
+  An index is found again only if it was built from the same version of the
+  ParameterMap, i.e. with the same detector positions and masking, and from
+  the same spectrum to detector mapping.
+*/
+class MANTID_GEOMETRY_DLL NeighbourIndexCache {
+public:
+  /// Identifies the data an index was built from
+  struct Key {
+    /// The version of the ParameterMap of the instrument
+    size_t parameterMapVersion;
+    /// Whether masked detectors were left out
+    bool ignoreMaskedDetectors;
+    /// The spectrum number, the number of detectors and the detector IDs of
+    /// each spectrum, in order of spectrum number
+    std::vector<int> mapping;
+
+    bool operator==(const Key &other) const {
+      return parameterMapVersion == other.parameterMapVersion &&
+             ignoreMaskedDetectors == other.ignoreMaskedDetectors &&
+             mapping == other.mapping;
+    }
+  };
+
+  /// The number of indices kept
+  static const size_t CAPACITY = 4;
+
+  boost::shared_ptr<const NeighbourIndex>
+  get(const Key &key,
+      const std::function<boost::shared_ptr<const NeighbourIndex>()> &build);
+  size_t size() const;
+  void clear();
+
+private:
+  /// The indices, most recently used first
+  std::list<std::pair<Key, boost::shared_ptr<const NeighbourIndex>>> m_entries;
+  /// Guards m_entries
+  mutable std::mutex m_mutex;
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_NEIGHBOURINDEX_H_ */
@@ -9,6 +9,7 @@
 
 #include "tbb/concurrent_unordered_map.h"
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <typeinfo>
@@ -78,6 +79,10 @@ public:
   inline bool empty() const { return m_map.empty(); }
   /// Return the size of the map
   inline int size() const { return static_cast<int>(m_map.size()); }
+  /// Stamp of the contents of the map. It changes whenever parameters are
+  /// added, replaced or removed through the methods of the map, and is never
+  /// shared by maps with different contents. Copies keep the stamp.
+  inline size_t version() const { return m_version; }
   /// Return string to be used in the map
   static const std::string &pos();
   static const std::string &posx();
@@ -106,12 +111,14 @@ public:
   inline void clear() {
     m_map.clear();
     clearPositionSensitiveCaches();
+    updateVersion();
   }
   /// method swaps two parameter maps contents  each other. All caches contents
   /// is nullified (TO DO: it can be efficiently swapped too)
   void swap(ParameterMap &other) {
     m_map.swap(other.m_map);
     clearPositionSensitiveCaches();
+    m_version = other.m_version.exchange(m_version);
   }
   /// Clear any parameters with the given name
   void clearParametersByName(const std::string &name);
@@ -345,6 +352,8 @@ private:
 
   /// Assignment operator
   ParameterMap &operator=(ParameterMap *rhs);
+  /// Give the current contents a new stamp
+  void updateVersion();
   /// internal function to get position of the parameter in the parameter map
   component_map_it positionOf(const IComponent *comp, const char *name,
                               const char *type);
@@ -365,6 +374,8 @@ private:
   /// internal cache map for cached bounding boxes
   std::unique_ptr<Kernel::Cache<const ComponentID, BoundingBox>>
       m_boundingBoxMap;
+  /// Stamp of the current contents
+  std::atomic<size_t> m_version;
 };
 
 /// ParameterMap shared pointer typedef
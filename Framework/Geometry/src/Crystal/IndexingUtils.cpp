@@ -1,10 +1,12 @@
 #include "MantidGeometry/Crystal/IndexingUtils.h"
 #include "MantidGeometry/Crystal/NiggliCell.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Quat.h"
 #include <algorithm>
 #include <cmath>
 #include <boost/math/special_functions/round.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <exception>
 #include <stdexcept>
 
 extern "C" {
@@ -25,6 +27,93 @@ using Mantid::Kernel::Quat;
 namespace {
 const constexpr double DEG_TO_RAD = M_PI / 180.;
 const constexpr double RAD_TO_DEG = 180. / M_PI;
+
+/// The real space edge vectors of a possible unit cell
+struct CellEdges {
+  V3D a;
+  V3D b;
+  V3D c;
+};
+
+/// Divide the Q vectors by 2 pi, so that their dot products with real space
+/// vectors are Miller indices
+std::vector<V3D> scaleQVectors(const std::vector<V3D> &q_vectors) {
+  std::vector<V3D> scaled_qs;
+  scaled_qs.reserve(q_vectors.size());
+  for (const auto &q_vector : q_vectors)
+    scaled_qs.push_back(q_vector / (2.0 * M_PI));
+  return scaled_qs;
+}
+
+/// Same as IndexingUtils::GetMagFFT, for Q vectors that are already divided
+/// by 2 pi
+double magnitudeFFT(const std::vector<V3D> &scaled_qs, const V3D &current_dir,
+                    const size_t N, double projections[], double index_factor,
+                    double magnitude_fft[]) {
+  for (size_t i = 0; i < N; i++) {
+    projections[i] = 0.0;
+  }
+  // project onto direction
+  for (const auto &q_vec : scaled_qs) {
+    double dot_prod = current_dir.scalar_prod(q_vec);
+    size_t index = static_cast<size_t>(fabs(index_factor * dot_prod));
+    if (index < N)
+      projections[index] += 1;
+    else
+      projections[N - 1] += 1; // This should not happen, but trap it in
+  }                            // case of rounding errors.
+
+  // get the |FFT|
+  gsl_fft_real_radix2_transform(projections, 1, N);
+  for (size_t i = 1; i < N / 2; i++) {
+    magnitude_fft[i] = sqrt(projections[i] * projections[i] +
+                            projections[N - i] * projections[N - i]);
+  }
+
+  magnitude_fft[0] = fabs(projections[0]);
+
+  size_t dc_end = 5; // we may need a better estimate of this
+  double max_mag_fft = 0.0;
+  for (size_t i = dc_end; i < N / 2; i++)
+    if (magnitude_fft[i] > max_mag_fft)
+      max_mag_fft = magnitude_fft[i];
+
+  return max_mag_fft;
+}
+
+/// The number of Q vectors indexed in one direction by each of the
+/// directions, see IndexingUtils::NumberIndexed_1D
+std::vector<int> numberIndexed1D(const std::vector<V3D> &directions,
+                                 const std::vector<V3D> &q_vectors,
+                                 double required_tolerance) {
+  std::vector<int> num_indexed(directions.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < static_cast<int>(directions.size()); i++) {
+    num_indexed[i] = IndexingUtils::NumberIndexed_1D(directions[i], q_vectors,
+                                                     required_tolerance);
+  }
+  return num_indexed;
+}
+
+/// The number of scaled Q vectors that are indexed in all of the three
+/// directions
+int numberIndexed3D(const CellEdges &edges, const std::vector<V3D> &scaled_qs,
+                    double required_tolerance) {
+  int num_indexed = 0;
+  for (const auto &q_vec : scaled_qs) {
+    double dot_prod = edges.a.scalar_prod(q_vec);
+    if (fabs(dot_prod - std::round(dot_prod)) > required_tolerance)
+      continue;
+    dot_prod = edges.b.scalar_prod(q_vec);
+    if (fabs(dot_prod - std::round(dot_prod)) > required_tolerance)
+      continue;
+    dot_prod = edges.c.scalar_prod(q_vec);
+    if (fabs(dot_prod - std::round(dot_prod)) > required_tolerance)
+      continue;
+    num_indexed++;
+  }
+  return num_indexed;
+}
 }
 
 /**
@@ -922,10 +1011,6 @@ double IndexingUtils::ScanFor_UB(DblMatrix &UB,
   auto beta = cell.beta();
   auto gamma = cell.gamma();
 
-  V3D a_dir;
-  V3D b_dir;
-  V3D c_dir;
-
   double num_a_steps = std::round(90.0 / degrees_per_step);
   double gamma_radians = gamma * DEG_TO_RAD;
 
@@ -934,110 +1019,84 @@ double IndexingUtils::ScanFor_UB(DblMatrix &UB,
   std::vector<V3D> a_dir_list =
       MakeHemisphereDirections(boost::numeric_cast<int>(num_a_steps));
 
-  std::vector<V3D> b_dir_list;
-
-  V3D a_dir_temp;
-  V3D b_dir_temp;
-  V3D c_dir_temp;
-
-  double error;
-  double dot_prod;
-  double nearest_int;
-  int max_indexed = 0;
-  V3D q_vec;
-  // first select those directions
-  // that index the most peaks
-  std::vector<V3D> selected_a_dirs;
-  std::vector<V3D> selected_b_dirs;
-  std::vector<V3D> selected_c_dirs;
-
-  for (auto &a_dir_num : a_dir_list) {
-    a_dir_temp = a_dir_num;
-    a_dir_temp = V3D(a_dir_temp);
-    a_dir_temp *= a;
-
-    b_dir_list = MakeCircleDirections(boost::numeric_cast<int>(num_b_steps),
-                                      a_dir_temp, gamma);
-
-    for (auto &b_dir_num : b_dir_list) {
-      b_dir_temp = b_dir_num;
-      b_dir_temp = V3D(b_dir_temp);
-      b_dir_temp *= b;
-      c_dir_temp = Make_c_dir(a_dir_temp, b_dir_temp, c, alpha, beta, gamma);
-      int num_indexed = 0;
-      for (const auto &q_vector : q_vectors) {
-        bool indexes_peak = true;
-        q_vec = q_vector / (2.0 * M_PI);
-        dot_prod = a_dir_temp.scalar_prod(q_vec);
-        nearest_int = std::round(dot_prod);
-        error = fabs(dot_prod - nearest_int);
-        if (error > required_tolerance)
-          indexes_peak = false;
-        else {
-          dot_prod = b_dir_temp.scalar_prod(q_vec);
-          nearest_int = std::round(dot_prod);
-          error = fabs(dot_prod - nearest_int);
-          if (error > required_tolerance)
-            indexes_peak = false;
-          else {
-            dot_prod = c_dir_temp.scalar_prod(q_vec);
-            nearest_int = std::round(dot_prod);
-            error = fabs(dot_prod - nearest_int);
-            if (error > required_tolerance)
-              indexes_peak = false;
-          }
-        }
-        if (indexes_peak)
-          num_indexed++;
-      }
+  const std::vector<V3D> scaled_qs = scaleQVectors(q_vectors);
+
+  // first select those directions that index the most peaks. Each "a"
+  // direction is scanned on its own, keeping the cells that index the
+  // most peaks for that direction.
+  std::vector<int> max_indexed_for_a(a_dir_list.size(), 0);
+  std::vector<std::vector<CellEdges>> selected_for_a(a_dir_list.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int a_dir_num = 0; a_dir_num < static_cast<int>(a_dir_list.size());
+       a_dir_num++) {
+    CellEdges edges;
+    edges.a = a_dir_list[a_dir_num] * a;
+
+    const std::vector<V3D> b_dir_list = MakeCircleDirections(
+        boost::numeric_cast<int>(num_b_steps), edges.a, gamma);
+
+    int &max_indexed = max_indexed_for_a[a_dir_num];
+    auto &selected = selected_for_a[a_dir_num];
+    for (const auto &b_dir : b_dir_list) {
+      edges.b = b_dir * b;
+      edges.c = Make_c_dir(edges.a, edges.b, c, alpha, beta, gamma);
+      int num_indexed = numberIndexed3D(edges, scaled_qs, required_tolerance);
 
       if (num_indexed > max_indexed) // only keep those directions that
       {                              // index the max number of peaks
-        selected_a_dirs.clear();
-        selected_b_dirs.clear();
-        selected_c_dirs.clear();
+        selected.clear();
         max_indexed = num_indexed;
       }
-      if (num_indexed == max_indexed) {
-        selected_a_dirs.push_back(a_dir_temp);
-        selected_b_dirs.push_back(b_dir_temp);
-        selected_c_dirs.push_back(c_dir_temp);
-      }
+      if (num_indexed == max_indexed)
+        selected.push_back(edges);
     }
   }
+  // keep the cells that index the most peaks over all directions, in the
+  // order of the scan
+  int max_indexed = 0;
+  for (const auto num_indexed : max_indexed_for_a)
+    max_indexed = std::max(max_indexed, num_indexed);
+  std::vector<CellEdges> selected;
+  for (size_t a_dir_num = 0; a_dir_num < a_dir_list.size(); a_dir_num++) {
+    if (max_indexed_for_a[a_dir_num] == max_indexed)
+      selected.insert(selected.end(), selected_for_a[a_dir_num].begin(),
+                      selected_for_a[a_dir_num].end());
+  }
   // now, for each such direction, find
   // the one that indexes closes to
   // integer values
-  double min_error = 1.0e50;
-  for (size_t dir_num = 0; dir_num < selected_a_dirs.size(); dir_num++) {
-    a_dir_temp = selected_a_dirs[dir_num];
-    b_dir_temp = selected_b_dirs[dir_num];
-    c_dir_temp = selected_c_dirs[dir_num];
-
+  std::vector<double> sum_sq_errors(selected.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int dir_num = 0; dir_num < static_cast<int>(selected.size());
+       dir_num++) {
+    const CellEdges &edges = selected[dir_num];
     double sum_sq_error = 0.0;
-    for (const auto &q_vector : q_vectors) {
-      q_vec = q_vector / (2.0 * M_PI);
-      dot_prod = a_dir_temp.scalar_prod(q_vec);
-      nearest_int = std::round(dot_prod);
-      error = dot_prod - nearest_int;
+    for (const auto &q_vec : scaled_qs) {
+      double dot_prod = edges.a.scalar_prod(q_vec);
+      double error = dot_prod - std::round(dot_prod);
       sum_sq_error += error * error;
 
-      dot_prod = b_dir_temp.scalar_prod(q_vec);
-      nearest_int = std::round(dot_prod);
-      error = dot_prod - nearest_int;
+      dot_prod = edges.b.scalar_prod(q_vec);
+      error = dot_prod - std::round(dot_prod);
       sum_sq_error += error * error;
 
-      dot_prod = c_dir_temp.scalar_prod(q_vec);
-      nearest_int = std::round(dot_prod);
-      error = dot_prod - nearest_int;
+      dot_prod = edges.c.scalar_prod(q_vec);
+      error = dot_prod - std::round(dot_prod);
       sum_sq_error += error * error;
     }
+    sum_sq_errors[dir_num] = sum_sq_error;
+  }
 
-    if (sum_sq_error < min_error) {
-      min_error = sum_sq_error;
-      a_dir = a_dir_temp;
-      b_dir = b_dir_temp;
-      c_dir = c_dir_temp;
+  V3D a_dir;
+  V3D b_dir;
+  V3D c_dir;
+  double min_error = 1.0e50;
+  for (size_t dir_num = 0; dir_num < selected.size(); dir_num++) {
+    if (sum_sq_errors[dir_num] < min_error) {
+      min_error = sum_sq_errors[dir_num];
+      a_dir = selected[dir_num].a;
+      b_dir = selected[dir_num].b;
+      c_dir = selected[dir_num].c;
     }
   }
 
@@ -1077,12 +1136,6 @@ size_t IndexingUtils::ScanFor_Directions(std::vector<V3D> &directions,
                                          double min_d, double max_d,
                                          double required_tolerance,
                                          double degrees_per_step) {
-  double error;
-  double fit_error;
-  double dot_prod;
-  double nearest_int;
-  int max_indexed = 0;
-  V3D q_vec;
   // first, make hemisphere of possible directions
   // with specified resolution.
   int num_steps = boost::math::iround(90.0 / degrees_per_step);
@@ -1095,52 +1148,80 @@ size_t IndexingUtils::ScanFor_Directions(std::vector<V3D> &directions,
   double delta_d = 0.1f;
   int n_steps = boost::math::iround(1.0 + (max_d - min_d) / delta_d);
 
-  std::vector<V3D> selected_dirs;
-  V3D dir_temp;
-
-  for (const auto &current_dir : full_list) {
+  const std::vector<V3D> scaled_qs = scaleQVectors(q_vectors);
+
+  // Each direction is scanned on its own, keeping the vectors that index the
+  // most peaks in that direction
+  std::vector<int> max_indexed_for_dir(full_list.size(), 0);
+  std::vector<std::vector<V3D>> selected_for_dir(full_list.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int dir_num = 0; dir_num < static_cast<int>(full_list.size());
+       dir_num++) {
+    int &max_indexed = max_indexed_for_dir[dir_num];
+    auto &selected = selected_for_dir[dir_num];
     for (int step = 0; step <= n_steps; step++) {
-      dir_temp = current_dir;
+      V3D dir_temp = full_list[dir_num];
       dir_temp *= (min_d + step * delta_d); // increasing size
 
       int num_indexed = 0;
-      for (const auto &q_vector : q_vectors) {
-        q_vec = q_vector / (2.0 * M_PI);
-        dot_prod = dir_temp.scalar_prod(q_vec);
-        nearest_int = std::round(dot_prod);
-        error = fabs(dot_prod - nearest_int);
+      for (const auto &q_vec : scaled_qs) {
+        double dot_prod = dir_temp.scalar_prod(q_vec);
+        double error = fabs(dot_prod - std::round(dot_prod));
         if (error <= required_tolerance)
           num_indexed++;
       }
 
       if (num_indexed > max_indexed) // only keep those directions that
       {                              // index the max number of peaks
-        selected_dirs.clear();
+        selected.clear();
         max_indexed = num_indexed;
       }
       if (num_indexed >= max_indexed) {
-        selected_dirs.emplace_back(dir_temp);
+        selected.push_back(dir_temp);
       }
     }
   }
+  int max_indexed = 0;
+  for (const auto num_indexed : max_indexed_for_dir)
+    max_indexed = std::max(max_indexed, num_indexed);
+  std::vector<V3D> selected_dirs;
+  for (size_t dir_num = 0; dir_num < full_list.size(); dir_num++) {
+    if (max_indexed_for_dir[dir_num] == max_indexed)
+      selected_dirs.insert(selected_dirs.end(),
+                           selected_for_dir[dir_num].begin(),
+                           selected_for_dir[dir_num].end());
+  }
   // Now, optimize each direction and discard possible
   // unit cell edges that are duplicates, putting the
-  // new smaller list in the vector "directions"
-  std::vector<int> index_vals;
-  std::vector<V3D> indexed_qs;
-  index_vals.reserve(q_vectors.size());
-  indexed_qs.reserve(q_vectors.size());
+  // new smaller list in the vector "directions". A direction
+  // that fails to optimize stops the scan as soon as it is
+  // reached, as if they were optimized one after the other.
+  std::vector<V3D> optimized_dirs(selected_dirs);
+  std::vector<std::exception_ptr> failures(selected_dirs.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int dir_num = 0; dir_num < static_cast<int>(optimized_dirs.size());
+       dir_num++) {
+    try {
+      std::vector<int> index_vals;
+      std::vector<V3D> indexed_qs;
+      double fit_error;
+      GetIndexedPeaks_1D(optimized_dirs[dir_num], q_vectors,
+                         required_tolerance, index_vals, indexed_qs,
+                         fit_error);
+      Optimize_Direction(optimized_dirs[dir_num], index_vals, indexed_qs);
+    } catch (...) {
+      failures[dir_num] = std::current_exception();
+    }
+  }
 
   directions.clear();
   V3D current_dir;
+  V3D dir_temp;
   V3D diff;
-  for (auto &selected_dir : selected_dirs) {
-    current_dir = selected_dir;
-
-    GetIndexedPeaks_1D(current_dir, q_vectors, required_tolerance, index_vals,
-                       indexed_qs, fit_error);
-
-    Optimize_Direction(current_dir, index_vals, indexed_qs);
+  for (size_t dir_num = 0; dir_num < optimized_dirs.size(); dir_num++) {
+    if (failures[dir_num])
+      std::rethrow_exception(failures[dir_num]);
+    current_dir = optimized_dirs[dir_num];
 
     double length = current_dir.norm();
     if (length >= min_d && length <= max_d) // only keep if within range
@@ -1202,9 +1283,6 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
 #define N_FFT_STEPS 512
 #define HALF_FFT_STEPS 256
 
-  double fit_error;
-  int max_indexed = 0;
-
   // first, make hemisphere of possible directions
   // with specified resolution.
   int num_steps = boost::math::iround(90.0 / degrees_per_step);
@@ -1221,38 +1299,31 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
 
   max_mag_Q *= 1.1f; // allow for a little "headroom" for FFT range
 
-  // apply the FFT to each of the directions, and
-  // keep track of their maximum magnitude past DC
-  double max_mag_fft;
-  std::vector<double> max_fft_val;
-  max_fft_val.resize(full_list.size());
-
-  double projections[N_FFT_STEPS];
-  double magnitude_fft[HALF_FFT_STEPS];
-
+  const std::vector<V3D> scaled_qs = scaleQVectors(q_vectors);
   double index_factor = N_FFT_STEPS / max_mag_Q; // maps |proj Q| to index
 
-  for (size_t dir_num = 0; dir_num < full_list.size(); dir_num++) {
-    V3D current_dir = full_list[dir_num];
-    max_mag_fft = GetMagFFT(q_vectors, current_dir, N_FFT_STEPS, projections,
-                            index_factor, magnitude_fft);
-
-    max_fft_val[dir_num] = max_mag_fft;
+  // apply the FFT to each of the directions, and
+  // keep track of their maximum magnitude past DC.
+  // Each thread transforms in its own arrays.
+  std::vector<double> max_fft_val(full_list.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int dir_num = 0; dir_num < static_cast<int>(full_list.size());
+       dir_num++) {
+    double projections[N_FFT_STEPS];
+    double magnitude_fft[HALF_FFT_STEPS];
+    max_fft_val[dir_num] =
+        magnitudeFFT(scaled_qs, full_list[dir_num], N_FFT_STEPS, projections,
+                     index_factor, magnitude_fft);
   }
   // find the directions with the 500 largest
   // fft values, and place them in temp_dirs vector
   int N_TO_TRY = 500;
 
-  std::vector<double> max_fft_copy;
-  max_fft_copy.resize(full_list.size());
-  for (size_t i = 0; i < max_fft_copy.size(); i++) {
-    max_fft_copy[i] = max_fft_val[i];
-  }
-
+  std::vector<double> max_fft_copy(max_fft_val);
   std::sort(max_fft_copy.begin(), max_fft_copy.end());
 
   size_t index = max_fft_copy.size() - 1;
-  max_mag_fft = max_fft_copy[index];
+  double max_mag_fft = max_fft_copy[index];
 
   double threshold = max_mag_fft;
   while ((index > max_fft_copy.size() - N_TO_TRY) &&
@@ -1271,64 +1342,71 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
   // FFT to find the cell edge length that
   // corresponds to the max_mag_fft.  Only keep
   // directions with length nearly in bounds
-  V3D temp;
-  std::vector<V3D> temp_dirs_2;
-
-  for (auto &temp_dir : temp_dirs) {
-    GetMagFFT(q_vectors, temp_dir, N_FFT_STEPS, projections, index_factor,
-              magnitude_fft);
-
-    double position = GetFirstMaxIndex(magnitude_fft, N_FFT_STEPS, threshold);
+  std::vector<V3D> edges(temp_dirs.size());
+  std::vector<char> in_bounds(temp_dirs.size(), false);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int dir_num = 0; dir_num < static_cast<int>(temp_dirs.size());
+       dir_num++) {
+    double projections[N_FFT_STEPS];
+    double magnitude_fft[HALF_FFT_STEPS];
+    magnitudeFFT(scaled_qs, temp_dirs[dir_num], N_FFT_STEPS, projections,
+                 index_factor, magnitude_fft);
+
+    double position =
+        GetFirstMaxIndex(magnitude_fft, HALF_FFT_STEPS, threshold);
     if (position > 0) {
       double q_val = max_mag_Q / position;
       double d_val = 1 / q_val;
       if (d_val >= 0.8 * min_d && d_val <= 1.2 * max_d) {
-        temp = temp_dir * d_val;
-        temp_dirs_2.push_back(temp);
+        edges[dir_num] = temp_dirs[dir_num] * d_val;
+        in_bounds[dir_num] = true;
       }
     }
   }
+  std::vector<V3D> temp_dirs_2;
+  for (size_t i = 0; i < edges.size(); i++) {
+    if (in_bounds[i])
+      temp_dirs_2.push_back(edges[i]);
+  }
   // look at how many peaks were indexed
   // for each of the initial directions
-  max_indexed = 0;
-  int num_indexed;
-  V3D current_dir;
-  for (auto &dir_num : temp_dirs_2) {
-    current_dir = dir_num;
-    num_indexed = NumberIndexed_1D(current_dir, q_vectors, required_tolerance);
-    if (num_indexed > max_indexed)
-      max_indexed = num_indexed;
-  }
+  std::vector<int> num_indexed =
+      numberIndexed1D(temp_dirs_2, q_vectors, required_tolerance);
+  int max_indexed = 0;
+  for (const auto count : num_indexed)
+    max_indexed = std::max(max_indexed, count);
 
   // only keep original directions that index
   // at least 50% of max num indexed
   temp_dirs.clear();
-  for (auto &dir_num : temp_dirs_2) {
-    current_dir = dir_num;
-    num_indexed = NumberIndexed_1D(current_dir, q_vectors, required_tolerance);
-    if (num_indexed >= 0.50 * max_indexed)
-      temp_dirs.push_back(current_dir);
+  for (size_t i = 0; i < temp_dirs_2.size(); i++) {
+    if (num_indexed[i] >= 0.50 * max_indexed)
+      temp_dirs.push_back(temp_dirs_2[i]);
   }
   // refine directions and again find the
   // max number indexed, for the optimized
   // directions
-  max_indexed = 0;
-  std::vector<int> index_vals;
-  std::vector<V3D> indexed_qs;
-  for (auto &temp_dir : temp_dirs) {
-    num_indexed = GetIndexedPeaks_1D(temp_dir, q_vectors, required_tolerance,
-                                     index_vals, indexed_qs, fit_error);
+  std::vector<int> max_refined(temp_dirs.size(), 0);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int dir_num = 0; dir_num < static_cast<int>(temp_dirs.size());
+       dir_num++) {
+    V3D &temp_dir = temp_dirs[dir_num];
+    std::vector<int> index_vals;
+    std::vector<V3D> indexed_qs;
+    double fit_error;
+    GetIndexedPeaks_1D(temp_dir, q_vectors, required_tolerance, index_vals,
+                       indexed_qs, fit_error);
     try {
       int count = 0;
       while (count < 5) // 5 iterations should be enough for
       {                 // the optimization to stabilize
         Optimize_Direction(temp_dir, index_vals, indexed_qs);
 
-        num_indexed =
+        int refined_indexed =
             GetIndexedPeaks_1D(temp_dir, q_vectors, required_tolerance,
                                index_vals, indexed_qs, fit_error);
-        if (num_indexed > max_indexed)
-          max_indexed = num_indexed;
+        if (refined_indexed > max_refined[dir_num])
+          max_refined[dir_num] = refined_indexed;
 
         count++;
       }
@@ -1336,22 +1414,23 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
       // don't continue to refine if the direction fails to optimize properly
     }
   }
+  max_indexed = 0;
+  for (const auto count : max_refined)
+    max_indexed = std::max(max_indexed, count);
   // discard those with length out of bounds
   temp_dirs_2.clear();
   for (auto &temp_dir : temp_dirs) {
-    current_dir = temp_dir;
-    double length = current_dir.norm();
+    double length = temp_dir.norm();
     if (length >= min_d && length <= max_d)
-      temp_dirs_2.push_back(current_dir);
+      temp_dirs_2.push_back(temp_dir);
   }
   // only keep directions that index at
   // least 75% of the max number of peaks
+  num_indexed = numberIndexed1D(temp_dirs_2, q_vectors, required_tolerance);
   temp_dirs.clear();
-  for (auto &dir_num : temp_dirs_2) {
-    current_dir = dir_num;
-    num_indexed = NumberIndexed_1D(current_dir, q_vectors, required_tolerance);
-    if (num_indexed > max_indexed * 0.75)
-      temp_dirs.push_back(current_dir);
+  for (size_t i = 0; i < temp_dirs_2.size(); i++) {
+    if (num_indexed[i] > max_indexed * 0.75)
+      temp_dirs.push_back(temp_dirs_2[i]);
   }
 
   std::sort(temp_dirs.begin(), temp_dirs.end(), V3D::CompareMagnitude);
@@ -1392,37 +1471,8 @@ double IndexingUtils::GetMagFFT(const std::vector<V3D> &q_vectors,
                                 const V3D &current_dir, const size_t N,
                                 double projections[], double index_factor,
                                 double magnitude_fft[]) {
-  for (size_t i = 0; i < N; i++) {
-    projections[i] = 0.0;
-  }
-  // project onto direction
-  V3D q_vec;
-  for (const auto &q_vector : q_vectors) {
-    q_vec = q_vector / (2.0 * M_PI);
-    double dot_prod = current_dir.scalar_prod(q_vec);
-    size_t index = static_cast<size_t>(fabs(index_factor * dot_prod));
-    if (index < N)
-      projections[index] += 1;
-    else
-      projections[N - 1] += 1; // This should not happen, but trap it in
-  }                            // case of rounding errors.
-
-  // get the |FFT|
-  gsl_fft_real_radix2_transform(projections, 1, N);
-  for (size_t i = 1; i < N / 2; i++) {
-    magnitude_fft[i] = sqrt(projections[i] * projections[i] +
-                            projections[N - i] * projections[N - i]);
-  }
-
-  magnitude_fft[0] = fabs(projections[0]);
-
-  size_t dc_end = 5; // we may need a better estimate of this
-  double max_mag_fft = 0.0;
-  for (size_t i = dc_end; i < N / 2; i++)
-    if (magnitude_fft[i] > max_mag_fft)
-      max_mag_fft = magnitude_fft[i];
-
-  return max_mag_fft;
+  return magnitudeFFT(scaleQVectors(q_vectors), current_dir, N, projections,
+                      index_factor, magnitude_fft);
 }
 
 /**
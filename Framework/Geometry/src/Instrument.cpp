@@ -1,6 +1,7 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/ParComponentFactory.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
+#include "MantidGeometry/Instrument/NeighbourIndex.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
 #include "MantidKernel/Exception.h"
@@ -26,14 +27,16 @@ Instrument::Instrument()
     : CompAssembly(), m_detectorCache(), m_sourceCache(nullptr),
       m_chopperPoints(new std::vector<const ObjComponent *>),
       m_sampleCache(nullptr), m_defaultView("3D"), m_defaultViewAxis("Z+"),
-      m_referenceFrame(new ReferenceFrame) {}
+      m_referenceFrame(new ReferenceFrame),
+      m_neighbourIndexCache(new NeighbourIndexCache) {}
 
 /// Constructor with name
 Instrument::Instrument(const std::string &name)
     : CompAssembly(name), m_detectorCache(), m_sourceCache(nullptr),
       m_chopperPoints(new std::vector<const ObjComponent *>),
       m_sampleCache(nullptr), m_defaultView("3D"), m_defaultViewAxis("Z+"),
-      m_referenceFrame(new ReferenceFrame) {}
+      m_referenceFrame(new ReferenceFrame),
+      m_neighbourIndexCache(new NeighbourIndexCache) {}
 
 /** Constructor to create a parametrized instrument
  *  @param instr :: instrument for parameter inclusion
@@ -62,7 +65,8 @@ Instrument::Instrument(const Instrument &instr)
       m_defaultViewAxis(instr.m_defaultViewAxis), m_instr(),
       m_map_nonconst(), /* Should not be parameterized */
       m_ValidFrom(instr.m_ValidFrom), m_ValidTo(instr.m_ValidTo),
-      m_referenceFrame(instr.m_referenceFrame) {
+      m_referenceFrame(instr.m_referenceFrame),
+      m_neighbourIndexCache(new NeighbourIndexCache) {
   // Now we need to fill the detector, source and sample caches with pointers
   // into the new instrument
   std::vector<IComponent_const_sptr> children;
@@ -127,6 +131,18 @@ Instrument_const_sptr Instrument::baseInstrument() const {
                              "non-parametrized instrument.");
 }
 
+/**
+ * The nearest neighbour indices built for this instrument. Parametrized
+ * instruments share the cache of their base instrument.
+ * @return the cache of nearest neighbour indices
+ */
+NeighbourIndexCache &Instrument::neighbourIndexCache() const {
+  if (m_map)
+    return m_instr->neighbourIndexCache();
+  else
+    return *m_neighbourIndexCache;
+}
+
 /**
  * Pointer to the ParameterMap holding the parameters of the modified instrument
  * components.
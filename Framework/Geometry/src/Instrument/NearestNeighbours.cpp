@@ -1,11 +1,13 @@
 #include "MantidGeometry/Instrument/NearestNeighbours.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
+#include "MantidGeometry/Instrument/NeighbourIndex.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
-// Nearest neighbours library
-#include "MantidKernel/ANN/ANN.h"
 #include "MantidKernel/Exception.h"
-#include "MantidKernel/Timer.h"
+
+#include <boost/make_shared.hpp>
+#include <algorithm>
 
 namespace Mantid {
 namespace Geometry {
@@ -23,9 +25,8 @@ NearestNeighbours::NearestNeighbours(
     boost::shared_ptr<const Instrument> instrument,
     const ISpectrumDetectorMapping &spectraMap, bool ignoreMaskedDetectors)
     : m_instrument(instrument), m_spectraMap(spectraMap), m_noNeighbours(8),
-      m_cutoff(-DBL_MAX), m_radius(0),
       m_bIgnoreMaskedDetectors(ignoreMaskedDetectors) {
-  this->build(m_noNeighbours);
+  this->build();
 }
 
 /**
@@ -40,9 +41,9 @@ NearestNeighbours::NearestNeighbours(
     int nNeighbours, boost::shared_ptr<const Instrument> instrument,
     const ISpectrumDetectorMapping &spectraMap, bool ignoreMaskedDetectors)
     : m_instrument(instrument), m_spectraMap(spectraMap),
-      m_noNeighbours(nNeighbours), m_cutoff(-DBL_MAX), m_radius(0),
+      m_noNeighbours(nNeighbours),
       m_bIgnoreMaskedDetectors(ignoreMaskedDetectors) {
-  this->build(m_noNeighbours);
+  this->build();
 }
 
 /**
@@ -50,19 +51,46 @@ NearestNeighbours::NearestNeighbours(
  * neighbours.
  * @param spectrum :: Spectrum No of the central pixel
  * @return map of Detector ID's to distance
+ * @throw NotFoundError if the spectrum is not known
  */
 std::map<specnum_t, V3D>
 NearestNeighbours::neighbours(const specnum_t spectrum) const {
-  return defaultNeighbours(spectrum);
+  const size_t index = m_index->indexOf(spectrum);
+  const auto nearest = m_index->nearest(std::vector<size_t>(1, index),
+                                        static_cast<size_t>(m_noNeighbours));
+  return distances(index, nearest.front());
 }
 
 /**
- * Returns a map of the spectrum numbers to the distances for the nearest
- * neighbours.
+ * Returns maps of the spectrum numbers to the distances for the nearest
+ * neighbours of many spectra. This is faster than asking for them one by one.
+ * @param spectra :: Spectrum numbers of the central pixels
+ * @return map of spectrum numbers to distance for each of the spectra
+ * @throw NotFoundError if a spectrum is not known
+ */
+std::vector<std::map<specnum_t, V3D>>
+NearestNeighbours::neighbours(const std::vector<specnum_t> &spectra) const {
+  std::vector<size_t> indices(spectra.size());
+  std::transform(spectra.begin(), spectra.end(), indices.begin(),
+                 [this](const specnum_t spectrum) {
+                   return m_index->indexOf(spectrum);
+                 });
+  const auto nearest =
+      m_index->nearest(indices, static_cast<size_t>(m_noNeighbours));
+  std::vector<std::map<specnum_t, V3D>> result(spectra.size());
+  for (size_t i = 0; i < indices.size(); ++i)
+    result[i] = distances(indices[i], nearest[i]);
+  return result;
+}
+
+/**
+ * Returns a map of the spectrum numbers to the distances for the neighbours
+ * within the given distance.
  * @param spectrum :: Spectrum No of the central pixel
- * @param radius :: cut-off distance for detector list to returns
+ * @param radius :: cut-off distance for detector list to returns. If 0 the
+ * 8 nearest neighbours are returned.
  * @return map of Detector ID's to distance
- * @throw NotFoundError if component is not recognised as a detector
+ * @throw NotFoundError if the spectrum is not known
  */
 std::map<specnum_t, V3D>
 NearestNeighbours::neighboursInRadius(const specnum_t spectrum,
@@ -73,167 +101,113 @@ NearestNeighbours::neighboursInRadius(const specnum_t spectrum,
         "NearestNeighbours::neighbours - Invalid radius parameter.");
   }
 
-  std::map<specnum_t, V3D> result;
+  const std::vector<size_t> index(1, m_index->indexOf(spectrum));
   if (radius == 0.0) {
-    const int eightNearest = 8;
-    if (m_noNeighbours != eightNearest) {
-      // Note: Should be able to do this better but time constraints for the
-      // moment mean that
-      // it is necessary.
-      // Cast is necessary as the user should see this as a const member
-      const_cast<NearestNeighbours *>(this)->build(eightNearest);
-    }
-    result = defaultNeighbours(spectrum);
-  } else if (radius > m_cutoff && m_radius != radius) {
-    // We might have to see how efficient this ends up being.
-    int neighbours = m_noNeighbours + 1;
-    while (true) {
-      try {
-        const_cast<NearestNeighbours *>(this)->build(neighbours);
-      } catch (std::invalid_argument &) {
-        break;
-      }
-      if (radius < m_cutoff)
-        break;
-      else
-        neighbours += 1;
-    }
+    const size_t eightNearest = 8;
+    return distances(index.front(),
+                     m_index->nearest(index, eightNearest).front());
   }
-  m_radius = radius;
-
-  std::map<detid_t, V3D> nearest = defaultNeighbours(spectrum);
-  for (std::map<specnum_t, V3D>::const_iterator cit = nearest.begin();
-       cit != nearest.end(); ++cit) {
-    if (cit->second.norm() <= radius) {
-      result[cit->first] = cit->second;
-    }
-  }
-  return result;
+  return distances(index.front(),
+                   m_index->withinRadius(index, radius).front());
 }
 
 //--------------------------------------------------------------------------
 // Private member functions
 //--------------------------------------------------------------------------
 /**
- * Builds a map based on the given number of neighbours
- * @param noNeighbours :: The number of nearest neighbours to use to build
- * the graph
+ * Gets the index of the spectra of the instrument from the cache of the
+ * instrument, or builds it if it is not there.
+ * @throw std::runtime_error if there are no spectra
+ * @throw std::invalid_argument if the number of neighbours is not less than
+ * the number of spectra
  */
-void NearestNeighbours::build(const int noNeighbours) {
-  std::map<specnum_t, IDetector_const_sptr> spectraDets =
-      getSpectraDetectors(m_instrument, m_spectraMap);
-  if (spectraDets.empty()) {
+void NearestNeighbours::build() {
+  if (m_instrument->isParametrized()) {
+    // The mapping in order of spectrum number, as the index is built
+    std::vector<ISpectrumDetectorMapping::const_iterator> entries;
+    entries.reserve(m_spectraMap.size());
+    for (auto it = m_spectraMap.cbegin(); it != m_spectraMap.cend(); ++it)
+      entries.push_back(it);
+    std::sort(entries.begin(), entries.end(),
+              [](const ISpectrumDetectorMapping::const_iterator &lhs,
+                 const ISpectrumDetectorMapping::const_iterator &rhs) {
+                return lhs->first < rhs->first;
+              });
+
+    NeighbourIndexCache::Key key;
+    key.parameterMapVersion = m_instrument->getParameterMap()->version();
+    key.ignoreMaskedDetectors = m_bIgnoreMaskedDetectors;
+    for (const auto &entry : entries) {
+      key.mapping.push_back(entry->first);
+      key.mapping.push_back(static_cast<int>(entry->second.size()));
+      key.mapping.insert(key.mapping.end(), entry->second.begin(),
+                         entry->second.end());
+    }
+    m_index = m_instrument->neighbourIndexCache().get(
+        key, [this]() { return createIndex(); });
+  } else {
+    // The base instrument may still change
+    m_index = createIndex();
+  }
+
+  if (m_index->size() == 0) {
     throw std::runtime_error(
         "NearestNeighbours::build - Cannot find any spectra");
   }
-  const int nspectra =
-      static_cast<int>(spectraDets.size()); // ANN only deals with integers
-  if (noNeighbours >= nspectra) {
+  if (m_noNeighbours < 0 ||
+      static_cast<size_t>(m_noNeighbours) >= m_index->size()) {
     throw std::invalid_argument(
         "NearestNeighbours::build - Invalid number of neighbours");
   }
+}
 
-  // Clear current
-  m_graph.clear();
-  m_specToVertex.clear();
-  m_noNeighbours = noNeighbours;
+/**
+ * Builds the k-d tree over the positions of the spectra
+ * @return the index
+ */
+boost::shared_ptr<const NeighbourIndex> NearestNeighbours::createIndex() {
+  std::map<specnum_t, IDetector_const_sptr> spectraDets =
+      getSpectraDetectors(m_instrument, m_spectraMap);
+  if (spectraDets.empty()) {
+    return boost::make_shared<const NeighbourIndex>(std::vector<specnum_t>(),
+                                                    std::vector<V3D>(), V3D());
+  }
 
-  BoundingBox bbox;
   // Base the scaling on the first detector, should be adequate but we can look
   // at this
-  IDetector_const_sptr firstDet = (*spectraDets.begin()).second;
-  firstDet->getBoundingBox(bbox);
-  m_scale = V3D(bbox.width());
-  ANNpointArray dataPoints = annAllocPts(nspectra, 3);
-  MapIV pointNoToVertex;
-
-  std::map<specnum_t, IDetector_const_sptr>::const_iterator detIt;
-  int pointNo = 0;
-  for (detIt = spectraDets.begin(); detIt != spectraDets.end(); ++detIt) {
-    IDetector_const_sptr detector = detIt->second;
-    const specnum_t spectrum = detIt->first;
-    V3D pos = detector->getPos() / m_scale;
-    dataPoints[pointNo][0] = pos.X();
-    dataPoints[pointNo][1] = pos.Y();
-    dataPoints[pointNo][2] = pos.Z();
-    Vertex vertex = boost::add_vertex(spectrum, m_graph);
-    pointNoToVertex[pointNo] = vertex;
-    m_specToVertex[spectrum] = vertex;
-    ++pointNo;
-  }
-
-  auto annTree = new ANNkd_tree(dataPoints, nspectra, 3);
-  pointNo = 0;
-  // Run the nearest neighbour search on each detector, reusing the arrays
-  auto nnIndexList = new ANNidx[m_noNeighbours];
-  auto nnDistList = new ANNdist[m_noNeighbours];
-
-  for (detIt = spectraDets.begin(); detIt != spectraDets.end(); ++detIt) {
-    ANNpoint scaledPos = dataPoints[pointNo];
-    annTree->annkSearch(scaledPos,      // Point to search nearest neighbours of
-                        m_noNeighbours, // Number of neighbours to find (8)
-                        nnIndexList,    // Index list of results
-                        nnDistList,     // List of distances to each of these
-                        0.0 // Error bound (?) is this the radius to search in?
-                        );
-    // The distances that are returned are in our scaled coordinate
-    // system. We store the real space ones.
-    V3D realPos = V3D(scaledPos[0], scaledPos[1], scaledPos[2]) * m_scale;
-    for (int i = 0; i < m_noNeighbours; i++) {
-      ANNidx index = nnIndexList[i];
-      V3D neighbour = V3D(dataPoints[index][0], dataPoints[index][1],
-                          dataPoints[index][2]) *
-                      m_scale;
-      V3D distance = neighbour - realPos;
-      double separation = distance.norm();
-      boost::add_edge(m_specToVertex[detIt->first], // from
-                      pointNoToVertex[index],       // to
-                      distance, m_graph);
-      if (separation > m_cutoff) {
-        m_cutoff = separation;
-      }
-    }
-    pointNo++;
+  BoundingBox bbox;
+  spectraDets.begin()->second->getBoundingBox(bbox);
+
+  std::vector<specnum_t> spectra;
+  std::vector<V3D> positions;
+  spectra.reserve(spectraDets.size());
+  positions.reserve(spectraDets.size());
+  for (const auto &spectrumDetector : spectraDets) {
+    spectra.push_back(spectrumDetector.first);
+    positions.push_back(spectrumDetector.second->getPos());
   }
-  delete[] nnIndexList;
-  delete[] nnDistList;
-  delete annTree;
-  annDeallocPts(dataPoints);
-  annClose();
-  pointNoToVertex.clear();
-
-  m_vertexID = get(boost::vertex_name, m_graph);
-  m_edgeLength = get(boost::edge_name, m_graph);
+  return boost::make_shared<const NeighbourIndex>(std::move(spectra),
+                                                  positions, bbox.width());
 }
 
 /**
- * Returns a map of the spectrum numbers to the nearest detectors and their
- * distance from the detector specified in the argument.
- * @param spectrum :: The spectrum number
- * @return map of detID to distance
- * @throw NotFoundError if detector ID is not recognised
+ * Converts neighbouring points of the index to a map of their spectrum
+ * numbers to the distance vectors from the central point.
+ * @param index :: The central point
+ * @param neighbours :: The neighbouring points
+ * @return map of spectrum numbers to distance
  */
 std::map<specnum_t, V3D>
-NearestNeighbours::defaultNeighbours(const specnum_t spectrum) const {
-  auto vertex = m_specToVertex.find(spectrum);
-
-  if (vertex != m_specToVertex.end()) {
-    std::map<specnum_t, V3D> result;
-    std::pair<Graph::adjacency_iterator, Graph::adjacency_iterator> adjacent =
-        boost::adjacent_vertices(vertex->second, m_graph);
-    Graph::adjacency_iterator adjIt;
-    for (adjIt = adjacent.first; adjIt != adjacent.second; adjIt++) {
-      Vertex nearest = (*adjIt);
-      specnum_t nrSpec = specnum_t(m_vertexID[nearest]);
-      std::pair<Graph::edge_descriptor, bool> nrEd =
-          boost::edge(vertex->second, nearest, m_graph);
-      result[nrSpec] = m_edgeLength[nrEd.first];
-    }
-    return result;
-  } else {
-    throw Mantid::Kernel::Exception::NotFoundError(
-        "NearestNeighbours: Unable to find spectrum in vertex map", spectrum);
-  }
+NearestNeighbours::distances(const size_t index,
+                             const std::vector<size_t> &neighbours) const {
+  // The distances are stored in real space, not in the scaled coordinates of
+  // the tree
+  const V3D centre = m_index->position(index);
+  std::map<specnum_t, V3D> result;
+  for (const auto neighbour : neighbours)
+    result[m_index->spectrum(neighbour)] =
+        m_index->position(neighbour) - centre;
+  return result;
 }
 
 /**
@@ -0,0 +1,214 @@
+#include "MantidGeometry/Instrument/NeighbourIndex.h"
+// Nearest neighbours library
+#include "MantidKernel/ANN/ANN.h"
+#include "MantidKernel/Exception.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Mantid {
+namespace Geometry {
+using Kernel::V3D;
+
+namespace {
+/// Serializes the calls to ANN, which keeps the state of a search and the
+/// shared empty leaf of the trees in global variables
+std::mutex g_annMutex;
+
+/// Scale components that are not positive do not scale that direction
+double validScale(const double scale) { return scale > 0.0 ? scale : 1.0; }
+
+/// Throw if an index is not in the range of the points
+void checkIndex(const size_t index, const size_t size) {
+  if (index >= size)
+    throw std::out_of_range("NeighbourIndex: index out of range");
+}
+}
+
+/**
+ * Constructor
+ * @param spectra :: The spectrum number of each point
+ * @param positions :: The position of each point
+ * @param scale :: The positions are divided by the components of the scale
+ * before they are added to the tree
+ * @throw std::invalid_argument if the sizes of spectra and positions differ
+ */
+NeighbourIndex::NeighbourIndex(std::vector<specnum_t> spectra,
+                               const std::vector<V3D> &positions,
+                               const V3D &scale)
+    : m_spectra(std::move(spectra)),
+      m_scale(validScale(scale.X()), validScale(scale.Y()),
+              validScale(scale.Z())),
+      m_points(nullptr) {
+  if (m_spectra.size() != positions.size()) {
+    throw std::invalid_argument(
+        "NeighbourIndex - Expected a position for every spectrum");
+  }
+  m_indices.reserve(m_spectra.size());
+  for (size_t i = 0; i < m_spectra.size(); ++i)
+    m_indices.emplace(m_spectra[i], i);
+  if (m_spectra.empty())
+    return;
+
+  const int npoints = static_cast<int>(m_spectra.size());
+  m_points = annAllocPts(npoints, 3);
+  for (size_t i = 0; i < positions.size(); ++i) {
+    const V3D pos = positions[i] / m_scale;
+    m_points[i][0] = pos.X();
+    m_points[i][1] = pos.Y();
+    m_points[i][2] = pos.Z();
+  }
+  std::lock_guard<std::mutex> lock(g_annMutex);
+  m_tree = std::unique_ptr<ANNkd_tree>(new ANNkd_tree(m_points, npoints, 3));
+}
+
+/// Destructor
+NeighbourIndex::~NeighbourIndex() {
+  m_tree.reset();
+  if (m_points)
+    annDeallocPts(m_points);
+}
+
+/**
+ * @param spectrum :: A spectrum number
+ * @return The index of the point of the spectrum
+ * @throw NotFoundError if the spectrum is not in the index
+ */
+size_t NeighbourIndex::indexOf(const specnum_t spectrum) const {
+  auto it = m_indices.find(spectrum);
+  if (it == m_indices.end()) {
+    throw Kernel::Exception::NotFoundError(
+        "NeighbourIndex: Unable to find spectrum", spectrum);
+  }
+  return it->second;
+}
+
+/**
+ * @param index :: The index of a point
+ * @return The position of the point in real space
+ */
+V3D NeighbourIndex::position(const size_t index) const {
+  checkIndex(index, size());
+  const double *point = m_points[index];
+  return V3D(point[0], point[1], point[2]) * m_scale;
+}
+
+/**
+ * Find the nearest neighbours of many points, in scaled coordinates. Points at
+ * the same position as the query point are not included.
+ * @param indices :: The indices of the query points
+ * @param k :: The number of neighbours to find for each of them
+ * @return The indices of the neighbours of each query point, nearest first
+ * @throw std::invalid_argument if k is not less than the number of points
+ */
+std::vector<std::vector<size_t>>
+NeighbourIndex::nearest(const std::vector<size_t> &indices,
+                        const size_t k) const {
+  if (k >= size()) {
+    throw std::invalid_argument(
+        "NeighbourIndex::nearest - Invalid number of neighbours");
+  }
+  for (const auto index : indices)
+    checkIndex(index, size());
+
+  std::vector<std::vector<size_t>> result(indices.size());
+  const int nk = static_cast<int>(k);
+  std::vector<ANNidx> nnIndexList(k);
+  std::vector<ANNdist> nnDistList(k);
+  std::lock_guard<std::mutex> lock(g_annMutex);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    m_tree->annkSearch(m_points[indices[i]], nk, nnIndexList.data(),
+                       nnDistList.data(), 0.0);
+    auto &neighbours = result[i];
+    neighbours.reserve(k);
+    for (const auto index : nnIndexList) {
+      if (index != ANN_NULL_IDX)
+        neighbours.push_back(static_cast<size_t>(index));
+    }
+  }
+  return result;
+}
+
+/**
+ * Find the points within a distance of many points, in real space. Points at
+ * the same position as the query point are not included.
+ * @param indices :: The indices of the query points
+ * @param radius :: The distance from the query points
+ * @return The indices of the neighbours of each query point, in no particular
+ * order
+ */
+std::vector<std::vector<size_t>>
+NeighbourIndex::withinRadius(const std::vector<size_t> &indices,
+                             const double radius) const {
+  for (const auto index : indices)
+    checkIndex(index, size());
+
+  // The sphere in real space is inside this sphere in scaled coordinates
+  const double scaledRadius =
+      radius / std::min({m_scale.X(), m_scale.Y(), m_scale.Z()});
+  const ANNdist sqRadius = scaledRadius * scaledRadius;
+
+  std::vector<std::vector<size_t>> result(indices.size());
+  std::vector<ANNidx> nnIndexList;
+  std::vector<ANNdist> nnDistList;
+  std::lock_guard<std::mutex> lock(g_annMutex);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    ANNpoint query = m_points[indices[i]];
+    const int count = m_tree->annkFRSearch(query, sqRadius, 0);
+    nnIndexList.resize(count);
+    nnDistList.resize(count);
+    m_tree->annkFRSearch(query, sqRadius, count, nnIndexList.data(),
+                         nnDistList.data());
+
+    const V3D centre = position(indices[i]);
+    auto &neighbours = result[i];
+    for (const auto index : nnIndexList) {
+      if (index != ANN_NULL_IDX &&
+          centre.distance(position(static_cast<size_t>(index))) <= radius)
+        neighbours.push_back(static_cast<size_t>(index));
+    }
+  }
+  return result;
+}
+
+/**
+ * Get the index built from the given data, building it if there is none.
+ * @param key :: Identifies the data to build the index from
+ * @param build :: Builds the index if it is not in the cache
+ * @return The index
+ */
+boost::shared_ptr<const NeighbourIndex> NeighbourIndexCache::get(
+    const Key &key,
+    const std::function<boost::shared_ptr<const NeighbourIndex>()> &build) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = std::find_if(
+      m_entries.begin(), m_entries.end(),
+      [&key](const std::pair<Key, boost::shared_ptr<const NeighbourIndex>>
+                 &entry) { return entry.first == key; });
+  if (it != m_entries.end()) {
+    m_entries.splice(m_entries.begin(), m_entries, it);
+    return it->second;
+  }
+  // Build while holding the lock, so that threads asking for the same index
+  // build it only once
+  auto index = build();
+  m_entries.emplace_front(key, index);
+  if (m_entries.size() > CAPACITY)
+    m_entries.pop_back();
+  return index;
+}
+
+/// The number of indices in the cache
+size_t NeighbourIndexCache::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+/// Remove all the indices from the cache
+void NeighbourIndexCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+}
+
+} // namespace Geometry
+} // namespace Mantid
@@ -40,6 +40,8 @@ const std::string QUAT_PARAM_NAME = "Quat";
 
 // static logger reference
 Kernel::Logger g_log("ParameterMap");
+// The last stamp given to the contents of a map
+std::atomic<size_t> g_lastVersion{0};
 }
 //--------------------------------------------------------------------------
 // Public method
@@ -53,7 +55,8 @@ ParameterMap::ParameterMap()
       m_cacheRotMap(Kernel::make_unique<
           Kernel::Cache<const ComponentID, Kernel::Quat>>()),
       m_boundingBoxMap(Kernel::make_unique<
-          Kernel::Cache<const ComponentID, BoundingBox>>()) {}
+          Kernel::Cache<const ComponentID, BoundingBox>>()),
+      m_version(++g_lastVersion) {}
 
 ParameterMap::ParameterMap(const ParameterMap &other)
     : m_parameterFileNames(other.m_parameterFileNames), m_map(other.m_map),
@@ -65,7 +68,8 @@ ParameterMap::ParameterMap(const ParameterMap &other)
               *other.m_cacheRotMap)),
       m_boundingBoxMap(
           Kernel::make_unique<Kernel::Cache<const ComponentID, BoundingBox>>(
-              *other.m_boundingBoxMap)) {}
+              *other.m_boundingBoxMap)),
+      m_version(other.m_version.load()) {}
 
 // Defined as default in source for forward declaration with std::unique_ptr.
 ParameterMap::~ParameterMap() = default;
@@ -293,6 +297,7 @@ void ParameterMap::clearParametersByName(const std::string &name) {
       ++itr;
     }
   }
+  updateVersion();
   // Check if the caches need invalidating
   if (name == pos() || name == rot())
     clearPositionSensitiveCaches();
@@ -315,6 +320,7 @@ void ParameterMap::clearParametersByName(const std::string &name,
         ++it;
       }
     }
+    updateVersion();
 
     // Check if the caches need invalidating
     if (name == pos() || name == rot())
@@ -383,6 +389,7 @@ void ParameterMap::add(const IComponent *comp,
     m_map.insert(std::make_pair(comp->getComponentID(), par));
 #endif
   }
+  updateVersion();
 }
 
 /** Create or adjust "pos" parameter for a component
@@ -980,6 +987,9 @@ std::string ParameterMap::asString() const {
   return out.str();
 }
 
+/// Give the current contents a stamp that no map has had before
+void ParameterMap::updateVersion() { m_version = ++g_lastVersion; }
+
 /**
  * Clears the location, rotation & bounding box caches
  */
@@ -1062,6 +1072,7 @@ void ParameterMap::copyFromParameterMap(const IComponent *oldComp,
         std::make_pair(newComp->getComponentID(), std::move(thisParameter)));
 #endif
   }
+  updateVersion();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -826,4 +826,52 @@ public:
   }
 };
 
+class IndexingUtilsTestPerformance : public CxxTest::TestSuite {
+public:
+  static IndexingUtilsTestPerformance *createSuite() {
+    return new IndexingUtilsTestPerformance();
+  }
+  static void destroySuite(IndexingUtilsTestPerformance *suite) {
+    delete suite;
+  }
+
+  IndexingUtilsTestPerformance() {
+    // About 10000 peaks of natrolite
+    const Matrix<double> UB = IndexingUtilsTest::getNatroliteUB();
+    for (int h = -10; h <= 10; h++) {
+      for (int k = -10; k <= 10; k++) {
+        for (int l = -10; l <= 10; l++) {
+          if (h != 0 || k != 0 || l != 0)
+            m_qVectors.push_back(UB * V3D(h, k, l) * (2.0 * M_PI));
+        }
+      }
+    }
+  }
+
+  void test_FFTScanFor_Directions() {
+    std::vector<V3D> directions;
+    IndexingUtils::FFTScanFor_Directions(directions, m_qVectors, 6, 20, 0.12,
+                                         1.0);
+    TS_ASSERT(!directions.empty());
+  }
+
+  void test_ScanFor_Directions() {
+    std::vector<V3D> directions;
+    IndexingUtils::ScanFor_Directions(
+        directions, IndexingUtilsTest::getNatroliteQs(), 6, 10, 0.12, 0.5);
+    TS_ASSERT(!directions.empty());
+  }
+
+  void test_ScanFor_UB() {
+    Matrix<double> UB(3, 3, false);
+    UnitCell cell(6.6f, 9.7f, 9.9f, 84, 71, 70);
+    const double error = IndexingUtils::ScanFor_UB(
+        UB, IndexingUtilsTest::getNatroliteQs(), cell, 1.5, 0.2);
+    TS_ASSERT_LESS_THAN(error, 1.0);
+  }
+
+private:
+  std::vector<V3D> m_qVectors;
+};
+
 #endif /* MANTID_GEOMETRY_INDEXING_UTILS_TEST_H_ */
@@ -5,9 +5,11 @@
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/NearestNeighbours.h"
+#include "MantidGeometry/Instrument/NeighbourIndex.h"
 #include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
+#include "MantidKernel/Exception.h"
 #include "MantidTestHelpers/ComponentCreationHelper.h"
 #include <cxxtest/TestSuite.h>
 #include <map>
@@ -172,8 +174,52 @@ public:
     TS_ASSERT_EQUALS(nb.size(), 0);
 
     // The ones above below and next to it
-    nb = nn.neighboursInRadius(spec, 0.016);
+    nb = nn.neighboursInRadius(spec, 0.009);
     TS_ASSERT_EQUALS(nb.size(), 4);
+
+    // And the ones on the diagonals
+    nb = nn.neighboursInRadius(spec, 0.012);
+    TS_ASSERT_EQUALS(nb.size(), 8);
+  }
+
+  void testIndexIsSharedUntilParametersChange() {
+    Instrument_sptr instrument = boost::dynamic_pointer_cast<Instrument>(
+        ComponentCreationHelper::createTestInstrumentCylindrical(2));
+    const ISpectrumDetectorMapping spectramap =
+        buildSpectrumDetectorMapping(1, 18);
+    ParameterMap_sptr pmap(new ParameterMap());
+    Instrument_sptr m_instrument(new Instrument(instrument, pmap));
+    auto &cache = instrument->neighbourIndexCache();
+
+    NearestNeighbours nn(m_instrument, spectramap);
+    NearestNeighbours nn4(4, m_instrument, spectramap);
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    TS_ASSERT_EQUALS(nn.neighbours(2).count(1), 1);
+
+    // Moving a detector away gives the parameter map a new version
+    pmap->addPositionCoordinate(instrument->getDetector(1).get(), "z", 100.0);
+    NearestNeighbours moved(m_instrument, spectramap);
+    TS_ASSERT_EQUALS(cache.size(), 2);
+    TS_ASSERT_EQUALS(moved.neighbours(2).count(1), 0);
+    TS_ASSERT_EQUALS(nn.neighbours(2).count(1), 1);
+  }
+
+  void testNeighboursOfManySpectra() {
+    Instrument_sptr instrument = boost::dynamic_pointer_cast<Instrument>(
+        ComponentCreationHelper::createTestInstrumentCylindrical(2));
+    const ISpectrumDetectorMapping spectramap =
+        buildSpectrumDetectorMapping(1, 18);
+    ParameterMap_sptr pmap(new ParameterMap());
+    Instrument_sptr m_instrument(new Instrument(instrument, pmap));
+
+    NearestNeighbours nn(m_instrument, spectramap);
+    const std::vector<specnum_t> spectra{1, 5, 14};
+    const auto neighbours = nn.neighbours(spectra);
+    TS_ASSERT_EQUALS(neighbours.size(), 3);
+    for (size_t i = 0; i < spectra.size(); ++i)
+      TS_ASSERT(neighbours[i] == nn.neighbours(spectra[i]));
+    TS_ASSERT_THROWS(nn.neighbours(std::vector<specnum_t>(1, 42)),
+                     Mantid::Kernel::Exception::NotFoundError);
   }
 
   void testIgnoreAndApplyMasking() {
@@ -0,0 +1,160 @@
+#ifndef MANTID_GEOMETRY_NEIGHBOURINDEXTEST_H_
+#define MANTID_GEOMETRY_NEIGHBOURINDEXTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Instrument/NeighbourIndex.h"
+#include "MantidKernel/Exception.h"
+
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+
+using Mantid::Geometry::NeighbourIndex;
+using Mantid::Geometry::NeighbourIndexCache;
+using Mantid::Kernel::V3D;
+using Mantid::specnum_t;
+
+class NeighbourIndexTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static NeighbourIndexTest *createSuite() { return new NeighbourIndexTest(); }
+  static void destroySuite(NeighbourIndexTest *suite) { delete suite; }
+
+  void test_spectra_and_positions() {
+    const auto index = createGrid(3, 0.01);
+    TS_ASSERT_EQUALS(index->size(), 9);
+    TS_ASSERT_EQUALS(index->spectrum(4), 105);
+    TS_ASSERT_EQUALS(index->indexOf(105), 4);
+    TS_ASSERT_THROWS(index->indexOf(42),
+                     Mantid::Kernel::Exception::NotFoundError);
+    TS_ASSERT_DELTA(index->position(4).X(), 0.01, 1e-12);
+    TS_ASSERT_DELTA(index->position(4).Y(), 0.01, 1e-12);
+    TS_ASSERT_THROWS(index->position(9), std::out_of_range);
+  }
+
+  void test_sizes_must_match() {
+    TS_ASSERT_THROWS(NeighbourIndex({1, 2}, {V3D()}, V3D(1, 1, 1)),
+                     std::invalid_argument);
+  }
+
+  void test_nearest_excludes_the_point_itself() {
+    const auto index = createGrid(3, 0.01);
+    // Scaling by the pixel size makes the grid spacing 1 in x and 0.1 in y
+    const auto nearest = index->nearest({4, 0}, 2);
+    TS_ASSERT_EQUALS(nearest.size(), 2);
+    auto centre = nearest[0];
+    std::sort(centre.begin(), centre.end());
+    TS_ASSERT_EQUALS(centre, std::vector<size_t>({1, 7}));
+    TS_ASSERT_EQUALS(nearest[1].front(), 3);
+    TS_ASSERT_THROWS(index->nearest({0}, 9), std::invalid_argument);
+  }
+
+  void test_within_radius_uses_real_distances() {
+    const auto index = createGrid(5, 0.01);
+    const size_t centre = 12;
+    auto faces = index->withinRadius({centre}, 0.011).front();
+    std::sort(faces.begin(), faces.end());
+    TS_ASSERT_EQUALS(faces, std::vector<size_t>({7, 11, 13, 17}));
+    TS_ASSERT_EQUALS(index->withinRadius({centre}, 0.015).front().size(), 8);
+    TS_ASSERT_EQUALS(index->withinRadius({centre}, 1.0).front().size(), 24);
+    TS_ASSERT(index->withinRadius({centre}, 0.001).front().empty());
+  }
+
+  void test_cache_builds_each_index_once() {
+    NeighbourIndexCache cache;
+    size_t builds = 0;
+    auto build = [&builds]() {
+      ++builds;
+      return createGrid(2, 0.01);
+    };
+    const auto first = cache.get(key(1), build);
+    TS_ASSERT_EQUALS(cache.get(key(1), build), first);
+    TS_ASSERT_EQUALS(builds, 1);
+    TS_ASSERT_DIFFERS(cache.get(key(2), build), first);
+    TS_ASSERT_EQUALS(builds, 2);
+    TS_ASSERT_EQUALS(cache.size(), 2);
+  }
+
+  void test_cache_drops_least_recently_used_index() {
+    NeighbourIndexCache cache;
+    size_t builds = 0;
+    auto build = [&builds]() {
+      ++builds;
+      return createGrid(2, 0.01);
+    };
+    for (size_t version = 0; version <= NeighbourIndexCache::CAPACITY;
+         ++version) {
+      cache.get(key(version), build);
+      // Keep using the first one
+      cache.get(key(0), build);
+    }
+    TS_ASSERT_EQUALS(cache.size(), NeighbourIndexCache::CAPACITY);
+    TS_ASSERT_EQUALS(builds, NeighbourIndexCache::CAPACITY + 1);
+    cache.get(key(1), build);
+    TS_ASSERT_EQUALS(builds, NeighbourIndexCache::CAPACITY + 2);
+    cache.clear();
+    TS_ASSERT_EQUALS(cache.size(), 0);
+  }
+
+  /// A square grid of n x n points in the x-y plane, whose spectrum numbers
+  /// start at 101, scaled by a pixel that is ten times higher than wide
+  static boost::shared_ptr<const NeighbourIndex>
+  createGrid(const size_t n, const double spacing) {
+    std::vector<specnum_t> spectra;
+    std::vector<V3D> positions;
+    for (size_t y = 0; y < n; ++y) {
+      for (size_t x = 0; x < n; ++x) {
+        spectra.push_back(static_cast<specnum_t>(101 + positions.size()));
+        positions.emplace_back(static_cast<double>(x) * spacing,
+                               static_cast<double>(y) * spacing, 5.0);
+      }
+    }
+    return boost::make_shared<const NeighbourIndex>(
+        std::move(spectra), positions,
+        V3D(spacing, 10.0 * spacing, spacing));
+  }
+
+private:
+  NeighbourIndexCache::Key key(const size_t version) {
+    NeighbourIndexCache::Key result;
+    result.parameterMapVersion = version;
+    result.ignoreMaskedDetectors = false;
+    result.mapping = {1, 1, 1};
+    return result;
+  }
+};
+
+class NeighbourIndexTestPerformance : public CxxTest::TestSuite {
+public:
+  static NeighbourIndexTestPerformance *createSuite() {
+    return new NeighbourIndexTestPerformance();
+  }
+  static void destroySuite(NeighbourIndexTestPerformance *suite) {
+    delete suite;
+  }
+
+  NeighbourIndexTestPerformance()
+      : m_index(NeighbourIndexTest::createGrid(1000, 0.01)),
+        m_all(m_index->size()) {
+    for (size_t i = 0; i < m_all.size(); ++i)
+      m_all[i] = i;
+  }
+
+  void test_eight_nearest_of_a_million_points() {
+    const auto nearest = m_index->nearest(m_all, 8);
+    TS_ASSERT_EQUALS(nearest.size(), m_all.size());
+  }
+
+  void test_radius_of_a_million_points() {
+    const auto neighbours = m_index->withinRadius(m_all, 0.015);
+    TS_ASSERT_EQUALS(neighbours[500500].size(), 8);
+  }
+
+private:
+  boost::shared_ptr<const NeighbourIndex> m_index;
+  std::vector<size_t> m_all;
+};
+
+#endif /* MANTID_GEOMETRY_NEIGHBOURINDEXTEST_H_ */
@@ -61,6 +61,8 @@ public:
 
   static size_t getNumPhysicalCores();
 
+  static bool useWorkStealing();
+
 protected:
   /// Number of cores used
   size_t m_numThreads;
@@ -103,8 +103,8 @@ public:
   virtual void clear() = 0;
 
   //-------------------------------------------------------------------------------
-  /// Returns the total cost of all Task's in the queue.
-  double totalCost() { return m_cost; }
+  /// Returns the total cost of all Task's pushed to the queue.
+  virtual double totalCost() { return m_cost; }
 
   //-------------------------------------------------------------------------------
   /// Returns the total cost of all Task's in the queue.
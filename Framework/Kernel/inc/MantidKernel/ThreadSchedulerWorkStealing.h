@@ -0,0 +1,91 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : A ThreadScheduler with one queue per worker
+ * thread. Threads pop from their own queue and steal from the queues of other
+ * threads once their own queue runs dry.
+ *
+ * Every queue has its own lock, so fine-grained tasks do not all contend on a
+ * single mutex as they do with the other schedulers. New tasks are distributed
+ * round-robin over the queues.
+ *
+ * Within each queue the tasks are sorted by cost, largest first, as in
+ * ThreadSchedulerLargestCost. Like ThreadSchedulerMutexes, a task is not handed
+ * out while another task with the same mutex is running, unless every queued
+ * task is waiting for a busy mutex.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  ThreadSchedulerWorkStealing(size_t numQueues = 0);
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(Task *newTask) override;
+  Task *pop(size_t threadnum) override;
+  void finished(Task *task, size_t threadnum) override;
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+  double totalCost() override;
+  double remainingCost();
+
+private:
+  /// Queue of tasks owned by one worker thread, sorted by cost.
+  struct WorkerQueue {
+    std::mutex lock;
+    std::multimap<double, Task *> tasks;
+    /// Cost of all tasks ever pushed to the queue
+    double pushedCost{0.0};
+    /// Cost of the tasks still in the queue
+    double cost{0.0};
+  };
+
+  Task *popFrom(WorkerQueue &queue, bool ignoreBusyMutexes);
+
+  /// One queue per worker thread
+  std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+  /// Number of tasks in all queues
+  std::atomic<size_t> m_size{0};
+  /// Queue that receives the next pushed task
+  std::atomic<size_t> m_nextQueue{0};
+  /// Mutexes of the tasks that are currently running, guarded by m_queueLock
+  std::multiset<boost::shared_ptr<std::mutex>> m_busyMutexes;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_ */
@@ -11,6 +11,7 @@
 #include "MantidKernel/PropertyNexus.h"
 #include "MantidKernel/Statistics.h"
 #include <cstdint>
+#include <memory>
 #include <utility>
 
 namespace Mantid {
@@ -87,6 +88,12 @@ public:
 /**
    A specialised Property class for holding a series of time-value pairs.
 
+   Queries over ranges of time, such as time averages, integrals and sums of
+   the values, use an index of the sorted entries that is built when first
+   needed and dropped whenever the series changes. It stores the times and
+   the values in separate arrays together with their running sums, so each
+   range costs two binary searches whatever the length of the series.
+
    Copyright &copy; 2007-2010 ISIS Rutherford Appleton Laboratory, NScD Oak
    Ridge National Laboratory & European Spallation Source
 
@@ -170,6 +177,11 @@ public:
       const std::vector<SplittingInterval> &filter) const override;
   /// Calculate the time-weighted average of a property
   double timeAverageValue() const;
+  /// Calculate the integral of the values over time between two times
+  double timeIntegral(const Kernel::DateAndTime &start,
+                      const Kernel::DateAndTime &stop) const;
+  /// Sum the values that filterByTimes would keep, without filtering
+  double sumValuesInFilter(const std::vector<SplittingInterval> &filter) const;
   /// generate constant time-step histogram from the property values
   void histogramData(const Kernel::DateAndTime &tMin,
                      const Kernel::DateAndTime &tMax,
@@ -254,6 +266,9 @@ public:
   TYPE getSingleValue(const DateAndTime &t) const;
   /// Returns the value at a particular time
   TYPE getSingleValue(const DateAndTime &t, int &index) const;
+  /// Returns the values at many times, given in increasing order
+  std::vector<TYPE>
+  getSingleValues(const std::vector<DateAndTime> &times) const;
 
   /// Returns n-th valid time interval, in a very inefficient way.
   TimeInterval nthInterval(int n) const;
@@ -297,6 +312,9 @@ public:
   void reserve(size_t size) { m_values.reserve(size); };
 
 private:
+  /// Columns and running sums of the sorted entries
+  struct Index;
+
   //----------------------------------------------------------------------------------------------
   /// Saves the time vector has time + start attribute
   void saveTimeVector(::NeXus::File *file);
@@ -308,6 +326,8 @@ private:
   int upperBound(Kernel::DateAndTime t, int istart, int iend) const;
   /// Apply a filter
   void applyFilter() const;
+  /// Get the index of the entries, building it if necessary
+  std::shared_ptr<const Index> index() const;
   /// A new algorithm to find Nth index.  It is simple and leave a lot work to
   /// the callers
   size_t findNthIndexFromQuickRef(int n) const;
@@ -330,6 +350,10 @@ private:
   mutable std::vector<std::pair<size_t, size_t>> m_filterQuickRef;
   /// True if a filter has been applied
   mutable bool m_filterApplied;
+
+  /// The index of the entries, or null if it has not been built since they
+  /// last changed
+  mutable std::shared_ptr<const Index> m_index;
 };
 
 /// Function filtering double TimeSeriesProperties according to the requested
@@ -55,6 +55,48 @@ private:
  */
 typedef std::vector<SplittingInterval> TimeSplitterType;
 
+/**
+ * The intervals of a TimeSplitterType sorted by start time and stored column
+ * by column in nanoseconds. The destination of each interval is given as a
+ * position in the sorted list of destination indices, so that the outputs of
+ * a split can be held in a vector. Index -1, for the times that are not in
+ * any interval, is always in the list.
+ *
+ * It is built once and shared by the threads splitting many event lists with
+ * the same splitter.
+ */
+class MANTID_KERNEL_DLL SplitterIndex {
+public:
+  SplitterIndex(const TimeSplitterType &splitter,
+                const std::vector<int> &indices);
+
+  /// The number of intervals
+  size_t size() const { return m_starts.size(); }
+  /// The start of each interval in nanoseconds
+  const std::vector<int64_t> &starts() const { return m_starts; }
+  /// The end of each interval in nanoseconds
+  const std::vector<int64_t> &stops() const { return m_stops; }
+  /// The position in indices() of the destination of each interval
+  const std::vector<size_t> &destinations() const { return m_destinations; }
+  /// The destination indices in increasing order
+  const std::vector<int> &indices() const { return m_indices; }
+  /// The position of index -1 in indices()
+  size_t unfiltered() const { return m_unfiltered; }
+  size_t position(const int index) const;
+
+private:
+  /// The start of each interval in nanoseconds
+  std::vector<int64_t> m_starts;
+  /// The end of each interval in nanoseconds
+  std::vector<int64_t> m_stops;
+  /// The position of the destination of each interval
+  std::vector<size_t> m_destinations;
+  /// The destination indices in increasing order
+  std::vector<int> m_indices;
+  /// The position of index -1
+  size_t m_unfiltered;
+};
+
 // -------------- Operators ---------------------
 MANTID_KERNEL_DLL TimeSplitterType
 operator+(const TimeSplitterType &a, const TimeSplitterType &b);
@@ -184,6 +184,25 @@ public:
    */
   virtual double singleFromTOF(const double tof) const = 0;
 
+  /** Convert an array of X values to TOF. The unit must be initialized.
+   * @param x :: the values to convert
+   * @param tof :: receives the TOF values, may be the same array as x
+   * @param n :: the number of values
+   */
+  virtual void multipleToTOF(const double *x, double *tof, size_t n) const;
+
+  /** Convert an array of tof values to this unit. The unit must be
+   * initialized.
+   * @param tof :: the values to convert
+   * @param x :: receives the converted values, may be the same array as tof
+   * @param n :: the number of values
+   */
+  virtual void multipleFromTOF(const double *tof, double *x, size_t n) const;
+
+  /// Convert an array of values in this unit to the destination unit via TOF
+  void convertViaTOF(const Unit &destination, const double *x, double *out,
+                     size_t n) const;
+
   /// @return true if the unit was initialized and so can use singleToTOF()
   bool isInitialized() const { return initialized; }
 
@@ -304,6 +323,8 @@ public:
   void init() override;
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof, size_t n) const override;
+  void multipleFromTOF(const double *tof, double *x, size_t n) const override;
   Unit *clone() const override;
   ///@return -DBL_MAX as ToF convertible to TOF for in any time range
   double conversionTOFMin() const override;
@@ -321,6 +342,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof, size_t n) const override;
+  void multipleFromTOF(const double *tof, double *x, size_t n) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -348,6 +371,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof, size_t n) const override;
+  void multipleFromTOF(const double *tof, double *x, size_t n) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -395,6 +420,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof, size_t n) const override;
+  void multipleFromTOF(const double *tof, double *x, size_t n) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -418,6 +445,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof, size_t n) const override;
+  void multipleFromTOF(const double *tof, double *x, size_t n) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -463,6 +492,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof, size_t n) const override;
+  void multipleFromTOF(const double *tof, double *x, size_t n) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -532,6 +563,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof, size_t n) const override;
+  void multipleFromTOF(const double *tof, double *x, size_t n) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -551,6 +584,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(const double *x, double *tof, size_t n) const override;
+  void multipleFromTOF(const double *tof, double *x, size_t n) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
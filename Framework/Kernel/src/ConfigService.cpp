@@ -600,6 +600,11 @@ void ConfigServiceImpl::createUserPropertiesFile() const {
     filestr
         << "## Set the maximum number of coures used to run algorithms over\n";
     filestr << "#MultiThreaded.MaxCores=4\n\n";
+    filestr << "## Use work stealing task queues in thread pools\n";
+    filestr << "#MultiThreaded.WorkStealing=1\n\n";
+    filestr << "## Set the memory (in MB) used to cache histograms of event "
+               "workspaces\n";
+    filestr << "#EventWorkspace.HistogramCacheMB=256\n\n";
     filestr << "##\n";
     filestr << "## FACILITY AND INSTRUMENT\n";
     filestr << "##\n\n";
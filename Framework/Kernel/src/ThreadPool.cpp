@@ -62,6 +62,18 @@ size_t ThreadPool::getNumPhysicalCores() {
     return Poco::Environment::processorCount();
 }
 
+//--------------------------------------------------------------------------------
+/** Should callers that do not depend on a particular task order use a
+ * ThreadSchedulerWorkStealing? Set by the MultiThreaded.WorkStealing key.
+ * @return true if work stealing is enabled.
+ */
+bool ThreadPool::useWorkStealing() {
+  int workStealing(0);
+  int retVal = Kernel::ConfigService::Instance().getValue(
+      "MultiThreaded.WorkStealing", workStealing);
+  return retVal > 0 && workStealing != 0;
+}
+
 //--------------------------------------------------------------------------------
 /** Start the threads and begin looking for tasks.
  *
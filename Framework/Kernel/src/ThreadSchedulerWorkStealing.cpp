@@ -0,0 +1,146 @@
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/make_unique.h"
+
+namespace Mantid {
+namespace Kernel {
+
+/** Constructor
+ *
+ * @param numQueues :: number of queues, typically the number of threads of the
+ *        ThreadPool using this scheduler; default = 0, meaning the number of
+ *        cores given by ThreadPool::getNumPhysicalCores().
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numQueues)
+    : ThreadScheduler() {
+  if (numQueues == 0)
+    numQueues = ThreadPool::getNumPhysicalCores();
+  for (size_t i = 0; i < numQueues; ++i)
+    m_queues.push_back(Kernel::make_unique<WorkerQueue>());
+}
+
+/// Destructor
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() { clear(); }
+
+/** Add a Task to one of the queues, chosen round-robin.
+ * @param newTask :: Task to add
+ */
+void ThreadSchedulerWorkStealing::push(Task *newTask) {
+  auto &queue = *m_queues[m_nextQueue++ % m_queues.size()];
+  const double cost = newTask->cost();
+  std::lock_guard<std::mutex> lock(queue.lock);
+  queue.pushedCost += cost;
+  queue.cost += cost;
+  queue.tasks.emplace(cost, newTask);
+  ++m_size;
+}
+
+/** Retrieves the next Task to execute. The queue of the calling thread is
+ * tried first, then the queues of all other threads in turn.
+ * @param threadnum :: ID of the calling thread.
+ * @return a Task pointer to execute, or NULL if all queues are empty.
+ */
+Task *ThreadSchedulerWorkStealing::pop(size_t threadnum) {
+  const size_t numQueues = m_queues.size();
+  const size_t own = threadnum % numQueues;
+  for (size_t i = 0; i < numQueues; ++i)
+    if (Task *task = popFrom(*m_queues[(own + i) % numQueues], false))
+      return task;
+  // All remaining tasks wait for a busy mutex. Take one anyway, the thread
+  // will block on the mutex until it is free.
+  for (size_t i = 0; i < numQueues; ++i)
+    if (Task *task = popFrom(*m_queues[(own + i) % numQueues], true))
+      return task;
+  return nullptr;
+}
+
+/** Take the largest cost task out of the queue, skipping tasks whose mutex is
+ * in use by a running task unless `ignoreBusyMutexes` is set.
+ * @param queue :: queue to take the task from
+ * @param ignoreBusyMutexes :: if true, return a task even if its mutex is busy
+ * @return the task, or NULL if no suitable task is in the queue.
+ */
+Task *ThreadSchedulerWorkStealing::popFrom(WorkerQueue &queue,
+                                           bool ignoreBusyMutexes) {
+  std::lock_guard<std::mutex> lock(queue.lock);
+  // The set of busy mutexes is shared by all queues; only lock it when we
+  // actually come across a task with a mutex.
+  std::unique_lock<std::mutex> busyLock(m_queueLock, std::defer_lock);
+  for (auto it = queue.tasks.rbegin(); it != queue.tasks.rend(); ++it) {
+    Task *task = it->second;
+    boost::shared_ptr<std::mutex> mutex = task->getMutex();
+    if (mutex) {
+      if (!busyLock.owns_lock())
+        busyLock.lock();
+      if (!ignoreBusyMutexes && m_busyMutexes.count(mutex) > 0)
+        continue;
+      m_busyMutexes.insert(mutex);
+    }
+    queue.cost -= it->first;
+    queue.tasks.erase(std::next(it).base());
+    --m_size;
+    return task;
+  }
+  return nullptr;
+}
+
+/** Signal to the scheduler that a task is complete, releasing its mutex.
+ *
+ * @param task :: the Task that was completed.
+ * @param threadnum :: unused argument
+ */
+void ThreadSchedulerWorkStealing::finished(Task *task, size_t threadnum) {
+  UNUSED_ARG(threadnum);
+  boost::shared_ptr<std::mutex> mutex = task->getMutex();
+  if (mutex) {
+    std::lock_guard<std::mutex> lock(m_queueLock);
+    auto it = m_busyMutexes.find(mutex);
+    if (it != m_busyMutexes.end())
+      m_busyMutexes.erase(it);
+  }
+}
+
+/// @return the number of tasks in all queues
+size_t ThreadSchedulerWorkStealing::size() { return m_size; }
+
+/// @return true if all queues are empty
+bool ThreadSchedulerWorkStealing::empty() { return m_size == 0; }
+
+/// Empty out all queues, deleting the tasks
+void ThreadSchedulerWorkStealing::clear() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    for (auto &task : queue->tasks)
+      delete task.second;
+    m_size -= queue->tasks.size();
+    queue->tasks.clear();
+    queue->pushedCost = 0.0;
+    queue->cost = 0.0;
+  }
+  m_cost = 0;
+  m_costExecuted = 0;
+}
+
+/// @return the total cost of all tasks pushed to any queue since the last
+/// clear(), as for the other schedulers
+double ThreadSchedulerWorkStealing::totalCost() {
+  double cost = 0.0;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    cost += queue->pushedCost;
+  }
+  return cost;
+}
+
+/// @return the total cost of the tasks still waiting in all queues
+double ThreadSchedulerWorkStealing::remainingCost() {
+  double cost = 0.0;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    cost += queue->cost;
+  }
+  return cost;
+}
+
+} // namespace Kernel
+} // namespace Mantid
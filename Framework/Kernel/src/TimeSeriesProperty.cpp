@@ -8,13 +8,72 @@
 
 #include <boost/regex.hpp>
 
+#include <algorithm>
+#include <numeric>
+
 namespace Mantid {
 namespace Kernel {
 namespace {
 /// static Logger definition
 Logger g_log("TimeSeriesProperty");
+
+/// The values of the entries as doubles
+template <typename TYPE>
+std::vector<double>
+valuesAsDoubles(const std::vector<TimeValueUnit<TYPE>> &entries) {
+  std::vector<double> values;
+  values.reserve(entries.size());
+  for (const auto &entry : entries)
+    values.push_back(static_cast<double>(entry.value()));
+  return values;
 }
 
+/// Strings have no numeric values
+std::vector<double>
+valuesAsDoubles(const std::vector<TimeValueUnit<std::string>> &) {
+  return std::vector<double>();
+}
+}
+
+/// The sorted entries stored column by column, with the running sums that
+/// integrate and sum the values over ranges of time. Strings only have times.
+template <typename TYPE> struct TimeSeriesProperty<TYPE>::Index {
+  /// The times in nanoseconds
+  std::vector<int64_t> times;
+  /// The values as doubles
+  std::vector<double> values;
+  /// The integral of the values over time, in seconds, from the first time
+  /// up to each time
+  std::vector<double> integrals;
+  /// The sum of the values before each entry, followed by the total
+  std::vector<double> sums;
+  /// The smallest value
+  double minimum = 0.0;
+  /// The largest value
+  double maximum = 0.0;
+
+  /** The integral of the values over time from the first time up to the
+   * given one. The first value holds before the first time and the last
+   * value after the last time, as in getSingleValue.
+   * @param time :: The time in nanoseconds
+   */
+  double integralUpTo(const int64_t time) const {
+    auto next = std::upper_bound(times.cbegin(), times.cend(), time);
+    const size_t i = next == times.cbegin()
+                         ? 0
+                         : static_cast<size_t>(next - times.cbegin()) - 1;
+    return integrals[i] +
+           values[i] * static_cast<double>(time - times[i]) / 1e9;
+  }
+
+  /// The memory used by the index, in bytes
+  size_t memorySize() const {
+    return times.capacity() * sizeof(int64_t) +
+           (values.capacity() + integrals.capacity() + sums.capacity()) *
+               sizeof(double);
+  }
+};
+
 /**
  * Constructor
  *  @param name :: The name to assign to the property
@@ -108,7 +167,10 @@ TimeSeriesProperty<std::string>::getDerivative() const {
 template <typename TYPE>
 size_t TimeSeriesProperty<TYPE>::getMemorySize() const {
   // Rough estimate
-  return m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime));
+  size_t memory = m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime));
+  if (const auto index = std::atomic_load(&m_index))
+    memory += index->memorySize();
+  return memory;
 }
 
 /**
@@ -137,6 +199,7 @@ operator+=(Property const *right) {
       m_values.insert(m_values.end(), rhs->m_values.begin(),
                       rhs->m_values.end());
       m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+      m_index.reset();
     } else {
       // Do nothing if appending yourself to yourself. The net result would be
       // the same anyway
@@ -308,6 +371,7 @@ void TimeSeriesProperty<TYPE>::filterByTime(const Kernel::DateAndTime &start,
 
   // 4. Make size consistent
   m_size = static_cast<int>(m_values.size());
+  m_index.reset();
 }
 
 /**
@@ -385,6 +449,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
   mp_copy.clear();
 
   m_size = static_cast<int>(m_values.size());
+  m_index.reset();
 }
 
 /**
@@ -420,6 +485,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(
         dynamic_cast<TimeSeriesProperty<TYPE> *>(outputs[i]);
     if (myOutput) {
       outputs_tsp.push_back(myOutput);
+      myOutput->m_index.reset();
       if (this->m_values.size() == 1) {
         // Special case for TSP with a single entry = just copy.
         myOutput->m_values = this->m_values;
@@ -566,13 +632,6 @@ void TimeSeriesProperty<TYPE>::makeFilterByValue(
     throw std::invalid_argument(ss.str());
   }
 
-  // If min or max were unset ("empty") in the algorithm, set to the min or max
-  // value of the log
-  if (emptyMin)
-    min = minValue();
-  if (emptyMax)
-    max = maxValue();
-
   // Make sure the splitter starts out empty
   split.clear();
 
@@ -580,8 +639,17 @@ void TimeSeriesProperty<TYPE>::makeFilterByValue(
   if (m_values.empty())
     return;
 
-  // 1. Sort
-  sort();
+  // 1. Sort and index
+  const auto sorted = index();
+  const auto &times = sorted->times;
+  const auto &values = sorted->values;
+
+  // If min or max were unset ("empty") in the algorithm, set to the min or max
+  // value of the log
+  if (emptyMin)
+    min = sorted->minimum;
+  if (emptyMax)
+    max = sorted->maximum;
 
   // 2. Do the rest
   bool lastGood(false);
@@ -590,11 +658,11 @@ void TimeSeriesProperty<TYPE>::makeFilterByValue(
   DateAndTime t;
   DateAndTime start, stop;
 
-  for (size_t i = 0; i < m_values.size(); ++i) {
+  for (size_t i = 0; i < times.size(); ++i) {
     const DateAndTime lastTime = t;
     // The new entry
-    t = m_values[i].time();
-    TYPE val = m_values[i].value();
+    t = DateAndTime(times[i]);
+    const double val = values[i];
 
     // A good value?
     const bool isGood = ((val >= min) && (val <= max));
@@ -667,10 +735,13 @@ void TimeSeriesProperty<TYPE>::expandFilterToRange(
 
   // If min or max were unset ("empty") in the algorithm, set to the min or max
   // value of the log
-  if (emptyMin)
-    min = minValue();
-  if (emptyMax)
-    max = maxValue();
+  if (emptyMin || emptyMax) {
+    const auto sorted = index();
+    if (emptyMin)
+      min = sorted->minimum;
+    if (emptyMax)
+      max = sorted->maximum;
+  }
 
   // Assume everything before the 1st value is constant
   double val = firstValue();
@@ -726,32 +797,16 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(
     return static_cast<double>(m_values.front().value());
   }
 
-  // Sort, if necessary.
-  sort();
+  // Sort and index, if necessary.
+  const auto sorted = index();
 
   double numerator(0.0), totalTime(0.0);
   // Loop through the filter ranges
   for (const auto &time : filter) {
     // Calculate the total time duration (in seconds) within by the filter
     totalTime += time.duration();
-
-    // Get the log value and index at the start time of the filter
-    int index;
-    double value = getSingleValue(time.start(), index);
-    DateAndTime startTime = time.start();
-
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-      numerator +=
-          DateAndTime::secondsFromDuration(m_values[index].time() - startTime) *
-          value;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
-    }
-
-    // Now close off with the end of the current filter range
-    numerator +=
-        DateAndTime::secondsFromDuration(time.stop() - startTime) * value;
+    numerator += sorted->integralUpTo(time.stop().totalNanoseconds()) -
+                 sorted->integralUpTo(time.start().totalNanoseconds());
   }
 
   // 'Normalise' by the total time
@@ -774,6 +829,91 @@ double TimeSeriesProperty<TYPE>::timeAverageValue() const {
   return retVal;
 }
 
+/** Integrates the log over time. Each value holds from its time up to the
+ * next one, the first value before the first time and the last value after
+ * the last time.
+ *  @param start The start of the range
+ *  @param stop The end of the range
+ *  @return The integral of the log from start to stop, in value x seconds.
+ * Negative if stop is before start.
+ *  @throws std::runtime_error if the log is empty
+ */
+template <typename TYPE>
+double TimeSeriesProperty<TYPE>::timeIntegral(const DateAndTime &start,
+                                              const DateAndTime &stop) const {
+  if (m_values.empty())
+    throw std::runtime_error("Property " + name() + " is empty");
+  const auto sorted = index();
+  return sorted->integralUpTo(stop.totalNanoseconds()) -
+         sorted->integralUpTo(start.totalNanoseconds());
+}
+
+/** Function specialization for TimeSeriesProperty<std::string>
+ *  @throws Kernel::Exception::NotImplementedError always
+ */
+template <>
+double
+TimeSeriesProperty<std::string>::timeIntegral(const DateAndTime &,
+                                              const DateAndTime &) const {
+  throw Exception::NotImplementedError("TimeSeriesProperty::timeIntegral is "
+                                       "not implemented for string "
+                                       "properties");
+}
+
+/** Sums the values that filterByTimes would keep with the same filter,
+ * without copying the log. Used to add up the proton charge of the pulses
+ * in a filter.
+ *  @param filter The splitter/filter restricting the range of values included
+ *  @return The sum of the values in the filter
+ */
+template <typename TYPE>
+double TimeSeriesProperty<TYPE>::sumValuesInFilter(
+    const std::vector<SplittingInterval> &filter) const {
+  if (m_values.empty())
+    return 0.0;
+  const auto sorted = index();
+  const auto &values = sorted->values;
+  if (values.size() == 1)
+    return values.front();
+
+  const int lastIndex = static_cast<int>(values.size()) - 1;
+  double sum = 0.0;
+  for (const auto &interval : filter) {
+    // The same range of entries as filterByTimes
+    int tstartindex = findIndex(interval.start());
+    if (tstartindex < 0)
+      tstartindex = 0;
+    else if (tstartindex > lastIndex)
+      tstartindex = lastIndex;
+
+    int tstopindex = findIndex(interval.stop());
+    if (tstopindex < 0)
+      tstopindex = 0;
+    else if (tstopindex > lastIndex)
+      tstopindex = lastIndex;
+    else if (interval.stop() == m_values[tstopindex].time() && tstopindex > 0)
+      tstopindex--;
+
+    const auto first = static_cast<size_t>(tstartindex);
+    const auto last = static_cast<size_t>(tstopindex);
+    sum += values[first];
+    if (last > first)
+      sum += sorted->sums[last + 1] - sorted->sums[first + 1];
+  }
+  return sum;
+}
+
+/** Function specialization for TimeSeriesProperty<std::string>
+ *  @throws Kernel::Exception::NotImplementedError always
+ */
+template <>
+double TimeSeriesProperty<std::string>::sumValuesInFilter(
+    const std::vector<SplittingInterval> &) const {
+  throw Exception::NotImplementedError("TimeSeriesProperty::sumValuesInFilter "
+                                       "is not implemented for string "
+                                       "properties");
+}
+
 /** Function specialization for TimeSeriesProperty<std::string>
  *  @throws Kernel::Exception::NotImplementedError always
  */
@@ -877,17 +1017,18 @@ std::vector<DateAndTime> TimeSeriesProperty<TYPE>::timesAsVector() const {
  */
 template <typename TYPE>
 std::vector<double> TimeSeriesProperty<TYPE>::timesAsVectorSeconds() const {
-  // 1. Sort if necessary
-  sort();
-
-  // 2. Output data structure
   std::vector<double> out;
-  out.reserve(m_values.size());
+  if (m_values.empty())
+    return out;
 
-  Kernel::DateAndTime start = m_values[0].time();
-  for (size_t i = 0; i < m_values.size(); i++) {
-    out.push_back(DateAndTime::secondsFromDuration(m_values[i].time() - start));
-  }
+  // 1. Sort and index if necessary
+  const auto &times = index()->times;
+
+  // 2. Output data structure
+  out.reserve(times.size());
+  const int64_t start = times.front();
+  for (const auto time : times)
+    out.push_back(static_cast<double>(time - start) / 1e9);
 
   return out;
 }
@@ -923,6 +1064,7 @@ void TimeSeriesProperty<TYPE>::addValue(const Kernel::DateAndTime &time,
   }
 
   m_filterApplied = false;
+  m_index.reset();
 }
 
 /** Add a value to the map
@@ -968,6 +1110,7 @@ void TimeSeriesProperty<TYPE>::addValues(
 
   if (!values.empty())
     m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+  m_index.reset();
 }
 
 /** replace vectors of values to the map. First we clear the vectors
@@ -1181,6 +1324,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
+  m_index.reset();
 }
 
 /** Clears out all but the last value in the property.
@@ -1355,6 +1499,51 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(const DateAndTime &t,
   return value;
 } // END-DEF getSinglevalue()
 
+/** Returns the values at many times, as getSingleValue would. The times are
+ * looked up in one pass over the series.
+ *  @param times :: The times, in increasing order
+ *  @return The value at each of the times
+ *  @throws std::runtime_error if the series is empty and there are times
+ *  @throws std::invalid_argument if the times are not in increasing order
+ */
+template <typename TYPE>
+std::vector<TYPE> TimeSeriesProperty<TYPE>::getSingleValues(
+    const std::vector<DateAndTime> &times) const {
+  std::vector<TYPE> values;
+  if (times.empty())
+    return values;
+  if (m_values.empty()) {
+    const std::string error("getSingleValues(): TimeSeriesProperty '" +
+                            name() + "' is empty");
+    g_log.debug(error);
+    throw std::runtime_error(error);
+  }
+  if (!std::is_sorted(times.begin(), times.end()))
+    throw std::invalid_argument("getSingleValues(): The times must be given "
+                                "in increasing order");
+
+  // 1. Get sorted
+  const auto &logTimes = index()->times;
+
+  // 2. Walk through the series and the times together
+  values.reserve(times.size());
+  auto next = logTimes.cbegin();
+  for (const auto &time : times) {
+    const int64_t t = time.totalNanoseconds();
+    if (t >= logTimes.back()) {
+      values.push_back(m_values.back().value());
+      continue;
+    }
+    next = std::lower_bound(next, logTimes.cend(), t);
+    auto entry = next;
+    if (*entry > t && entry != logTimes.cbegin())
+      --entry;
+    values.push_back(
+        m_values[static_cast<size_t>(entry - logTimes.cbegin())].value());
+  }
+  return values;
+}
+
 /** Returns n-th valid time interval, in a very inefficient way.
  *
  * Here are some special cases
@@ -1761,6 +1950,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
 
   // update m_size
   countSize();
+  m_index.reset();
 
   // 3. Finish
   g_log.warning() << "Log " << this->name() << " has " << numremoved
@@ -1805,6 +1995,45 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::sort() const {
   }
 }
 
+/** Get the index of the sorted entries, sorting them and building the index
+ * if it is not there. Concurrent const calls may build it more than once but
+ * always see a complete index.
+ * @return The index
+ */
+template <typename TYPE>
+std::shared_ptr<const typename TimeSeriesProperty<TYPE>::Index>
+TimeSeriesProperty<TYPE>::index() const {
+  auto existing = std::atomic_load(&m_index);
+  if (existing)
+    return existing;
+
+  sort();
+  auto index = std::make_shared<Index>();
+  index->times.reserve(m_values.size());
+  for (const auto &entry : m_values)
+    index->times.push_back(entry.time().totalNanoseconds());
+  index->values = valuesAsDoubles(m_values);
+
+  const auto &values = index->values;
+  if (!values.empty()) {
+    const auto &times = index->times;
+    index->integrals.resize(values.size(), 0.0);
+    for (size_t i = 1; i < values.size(); ++i)
+      index->integrals[i] =
+          index->integrals[i - 1] +
+          values[i - 1] * static_cast<double>(times[i] - times[i - 1]) / 1e9;
+    index->sums.resize(values.size() + 1, 0.0);
+    std::partial_sum(values.cbegin(), values.cend(), index->sums.begin() + 1);
+    const auto range = std::minmax_element(values.cbegin(), values.cend());
+    index->minimum = *range.first;
+    index->maximum = *range.second;
+  }
+
+  std::shared_ptr<const Index> result = std::move(index);
+  std::atomic_store(&m_index, result);
+  return result;
+}
+
 /** Find the index of the entry of time t in the mP vector (sorted)
  *  Return @ if t is within log.begin and log.end, then the index of the log
  * equal or just smaller than t
@@ -2054,6 +2283,7 @@ TimeSeriesProperty<TYPE>::setValueFromProperty(const Property &right) {
   m_filter = prop->m_filter;
   m_filterQuickRef = prop->m_filterQuickRef;
   m_filterApplied = prop->m_filterApplied;
+  m_index = std::atomic_load(&prop->m_index);
   return "";
 }
 
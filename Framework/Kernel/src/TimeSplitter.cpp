@@ -1,6 +1,8 @@
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/TimeSplitter.h"
 
+#include <algorithm>
+
 namespace Mantid {
 namespace Kernel {
 
@@ -267,5 +269,54 @@ TimeSplitterType operator~(const TimeSplitterType &a) {
   }
   return out;
 }
+
+//------------------------------------------------------------------------------------------------
+/** Constructor
+ * @param splitter :: The intervals, sorted here by start time if they are not
+ * @param indices :: The indices of the destinations, in any order. -1 is
+ * added if it is not there.
+ * @throw std::invalid_argument if the destination of an interval is not one
+ * of the indices
+ */
+SplitterIndex::SplitterIndex(const TimeSplitterType &splitter,
+                             const std::vector<int> &indices)
+    : m_indices(indices) {
+  m_indices.push_back(-1);
+  std::sort(m_indices.begin(), m_indices.end());
+  m_indices.erase(std::unique(m_indices.begin(), m_indices.end()),
+                  m_indices.end());
+  m_unfiltered = position(-1);
+
+  TimeSplitterType sorted;
+  const TimeSplitterType *intervals = &splitter;
+  if (!std::is_sorted(splitter.begin(), splitter.end())) {
+    sorted = splitter;
+    std::stable_sort(sorted.begin(), sorted.end());
+    intervals = &sorted;
+  }
+
+  m_starts.reserve(intervals->size());
+  m_stops.reserve(intervals->size());
+  m_destinations.reserve(intervals->size());
+  for (const auto &interval : *intervals) {
+    m_starts.push_back(interval.start().totalNanoseconds());
+    m_stops.push_back(interval.stop().totalNanoseconds());
+    m_destinations.push_back(position(interval.index()));
+  }
+}
+
+/** Get the position of a destination index
+ * @param index :: The index of a destination
+ * @return The position of the index in indices()
+ * @throw std::invalid_argument if the index is not one of the indices
+ */
+size_t SplitterIndex::position(const int index) const {
+  auto it = std::lower_bound(m_indices.begin(), m_indices.end(), index);
+  if (it == m_indices.end() || *it != index)
+    throw std::invalid_argument("SplitterIndex: splitting interval has an "
+                                "unknown destination index " +
+                                std::to_string(index));
+  return static_cast<size_t>(it - m_indices.begin());
+}
 }
 }
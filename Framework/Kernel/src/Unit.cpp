@@ -6,11 +6,17 @@
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/UnitLabelTypes.h"
+#include <algorithm>
 #include <cfloat>
 
 namespace Mantid {
 namespace Kernel {
 
+namespace {
+/// Number of values converted at a time by Unit::convertViaTOF
+const size_t CONVERSION_BLOCK_SIZE = 1024;
+}
+
 /**
  * Default constructor
  * Gives the unit an empty UnitLabel
@@ -139,9 +145,7 @@ void Unit::toTOF(std::vector<double> &xdata, std::vector<double> &ydata,
                  const double &_delta) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _l2, _twoTheta, _emode, _efixed, _delta);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleToTOF(xdata[i]);
+  this->multipleToTOF(xdata.data(), xdata.data(), xdata.size());
 }
 
 /** Convert a single value to TOF
@@ -170,9 +174,7 @@ void Unit::fromTOF(std::vector<double> &xdata, std::vector<double> &ydata,
                    const double &_efixed, const double &_delta) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _l2, _twoTheta, _emode, _efixed, _delta);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleFromTOF(xdata[i]);
+  this->multipleFromTOF(xdata.data(), xdata.data(), xdata.size());
 }
 
 /** Convert a single value from TOF
@@ -192,6 +194,46 @@ double Unit::convertSingleFromTOF(const double xvalue, const double &l1,
   return this->singleFromTOF(xvalue);
 }
 
+/** Convert an array of values to TOF, one value at a time. Subclasses override
+ * this with loops that the compiler can vectorise.
+ * @param x :: the values to convert
+ * @param tof :: receives the TOF values
+ * @param n :: the number of values
+ */
+void Unit::multipleToTOF(const double *x, double *tof, size_t n) const {
+  for (size_t i = 0; i < n; ++i)
+    tof[i] = this->singleToTOF(x[i]);
+}
+
+/** Convert an array of TOF values to this unit, one value at a time.
+ * Subclasses override this with loops that the compiler can vectorise.
+ * @param tof :: the values to convert
+ * @param x :: receives the converted values
+ * @param n :: the number of values
+ */
+void Unit::multipleFromTOF(const double *tof, double *x, size_t n) const {
+  for (size_t i = 0; i < n; ++i)
+    x[i] = this->singleFromTOF(tof[i]);
+}
+
+/** Convert an array of values in this unit to another unit by going through
+ * TOF. Both units must be initialized. The values are converted in blocks, so
+ * the intermediate TOF values stay in cache between the two steps.
+ * @param destination :: the unit to convert to
+ * @param x :: the values to convert
+ * @param out :: receives the converted values, may be the same array as x
+ * @param n :: the number of values
+ */
+void Unit::convertViaTOF(const Unit &destination, const double *x, double *out,
+                         size_t n) const {
+  double tof[CONVERSION_BLOCK_SIZE];
+  for (size_t start = 0; start < n; start += CONVERSION_BLOCK_SIZE) {
+    const size_t count = std::min(CONVERSION_BLOCK_SIZE, n - start);
+    this->multipleToTOF(x + start, tof, count);
+    destination.multipleFromTOF(tof, out + start, count);
+  }
+}
+
 std::pair<double, double> Unit::conversionRange() const {
   double u1 = this->singleFromTOF(this->conversionTOFMin());
   double u2 = this->singleFromTOF(this->conversionTOFMax());
@@ -288,6 +330,16 @@ double TOF::singleFromTOF(const double tof) const {
   return tof;
 }
 
+void TOF::multipleToTOF(const double *x, double *tof, size_t n) const {
+  if (x != tof)
+    std::copy(x, x + n, tof);
+}
+
+void TOF::multipleFromTOF(const double *tof, double *x, size_t n) const {
+  if (tof != x)
+    std::copy(tof, tof + n, x);
+}
+
 Unit *TOF::clone() const { return new TOF(*this); }
 double TOF::conversionTOFMin() const { return -DBL_MAX; }
 ///@return DBL_MAX as ToF convetanble to TOF for in any time range
@@ -396,6 +448,26 @@ double Wavelength::singleFromTOF(const double tof) const {
   x *= factorFrom;
   return x;
 }
+void Wavelength::multipleToTOF(const double *x, double *tof,
+                               size_t n) const {
+  if (emode == 1 || emode == 2) {
+    for (size_t i = 0; i < n; ++i)
+      tof[i] = x[i] * factorTo + sfpTo;
+  } else {
+    for (size_t i = 0; i < n; ++i)
+      tof[i] = x[i] * factorTo;
+  }
+}
+void Wavelength::multipleFromTOF(const double *tof, double *x,
+                                 size_t n) const {
+  if (do_sfpFrom) {
+    for (size_t i = 0; i < n; ++i)
+      x[i] = (tof[i] - sfpFrom) * factorFrom;
+  } else {
+    for (size_t i = 0; i < n; ++i)
+      x[i] = tof[i] * factorFrom;
+  }
+}
 ///@return  Minimal time of flight, which can be reversively converted into
 /// wavelength
 double Wavelength::conversionTOFMin() const {
@@ -472,6 +544,20 @@ double Energy::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+void Energy::multipleToTOF(const double *x, double *tof, size_t n) const {
+  for (size_t i = 0; i < n; ++i) {
+    const double temp = x[i] == 0.0 ? DBL_MIN : x[i];
+    tof[i] = factorTo / sqrt(temp);
+  }
+}
+
+void Energy::multipleFromTOF(const double *tof, double *x, size_t n) const {
+  for (size_t i = 0; i < n; ++i) {
+    const double temp = tof[i] == 0.0 ? DBL_MIN : tof[i];
+    x[i] = factorFrom / (temp * temp);
+  }
+}
+
 Unit *Energy::clone() const { return new Energy(*this); }
 
 // ============================================================================================
@@ -578,6 +664,14 @@ double dSpacing::singleToTOF(const double x) const { return x * factorTo; }
 double dSpacing::singleFromTOF(const double tof) const {
   return tof / factorFrom;
 }
+void dSpacing::multipleToTOF(const double *x, double *tof, size_t n) const {
+  for (size_t i = 0; i < n; ++i)
+    tof[i] = x[i] * factorTo;
+}
+void dSpacing::multipleFromTOF(const double *tof, double *x, size_t n) const {
+  for (size_t i = 0; i < n; ++i)
+    x[i] = tof[i] / factorFrom;
+}
 double dSpacing::conversionTOFMin() const { return 0; }
 double dSpacing::conversionTOFMax() const { return DBL_MAX / factorTo; }
 
@@ -634,6 +728,18 @@ double MomentumTransfer::singleFromTOF(const double tof) const {
   return factorFrom / temp;
 }
 
+void MomentumTransfer::multipleToTOF(const double *x, double *tof,
+                                     size_t n) const {
+  for (size_t i = 0; i < n; ++i)
+    tof[i] = factorTo / (x[i] == 0.0 ? DBL_MIN : x[i]);
+}
+
+void MomentumTransfer::multipleFromTOF(const double *tof, double *x,
+                                       size_t n) const {
+  for (size_t i = 0; i < n; ++i)
+    x[i] = factorFrom / (tof[i] == 0.0 ? DBL_MIN : tof[i]);
+}
+
 double MomentumTransfer::conversionTOFMin() const {
   return factorFrom / DBL_MAX;
 }
@@ -806,6 +912,43 @@ double DeltaE::singleFromTOF(const double tof) const {
     return DBL_MAX;
 }
 
+void DeltaE::multipleToTOF(const double *x, double *tof, size_t n) const {
+  const double maxTOF = DeltaE::conversionTOFMax();
+  if (emode == 1) {
+    for (size_t i = 0; i < n; ++i) {
+      const double e2 = efixed - x[i] / unitScaling;
+      tof[i] = e2 <= 0.0 ? maxTOF : factorTo / sqrt(e2) + t_other;
+    }
+  } else if (emode == 2) {
+    for (size_t i = 0; i < n; ++i) {
+      const double e1 = efixed + x[i] / unitScaling;
+      tof[i] = e1 <= 0.0 ? maxTOF : factorTo / sqrt(e1) + t_other;
+    }
+  } else {
+    std::fill(tof, tof + n, maxTOF);
+  }
+}
+
+void DeltaE::multipleFromTOF(const double *tof, double *x, size_t n) const {
+  if (emode == 1) {
+    for (size_t i = 0; i < n; ++i) {
+      const double this_t = tof[i] - t_otherFrom;
+      x[i] = this_t <= 0.0
+                 ? -DBL_MAX
+                 : (efixed - factorFrom / (this_t * this_t)) * unitScaling;
+    }
+  } else if (emode == 2) {
+    for (size_t i = 0; i < n; ++i) {
+      const double this_t = tof[i] - t_otherFrom;
+      x[i] = this_t <= 0.0
+                 ? DBL_MAX
+                 : (factorFrom / (this_t * this_t) - efixed) * unitScaling;
+    }
+  } else {
+    std::fill(x, x + n, DBL_MAX);
+  }
+}
+
 double DeltaE::conversionTOFMin() const {
   double time(
       DBL_MAX); // impossible for elastic, this units do not work for elastic
@@ -1025,6 +1168,17 @@ double SpinEchoLength::singleFromTOF(const double tof) const {
   return x;
 }
 
+// Wavelength overrides these without the spin echo conversion
+void SpinEchoLength::multipleToTOF(const double *x, double *tof,
+                                   size_t n) const {
+  Unit::multipleToTOF(x, tof, n);
+}
+
+void SpinEchoLength::multipleFromTOF(const double *tof, double *x,
+                                     size_t n) const {
+  Unit::multipleFromTOF(tof, x, n);
+}
+
 Unit *SpinEchoLength::clone() const { return new SpinEchoLength(*this); }
 
 // ============================================================================================
@@ -1070,6 +1224,16 @@ double SpinEchoTime::singleFromTOF(const double tof) const {
   return x;
 }
 
+// Wavelength overrides these without the spin echo conversion
+void SpinEchoTime::multipleToTOF(const double *x, double *tof, size_t n) const {
+  Unit::multipleToTOF(x, tof, n);
+}
+
+void SpinEchoTime::multipleFromTOF(const double *tof, double *x,
+                                   size_t n) const {
+  Unit::multipleFromTOF(tof, x, n);
+}
+
 Unit *SpinEchoTime::clone() const { return new SpinEchoTime(*this); }
 
 // ================================================================================
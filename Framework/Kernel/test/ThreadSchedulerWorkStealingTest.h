@@ -0,0 +1,237 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include <boost/make_shared.hpp>
+
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadScheduler.h"
+#include "MantidKernel/ThreadSchedulerMutexes.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <atomic>
+
+using namespace Mantid::Kernel;
+
+namespace {
+int ThreadSchedulerWorkStealingTest_numDestructed;
+
+class TaskWithCost : public Task {
+public:
+  TaskWithCost(double cost, boost::shared_ptr<std::mutex> mutex =
+                                boost::shared_ptr<std::mutex>()) {
+    m_cost = cost;
+    m_mutex = mutex;
+  }
+  ~TaskWithCost() override { ThreadSchedulerWorkStealingTest_numDestructed++; }
+  void run() override {}
+};
+
+/// Task doing a given amount of floating point work.
+class TaskWithWork : public Task {
+public:
+  TaskWithWork(size_t work, std::atomic<size_t> &counter)
+      : Task(static_cast<double>(work)), m_work(work), m_counter(counter) {}
+  void run() override {
+    double x = 1.1;
+    for (size_t i = 0; i < m_work; ++i)
+      x = x * x / 1.1;
+    if (x > 0.0)
+      ++m_counter;
+  }
+
+private:
+  size_t m_work;
+  std::atomic<size_t> &m_counter;
+};
+}
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ThreadSchedulerWorkStealingTest *createSuite() {
+    return new ThreadSchedulerWorkStealingTest();
+  }
+  static void destroySuite(ThreadSchedulerWorkStealingTest *suite) {
+    delete suite;
+  }
+
+  void test_push_size_clear() {
+    ThreadSchedulerWorkStealing sc(3);
+    TS_ASSERT(sc.empty());
+    for (size_t i = 0; i < 5; ++i)
+      sc.push(new TaskWithCost(static_cast<double>(i)));
+    TS_ASSERT_EQUALS(sc.size(), 5);
+    TS_ASSERT(!sc.empty());
+    TS_ASSERT_DELTA(sc.totalCost(), 10.0, 1e-12);
+    TS_ASSERT_DELTA(sc.remainingCost(), 10.0, 1e-12);
+
+    ThreadSchedulerWorkStealingTest_numDestructed = 0;
+    sc.clear();
+    TS_ASSERT_EQUALS(sc.size(), 0);
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_EQUALS(sc.totalCost(), 0.0);
+    TS_ASSERT_EQUALS(sc.remainingCost(), 0.0);
+    TS_ASSERT_EQUALS(ThreadSchedulerWorkStealingTest_numDestructed, 5);
+  }
+
+  void test_totalCost_includes_popped_tasks() {
+    ThreadSchedulerWorkStealing sc(2);
+    sc.push(new TaskWithCost(1.0));
+    sc.push(new TaskWithCost(2.0));
+    sc.push(new TaskWithCost(4.0));
+    Task *task = sc.pop(0);
+    TS_ASSERT_DELTA(sc.totalCost(), 7.0, 1e-12);
+    TS_ASSERT_DELTA(sc.remainingCost(), 7.0 - task->cost(), 1e-12);
+    sc.finished(task, 0);
+    delete task;
+  }
+
+  void test_pop_prefers_largest_cost_in_own_queue() {
+    ThreadSchedulerWorkStealing sc(1);
+    auto task1 = new TaskWithCost(1.0);
+    auto task2 = new TaskWithCost(5.0);
+    auto task3 = new TaskWithCost(2.0);
+    sc.push(task1);
+    sc.push(task2);
+    sc.push(task3);
+    Task *popped[3] = {sc.pop(0), sc.pop(0), sc.pop(0)};
+    TS_ASSERT_EQUALS(popped[0], task2);
+    TS_ASSERT_EQUALS(popped[1], task3);
+    TS_ASSERT_EQUALS(popped[2], task1);
+    TS_ASSERT(!sc.pop(0));
+    for (auto task : popped)
+      delete task;
+  }
+
+  void test_pop_steals_from_other_queues() {
+    ThreadSchedulerWorkStealing sc(4);
+    // Round-robin push: one task in each queue
+    std::vector<Task *> tasks;
+    for (size_t i = 0; i < 4; ++i) {
+      tasks.push_back(new TaskWithCost(1.0));
+      sc.push(tasks.back());
+    }
+    // Thread 0 drains all queues
+    for (size_t i = 0; i < 4; ++i) {
+      Task *task = sc.pop(0);
+      TS_ASSERT(task);
+      TS_ASSERT_EQUALS(task, tasks[i]);
+    }
+    TS_ASSERT(sc.empty());
+    TS_ASSERT(!sc.pop(0));
+    for (auto task : tasks)
+      delete task;
+  }
+
+  void test_pop_skips_busy_mutexes() {
+    ThreadSchedulerWorkStealing sc(1);
+    auto mutex = boost::make_shared<std::mutex>();
+    auto task1 = new TaskWithCost(3.0, mutex);
+    auto task2 = new TaskWithCost(2.0, mutex);
+    auto task3 = new TaskWithCost(1.0);
+    sc.push(task1);
+    sc.push(task2);
+    sc.push(task3);
+
+    TS_ASSERT_EQUALS(sc.pop(0), task1);
+    // task2 has the same mutex as the running task1
+    TS_ASSERT_EQUALS(sc.pop(0), task3);
+    sc.finished(task1, 0);
+    TS_ASSERT_EQUALS(sc.pop(0), task2);
+    sc.finished(task2, 0);
+    sc.finished(task3, 0);
+    delete task1;
+    delete task2;
+    delete task3;
+  }
+
+  void test_pop_returns_busy_task_if_nothing_else_is_left() {
+    ThreadSchedulerWorkStealing sc(2);
+    auto mutex = boost::make_shared<std::mutex>();
+    auto task1 = new TaskWithCost(3.0, mutex);
+    auto task2 = new TaskWithCost(2.0, mutex);
+    sc.push(task1);
+    sc.push(task2);
+    TS_ASSERT_EQUALS(sc.pop(0), task1);
+    TS_ASSERT_EQUALS(sc.pop(1), task2);
+    sc.finished(task1, 0);
+    sc.finished(task2, 1);
+    delete task1;
+    delete task2;
+  }
+
+  void test_ThreadPool_runs_all_tasks() {
+    std::atomic<size_t> counter{0};
+    ThreadPool pool(new ThreadSchedulerWorkStealing(4), 4);
+    for (size_t i = 0; i < 10000; ++i)
+      pool.schedule(new TaskWithWork(i % 100, counter));
+    TS_ASSERT_THROWS_NOTHING(pool.joinAll());
+    TS_ASSERT_EQUALS(counter.load(), 10000);
+  }
+};
+
+/** Task throughput versus task size for all schedulers.
+ */
+class ThreadSchedulerWorkStealingTestPerformance : public CxxTest::TestSuite {
+public:
+  static ThreadSchedulerWorkStealingTestPerformance *createSuite() {
+    return new ThreadSchedulerWorkStealingTestPerformance();
+  }
+  static void destroySuite(ThreadSchedulerWorkStealingTestPerformance *suite) {
+    delete suite;
+  }
+
+  void test_FIFO_tiny_tasks() { run(new ThreadSchedulerFIFO(), tinyTask); }
+  void test_FIFO_small_tasks() { run(new ThreadSchedulerFIFO(), smallTask); }
+  void test_FIFO_large_tasks() { run(new ThreadSchedulerFIFO(), largeTask); }
+
+  void test_LargestCost_tiny_tasks() {
+    run(new ThreadSchedulerLargestCost(), tinyTask);
+  }
+  void test_LargestCost_small_tasks() {
+    run(new ThreadSchedulerLargestCost(), smallTask);
+  }
+  void test_LargestCost_large_tasks() {
+    run(new ThreadSchedulerLargestCost(), largeTask);
+  }
+
+  void test_Mutexes_tiny_tasks() {
+    run(new ThreadSchedulerMutexes(), tinyTask);
+  }
+  void test_Mutexes_small_tasks() {
+    run(new ThreadSchedulerMutexes(), smallTask);
+  }
+  void test_Mutexes_large_tasks() {
+    run(new ThreadSchedulerMutexes(), largeTask);
+  }
+
+  void test_WorkStealing_tiny_tasks() {
+    run(new ThreadSchedulerWorkStealing(), tinyTask);
+  }
+  void test_WorkStealing_small_tasks() {
+    run(new ThreadSchedulerWorkStealing(), smallTask);
+  }
+  void test_WorkStealing_large_tasks() {
+    run(new ThreadSchedulerWorkStealing(), largeTask);
+  }
+
+private:
+  static constexpr size_t tinyTask = 10;
+  static constexpr size_t smallTask = 1000;
+  static constexpr size_t largeTask = 100000;
+
+  /// Run tasks with a total amount of work independent of the task size.
+  void run(ThreadScheduler *scheduler, size_t workPerTask) {
+    const size_t numTasks = 10000000 / workPerTask;
+    std::atomic<size_t> counter{0};
+    ThreadPool pool(scheduler);
+    for (size_t i = 0; i < numTasks; ++i)
+      pool.schedule(new TaskWithWork(workPerTask, counter));
+    TS_ASSERT_THROWS_NOTHING(pool.joinAll());
+    TS_ASSERT_EQUALS(counter.load(), numTasks);
+  }
+};
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_ */
@@ -7,7 +7,10 @@
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/TimeSplitter.h"
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <numeric>
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/scoped_ptr.hpp>
@@ -592,6 +595,74 @@ public:
                      Exception::NotImplementedError);
   }
 
+  void test_averageValueInFilter_follows_added_values() {
+    auto dblLog = createDoubleTSP();
+    TS_ASSERT_DELTA(dblLog->timeAverageValue(), 7.6966, .0001);
+    dblLog->addValue("2007-11-30T16:17:40", 0.0);
+    TS_ASSERT_DELTA(dblLog->timeAverageValue(), 8.4100, .0001);
+    dblLog->filterByTime(DateAndTime("2007-11-30T16:17:05"),
+                         DateAndTime("2007-11-30T16:17:25"));
+    TS_ASSERT_EQUALS(dblLog->timesAsVectorSeconds(),
+                     std::vector<double>({0.0, 5.0, 15.0}));
+    TS_ASSERT_DELTA(dblLog->timeAverageValue(), 8.3633, .0001);
+    delete dblLog;
+  }
+
+  void test_timeIntegral() {
+    auto dblLog = createDoubleTSP();
+    const DateAndTime start("2007-11-30T16:17:05");
+    const DateAndTime stop("2007-11-30T16:17:29");
+    TS_ASSERT_DELTA(dblLog->timeIntegral(start, stop), 175.4, 1e-9);
+    TS_ASSERT_DELTA(dblLog->timeIntegral(stop, start), -175.4, 1e-9);
+    TS_ASSERT_EQUALS(dblLog->timeIntegral(start, start), 0.0);
+
+    // The first value holds before the log and the last one after it
+    TS_ASSERT_DELTA(dblLog->timeIntegral(DateAndTime("2007-11-30T16:16:50"),
+                                         DateAndTime("2007-11-30T16:17:00")),
+                    99.9, 1e-9);
+    TS_ASSERT_DELTA(dblLog->timeIntegral(DateAndTime("2007-11-30T16:17:40"),
+                                         DateAndTime("2007-11-30T16:17:50")),
+                    105.5, 1e-9);
+
+    TS_ASSERT_THROWS(dProp->timeIntegral(start, stop), std::runtime_error);
+    TS_ASSERT_THROWS(sProp->timeIntegral(start, stop),
+                     Exception::NotImplementedError);
+    delete dblLog;
+  }
+
+  void test_sumValuesInFilter_matches_filterByTimes() {
+    auto log = createIntegerTSP(12);
+    std::vector<TimeSplitterType> filters(5);
+    filters[0].emplace_back(DateAndTime("2007-11-30T16:17:05"),
+                            DateAndTime("2007-11-30T16:17:29"));
+    filters[1].emplace_back(DateAndTime("2007-11-30T16:16:00"),
+                            DateAndTime("2007-11-30T16:17:00"));
+    filters[2].emplace_back(DateAndTime("2007-11-30T16:17:20"),
+                            DateAndTime("2007-11-30T16:17:40"));
+    filters[3].emplace_back(DateAndTime("2007-11-30T16:17:05"),
+                            DateAndTime("2007-11-30T16:17:15"));
+    filters[3].emplace_back(DateAndTime("2007-11-30T16:17:35"),
+                            DateAndTime("2007-11-30T16:20:00"));
+    filters[4].emplace_back(DateAndTime("2007-11-30T16:25:00"),
+                            DateAndTime("2007-11-30T16:30:00"));
+
+    for (const auto &filter : filters) {
+      std::unique_ptr<TimeSeriesProperty<int>> filtered(log->clone());
+      filtered->filterByTimes(filter);
+      const auto values = filtered->valuesAsVector();
+      const double expected =
+          std::accumulate(values.begin(), values.end(), 0.0);
+      TS_ASSERT_EQUALS(log->sumValuesInFilter(filter), expected);
+    }
+
+    TS_ASSERT_EQUALS(iProp->sumValuesInFilter(filters[0]), 0.0);
+    iProp->addValue(DateAndTime("2010-11-30T16:17:25"), 99);
+    TS_ASSERT_EQUALS(iProp->sumValuesInFilter(filters[0]), 99.0);
+    TS_ASSERT_THROWS(sProp->sumValuesInFilter(filters[0]),
+                     Exception::NotImplementedError);
+    delete log;
+  }
+
   //----------------------------------------------------------------------------
   void test_splitByTime_and_getTotalValue() {
     TimeSeriesProperty<int> *log = createIntegerTSP(12);
@@ -796,6 +867,28 @@ public:
     delete p;
   }
 
+  void test_getSingleValues_matches_getSingleValue() {
+    auto log = createIntegerTSP(5);
+    std::vector<DateAndTime> times;
+    DateAndTime time("2007-11-30T16:16:50");
+    for (int i = 0; i < 48; ++i) {
+      times.push_back(time);
+      // Hit the times of the log, the ones in between and repeat some
+      if (i % 3 != 0)
+        time += 1.25;
+    }
+    const auto values = log->getSingleValues(times);
+    TS_ASSERT_EQUALS(values.size(), times.size());
+    for (size_t i = 0; i < times.size(); ++i)
+      TS_ASSERT_EQUALS(values[i], log->getSingleValue(times[i]));
+
+    std::reverse(times.begin(), times.end());
+    TS_ASSERT_THROWS(log->getSingleValues(times), std::invalid_argument);
+    TS_ASSERT_THROWS(iProp->getSingleValues(times), std::runtime_error);
+    TS_ASSERT(iProp->getSingleValues({}).empty());
+    delete log;
+  }
+
   void test_getSingleValue_emptyPropertyThrows() {
     const TimeSeriesProperty<int> empty("Empty");
 
@@ -1805,6 +1898,12 @@ public:
     memsize = p->getMemorySize();
     TS_ASSERT_EQUALS(memsize, 128);
 
+    // The index built by the first query is counted too
+    p->timeAverageValue();
+    TS_ASSERT_LESS_THAN(128, p->getMemorySize());
+    p->addValue("2007-11-30T16:37:00", 1.00);
+    TS_ASSERT_EQUALS(p->getMemorySize(), 144);
+
     delete p;
 
     return;
@@ -1929,4 +2028,58 @@ private:
   TimeSeriesProperty<std::string> *sProp;
 };
 
+class TimeSeriesPropertyTestPerformance : public CxxTest::TestSuite {
+public:
+  static TimeSeriesPropertyTestPerformance *createSuite() {
+    return new TimeSeriesPropertyTestPerformance();
+  }
+  static void destroySuite(TimeSeriesPropertyTestPerformance *suite) {
+    delete suite;
+  }
+
+  TimeSeriesPropertyTestPerformance() : m_log("proton_charge") {
+    // A proton charge log with a pulse every 1/60th of a second for 9 hours
+    const DateAndTime start("2010-01-01T00:00:00");
+    const size_t numberOfPulses = 2000000;
+    std::vector<DateAndTime> times;
+    std::vector<double> values;
+    times.reserve(numberOfPulses);
+    values.reserve(numberOfPulses);
+    for (size_t i = 0; i < numberOfPulses; ++i) {
+      times.push_back(start + static_cast<double>(i) / 60.0);
+      values.push_back(static_cast<double>(i % 7));
+    }
+    m_log.addValues(times, values);
+
+    // A filter with an interval every 10 seconds
+    for (size_t i = 0; i < 3000; ++i) {
+      const DateAndTime begin = start + 10.0 * static_cast<double>(i);
+      m_filter.emplace_back(begin, begin + 5.0);
+    }
+    for (size_t i = 0; i < numberOfPulses; i += 2)
+      m_queries.push_back(start + static_cast<double>(i) / 60.0 + 0.001);
+  }
+
+  void test_averageValueInFilter_many_intervals() {
+    for (int i = 0; i < 100; ++i)
+      TS_ASSERT_DELTA(m_log.averageValueInFilter(m_filter), 3.0, 0.01);
+  }
+
+  void test_sumValuesInFilter_many_intervals() {
+    for (int i = 0; i < 100; ++i)
+      TS_ASSERT_LESS_THAN(0.0, m_log.sumValuesInFilter(m_filter));
+  }
+
+  void test_getSingleValues_every_other_pulse() {
+    const auto values = m_log.getSingleValues(m_queries);
+    TS_ASSERT_EQUALS(values.size(), m_queries.size());
+    TS_ASSERT_EQUALS(values[1], 2.0);
+  }
+
+private:
+  TimeSeriesProperty<double> m_log;
+  TimeSplitterType m_filter;
+  std::vector<DateAndTime> m_queries;
+};
+
 #endif /*TIMESERIESPROPERTYTEST_H_*/
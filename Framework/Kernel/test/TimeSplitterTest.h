@@ -10,6 +10,7 @@
 
 #include <cxxtest/TestSuite.h>
 #include <ctime>
+#include <stdexcept>
 #include "MantidKernel/TimeSplitter.h"
 #include "MantidKernel/DateAndTime.h"
 
@@ -538,6 +539,32 @@ public:
     int index2 = int(sit - b.begin());
     TS_ASSERT_EQUALS(index2, 2);
   }
+
+  //----------------------------------------------------------------------------
+  void test_SplitterIndex_sorts_intervals_and_maps_destinations() {
+    TimeSplitterType b;
+    b.emplace_back(DateAndTime(300), DateAndTime(400), 7);
+    b.emplace_back(DateAndTime(100), DateAndTime(200), 3);
+    b.emplace_back(DateAndTime(200), DateAndTime(300), 7);
+
+    SplitterIndex index(b, {7, 3, 7});
+    TS_ASSERT_EQUALS(index.indices(), std::vector<int>({-1, 3, 7}));
+    TS_ASSERT_EQUALS(index.unfiltered(), 0);
+    TS_ASSERT_EQUALS(index.position(7), 2);
+    TS_ASSERT_THROWS(index.position(5), std::invalid_argument);
+
+    TS_ASSERT_EQUALS(index.size(), 3);
+    TS_ASSERT_EQUALS(index.starts(), std::vector<int64_t>({100, 200, 300}));
+    TS_ASSERT_EQUALS(index.stops(), std::vector<int64_t>({200, 300, 400}));
+    TS_ASSERT_EQUALS(index.destinations(), std::vector<size_t>({1, 2, 2}));
+  }
+
+  void test_SplitterIndex_throws_for_unknown_destination() {
+    TimeSplitterType b;
+    b.emplace_back(DateAndTime(100), DateAndTime(200), 3);
+    TS_ASSERT_THROWS(SplitterIndex(b, {1, 2}), std::invalid_argument);
+    TS_ASSERT_THROWS_NOTHING(SplitterIndex(TimeSplitterType(), {}));
+  }
 };
 
 #endif /* TIMESPLITTERTEST_H_ */
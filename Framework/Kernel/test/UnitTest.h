@@ -4,6 +4,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "MantidKernel/Unit.h"
+#include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/UnitLabelTypes.h"
 #include <boost/lexical_cast.hpp>
@@ -1224,6 +1225,54 @@ public:
     TS_ASSERT_EQUALS(degrees.unitID(), "Degrees");
   }
 
+  void test_multiple_conversions_match_single_conversions() {
+    std::vector<double> values{0.0, 0.3, 1.1, 4.0, 3000.0, 15000.0};
+    const std::vector<std::string> names{
+        "TOF", "Wavelength", "Energy", "Energy_inWavenumber", "dSpacing",
+        "MomentumTransfer", "QSquared", "DeltaE", "DeltaE_inWavenumber",
+        "Momentum", "SpinEchoLength", "SpinEchoTime"};
+    for (const auto &name : names) {
+      auto unit = UnitFactory::Instance().create(name);
+      for (int emode = 0; emode < 3; ++emode) {
+        try {
+          unit->initialize(1.5, 2.5, 0.7, emode, 4.0, 0.0);
+        } catch (std::invalid_argument &) {
+          continue; // e.g. DeltaE in elastic mode
+        }
+        std::vector<double> tof(values.size()), x(values.size());
+        unit->multipleToTOF(values.data(), tof.data(), values.size());
+        unit->multipleFromTOF(values.data(), x.data(), values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+          const double expectedTOF = unit->singleToTOF(values[i]);
+          const double expectedX = unit->singleFromTOF(values[i]);
+          TSM_ASSERT_DELTA(name, tof[i], expectedTOF,
+                           1e-12 * std::max(1.0, std::fabs(expectedTOF)));
+          TSM_ASSERT_DELTA(name, x[i], expectedX,
+                           1e-12 * std::max(1.0, std::fabs(expectedX)));
+        }
+        // In place
+        std::vector<double> inPlace(values);
+        unit->multipleToTOF(inPlace.data(), inPlace.data(), inPlace.size());
+        TSM_ASSERT_EQUALS(name, inPlace, tof);
+      }
+    }
+  }
+
+  void test_convertViaTOF() {
+    Units::Wavelength wavelength;
+    Units::dSpacing dSpacingUnit;
+    wavelength.initialize(1.5, 2.5, 0.7, 0, 0.0, 0.0);
+    dSpacingUnit.initialize(1.5, 2.5, 0.7, 0, 0.0, 0.0);
+    // More than one block
+    std::vector<double> x(3000), out(3000);
+    for (size_t i = 0; i < x.size(); ++i)
+      x[i] = 0.1 + 0.001 * static_cast<double>(i);
+    wavelength.convertViaTOF(dSpacingUnit, x.data(), out.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i)
+      TS_ASSERT_EQUALS(
+          out[i], dSpacingUnit.singleFromTOF(wavelength.singleToTOF(x[i])));
+  }
+
 private:
   Units::Label label;
   Units::TOF tof;
@@ -1241,4 +1290,35 @@ private:
   Units::Degrees degrees;
 };
 
+class UnitTestPerformance : public CxxTest::TestSuite {
+public:
+  static UnitTestPerformance *createSuite() {
+    return new UnitTestPerformance();
+  }
+  static void destroySuite(UnitTestPerformance *suite) { delete suite; }
+
+  UnitTestPerformance() : m_x(10000000) {
+    for (size_t i = 0; i < m_x.size(); ++i)
+      m_x[i] = 1000.0 + 0.001 * static_cast<double>(i);
+    m_tof.initialize(10.0, 2.0, 1.2, 0, 0.0, 0.0);
+    m_dSpacing.initialize(10.0, 2.0, 1.2, 0, 0.0, 0.0);
+  }
+
+  void test_TOF_to_dSpacing_single() {
+    for (auto &x : m_x)
+      x = m_dSpacing.singleFromTOF(m_tof.singleToTOF(x));
+    TS_ASSERT_LESS_THAN(0.0, m_x.back());
+  }
+
+  void test_TOF_to_dSpacing_multiple() {
+    m_tof.convertViaTOF(m_dSpacing, m_x.data(), m_x.data(), m_x.size());
+    TS_ASSERT_LESS_THAN(0.0, m_x.back());
+  }
+
+private:
+  std::vector<double> m_x;
+  Units::TOF m_tof;
+  Units::dSpacing m_dSpacing;
+};
+
 #endif /*UNITTEST_H_*/
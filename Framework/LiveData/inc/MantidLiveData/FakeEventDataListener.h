@@ -5,11 +5,10 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAPI/ILiveListener.h"
-#include "MantidDataObjects/EventWorkspace.h"
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
+#include "MantidLiveData/LiveEventBuffer.h"
 #include <Poco/Timer.h>
 #include "MantidKernel/DateAndTime.h"
-#include <mutex>
 
 namespace Mantid {
 namespace LiveData {
@@ -56,8 +55,8 @@ public:
 private:
   void generateEvents(Poco::Timer &);
 
-  DataObjects::EventWorkspace_sptr
-      m_buffer; ///< Used to buffer events between calls to extractData()
+  LiveEventBuffer m_buffer; ///< Used to buffer events between calls to
+  /// extractData()
   Kernel::PseudoRandomNumberGenerator *
       m_rand; ///< Used in generation of random events
   Poco::Timer
@@ -75,9 +74,6 @@ private:
 
   /// Fake run number to give
   int m_runNumber;
-
-  /// Mutex to exclude generateEvents() and extractData().
-  std::mutex m_mutex;
 };
 
 } // namespace LiveData
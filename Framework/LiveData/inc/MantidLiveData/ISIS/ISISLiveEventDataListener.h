@@ -8,10 +8,12 @@
 
 #include "MantidAPI/ILiveListener.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidLiveData/LiveEventBuffer.h"
 
 #include "Poco/Net/StreamSocket.h"
 #include <Poco/Runnable.h>
 #include <Poco/Thread.h>
+#include <memory>
 #include <mutex>
 #include <map>
 
@@ -149,9 +151,10 @@ protected:
   void saveEvents(const std::vector<TCPStreamEventNeutron> &data,
                   const Kernel::DateAndTime &pulseTime, size_t period);
   // Set the spectra-detector map
-  void loadSpectraMap();
+  void loadSpectraMap(DataObjects::EventWorkspace &workspace);
   // Load the instrument
-  void loadInstrument(const std::string &instrName);
+  void loadInstrument(const std::string &instrName,
+                      DataObjects::EventWorkspace_sptr workspace);
   // Get an integer value ising the IDC interface
   int getInt(const std::string &par) const;
   // Get an integer array ising the IDC interface
@@ -195,9 +198,9 @@ protected:
   /// can re-throw them in the forground thread
   boost::shared_ptr<std::runtime_error> m_backgroundException;
 
-  /// Used to buffer events between calls to extractData()
-  std::vector<DataObjects::EventWorkspace_sptr> m_eventBuffer;
-  /// Protects m_eventBuffer
+  /// Used to buffer events between calls to extractData(), one per period
+  std::vector<std::unique_ptr<LiveEventBuffer>> m_eventBuffer;
+  /// Protects the logs of m_eventBuffer
   std::mutex m_mutex;
   /// Run start time
   Kernel::DateAndTime m_startTime;
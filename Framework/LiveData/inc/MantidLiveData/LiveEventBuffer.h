@@ -0,0 +1,111 @@
+#ifndef MANTID_LIVEDATA_LIVEEVENTBUFFER_H_
+#define MANTID_LIVEDATA_LIVEEVENTBUFFER_H_
+
+#include "MantidKernel/System.h"
+#include "MantidDataObjects/EventWorkspace.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Mantid {
+namespace LiveData {
+
+/** LiveEventBuffer : Double buffer of EventWorkspaces for the live listeners.
+
+  The background thread of a listener appends events to the active buffer
+  through an Appender, which takes a lock when it is created, e.g. once per
+  packet, but not for every event it appends. extractData() makes the
+  spare buffer active in constant time and hands out the previous one once no
+  Appender is using it any more. The next spare buffer is cloned from an empty
+  template, so the instrument and the spectrum to detector mapping are set up
+  only once rather than for every chunk.
+
+  Logs and monitor workspaces are not protected by the buffer. Listeners keep
+  guarding them with their own mutex, and copy the logs they want to keep to
+  the spare buffer before calling swap() while holding that mutex.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport LiveEventBuffer {
+public:
+  /** Pins the active buffer for as long as it exists. Events added through
+   * the Appender always end up in the same workspace, even if swap() is
+   * called in the meantime.
+   */
+  class DLLExport Appender {
+  public:
+    explicit Appender(LiveEventBuffer &buffer);
+    ~Appender();
+    Appender(const Appender &) = delete;
+    Appender &operator=(const Appender &) = delete;
+
+    /// The workspace receiving the events
+    DataObjects::EventWorkspace &workspace() { return *m_workspace; }
+    /// Append an event to the spectrum at the given workspace index
+    void addEvent(size_t workspaceIndex, const DataObjects::TofEvent &event) {
+      m_workspace->getSpectrum(workspaceIndex).addEventQuickly(event);
+    }
+
+  private:
+    LiveEventBuffer &m_buffer;
+    size_t m_index;
+    DataObjects::EventWorkspace_sptr m_workspace;
+  };
+
+  LiveEventBuffer() = default;
+  explicit LiveEventBuffer(DataObjects::EventWorkspace_sptr workspace);
+
+  void reset(DataObjects::EventWorkspace_sptr workspace);
+  /// Whether reset() has been called with a workspace
+  bool initialized() const { return static_cast<bool>(m_template); }
+
+  /// The buffer receiving the events
+  DataObjects::EventWorkspace_sptr active() const {
+    return m_buffers[m_active.load()];
+  }
+  /// The buffer that becomes active on the next call to swap()
+  DataObjects::EventWorkspace_sptr spare() const {
+    return m_buffers[1 - m_active.load()];
+  }
+
+  void swap();
+  DataObjects::EventWorkspace_sptr extract();
+
+private:
+  /// Empty workspace with the geometry of the buffers
+  DataObjects::EventWorkspace_sptr m_template;
+  /// The active and the spare buffer
+  DataObjects::EventWorkspace_sptr m_buffers[2];
+  /// Index of the active buffer
+  std::atomic<size_t> m_active{0};
+  /// Number of Appenders using each buffer
+  std::atomic<int> m_appenders[2]{{0}, {0}};
+  /// Number of calls to reset(), guarded by m_mutex
+  size_t m_generation{0};
+  /// Guards replacing the buffers
+  std::mutex m_mutex;
+};
+
+} // namespace LiveData
+} // namespace Mantid
+
+#endif /* MANTID_LIVEDATA_LIVEEVENTBUFFER_H_ */
@@ -62,6 +62,8 @@ private:
   void addMatrixWSChunk(const std::string &algoName,
                         API::Workspace_sptr accumWS,
                         API::Workspace_sptr chunkWS);
+  bool addChunkInPlace(API::Workspace_sptr accumWS,
+                       API::Workspace_sptr chunkWS);
   void appendChunk(Mantid::API::Workspace_sptr chunkWS);
   API::Workspace_sptr appendMatrixWSChunk(API::Workspace_sptr accumWS,
                                           Mantid::API::Workspace_sptr chunkWS);
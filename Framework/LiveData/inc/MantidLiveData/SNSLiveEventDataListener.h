@@ -7,6 +7,7 @@
 #include "MantidLiveData/ADARA/ADARAParser.h"
 #include "MantidAPI/ILiveListener.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidLiveData/LiveEventBuffer.h"
 
 #include <Poco/Timer.h>
 #include <Poco/Net/StreamSocket.h>
@@ -112,8 +113,8 @@ private:
   // Returns true if we've got a value for every log listed in m_requiredLogs
   bool haveRequiredLogs();
 
-  void appendEvent(uint32_t pixelId, double tof,
-                   const Mantid::Kernel::DateAndTime pulseTime);
+  void appendEvent(LiveEventBuffer::Appender &appender, uint32_t pixelId,
+                   double tof, const Mantid::Kernel::DateAndTime pulseTime);
   // tof is "Time Of Flight" and is in units of microsecondss relative to the
   // start of the pulse
   // (There's some documentation that says nanoseconds, but Russell Taylor
@@ -124,7 +125,7 @@ private:
 
   ILiveListener::RunStatus m_status;
   int m_runNumber;
-  DataObjects::EventWorkspace_sptr m_eventBuffer;
+  LiveEventBuffer m_eventBuffer;
   ///< Used to buffer events between calls to extractData()
 
   bool m_workspaceInitialized;
@@ -148,7 +149,7 @@ private:
   bool m_isConnected;
 
   Poco::Thread m_thread;
-  std::mutex m_mutex; // protects m_buffer & m_status
+  std::mutex m_mutex; // protects the logs of m_eventBuffer & m_status
   bool m_pauseNetRead;
   bool m_stopThread; // background thread checks this periodically.
                      // If true, the thread exits
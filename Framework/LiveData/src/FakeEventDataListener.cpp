@@ -68,8 +68,8 @@ void FakeEventDataListener::start(
   // 2 spectra event workspace for now. Will make larger later.
   // No instrument, meta-data etc - will need to figure out who's responsible
   // for that
-  m_buffer = boost::dynamic_pointer_cast<DataObjects::EventWorkspace>(
-      WorkspaceFactory::Instance().create("EventWorkspace", 2, 2, 1));
+  m_buffer.reset(boost::dynamic_pointer_cast<DataObjects::EventWorkspace>(
+      WorkspaceFactory::Instance().create("EventWorkspace", 2, 2, 1)));
   // Set a sample tof range
   m_rand->setRange(40000, 60000);
   m_rand->setSeed(Kernel::DateAndTime::getCurrentTime().totalNanoseconds());
@@ -104,23 +104,12 @@ boost::shared_ptr<Workspace> FakeEventDataListener::extractData() {
    */
   using namespace DataObjects;
 
-  // Create a new, empty workspace of the same dimensions and assign to the
-  // buffer variable
-  EventWorkspace_sptr temp = boost::dynamic_pointer_cast<EventWorkspace>(
-      WorkspaceFactory::Instance().create("EventWorkspace", 2, 2, 1));
-  // Will need an 'initializeFromParent' here later on....
-
-  // Safety considerations suggest I should stop the thread here, but the below
-  // methods don't
-  // seem to do what I'd expect and I haven't seen any problems from not having
-  // them (yet).
-  // m_timer.stop();
-  // m_timer.restart();
+  if (!m_buffer.initialized())
+    throw Exception::NotYet("No workspace yet!");
 
-  // Get an exclusive lock
-  // will wait for generateEvents() to finish before swapping
-  std::lock_guard<std::mutex> _lock(m_mutex);
-  std::swap(m_buffer, temp);
+  // Events generated from now on go to the spare buffer
+  m_buffer.swap();
+  EventWorkspace_sptr temp = m_buffer.extract();
 
   // Add a run number
   temp->mutableRun().addLogData(
@@ -133,12 +122,10 @@ boost::shared_ptr<Workspace> FakeEventDataListener::extractData() {
  *  Used to fill buffer workspace with events between calls to extractData.
  */
 void FakeEventDataListener::generateEvents(Poco::Timer &) {
-  std::lock_guard<std::mutex> _lock(m_mutex);
+  LiveEventBuffer::Appender appender(m_buffer);
   for (long i = 0; i < m_callbackloop; ++i) {
-    m_buffer->getSpectrum(0)
-        .addEventQuickly(DataObjects::TofEvent(m_rand->nextValue()));
-    m_buffer->getSpectrum(1)
-        .addEventQuickly(DataObjects::TofEvent(m_rand->nextValue()));
+    appender.addEvent(0, DataObjects::TofEvent(m_rand->nextValue()));
+    appender.addEvent(1, DataObjects::TofEvent(m_rand->nextValue()));
   }
 }
 } // namespace LiveData
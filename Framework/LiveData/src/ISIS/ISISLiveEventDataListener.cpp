@@ -13,6 +13,7 @@
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/UnitFactory.h"
+#include "MantidKernel/make_unique.h"
 #include "MantidKernel/WarningSuppressions.h"
 
 #ifdef GCC_VERSION
@@ -157,7 +158,7 @@ void ISISLiveEventDataListener::start(Kernel::DateAndTime startTime) {
 
 // return a workspace with collected events
 boost::shared_ptr<API::Workspace> ISISLiveEventDataListener::extractData() {
-  if (m_eventBuffer.empty() || !m_eventBuffer[0]) {
+  if (m_eventBuffer.empty() || !m_eventBuffer[0]->initialized()) {
     // extractData() is called too early
     throw LiveData::Exception::NotYet(
         "The workspace has not yet been initialized.");
@@ -169,30 +170,23 @@ boost::shared_ptr<API::Workspace> ISISLiveEventDataListener::extractData() {
     throw std::runtime_error("Background thread stopped.");
   }
 
-  std::lock_guard<std::mutex> scopedLock(m_mutex);
+  {
+    std::lock_guard<std::mutex> scopedLock(m_mutex);
+    for (auto &buffer : m_eventBuffer) {
+      // Copy the logs over and clear out the old time series values
+      auto spare = buffer->spare();
+      spare->mutableRun() = buffer->active()->run();
+      spare->mutableRun().clearTimeSeriesLogs();
+
+      // New events go to the spare buffer from now on
+      buffer->swap();
+    }
+  }
 
   std::vector<DataObjects::EventWorkspace_sptr> outWorkspaces(
       m_numberOfPeriods);
   for (size_t i = 0; i < static_cast<size_t>(m_numberOfPeriods); ++i) {
-
-    // Make a brand new EventWorkspace
-    DataObjects::EventWorkspace_sptr temp =
-        boost::dynamic_pointer_cast<DataObjects::EventWorkspace>(
-            API::WorkspaceFactory::Instance().create(
-                "EventWorkspace", m_eventBuffer[i]->getNumberHistograms(), 2,
-                1));
-
-    // Copy geometry over.
-    API::WorkspaceFactory::Instance().initializeFromParent(m_eventBuffer[i],
-                                                           temp, false);
-
-    // Clear out the old logs
-    temp->mutableRun().clearTimeSeriesLogs();
-
-    // Swap the workspaces
-    std::swap(m_eventBuffer[i], temp);
-
-    outWorkspaces[i] = temp;
+    outWorkspaces[i] = m_eventBuffer[i]->extract();
   }
 
   if (m_numberOfPeriods > 1) {
@@ -251,10 +245,14 @@ void ISISLiveEventDataListener::run() {
           m_startTime + static_cast<double>(events.head_n.frame_time_zero);
       // Save the pulse charge in the logs
       double protons = static_cast<double>(events.head_n.protons);
-      m_eventBuffer[0]
-          ->mutableRun()
-          .getTimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY)
-          ->addValue(pulseTime, protons);
+      {
+        std::lock_guard<std::mutex> scopedLock(m_mutex);
+        m_eventBuffer[0]
+            ->active()
+            ->mutableRun()
+            .getTimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY)
+            ->addValue(pulseTime, protons);
+      }
 
       events.data.resize(events.head_n.nevents);
       uint32_t nread = 0;
@@ -319,53 +317,44 @@ void ISISLiveEventDataListener::run() {
 void ISISLiveEventDataListener::initEventBuffer(
     const TCPStreamEventDataSetup &setup) {
   // Create an event workspace for the output
-  auto workspace = API::WorkspaceFactory::Instance().create(
-      "EventWorkspace", m_numberOfSpectra, 2, 1);
-
-  m_eventBuffer.resize(m_numberOfPeriods);
-
-  // save this workspace as the event buffer
-  m_eventBuffer[0] =
-      boost::dynamic_pointer_cast<DataObjects::EventWorkspace>(workspace);
-  if (!m_eventBuffer[0]) {
+  auto workspace = boost::dynamic_pointer_cast<DataObjects::EventWorkspace>(
+      API::WorkspaceFactory::Instance().create("EventWorkspace",
+                                               m_numberOfSpectra, 2, 1));
+  if (!workspace) {
     throw std::runtime_error("Failed to create an event workspace");
   }
   // Set the units
-  m_eventBuffer[0]->getAxis(0)->unit() =
-      Kernel::UnitFactory::Instance().create("TOF");
-  m_eventBuffer[0]->setYUnit("Counts");
+  workspace->getAxis(0)->unit() = Kernel::UnitFactory::Instance().create("TOF");
+  workspace->setYUnit("Counts");
 
   // Set the spectra-detector maping
-  loadSpectraMap();
+  loadSpectraMap(*workspace);
 
   // Load the instrument
   std::string instrName(setup.head_setup.inst_name);
-  loadInstrument(instrName);
+  loadInstrument(instrName, workspace);
 
   // Set the run number
   m_runNumber = setup.head_setup.run_number;
   std::string run_num = std::to_string(m_runNumber);
-  m_eventBuffer[0]->mutableRun().addLogData(
+  workspace->mutableRun().addLogData(
       new Mantid::Kernel::PropertyWithValue<std::string>(RUN_NUMBER_PROPERTY,
                                                          run_num));
 
   // Add the proton charge property
-  m_eventBuffer[0]->mutableRun().addLogData(
+  workspace->mutableRun().addLogData(
       new Mantid::Kernel::TimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY));
 
-  if (m_numberOfPeriods > 1) {
-    for (size_t i = 1; i < static_cast<size_t>(m_numberOfPeriods); ++i) {
-      // create an event workspace for each period
-      m_eventBuffer[i] =
-          boost::dynamic_pointer_cast<DataObjects::EventWorkspace>(
-              API::WorkspaceFactory::Instance().create(
-                  "EventWorkspace", m_eventBuffer[0]->getNumberHistograms(), 2,
-                  1));
-
-      // Copy geometry over.
-      API::WorkspaceFactory::Instance().initializeFromParent(
-          m_eventBuffer[0], m_eventBuffer[i], false);
-    }
+  // Create a double buffer for each period. They share the instrument and the
+  // spectra-detector mapping of the first one.
+  m_eventBuffer.clear();
+  m_eventBuffer.push_back(Kernel::make_unique<LiveEventBuffer>(workspace));
+  for (size_t i = 1; i < static_cast<size_t>(m_numberOfPeriods); ++i) {
+    // create an event workspace for each period
+    DataObjects::EventWorkspace_sptr periodWorkspace(
+        m_eventBuffer[0]->spare()->clone());
+    m_eventBuffer.push_back(
+        Kernel::make_unique<LiveEventBuffer>(periodWorkspace));
   }
 }
 
@@ -376,8 +365,6 @@ void ISISLiveEventDataListener::initEventBuffer(
 void ISISLiveEventDataListener::saveEvents(
     const std::vector<TCPStreamEventNeutron> &data,
     const Kernel::DateAndTime &pulseTime, size_t period) {
-  std::lock_guard<std::mutex> scopedLock(m_mutex);
-
   if (period >= static_cast<size_t>(m_numberOfPeriods)) {
     auto warn = m_warnings.find("period");
     if (warn != m_warnings.end()) {
@@ -387,18 +374,20 @@ void ISISLiveEventDataListener::saveEvents(
     period = 0;
   }
 
+  // Events are appended without locking m_mutex
+  LiveEventBuffer::Appender appender(*m_eventBuffer[period]);
   for (const auto &streamEvent : data) {
     Mantid::DataObjects::TofEvent event(streamEvent.time_of_flight, pulseTime);
-    m_eventBuffer[period]
-        ->getSpectrum(streamEvent.spectrum)
-        .addEventQuickly(event);
+    appender.addEvent(streamEvent.spectrum, event);
   }
 }
 
 /**
   * Set the spectra-detector map to the buffer workspace.
+  * @param workspace :: The buffer workspace
   */
-void ISISLiveEventDataListener::loadSpectraMap() {
+void ISISLiveEventDataListener::loadSpectraMap(
+    DataObjects::EventWorkspace &workspace) {
   // Read in the number of detectors
   int ndet = getInt("NDET");
   // Read in matching arrays of spectra indices and detector ids
@@ -407,15 +396,16 @@ void ISISLiveEventDataListener::loadSpectraMap() {
   getIntArray("UDET", udet, ndet);
   getIntArray("SPEC", spec, ndet);
   // set up the mapping
-  m_eventBuffer[0]->updateSpectraUsing(
-      API::SpectrumDetectorMapping(spec, udet));
+  workspace.updateSpectraUsing(API::SpectrumDetectorMapping(spec, udet));
 }
 
 /**
   * Load the instrument
   * @param instrName :: Instrument name
+  * @param workspace :: The buffer workspace to load the instrument into
   */
-void ISISLiveEventDataListener::loadInstrument(const std::string &instrName) {
+void ISISLiveEventDataListener::loadInstrument(
+    const std::string &instrName, DataObjects::EventWorkspace_sptr workspace) {
   // try to load the instrument. if it doesn't load give a warning and carry on
   if (instrName.empty()) {
     g_log.warning() << "Unable to read instrument name from DAE.\n";
@@ -428,7 +418,7 @@ void ISISLiveEventDataListener::loadInstrument(const std::string &instrName) {
         API::AlgorithmFactory::Instance().create("LoadInstrument", -1);
     alg->initialize();
     alg->setPropertyValue("InstrumentName", instrName);
-    alg->setProperty("Workspace", m_eventBuffer[0]);
+    alg->setProperty("Workspace", workspace);
     alg->setProperty("RewriteSpectraMap", Mantid::Kernel::OptionalBool(false));
     alg->setChild(true);
     alg->execute();
@@ -0,0 +1,98 @@
+#include "MantidLiveData/LiveEventBuffer.h"
+
+#include <thread>
+
+namespace Mantid {
+namespace LiveData {
+
+using DataObjects::EventWorkspace_sptr;
+
+/** Pin the active buffer.
+ * @param buffer :: The buffer to append events to
+ */
+LiveEventBuffer::Appender::Appender(LiveEventBuffer &buffer)
+    : m_buffer(buffer) {
+  // The lock keeps reset() and extract() from replacing the buffers meanwhile.
+  // extract() only waits for Appenders that are already registered, so it
+  // never holds the lock while waiting for this one.
+  std::lock_guard<std::mutex> lock(buffer.m_mutex);
+  // Register with the active buffer and check that it is still active
+  // afterwards. If swap() runs concurrently either extract() sees the
+  // registration and waits, or the check fails and we try again.
+  for (;;) {
+    m_index = buffer.m_active.load();
+    ++buffer.m_appenders[m_index];
+    if (buffer.m_active.load() == m_index)
+      break;
+    --buffer.m_appenders[m_index];
+  }
+  m_workspace = buffer.m_buffers[m_index];
+}
+
+/// Release the pinned buffer
+LiveEventBuffer::Appender::~Appender() { --m_buffer.m_appenders[m_index]; }
+
+/** Constructor
+ * @param workspace :: The initial active buffer, see reset()
+ */
+LiveEventBuffer::LiveEventBuffer(EventWorkspace_sptr workspace) {
+  reset(workspace);
+}
+
+/** Start buffering into a new workspace, e.g. once the instrument is known.
+ * Events in the current buffers are discarded.
+ *
+ * @param workspace :: The new active buffer. The spare buffers are created
+ * with the same geometry and logs, but without events.
+ */
+void LiveEventBuffer::reset(EventWorkspace_sptr workspace) {
+  EventWorkspace_sptr emptyWorkspace(workspace->clone());
+  for (size_t i = 0; i < emptyWorkspace->getNumberHistograms(); ++i)
+    emptyWorkspace->getSpectrum(i).clearData();
+  EventWorkspace_sptr spareWorkspace(emptyWorkspace->clone());
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_template = emptyWorkspace;
+  const size_t active = m_active.load();
+  m_buffers[1 - active] = spareWorkspace;
+  m_buffers[active] = workspace;
+  ++m_generation;
+}
+
+/** Make the spare buffer active, in constant time. Logs that are to be kept
+ * should be copied to spare() beforehand, under the same lock that guards
+ * the logs of the active buffer. Each call must be followed by a call to
+ * extract().
+ */
+void LiveEventBuffer::swap() { m_active.store(1 - m_active.load()); }
+
+/** Hand out the buffer that was active before the last call to swap(), once
+ * no Appender is using it any more, and prepare a new spare buffer.
+ *
+ * @return the workspace with the events appended before swap()
+ */
+EventWorkspace_sptr LiveEventBuffer::extract() {
+  // Clone the next spare buffer without blocking new Appenders
+  EventWorkspace_sptr emptyWorkspace;
+  size_t generation;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    emptyWorkspace = m_template;
+    generation = m_generation;
+  }
+  EventWorkspace_sptr spareWorkspace(emptyWorkspace->clone());
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const size_t previous = 1 - m_active.load();
+  while (m_appenders[previous].load() > 0)
+    std::this_thread::yield();
+
+  EventWorkspace_sptr workspace = m_buffers[previous];
+  if (generation != m_generation)
+    spareWorkspace = EventWorkspace_sptr(m_template->clone());
+  m_buffers[previous] = spareWorkspace;
+  return workspace;
+}
+
+} // namespace LiveData
+} // namespace Mantid
@@ -1,18 +1,25 @@
 #include "MantidLiveData/LoadLiveData.h"
 #include "MantidLiveData/Exception.h"
+#include "MantidAPI/Axis.h"
 #include "MantidKernel/WriteLock.h"
 #include "MantidKernel/ReadLock.h"
 #include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/Run.h"
+#include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/Workspace.h"
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Unit.h"
 
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include <Poco/Thread.h>
 
+#include <cmath>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
@@ -23,6 +30,142 @@ namespace LiveData {
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(LoadLiveData)
 
+namespace {
+/** Check that a chunk can be added to the accumulation workspace spectrum by
+ * spectrum, i.e. that both have the same spectra, units and (for histograms)
+ * binning.
+ *
+ * @param accumWS :: accumulation matrix workspace
+ * @param chunkWS :: processed live data chunk matrix workspace
+ * @return true if the chunk can be added in place
+ */
+bool canAddInPlace(const MatrixWorkspace &accumWS,
+                   const MatrixWorkspace &chunkWS) {
+  const size_t numHist = accumWS.getNumberHistograms();
+  if (chunkWS.getNumberHistograms() != numHist ||
+      chunkWS.YUnit() != accumWS.YUnit())
+    return false;
+  const auto accumUnit = accumWS.getAxis(0)->unit();
+  const auto chunkUnit = chunkWS.getAxis(0)->unit();
+  if (!accumUnit || !chunkUnit || accumUnit->unitID() != chunkUnit->unitID())
+    return false;
+
+  // Events are kept whatever the binning, histograms have to match bin by bin
+  const bool compareX = !dynamic_cast<const EventWorkspace *>(&accumWS);
+  if (compareX && (chunkWS.blocksize() != accumWS.blocksize() ||
+                   chunkWS.isHistogramData() != accumWS.isHistogramData()))
+    return false;
+  for (size_t i = 0; i < numHist; ++i) {
+    if (accumWS.getSpectrum(i).getSpectrumNo() !=
+        chunkWS.getSpectrum(i).getSpectrumNo())
+      return false;
+    if (compareX && &accumWS.x(i) != &chunkWS.x(i) &&
+        accumWS.x(i).rawData() != chunkWS.x(i).rawData())
+      return false;
+  }
+  return true;
+}
+
+/** Find the spectra to mask in the accumulation workspace: those with masked
+ * detectors in either workspace, as in BinaryOperation::propagateSpectraMask.
+ *
+ * @param accumWS :: accumulation matrix workspace
+ * @param chunkWS :: processed live data chunk matrix workspace
+ * @return a flag for each workspace index, set if the spectrum is masked
+ */
+std::vector<bool> findMaskedSpectra(const MatrixWorkspace &accumWS,
+                                    const MatrixWorkspace &chunkWS) {
+  const auto &accumInfo = accumWS.spectrumInfo();
+  const auto &chunkInfo = chunkWS.spectrumInfo();
+  const size_t numHist = accumWS.getNumberHistograms();
+  std::vector<bool> masked(numHist);
+  for (size_t i = 0; i < numHist; ++i)
+    masked[i] = (accumInfo.hasDetectors(i) && accumInfo.isMasked(i)) ||
+                (chunkInfo.hasDetectors(i) && chunkInfo.isMasked(i));
+  return masked;
+}
+
+/** Append the events of the chunk to the accumulation workspace. The event
+ * lists are left unsorted: sorting or merging them would take a time
+ * proportional to all the events accumulated so far. Whatever needs sorted
+ * events sorts a list when reading it, and histogramming on regular bins does
+ * not need to sort at all.
+ *
+ * @param accumWS :: accumulation event workspace
+ * @param chunkWS :: processed live data chunk event workspace
+ * @param masked :: flag for each masked spectrum, which is left out
+ */
+void addEventsInPlace(EventWorkspace &accumWS, const EventWorkspace &chunkWS,
+                      const std::vector<bool> &masked) {
+  const auto numHist = static_cast<int>(accumWS.getNumberHistograms());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < numHist; ++i) {
+    if (masked[i])
+      continue;
+    auto &accum = accumWS.getSpectrum(i);
+    const auto &chunk = chunkWS.getSpectrum(i);
+    if (chunk.getNumberEvents() == 0)
+      accum.addDetectorIDs(chunk.getDetectorIDs());
+    else
+      accum += chunk;
+  }
+}
+
+/** Add the counts of the chunk to the accumulation workspace. Errors are added
+ * in quadrature, as done by Plus. Bins of the chunk without counts or errors
+ * leave the accumulation workspace untouched.
+ *
+ * @param accumWS :: accumulation matrix workspace
+ * @param chunkWS :: processed live data chunk matrix workspace
+ * @param masked :: flag for each masked spectrum, which is left out
+ */
+void addHistogramsInPlace(MatrixWorkspace &accumWS,
+                          const MatrixWorkspace &chunkWS,
+                          const std::vector<bool> &masked) {
+  const auto numHist = static_cast<int>(accumWS.getNumberHistograms());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < numHist; ++i) {
+    if (masked[i])
+      continue;
+    const auto &chunkY = chunkWS.y(i);
+    const auto &chunkE = chunkWS.e(i);
+    const auto isEmptyBin = [&](size_t j) {
+      return chunkY[j] == 0.0 && chunkE[j] == 0.0;
+    };
+    size_t first = 0;
+    while (first < chunkY.size() && isEmptyBin(first))
+      ++first;
+    if (first == chunkY.size())
+      continue;
+
+    auto &accumY = accumWS.mutableY(i);
+    auto &accumE = accumWS.mutableE(i);
+    for (size_t j = first; j < chunkY.size(); ++j) {
+      if (isEmptyBin(j))
+        continue;
+      accumY[j] += chunkY[j];
+      accumE[j] = std::sqrt(accumE[j] * accumE[j] + chunkE[j] * chunkE[j]);
+    }
+  }
+}
+
+/** Copy the bin masks of the chunk to the accumulation workspace, as Plus
+ * does for the masks of its right hand operand.
+ *
+ * @param accumWS :: accumulation matrix workspace
+ * @param chunkWS :: processed live data chunk matrix workspace
+ */
+void addBinMasks(MatrixWorkspace &accumWS, const MatrixWorkspace &chunkWS) {
+  const size_t numHist = accumWS.getNumberHistograms();
+  for (size_t i = 0; i < numHist; ++i) {
+    if (!chunkWS.hasMaskedBins(i))
+      continue;
+    for (const auto &mask : chunkWS.maskedBins(i))
+      accumWS.flagMasked(i, mask.first, mask.second);
+  }
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /// Algorithm's name for identification. @see Algorithm::name
 const std::string LoadLiveData::name() const { return "LoadLiveData"; }
@@ -178,7 +321,8 @@ void LoadLiveData::runPostProcessing() {
 
 //----------------------------------------------------------------------------------------------
 /** Accumulate the data by adding (summing) to the output workspace.
- * Calls the Plus algorithm
+ * Adds matrix workspaces in place when possible, otherwise calls the Plus
+ * algorithm.
  * Sets m_accumWS.
  *
  * @param chunkWS :: processed live data chunk workspace
@@ -243,6 +387,8 @@ void LoadLiveData::addMatrixWSChunk(const std::string &algoName,
   }
 
   // Now do the main workspace
+  if (addChunkInPlace(accumWS, chunkWS))
+    return;
   IAlgorithm_sptr alg = this->createChildAlgorithm(algoName);
   alg->setProperty("LHSWorkspace", accumWS);
   alg->setProperty("RHSWorkspace", chunkWS);
@@ -268,6 +414,48 @@ void LoadLiveData::addMatrixWSChunk(const std::string &algoName,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Add a matrix workspace to the accumulation workspace without running Plus,
+ * if both have the same spectra. Events are appended to the event lists and
+ * histograms are added bin by bin, so the time taken depends on the size of
+ * the chunk rather than on the amount of data accumulated so far. The
+ * spectrum and bin masks and the run of the chunk are added to the
+ * accumulation workspace, as done by Plus.
+ *
+ * @param accumWS :: accumulation matrix workspace
+ * @param chunkWS :: processed live data chunk matrix workspace
+ * @return true if the chunk was added, false if Plus has to be used instead
+ */
+bool LoadLiveData::addChunkInPlace(Workspace_sptr accumWS,
+                                   Workspace_sptr chunkWS) {
+  auto accumMW = boost::dynamic_pointer_cast<MatrixWorkspace>(accumWS);
+  auto chunkMW = boost::dynamic_pointer_cast<MatrixWorkspace>(chunkWS);
+  if (!accumMW || !chunkMW)
+    return false;
+  auto accumEW = boost::dynamic_pointer_cast<EventWorkspace>(accumMW);
+  auto chunkEW = boost::dynamic_pointer_cast<EventWorkspace>(chunkMW);
+  // Plus turns events into histograms if only one of them has events
+  if (static_cast<bool>(accumEW) != static_cast<bool>(chunkEW) ||
+      !canAddInPlace(*accumMW, *chunkMW))
+    return false;
+
+  CPUTimer tim;
+  const auto masked = findMaskedSpectra(*accumMW, *chunkMW);
+  if (accumEW)
+    addEventsInPlace(*accumEW, *chunkEW, masked);
+  else
+    addHistogramsInPlace(*accumMW, *chunkMW, masked);
+  for (size_t i = 0; i < masked.size(); ++i) {
+    if (masked[i])
+      accumMW->maskWorkspaceIndex(i);
+  }
+  addBinMasks(*accumMW, *chunkMW);
+  accumMW->mutableRun() += chunkMW->run();
+  g_log.debug() << tim << " to add the chunk to " << accumWS->name()
+                << " in place\n";
+  return true;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Accumulate the data by replacing the output workspace.
  * Sets m_accumWS.
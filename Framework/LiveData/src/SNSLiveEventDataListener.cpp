@@ -392,51 +392,55 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::BankedEventPkt &pkt) {
 
   // Append the events
   g_log.debug() << "----- Pulse ID: " << pkt.pulseId() << " -----\n";
+  // Timestamp for the events
+  Mantid::Kernel::DateAndTime eventTime = timeFromPacket(pkt);
+
+  // Pin the buffer that receives the events of this pulse. Only the pulse
+  // charge needs the mutex, the events are appended without it.
+  LiveEventBuffer::Appender appender(m_eventBuffer);
   // Scope braces
   {
     std::lock_guard<std::mutex> scopedLock(m_mutex);
 
-    // Timestamp for the events
-    Mantid::Kernel::DateAndTime eventTime = timeFromPacket(pkt);
-
     // Save the pulse charge in the logs (*10 because we want the units to be
     // picoCulombs, and ADARA sends them out in units of 10pC)
-    m_eventBuffer->mutableRun()
+    appender.workspace()
+        .mutableRun()
         .getTimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY)
         ->addValue(eventTime, pkt.pulseCharge() * 10);
+  } // mutex automatically unlocks here
 
-    // Iterate through each event
-    const ADARA::Event *event = pkt.firstEvent();
-    unsigned lastBankID = pkt.curBankId();
-    // A counter that we use for logging purposes
-    unsigned eventsPerBank = 0;
-    while (event != nullptr) {
-      eventsPerBank++;
-      totalEvents++;
-      if (lastBankID < 0xFFFFFFFE) // Bank ID -1 & -2 are special cases and are
-                                   // not valid pixels
-      {
-        // appendEvent needs tof to be in units of microseconds, but it comes
-        // from the ADARA stream in units of 100ns.
-        if (pkt.getSourceCORFlag()) {
-          appendEvent(event->pixel, event->tof / 10.0, eventTime);
-        } else {
-          appendEvent(event->pixel,
-                      (event->tof + pkt.getSourceTOFOffset()) / 10.0,
-                      eventTime);
-        }
+  // Iterate through each event
+  const ADARA::Event *event = pkt.firstEvent();
+  unsigned lastBankID = pkt.curBankId();
+  // A counter that we use for logging purposes
+  unsigned eventsPerBank = 0;
+  while (event != nullptr) {
+    eventsPerBank++;
+    totalEvents++;
+    if (lastBankID < 0xFFFFFFFE) // Bank ID -1 & -2 are special cases and are
+                                 // not valid pixels
+    {
+      // appendEvent needs tof to be in units of microseconds, but it comes
+      // from the ADARA stream in units of 100ns.
+      if (pkt.getSourceCORFlag()) {
+        appendEvent(appender, event->pixel, event->tof / 10.0, eventTime);
+      } else {
+        appendEvent(appender, event->pixel,
+                    (event->tof + pkt.getSourceTOFOffset()) / 10.0,
+                    eventTime);
       }
+    }
 
-      event = pkt.nextEvent();
-      if (pkt.curBankId() != lastBankID) {
-        g_log.debug() << "BankID " << lastBankID << " had " << eventsPerBank
-                      << " events\n";
+    event = pkt.nextEvent();
+    if (pkt.curBankId() != lastBankID) {
+      g_log.debug() << "BankID " << lastBankID << " had " << eventsPerBank
+                    << " events\n";
 
-        lastBankID = pkt.curBankId();
-        eventsPerBank = 0;
-      }
+      lastBankID = pkt.curBankId();
+      eventsPerBank = 0;
     }
-  } // mutex automatically unlocks here
+  }
 
   g_log.debug() << "Total Events: " << totalEvents << "\n";
   g_log.debug("-------------------------------");
@@ -463,12 +467,13 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::BeamMonitorPkt &pkt) {
   }
 
   // We'll likely be modifying m_eventBuffer (specifically,
-  // m_eventBuffer->m_monitorWorkspace),
+  // the monitor workspace and logs of the active buffer),
   // so lock the mutex
   std::lock_guard<std::mutex> scopedLock(m_mutex);
 
+  auto workspace = m_eventBuffer.active();
   auto monitorBuffer = boost::static_pointer_cast<DataObjects::EventWorkspace>(
-      m_eventBuffer->monitorWorkspace());
+      workspace->monitorWorkspace());
   const auto pktTime = timeFromPacket(pkt);
 
   while (pkt.nextSection()) {
@@ -492,15 +497,15 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::BeamMonitorPkt &pkt) {
       // list at the top of Run.cpp!
 
       int events = pkt.getSectionEventCount();
-      if (m_eventBuffer->run().hasProperty(monName)) {
-        events += m_eventBuffer->run().getPropertyValueAsType<int>(monName);
+      if (workspace->run().hasProperty(monName)) {
+        events += workspace->run().getPropertyValueAsType<int>(monName);
       } else {
         // First time we've received this monitor.  Add it to our list
         m_monitorLogs.push_back(monName);
       }
 
       // Update the property value (overwriting the old value if there was one)
-      m_eventBuffer->mutableRun().addProperty<int>(monName, events, true);
+      workspace->mutableRun().addProperty<int>(monName, events, true);
 
       auto it = m_monitorIndexMap.find(
           // cppcheck-suppress signConversion
@@ -642,7 +647,8 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::RunStatusPkt &pkt) {
 
   std::lock_guard<std::mutex> scopedLock(m_mutex);
 
-  const bool haveRunNumber = m_eventBuffer->run().hasProperty("run_number");
+  const bool haveRunNumber =
+      m_eventBuffer.active()->run().hasProperty("run_number");
 
   if (pkt.status() == ADARA::RunStatus::NEW_RUN) {
     // Starting a new run:  update m_status and add the run_start & run_number
@@ -818,7 +824,7 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::RunStatusPkt &pkt) {
 
 void SNSLiveEventDataListener::setRunDetails(const ADARA::RunStatusPkt &pkt) {
   m_runNumber = pkt.runNumber();
-  m_eventBuffer->mutableRun().addProperty(
+  m_eventBuffer.active()->mutableRun().addProperty(
       "run_number", Strings::toString<int>(pkt.runNumber()));
   g_log.notice() << "Run number is " << m_runNumber << '\n';
 
@@ -830,7 +836,8 @@ void SNSLiveEventDataListener::setRunDetails(const ADARA::RunStatusPkt &pkt) {
                        // terminator)
   strftime(timeString, 64, "%Y-%m-%dT%H:%M:%SZ", gmtime(&runStartTime));
   // addProperty() wants the time as an ISO 8601 string
-  m_eventBuffer->mutableRun().addProperty("run_start", std::string(timeString));
+  m_eventBuffer.active()->mutableRun().addProperty("run_start",
+                                                  std::string(timeString));
 }
 
 /// Parse a variable value packet
@@ -866,7 +873,7 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::VariableU32Pkt &pkt) {
     } else {
       {
         std::lock_guard<std::mutex> scopedLock(m_mutex);
-        m_eventBuffer->mutableRun()
+        m_eventBuffer.active()->mutableRun()
             .getTimeSeriesProperty<int>((*it).second)
             ->addValue(timeFromPacket(pkt), pkt.value());
       }
@@ -916,7 +923,7 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::VariableDoublePkt &pkt) {
     } else {
       {
         std::lock_guard<std::mutex> scopedLock(m_mutex);
-        m_eventBuffer->mutableRun()
+        m_eventBuffer.active()->mutableRun()
             .getTimeSeriesProperty<double>((*it).second)
             ->addValue(timeFromPacket(pkt), pkt.value());
       }
@@ -969,7 +976,7 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::VariableStringPkt &pkt) {
     } else {
       {
         std::lock_guard<std::mutex> scopedLock(m_mutex);
-        m_eventBuffer->mutableRun()
+        m_eventBuffer.active()->mutableRun()
             .getTimeSeriesProperty<std::string>((*it).second)
             ->addValue(timeFromPacket(pkt), pkt.value());
       }
@@ -1119,7 +1126,7 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::DeviceDescriptorPkt &pkt) {
               // do need to
               // the lock the mutex here.
               std::lock_guard<std::mutex> scopedLock(m_mutex);
-              m_eventBuffer->mutableRun().addLogData(prop);
+              m_eventBuffer.active()->mutableRun().addLogData(prop);
             }
 
             // Add the pv id, device id and pv name to the name map so we can
@@ -1163,21 +1170,21 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::AnnotationPkt &pkt) {
       break;
 
     case ADARA::MarkerType::SCAN_START:
-      m_eventBuffer->mutableRun()
+      m_eventBuffer.active()->mutableRun()
           .getTimeSeriesProperty<int>(SCAN_PROPERTY)
           ->addValue(timeFromPacket(pkt), pkt.scanIndex());
       g_log.information() << "Scan Start: " << pkt.scanIndex() << '\n';
       break;
 
     case ADARA::MarkerType::SCAN_STOP:
-      m_eventBuffer->mutableRun()
+      m_eventBuffer.active()->mutableRun()
           .getTimeSeriesProperty<int>(SCAN_PROPERTY)
           ->addValue(timeFromPacket(pkt), 0);
       g_log.information() << "Scan Stop:  " << pkt.scanIndex() << '\n';
       break;
 
     case ADARA::MarkerType::PAUSE:
-      m_eventBuffer->mutableRun()
+      m_eventBuffer.active()->mutableRun()
           .getTimeSeriesProperty<int>(PAUSE_PROPERTY)
           ->addValue(timeFromPacket(pkt), 1);
       g_log.information() << "Run paused\n";
@@ -1185,7 +1192,7 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::AnnotationPkt &pkt) {
       break;
 
     case ADARA::MarkerType::RESUME:
-      m_eventBuffer->mutableRun()
+      m_eventBuffer.active()->mutableRun()
           .getTimeSeriesProperty<int>(PAUSE_PROPERTY)
           ->addValue(timeFromPacket(pkt), 0);
       g_log.information() << "Run resumed\n";
@@ -1212,7 +1219,7 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::AnnotationPkt &pkt) {
 /// Performs various initialization steps that can (and, in some
 /// cases, must) be done prior to receiving any packets from the SMS daemon.
 void SNSLiveEventDataListener::initWorkspacePart1() {
-  m_eventBuffer = boost::static_pointer_cast<DataObjects::EventWorkspace>(
+  auto workspace = boost::static_pointer_cast<DataObjects::EventWorkspace>(
       WorkspaceFactory::Instance().create("EventWorkspace", 1, 1, 1));
   // The numbers in the create() function don't matter - they'll get overwritten
   // down in initWorkspacePart2() when we load the instrument definition.
@@ -1223,11 +1230,12 @@ void SNSLiveEventDataListener::initWorkspacePart1() {
   // we
   // can call initWorkspacePart2().)
   Property *prop = new TimeSeriesProperty<int>(PAUSE_PROPERTY);
-  m_eventBuffer->mutableRun().addLogData(prop);
+  workspace->mutableRun().addLogData(prop);
   prop = new TimeSeriesProperty<int>(SCAN_PROPERTY);
-  m_eventBuffer->mutableRun().addLogData(prop);
+  workspace->mutableRun().addLogData(prop);
   prop = new TimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY);
-  m_eventBuffer->mutableRun().addLogData(prop);
+  workspace->mutableRun().addLogData(prop);
+  m_eventBuffer.reset(workspace);
 }
 
 /// Second part of the workspace initialization
@@ -1244,7 +1252,8 @@ void SNSLiveEventDataListener::initWorkspacePart2() {
   loadInst->setChild(true); // keep the workspace out of the ADS
   loadInst->setProperty("InstrumentXML", m_instrumentXML);
   loadInst->setProperty("InstrumentName", m_instrumentName);
-  loadInst->setProperty("Workspace", m_eventBuffer);
+  auto workspace = m_eventBuffer.active();
+  loadInst->setProperty("Workspace", workspace);
   loadInst->setProperty("RewriteSpectraMap", OptionalBool(false));
 
   loadInst->execute();
@@ -1255,19 +1264,19 @@ void SNSLiveEventDataListener::initWorkspacePart2() {
   // repopulated when we receive the next geometry packet.
 
   auto tmp = createWorkspace<DataObjects::EventWorkspace>(
-      m_eventBuffer->getInstrument()->getDetectorIDs(true).size(), 2, 1);
-  WorkspaceFactory::Instance().initializeFromParent(m_eventBuffer, tmp, true);
-  if (m_eventBuffer->getNumberHistograms() != tmp->getNumberHistograms()) {
+      workspace->getInstrument()->getDetectorIDs(true).size(), 2, 1);
+  WorkspaceFactory::Instance().initializeFromParent(workspace, tmp, true);
+  if (workspace->getNumberHistograms() != tmp->getNumberHistograms()) {
     // need to generate the spectra to detector map
     tmp->rebuildSpectraMapping();
   }
-  m_eventBuffer = std::move(tmp);
+  workspace = std::move(tmp);
 
   // Set the units
-  m_eventBuffer->getAxis(0)->unit() = UnitFactory::Instance().create("TOF");
-  m_eventBuffer->setYUnit("Counts");
+  workspace->getAxis(0)->unit() = UnitFactory::Instance().create("TOF");
+  workspace->setYUnit("Counts");
 
-  m_indexMap = m_eventBuffer->getDetectorIDToWorkspaceIndexMap(
+  m_indexMap = workspace->getDetectorIDToWorkspaceIndexMap(
       true /* bool throwIfMultipleDets */);
 
   // We always want to have at least one value for the the scan index time
@@ -1275,14 +1284,17 @@ void SNSLiveEventDataListener::initWorkspacePart2() {
   // already gotten a scan start packet by the time we get here and therefor
   // don't need to do
   // anything.  If not, we need to put a 0 into the time series.
-  if (m_eventBuffer->mutableRun()
+  if (workspace->mutableRun()
           .getTimeSeriesProperty<int>(SCAN_PROPERTY)
           ->size() == 0) {
-    m_eventBuffer->mutableRun()
+    workspace->mutableRun()
         .getTimeSeriesProperty<int>(SCAN_PROPERTY)
         ->addValue(m_dataStartTime, 0);
   }
 
+  // The spare buffer is set up with the same instrument and spectra, so they
+  // need not be created again for every chunk
+  m_eventBuffer.reset(workspace);
   initMonitorWorkspace();
 
   m_workspaceInitialized = true;
@@ -1291,11 +1303,12 @@ void SNSLiveEventDataListener::initWorkspacePart2() {
 /// Creates a monitor workspace sized to the number of monitors, with the
 /// monitor IDs set
 void SNSLiveEventDataListener::initMonitorWorkspace() {
-  auto monitors = m_eventBuffer->getInstrument()->getMonitors();
+  auto workspace = m_eventBuffer.active();
+  auto monitors = workspace->getInstrument()->getMonitors();
   auto monitorsBuffer = WorkspaceFactory::Instance().create(
       "EventWorkspace", monitors.size(), 1, 1);
-  WorkspaceFactory::Instance().initializeFromParent(m_eventBuffer,
-                                                    monitorsBuffer, true);
+  WorkspaceFactory::Instance().initializeFromParent(workspace, monitorsBuffer,
+                                                    true);
   // Set the id numbers
   for (size_t i = 0; i < monitors.size(); ++i) {
     monitorsBuffer->getSpectrum(i).setDetectorID(monitors[i]);
@@ -1303,7 +1316,7 @@ void SNSLiveEventDataListener::initMonitorWorkspace() {
 
   m_monitorIndexMap = monitorsBuffer->getDetectorIDToWorkspaceIndexMap(true);
 
-  m_eventBuffer->setMonitorWorkspace(monitorsBuffer);
+  workspace->setMonitorWorkspace(monitorsBuffer);
 }
 
 // Check to see if we have data for all of the logs listed in m_requiredLogs.
@@ -1314,7 +1327,7 @@ void SNSLiveEventDataListener::initMonitorWorkspace() {
 // has been initialized...)
 bool SNSLiveEventDataListener::haveRequiredLogs() {
   bool allFound = true;
-  Run &run = m_eventBuffer->mutableRun();
+  Run &run = m_eventBuffer.active()->mutableRun();
   auto it = m_requiredLogs.begin();
   while (it != m_requiredLogs.end() && allFound) {
     if (!run.hasProperty(*it)) {
@@ -1331,9 +1344,10 @@ bool SNSLiveEventDataListener::haveRequiredLogs() {
 
 /// Adds an event to the workspace
 void SNSLiveEventDataListener::appendEvent(
-    uint32_t pixelId, double tof, const Mantid::Kernel::DateAndTime pulseTime)
-// NOTE: This function does NOT lock the mutex!  Make sure you do that
-// before calling this function!
+    LiveEventBuffer::Appender &appender, uint32_t pixelId, double tof,
+    const Mantid::Kernel::DateAndTime pulseTime)
+// NOTE: This function does NOT lock the mutex! The appender keeps the
+// buffer it appends to from being extracted.
 {
   // It'd be nice to use operator[], but we might end up inserting a value....
   // Have to use find() instead.
@@ -1341,7 +1355,7 @@ void SNSLiveEventDataListener::appendEvent(
   if (it != m_indexMap.end()) {
     std::size_t workspaceIndex = it->second;
     Mantid::DataObjects::TofEvent event(tof, pulseTime);
-    m_eventBuffer->getSpectrum(workspaceIndex).addEventQuickly(event);
+    appender.addEvent(workspaceIndex, event);
   } else {
     g_log.warning() << "Invalid pixel ID: " << pixelId << " (TofF: " << tof
                     << " microseconds)\n";
@@ -1383,41 +1397,37 @@ boost::shared_ptr<Workspace> SNSLiveEventDataListener::extractData() {
     throw Exception::NotYet("Waiting for a run to start.");
   }
 
-  using namespace DataObjects;
-
-  // Make a brand new EventWorkspace
-  EventWorkspace_sptr temp = boost::dynamic_pointer_cast<EventWorkspace>(
-      API::WorkspaceFactory::Instance().create(
-          "EventWorkspace", m_eventBuffer->getNumberHistograms(), 2, 1));
-
-  // Copy geometry over.
-  API::WorkspaceFactory::Instance().initializeFromParent(m_eventBuffer, temp,
-                                                         false);
-
-  // Clear out the old logs, except for the most recent entry
-  temp->mutableRun().clearOutdatedTimeSeriesLogValues();
-
-  // Clear out old monitor logs
-  for (auto &monitorLog : m_monitorLogs) {
-    temp->mutableRun().removeProperty(monitorLog);
-  }
-  m_monitorLogs.clear();
-
-  // Create a fresh monitor workspace and insert into the new 'main' workspace
-  auto monitorBuffer = m_eventBuffer->monitorWorkspace();
-  auto newMonitorBuffer = WorkspaceFactory::Instance().create(
-      "EventWorkspace", monitorBuffer->getNumberHistograms(), 1, 1);
-  WorkspaceFactory::Instance().initializeFromParent(monitorBuffer,
-                                                    newMonitorBuffer, false);
-  temp->setMonitorWorkspace(newMonitorBuffer);
-
-  // Lock the mutex and swap the workspaces
   {
     std::lock_guard<std::mutex> scopedLock(m_mutex);
-    std::swap(m_eventBuffer, temp);
+    auto active = m_eventBuffer.active();
+    auto spare = m_eventBuffer.spare();
+
+    // Copy the logs over and clear out their old values, except for the most
+    // recent entry
+    spare->mutableRun() = active->run();
+    spare->mutableRun().clearOutdatedTimeSeriesLogValues();
+
+    // Clear out old monitor logs
+    for (auto &monitorLog : m_monitorLogs) {
+      spare->mutableRun().removeProperty(monitorLog);
+    }
+    m_monitorLogs.clear();
+
+    // Create a fresh monitor workspace and insert into the new 'main'
+    // workspace
+    auto monitorBuffer = active->monitorWorkspace();
+    auto newMonitorBuffer = WorkspaceFactory::Instance().create(
+        "EventWorkspace", monitorBuffer->getNumberHistograms(), 1, 1);
+    WorkspaceFactory::Instance().initializeFromParent(monitorBuffer,
+                                                      newMonitorBuffer, false);
+    spare->setMonitorWorkspace(newMonitorBuffer);
+
+    // New events go to the spare buffer from now on
+    m_eventBuffer.swap();
   } // mutex automatically unlocks here
 
-  return temp;
+  // Wait for the events of the current packet, if any, outside of the lock
+  return m_eventBuffer.extract();
 }
 
 /// Check the status of the current run
@@ -6,6 +6,8 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include <Poco/Thread.h>
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Timer.h"
 
 using namespace Mantid::API;
 using Mantid::Kernel::CPUTimer;
@@ -98,4 +100,52 @@ private:
   boost::shared_ptr<ILiveListener> fakel;
 };
 
+/** Throughput of the event buffer with the ingest thread generating events as
+ * fast as it can while the data are extracted as by MonitorLiveData.
+ */
+class FakeEventDataListenerTestPerformance : public CxxTest::TestSuite {
+public:
+  static FakeEventDataListenerTestPerformance *createSuite() {
+    return new FakeEventDataListenerTestPerformance();
+  }
+  static void destroySuite(FakeEventDataListenerTestPerformance *suite) {
+    delete suite;
+  }
+
+  void setUp() override {
+    auto &config = Mantid::Kernel::ConfigService::Instance();
+    m_datarate = config.getString("fakeeventdatalistener.datarate");
+    config.setString("fakeeventdatalistener.datarate", "50000000");
+  }
+
+  void tearDown() override {
+    Mantid::Kernel::ConfigService::Instance().setString(
+        "fakeeventdatalistener.datarate", m_datarate);
+  }
+
+  void test_extractData_at_50M_events_per_second() {
+    using namespace Mantid::DataObjects;
+    auto listener =
+        LiveListenerFactory::Instance().create("FakeEventDataListener", true);
+    listener->start(0);
+
+    size_t numEvents = 0;
+    Mantid::Kernel::Timer timer;
+    while (timer.elapsed_no_reset() < 5.0) {
+      Poco::Thread::sleep(100);
+      auto buffer = boost::dynamic_pointer_cast<const EventWorkspace>(
+          listener->extractData());
+      TS_ASSERT(buffer);
+      numEvents += buffer->getNumberEvents();
+    }
+    const double seconds = timer.elapsed();
+    std::cout << "Extracted " << static_cast<double>(numEvents) / seconds
+              << " events/s\n";
+    TS_ASSERT_LESS_THAN(0, numEvents);
+  }
+
+private:
+  std::string m_datarate;
+};
+
 #endif /* MANTID_LIVEDATA_FAKEEVENTDATALISTENERTEST_H_ */
@@ -0,0 +1,138 @@
+#ifndef MANTID_LIVEDATA_LIVEEVENTBUFFERTEST_H_
+#define MANTID_LIVEDATA_LIVEEVENTBUFFERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidLiveData/LiveEventBuffer.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidKernel/make_unique.h"
+
+#include <atomic>
+#include <thread>
+
+using Mantid::DataObjects::EventWorkspace;
+using Mantid::DataObjects::EventWorkspace_sptr;
+using Mantid::DataObjects::TofEvent;
+using Mantid::LiveData::LiveEventBuffer;
+
+class LiveEventBufferTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LiveEventBufferTest *createSuite() {
+    return new LiveEventBufferTest();
+  }
+  static void destroySuite(LiveEventBufferTest *suite) { delete suite; }
+
+  void test_default_constructed_buffer_is_not_initialized() {
+    LiveEventBuffer buffer;
+    TS_ASSERT(!buffer.initialized());
+    buffer.reset(createWorkspace());
+    TS_ASSERT(buffer.initialized());
+  }
+
+  void test_extract_returns_appended_events() {
+    auto workspace = createWorkspace();
+    LiveEventBuffer buffer(workspace);
+    TS_ASSERT_EQUALS(buffer.active(), workspace);
+    {
+      LiveEventBuffer::Appender appender(buffer);
+      appender.addEvent(0, TofEvent(1.0));
+      appender.addEvent(1, TofEvent(2.0));
+      appender.addEvent(1, TofEvent(3.0));
+    }
+    buffer.swap();
+    auto extracted = buffer.extract();
+    TS_ASSERT_EQUALS(extracted, workspace);
+    TS_ASSERT_EQUALS(extracted->getNumberEvents(), 3);
+    TS_ASSERT_EQUALS(extracted->getSpectrum(1).getNumberEvents(), 2);
+
+    {
+      LiveEventBuffer::Appender appender(buffer);
+      appender.addEvent(1, TofEvent(4.0));
+    }
+    buffer.swap();
+    extracted = buffer.extract();
+    TS_ASSERT_DIFFERS(extracted, workspace);
+    TS_ASSERT_EQUALS(extracted->getNumberEvents(), 1);
+    TS_ASSERT_DELTA(extracted->getSpectrum(1).getEvent(0).tof(), 4.0, 1e-12);
+    // The events that were extracted before are unchanged
+    TS_ASSERT_EQUALS(workspace->getNumberEvents(), 3);
+  }
+
+  void test_spare_buffers_keep_the_spectra_without_events() {
+    auto workspace = createWorkspace();
+    workspace->getSpectrum(0).addEventQuickly(TofEvent(1.0));
+    LiveEventBuffer buffer(workspace);
+    buffer.swap();
+    buffer.extract();
+    buffer.swap();
+    auto extracted = buffer.extract();
+    TS_ASSERT_EQUALS(extracted->getNumberHistograms(), 2);
+    TS_ASSERT_EQUALS(extracted->getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(extracted->getSpectrum(1).getSpectrumNo(), 12);
+    TS_ASSERT(extracted->getSpectrum(1).hasDetectorID(102));
+  }
+
+  void test_appender_keeps_its_buffer_across_swap() {
+    auto workspace = createWorkspace();
+    LiveEventBuffer buffer(workspace);
+    auto appender = Mantid::Kernel::make_unique<LiveEventBuffer::Appender>(
+        buffer);
+    buffer.swap();
+
+    std::atomic<bool> extracted{false};
+    EventWorkspace_sptr result;
+    std::thread extractor([&]() {
+      result = buffer.extract();
+      extracted = true;
+    });
+    // extract() waits for the appender
+    appender->addEvent(0, TofEvent(1.0));
+    TS_ASSERT(!extracted);
+    appender.reset();
+    extractor.join();
+
+    TS_ASSERT_EQUALS(result, workspace);
+    TS_ASSERT_EQUALS(result->getNumberEvents(), 1);
+    TS_ASSERT_EQUALS(buffer.active()->getNumberEvents(), 0);
+  }
+
+  void test_no_events_are_lost_while_extracting_concurrently() {
+    LiveEventBuffer buffer(createWorkspace());
+    const size_t numPackets = 2000;
+    const size_t eventsPerPacket = 100;
+
+    std::thread ingest([&]() {
+      for (size_t packet = 0; packet < numPackets; ++packet) {
+        LiveEventBuffer::Appender appender(buffer);
+        for (size_t i = 0; i < eventsPerPacket; ++i)
+          appender.addEvent(i % 2, TofEvent(static_cast<double>(i)));
+      }
+    });
+
+    size_t numEvents = 0;
+    for (size_t i = 0; i < 100; ++i) {
+      buffer.swap();
+      numEvents += buffer.extract()->getNumberEvents();
+    }
+    ingest.join();
+    buffer.swap();
+    numEvents += buffer.extract()->getNumberEvents();
+
+    TS_ASSERT_EQUALS(numEvents, numPackets * eventsPerPacket);
+  }
+
+private:
+  EventWorkspace_sptr createWorkspace() {
+    auto workspace = boost::make_shared<EventWorkspace>();
+    workspace->initialize(2, 2, 1);
+    for (size_t i = 0; i < 2; ++i) {
+      workspace->getSpectrum(i).setSpectrumNo(static_cast<int>(11 + i));
+      workspace->getSpectrum(i).setDetectorID(static_cast<int>(101 + i));
+    }
+    return workspace;
+  }
+};
+
+#endif /* MANTID_LIVEDATA_LIVEEVENTBUFFERTEST_H_ */
@@ -3,15 +3,19 @@
 
 #include "MantidLiveData/LoadLiveData.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidAPI/Axis.h"
 #include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/SpectrumInfo.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Timer.h"
 #include <cxxtest/TestSuite.h>
+#include <algorithm>
 #include <numeric>
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidAPI/LiveListenerFactory.h"
 #include "MantidTestHelpers/FacilityHelper.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include "TestGroupDataListener.h"
 
 using namespace Mantid;
@@ -20,6 +24,39 @@ using namespace Mantid::DataObjects;
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
 
+/** A listener giving back histogram chunks. In every chunk but the first one
+ * either a bin of the second spectrum or the whole first spectrum is masked.
+ */
+class MaskedDataListener : public ILiveListener {
+public:
+  explicit MaskedDataListener(bool maskSpectrum = false)
+      : m_maskSpectrum(maskSpectrum) {}
+  std::string name() const override { return "MaskedDataListener"; }
+  bool supportsHistory() const override { return false; }
+  bool buffersEvents() const override { return false; }
+  bool connect(const Poco::Net::SocketAddress &) override { return true; }
+  void start(DateAndTime) override {}
+  Workspace_sptr extractData() override {
+    auto ws =
+        WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(2, 10);
+    ws->mutableRun().addProperty("run_number", std::string("999"));
+    if (m_timesCalled++ == 0)
+      return ws;
+    if (m_maskSpectrum)
+      ws->maskWorkspaceIndex(0);
+    else
+      ws->flagMasked(1, 3, 0.5);
+    return ws;
+  }
+  bool isConnected() override { return true; }
+  RunStatus runStatus() override { return Running; }
+  int runNumber() const override { return 999; }
+
+private:
+  const bool m_maskSpectrum;
+  int m_timesCalled = 0;
+};
+
 class LoadLiveDataTest : public CxxTest::TestSuite {
 public:
   // This pair of boilerplate methods prevent the suite being created statically
@@ -146,13 +183,31 @@ public:
     TS_ASSERT_EQUALS(ws2->getNumberEvents(), 400);
 
     TSM_ASSERT("Workspace being added stayed the same pointer", ws1 == ws2);
-    TSM_ASSERT("Events are sorted", ws2->getSpectrum(0).isSortedByTof());
     TS_ASSERT_EQUALS(AnalysisDataService::Instance().size(), 1);
 
     // Test monitor workspace is present
     TS_ASSERT(ws2->monitorWorkspace());
   }
 
+  //--------------------------------------------------------------------------------------------
+  void test_add_sorts_events_when_read() {
+    EventWorkspace_sptr ws;
+    for (int i = 0; i < 3; ++i)
+      ws = doExec<EventWorkspace>("Add");
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), 600);
+    // The chunks are appended, the lists get sorted when they are read
+    const MantidVec X{0., 1e3, 1e4, 1e5};
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      const auto &el = ws->getSpectrum(i);
+      TS_ASSERT(!el.isSortedByTof());
+      MantidVec Y, E;
+      el.generateHistogram(X, Y, E);
+      TS_ASSERT(el.isSortedByTof());
+      TS_ASSERT(std::is_sorted(el.getEvents().begin(), el.getEvents().end()));
+      TS_ASSERT_DELTA(std::accumulate(Y.begin(), Y.end(), 0.), 300., 1e-10);
+    }
+  }
+
   //--------------------------------------------------------------------------------------------
   /** Make the test listener send out a "reset" signal. */
   void test_dataReset() {
@@ -212,6 +267,41 @@ public:
     TS_ASSERT_EQUALS(ws1->monitorWorkspace(), ws2->monitorWorkspace());
   }
 
+  //--------------------------------------------------------------------------------------------
+  void test_add_keeps_masked_bins_of_the_chunk() {
+    Workspace2D_sptr ws1, ws2;
+    ILiveListener_sptr listener = boost::make_shared<MaskedDataListener>();
+
+    ws1 = doExec<Workspace2D>("Add", "", "", "", "", true, listener);
+    TS_ASSERT(!ws1->hasMaskedBins(1));
+    ws2 = doExec<Workspace2D>("Add", "", "", "", "", true, listener);
+    TSM_ASSERT("Workspace being added stayed the same pointer", ws1 == ws2);
+    TS_ASSERT_DELTA(ws2->y(1)[3], 4.0, 1e-10);
+
+    TS_ASSERT(!ws2->hasMaskedBins(0));
+    TS_ASSERT(ws2->hasMaskedBins(1));
+    const auto &masks = ws2->maskedBins(1);
+    TS_ASSERT_EQUALS(masks.size(), 1);
+    TS_ASSERT_EQUALS(masks.begin()->first, 3);
+    TS_ASSERT_EQUALS(masks.begin()->second, 0.5);
+  }
+
+  //--------------------------------------------------------------------------------------------
+  void test_add_masks_the_spectra_masked_in_the_chunk() {
+    Workspace2D_sptr ws1, ws2;
+    ILiveListener_sptr listener = boost::make_shared<MaskedDataListener>(true);
+
+    ws1 = doExec<Workspace2D>("Add", "", "", "", "", true, listener);
+    TS_ASSERT(!ws1->spectrumInfo().isMasked(0));
+    ws2 = doExec<Workspace2D>("Add", "", "", "", "", true, listener);
+    TSM_ASSERT("Workspace being added stayed the same pointer", ws1 == ws2);
+
+    TS_ASSERT(ws2->spectrumInfo().isMasked(0));
+    TS_ASSERT_EQUALS(ws2->y(0)[3], 0.0);
+    TS_ASSERT(!ws2->spectrumInfo().isMasked(1));
+    TS_ASSERT_DELTA(ws2->y(1)[3], 4.0, 1e-10);
+  }
+
   //--------------------------------------------------------------------------------------------
   /** Simple processing of a chunk */
   void test_ProcessChunk_DoPreserveEvents() {
@@ -511,4 +601,54 @@ public:
   }
 };
 
+class LoadLiveDataTestPerformance : public CxxTest::TestSuite {
+public:
+  static LoadLiveDataTestPerformance *createSuite() {
+    return new LoadLiveDataTestPerformance();
+  }
+  static void destroySuite(LoadLiveDataTestPerformance *suite) {
+    delete suite;
+  }
+
+  void setUp() override {
+    FrameworkManager::Instance();
+    AnalysisDataService::Instance().clear();
+    ConfigService::Instance().setString("testdatalistener.reset_after", "0");
+  }
+
+  void tearDown() override { AnalysisDataService::Instance().clear(); }
+
+  /// An update every 30 seconds over an 8 hour run
+  void test_add_over_an_8_hour_run() {
+    FacilityHelper::ScopedFacilities loadTESTFacility(
+        "IDFs_for_UNIT_TESTING/UnitTestFacilities.xml", "TEST");
+    const int numUpdates = 8 * 60 * 2;
+    const int numTimed = 100;
+    double firstUpdates = 0.0;
+    double lastUpdates = 0.0;
+    for (int i = 0; i < numUpdates; ++i) {
+      LoadLiveData alg;
+      alg.initialize();
+      alg.setPropertyValue("Instrument", "TestDataListener");
+      alg.setPropertyValue("AccumulationMethod", "Add");
+      alg.setPropertyValue("OutputWorkspace", "fake");
+      Timer timer;
+      alg.execute();
+      const double seconds = timer.elapsed();
+      if (i > 0 && i <= numTimed)
+        firstUpdates += seconds;
+      else if (i >= numUpdates - numTimed)
+        lastUpdates += seconds;
+    }
+
+    auto ws = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+        "fake");
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), numUpdates * 200);
+    std::cout << "Mean time per update: " << firstUpdates / numTimed
+              << " s for the first " << numTimed << " updates, "
+              << lastUpdates / numTimed << " s for the last " << numTimed
+              << " updates\n";
+  }
+};
+
 #endif /* MANTID_LIVEDATA_LOADLIVEDATATEST_H_ */
@@ -66,7 +66,14 @@ private:
   /// Method to bin a single MDBox
   template <typename MDE, size_t nd>
   void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                const size_t *const chunkMax);
+                const size_t *const chunkMax, std::vector<coord_t> &outCenters,
+                std::vector<size_t> &linearIndices);
+
+  /// Compute the linear indices of transformed coordinates
+  void computeLinearIndices(const coord_t *outCenters, size_t numPoints,
+                            const size_t *const chunkMin,
+                            const size_t *const chunkMax,
+                            size_t *linearIndices) const;
 
   /// The output MDHistoWorkspace
   Mantid::DataObjects::MDHistoWorkspace_sptr outWS;
@@ -61,15 +61,32 @@ public:
   void runConversion(API::Progress *pProgress) override;
 
 private:
+  /// MD events converted from a range of spectra, staged until they are added
+  /// to the target workspace
+  struct ConvertedEvents {
+    std::vector<coord_t> coord;
+    std::vector<float> sig_err;
+    std::vector<uint16_t> run_index;
+    std::vector<uint32_t> det_ids;
+  };
+
   // function runs the conversion on
   size_t conversionChunk(size_t workspaceIndex) override;
   // the pointer to the source event workspace as event ws does not work through
   // the public Matrix WS interface
   DataObjects::EventWorkspace_const_sptr m_EventWS;
 
-  /**function converts particular type of events into MD space and add these
-   * events to the workspace itself    */
-  template <class T> size_t convertEventList(size_t workspaceIndex);
+  /// convert a range of spectra into the staging buffer
+  void convertSpectra(size_t begin, size_t end, MDTransfInterface &qConverter,
+                      ConvertedEvents &events) const;
+  /// add the staged events to the target workspace and empty the buffer
+  size_t addConvertedEvents(ConvertedEvents &events);
+
+  /**function converts particular type of events into MD space and appends
+   * them to the staging buffer    */
+  template <class T>
+  void convertEventList(size_t workspaceIndex, MDTransfInterface &qConverter,
+                        ConvertedEvents &events) const;
 };
 
 } // endNamespace DataObjects
@@ -80,6 +80,7 @@ public:
                   int Emode, bool forceViaTOF = false);
   void updateConversion(size_t i);
   double convertUnits(double val) const;
+  void convertUnits(const double *in, double *out, size_t n) const;
 
   bool isUnitConverted() const;
   std::pair<double, double> getConversionRange(double x1, double x2) const;
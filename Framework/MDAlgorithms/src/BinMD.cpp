@@ -14,6 +14,8 @@
 #include "MantidDataObjects/MDHistoWorkspace.h"
 #include "MantidMDAlgorithms/BinMD.h"
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <limits>
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidDataObjects/CoordTransformAffine.h"
 
@@ -80,21 +82,72 @@ void BinMD::init() {
                   "A name for the output MDHistoWorkspace.");
 }
 
+namespace {
+/// Marks points outside of the current chunk
+const size_t OUTSIDE_CHUNK = std::numeric_limits<size_t>::max();
+}
+
+//----------------------------------------------------------------------------------------------
+/** Compute the linear index in the output workspace of each transformed
+ * point. The loop over the points has no early exit, so the compiler can
+ * vectorise it.
+ *
+ * @param outCenters :: numPoints * m_outD transformed coordinates
+ * @param numPoints :: number of points
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ * @param linearIndices :: set to the linear index of each point, or
+ *OUTSIDE_CHUNK
+ */
+void BinMD::computeLinearIndices(const coord_t *outCenters, size_t numPoints,
+                                 const size_t *const chunkMin,
+                                 const size_t *const chunkMax,
+                                 size_t *linearIndices) const {
+  std::fill_n(linearIndices, numPoints, size_t(0));
+  std::vector<unsigned char> inside(numPoints, 1);
+  /// Loop through the dimensions on which we bin
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    const size_t multiplier = indexMultiplier[bd];
+    const size_t min = chunkMin[bd];
+    const size_t max = chunkMax[bd];
+    for (size_t i = 0; i < numPoints; ++i) {
+      // What is the bin index in that dimension
+      const coord_t x = outCenters[i * m_outD + bd];
+      const size_t ix = size_t(x);
+      // Within range (for this chunk)?
+      inside[i] &= static_cast<unsigned char>((x >= 0) & (ix >= min) &
+                                              (ix < max));
+      // Build up the linear index
+      linearIndices[i] += multiplier * ix;
+    }
+  }
+  for (size_t i = 0; i < numPoints; ++i)
+    if (!inside[i])
+      linearIndices[i] = OUTSIDE_CHUNK;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Bin the contents of a MDBox
+ *
+ * The centers of all the events are transformed in one batch, then all their
+ * linear indices are computed before the signal is added to the output.
  *
  * @param box :: pointer to the MDBox to bin
  * @param chunkMin :: the minimum index in each dimension to consider "valid"
  *(inclusive)
  * @param chunkMax :: the maximum index in each dimension to consider "valid"
  *(exclusive)
+ * @param outCenters :: buffer for the transformed coordinates, reused between
+ *boxes
+ * @param linearIndices :: buffer for the linear indices, reused between boxes
  */
 template <typename MDE, size_t nd>
 inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                            const size_t *const chunkMax) {
-  // An array to hold the rotated/transformed coordinates
-  auto outCenter = new coord_t[m_outD];
-
+                            const size_t *const chunkMax,
+                            std::vector<coord_t> &outCenters,
+                            std::vector<size_t> &linearIndices) {
   // Evaluate whether the entire box is in the same bin
   if (box->getNPoints() > (1 << nd) * 2) {
     // There is a check that the number of events is enough for it to make sense
@@ -102,61 +155,23 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
     size_t numVertexes = 0;
     coord_t *vertexes = box->getVertexesArray(numVertexes);
 
-    // All vertexes have to be within THE SAME BIN = have the same linear index.
-    size_t lastLinearIndex = 0;
-    bool badOne = false;
-
-    for (size_t i = 0; i < numVertexes; i++) {
-      // Cache the center of the event (again for speed)
-      const coord_t *inCenter = vertexes + i * nd;
-
-      // Now transform to the output dimensions
-      m_transform->apply(inCenter, outCenter);
-      // std::cout << "Input coord " << VMD(nd,inCenter) << " transformed to "
-      // <<  VMD(nd,outCenter) << '\n';
-
-      // To build up the linear index
-      size_t linearIndex = 0;
-      // To mark VERTEXES outside range
-      badOne = false;
-
-      /// Loop through the dimensions on which we bin
-      for (size_t bd = 0; bd < m_outD; bd++) {
-        // What is the bin index in that dimension
-        coord_t x = outCenter[bd];
-        size_t ix = size_t(x);
-        // Within range (for this chunk)?
-        if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-          // Build up the linear index
-          linearIndex += indexMultiplier[bd] * ix;
-        } else {
-          // Outside the range
-          badOne = true;
-          break;
-        }
-      } // (for each dim in MDHisto)
-
-      // Is the vertex at the same place as the last one?
-      if (!badOne) {
-        if ((i > 0) && (linearIndex != lastLinearIndex)) {
-          // Change of index
-          badOne = true;
-          break;
-        }
-        lastLinearIndex = linearIndex;
-      }
-
-      // Was the vertex completely outside the range?
-      if (badOne)
-        break;
-    } // (for each vertex)
-
+    // Now transform to the output dimensions
+    outCenters.resize(numVertexes * m_outD);
+    linearIndices.resize(numVertexes);
+    m_transform->applyBatch(vertexes, nd * sizeof(coord_t), numVertexes,
+                            outCenters.data());
     delete[] vertexes;
+    computeLinearIndices(outCenters.data(), numVertexes, chunkMin, chunkMax,
+                         linearIndices.data());
+
+    // All vertexes have to be within THE SAME BIN = have the same linear index.
+    const size_t lastLinearIndex = linearIndices[0];
+    bool badOne = lastLinearIndex == OUTSIDE_CHUNK;
+    for (size_t i = 1; i < numVertexes && !badOne; i++)
+      badOne = linearIndices[i] != lastLinearIndex;
 
     if (!badOne) {
       // Yes, the entire box is within a single bin
-      //        std::cout << "Box at " << box->getExtentsStr() << " is within a
-      //        single bin.\n";
       // Add the CACHED signal from the entire box
       signals[lastLinearIndex] += box->getSignal();
       errors[lastLinearIndex] += box->getErrorSquared();
@@ -166,7 +181,6 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
 
       // And don't bother looking at each event. This may save lots of time
       // loading from disk.
-      delete[] outCenter;
       return;
     }
   }
@@ -175,47 +189,31 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
   // same bin.
   // So you need to iterate through events.
   const std::vector<MDE> &events = box->getConstEvents();
-  for (auto it = events.begin(); it != events.end(); ++it) {
-    // Cache the center of the event (again for speed)
-    const coord_t *inCenter = it->getCenter();
-
-    // Now transform to the output dimensions
-    m_transform->apply(inCenter, outCenter);
-
-    // To build up the linear index
-    size_t linearIndex = 0;
-    // To mark events outside range
-    bool badOne = false;
-
-    /// Loop through the dimensions on which we bin
-    for (size_t bd = 0; bd < m_outD; bd++) {
-      // What is the bin index in that dimension
-      coord_t x = outCenter[bd];
-      size_t ix = size_t(x);
-      // Within range (for this chunk)?
-      if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-        // Build up the linear index
-        linearIndex += indexMultiplier[bd] * ix;
-      } else {
-        // Outside the range
-        badOne = true;
-        break;
+  const size_t numPoints = events.size();
+  if (numPoints > 0) {
+    // Transform the centers of all events straight out of the event vector
+    outCenters.resize(numPoints * m_outD);
+    linearIndices.resize(numPoints);
+    m_transform->applyBatch(events.front().getCenter(), sizeof(MDE),
+                            numPoints, outCenters.data());
+    computeLinearIndices(outCenters.data(), numPoints, chunkMin, chunkMax,
+                         linearIndices.data());
+
+    for (size_t i = 0; i < numPoints; ++i) {
+      const size_t linearIndex = linearIndices[i];
+      if (linearIndex != OUTSIDE_CHUNK) {
+        // Sum the signals as doubles to preserve precision
+        signals[linearIndex] += static_cast<signal_t>(events[i].getSignal());
+        errors[linearIndex] +=
+            static_cast<signal_t>(events[i].getErrorSquared());
+        // TODO: If DataObjects get a weight, this would need to get the summed
+        // weight.
+        numEvents[linearIndex] += 1.0;
       }
-    } // (for each dim in MDHisto)
-
-    if (!badOne) {
-      // Sum the signals as doubles to preserve precision
-      signals[linearIndex] += static_cast<signal_t>(it->getSignal());
-      errors[linearIndex] += static_cast<signal_t>(it->getErrorSquared());
-      // TODO: If DataObjects get a weight, this would need to get the summed
-      // weight.
-      numEvents[linearIndex] += 1.0;
     }
   }
   // Done with the events list
   box->releaseEvents();
-
-  delete[] outCenter;
 }
 
 //----------------------------------------------------------------------------------------------
@@ -325,11 +323,14 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       }
 
       // Go through every box for this chunk.
+      std::vector<coord_t> outCenters;
+      std::vector<size_t> linearIndices;
       for (auto &boxe : boxes) {
         MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
         // Perform the binning in this separate method.
         if (box && !box->getIsMasked())
-          this->binMDBox(box, chunkMin.data(), chunkMax.data());
+          this->binMDBox(box, chunkMin.data(), chunkMax.data(), outCenters,
+                         linearIndices);
 
         // Progress reporting
         if (prog)
@@ -1,19 +1,44 @@
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
 
+#include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/make_unique.h"
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
 
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <memory>
+
 namespace Mantid {
 namespace MDAlgorithms {
-/**function converts particular list of events of type T into MD workspace and
- * adds these events to the workspace itself  */
+
+namespace {
+/// Approximate number of events converted by one task
+const size_t EVENTS_PER_TASK = 100000;
+/// Number of events whose units are converted together
+const size_t UNITS_BLOCK_SIZE = 1024;
+}
+
+/**function converts particular list of events of type T into MD events and
+ * appends them to the staging buffer
+ * @param workspaceIndex -- the index of the spectrum to convert
+ * @param qConverter     -- the MD transformation to use. Each thread needs its
+ *                          own copy as the transformation caches per-spectrum
+ *                          values
+ * @param events         -- the buffer to append the converted events to
+ */
 template <class T>
-size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
+void ConvToMDEventsWS::convertEventList(size_t workspaceIndex,
+                                        MDTransfInterface &qConverter,
+                                        ConvertedEvents &events) const {
 
   const Mantid::DataObjects::EventList &el =
       m_EventWS->getSpectrum(workspaceIndex);
   size_t numEvents = el.getNumberEvents();
   if (numEvents == 0)
-    return 0;
+    return;
 
   // create local unit conversion class
   UnitsConversionHelper localUnitConv(m_UnitConversion);
@@ -24,67 +49,87 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   std::vector<coord_t> locCoord(m_Coord);
   // set up unit conversion and calculate up all coordinates, which depend on
   // spectra index only
-  if (!m_QConverter->calcYDepCoordinates(locCoord, workspaceIndex))
-    return 0; // skip if any y outsize of the range of interest;
+  if (!qConverter.calcYDepCoordinates(locCoord, workspaceIndex))
+    return; // skip if any y outsize of the range of interest;
   localUnitConv.updateConversion(workspaceIndex);
-  //
-  // allocate temporary buffers for MD Events data
-  // MD events coordinates buffer
-  std::vector<coord_t> allCoord;
-  std::vector<float> sig_err;      // array for signal and error.
-  std::vector<uint16_t> run_index; // Buffer for run index for each event
-  std::vector<uint32_t> det_ids;   // Buffer of det Id-s for each event
-
-  allCoord.reserve(this->m_NDims * numEvents);
-  sig_err.reserve(2 * numEvents);
-  run_index.reserve(numEvents);
-  det_ids.reserve(numEvents);
 
   // This little dance makes the getting vector of events more general (since
   // you can't overload by return type).
   typename std::vector<T> const *events_ptr;
   getEventsFrom(el, events_ptr);
-  const typename std::vector<T> &events = *events_ptr;
-
-  // Iterators to start/end
-  for (auto it = events.cbegin(); it != events.cend(); it++) {
-    double val = localUnitConv.convertUnits(it->tof());
-    double signal = it->weight();
-    double errorSq = it->errorSquared();
-    if (!m_QConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
-      continue; // skip ND outside the range
-
-    sig_err.push_back(static_cast<float>(signal));
-    sig_err.push_back(static_cast<float>(errorSq));
-    run_index.push_back(runIndexLoc);
-    det_ids.push_back(detID);
-    allCoord.insert(allCoord.end(), locCoord.begin(), locCoord.end());
+  const typename std::vector<T> &eventList = *events_ptr;
+
+  // Convert the units of a block of events at a time
+  double val[UNITS_BLOCK_SIZE];
+  for (size_t start = 0; start < numEvents; start += UNITS_BLOCK_SIZE) {
+    const size_t count = std::min(UNITS_BLOCK_SIZE, numEvents - start);
+    for (size_t i = 0; i < count; ++i)
+      val[i] = eventList[start + i].tof();
+    localUnitConv.convertUnits(val, val, count);
+
+    for (size_t i = 0; i < count; ++i) {
+      const T &event = eventList[start + i];
+      double signal = event.weight();
+      double errorSq = event.errorSquared();
+      if (!qConverter.calcMatrixCoord(val[i], locCoord, signal, errorSq))
+        continue; // skip ND outside the range
+
+      events.sig_err.push_back(static_cast<float>(signal));
+      events.sig_err.push_back(static_cast<float>(errorSq));
+      events.run_index.push_back(runIndexLoc);
+      events.det_ids.push_back(detID);
+      events.coord.insert(events.coord.end(), locCoord.begin(), locCoord.end());
+    }
   }
+}
 
-  // Add them to the MDEW
-  size_t n_added_events = run_index.size();
-  m_OutWSWrapper->addMDData(sig_err, run_index, det_ids, allCoord,
-                            n_added_events);
+/** Convert the events of the spectra [begin, end) into the staging buffer.
+ * Only reads the source workspace, so that ranges can be converted
+ * concurrently as long as each one has its own transformation and buffer. */
+void ConvToMDEventsWS::convertSpectra(size_t begin, size_t end,
+                                      MDTransfInterface &qConverter,
+                                      ConvertedEvents &events) const {
+  for (size_t wi = begin; wi < end; ++wi) {
+    switch (m_EventWS->getSpectrum(wi).getEventType()) {
+    case Mantid::API::TOF:
+      this->convertEventList<Mantid::DataObjects::TofEvent>(wi, qConverter,
+                                                            events);
+      break;
+    case Mantid::API::WEIGHTED:
+      this->convertEventList<Mantid::DataObjects::WeightedEvent>(
+          wi, qConverter, events);
+      break;
+    case Mantid::API::WEIGHTED_NOTIME:
+      this->convertEventList<Mantid::DataObjects::WeightedEventNoTime>(
+          wi, qConverter, events);
+      break;
+    default:
+      throw std::runtime_error("EventList had an unexpected data type!");
+    }
+  }
+}
+
+/** Add the staged events to the target workspace. The buffer is emptied but
+ * keeps its capacity for reuse.
+ * @return the number of events added */
+size_t ConvToMDEventsWS::addConvertedEvents(ConvertedEvents &events) {
+  size_t n_added_events = events.run_index.size();
+  if (n_added_events > 0)
+    m_OutWSWrapper->addMDData(events.sig_err, events.run_index, events.det_ids,
+                              events.coord, n_added_events);
+  events.coord.clear();
+  events.sig_err.clear();
+  events.run_index.clear();
+  events.det_ids.clear();
   return n_added_events;
 }
 
 /** The method runs conversion for a single event list, corresponding to a
  * particular workspace index */
 size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex) {
-
-  switch (m_EventWS->getSpectrum(workspaceIndex).getEventType()) {
-  case Mantid::API::TOF:
-    return this->convertEventList<Mantid::DataObjects::TofEvent>(
-        workspaceIndex);
-  case Mantid::API::WEIGHTED:
-    return this->convertEventList<Mantid::DataObjects::WeightedEvent>(
-        workspaceIndex);
-  case Mantid::API::WEIGHTED_NOTIME:
-    return this->convertEventList<Mantid::DataObjects::WeightedEventNoTime>(
-        workspaceIndex);
-  default:
-    throw std::runtime_error("EventList had an unexpected data type!");
-  }
+  ConvertedEvents events;
+  convertSpectra(workspaceIndex, workspaceIndex + 1, *m_QConverter, events);
+  return addConvertedEvents(events);
 }
 
 /** method sets up all internal variables necessary to convert from Event
@@ -112,6 +157,11 @@ ConvToMDEventsWS::initialize(const MDWSDescription &WSD,
   return numSpec;
 }
 
+/** Convert all spectra. The spectra are processed in batches: the spectra of
+ * a batch are split into contiguous ranges, which are converted concurrently
+ * into separate buffers. The buffers are then added to the workspace in
+ * order, so the result does not depend on the number of threads.
+ */
 void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
 
   // Get the box controller
@@ -119,29 +169,30 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
       m_OutWSWrapper->pWorkspace()->getBoxController();
   size_t lastNumBoxes = bc->getTotalNumMDBoxes();
   size_t nEventsInWS = m_OutWSWrapper->pWorkspace()->getNPoints();
-  // Is the access to input events thread-safe?
-  // bool MultiThreadedAdding = m_EventWS->threadSafe();
   // preprocessed detectors insure that each detector has its own spectra
   size_t nValidSpectra = m_NSpectra;
 
   //--->>> Thread control stuff
-  Kernel::ThreadSchedulerFIFO *ts(nullptr);
+  Kernel::ThreadScheduler *ts(nullptr);
+  std::unique_ptr<Kernel::ThreadPool> tp;
 
-  int nThreads(m_NumThreads);
-  if (nThreads < 0)
-    nThreads = 0; // negative m_NumThreads correspond to all cores used, 0 no
-                  // threads and positive number -- nThreads requested;
+  // negative m_NumThreads correspond to all cores used, 0 no threads and
+  // positive number -- nThreads requested;
+  size_t nThreads(0);
   bool runMultithreaded = false;
   if (m_NumThreads != 0) {
     runMultithreaded = true;
-    // Create the thread pool that will run all of these. It will be deleted by
-    // the threadpool
-    ts = new Kernel::ThreadSchedulerFIFO();
-    // it will initiate thread pool with number threads or machine's cores (0 in
-    // tp constructor)
-    pProgress->resetNumSteps(nValidSpectra, 0, 1);
+    nThreads = m_NumThreads > 0 ? static_cast<size_t>(m_NumThreads)
+                                : Kernel::ThreadPool::getNumPhysicalCores();
+    // Create the thread pool that will run all of these. The scheduler will
+    // be deleted by the threadpool
+    if (Kernel::ThreadPool::useWorkStealing())
+      ts = new Kernel::ThreadSchedulerWorkStealing(nThreads);
+    else
+      ts = new Kernel::ThreadSchedulerFIFO();
+    tp = Kernel::make_unique<Kernel::ThreadPool>(ts, nThreads);
   }
-  Kernel::ThreadPool tp(ts, nThreads, new API::Progress(*pProgress));
+  pProgress->resetNumSteps(nValidSpectra, 0, 1);
   //<<<--  Thread control stuff
 
   // if any property dimension is outside of the data range requested, the job
@@ -149,25 +200,62 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   if (!m_QConverter->calcGenericVariables(m_Coord, m_NDims))
     return;
 
+  // One transformation and one buffer per task. Two tasks per thread give
+  // some room for balancing spectra of different size.
+  const size_t nTasks = runMultithreaded ? 2 * nThreads : 1;
+  std::vector<std::unique_ptr<MDTransfInterface>> converters(nTasks);
+  for (auto &converter : converters)
+    converter.reset(m_QConverter->clone());
+  std::vector<ConvertedEvents> buffers(nTasks);
+  std::vector<size_t> taskBegin(nTasks + 1);
+
   size_t eventsAdded = 0;
-  for (size_t wi = 0; wi < nValidSpectra; wi++) {
+  size_t wi = 0;
+  while (wi < nValidSpectra) {
+    // Split the next batch of spectra into ranges of similar number of events
+    size_t task = 0;
+    for (; task < nTasks && wi < nValidSpectra; ++task) {
+      taskBegin[task] = wi;
+      size_t nEvents = 0;
+      do {
+        nEvents += m_EventWS->getSpectrum(wi).getNumberEvents();
+        ++wi;
+      } while (wi < nValidSpectra && nEvents < EVENTS_PER_TASK);
+    }
+    const size_t nBatchTasks = task;
+    taskBegin[nBatchTasks] = wi;
 
-    size_t nConverted = this->conversionChunk(wi);
-    eventsAdded += nConverted;
-    nEventsInWS += nConverted;
-    // Give this task to the scheduler
-    //%double cost = double(el.getNumberEvents());
-    // ts->push( new FunctionTask( func, cost) );
+    if (runMultithreaded) {
+      for (task = 0; task < nBatchTasks; ++task) {
+        double cost =
+            static_cast<double>(taskBegin[task + 1] - taskBegin[task]);
+        tp->schedule(new Kernel::FunctionTask(
+            boost::bind(&ConvToMDEventsWS::convertSpectra, this,
+                        taskBegin[task], taskBegin[task + 1],
+                        boost::ref(*converters[task]),
+                        boost::ref(buffers[task])),
+            cost));
+      }
+      tp->joinAll();
+    } else {
+      convertSpectra(taskBegin[0], taskBegin[1], *converters[0], buffers[0]);
+    }
+
+    // Adding to the workspace is not thread-safe; do it in task order
+    for (task = 0; task < nBatchTasks; ++task) {
+      size_t nConverted = addConvertedEvents(buffers[task]);
+      eventsAdded += nConverted;
+      nEventsInWS += nConverted;
+    }
+    pProgress->report(wi);
 
     // Keep a running total of how many events we've added
     if (bc->shouldSplitBoxes(nEventsInWS, eventsAdded, lastNumBoxes)) {
       if (runMultithreaded) {
-        // Do all the adding tasks
-        tp.joinAll();
         // Now do all the splitting tasks
         m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(ts);
         if (ts->size() > 0)
-          tp.joinAll();
+          tp->joinAll();
       } else {
         m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(
             nullptr); // it is done this way as it is possible trying to do
@@ -179,14 +267,12 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
                          ->getBoxController()
                          ->getTotalNumMDBoxes();
       eventsAdded = 0;
-      pProgress->report(wi);
     }
   }
   // Do a final splitting of everything
   if (runMultithreaded) {
-    tp.joinAll();
     m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(ts);
-    tp.joinAll();
+    tp->joinAll();
   } else {
     m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(nullptr);
   }
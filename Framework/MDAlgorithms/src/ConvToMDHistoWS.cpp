@@ -96,18 +96,17 @@ size_t ConvToMDHistoWS::conversionChunk(size_t startSpectra) {
     localUnitConv.updateConversion(i);
     std::vector<double> XtargetUnits;
     XtargetUnits.resize(X.size());
+    localUnitConv.convertUnits(X.data(), XtargetUnits.data(), X.size());
 
     if (histogram) {
-      double xm1 = localUnitConv.convertUnits(X[0]);
+      double xm1 = XtargetUnits[0];
       for (size_t j = 1; j < XtargetUnits.size(); j++) {
-        double xm = localUnitConv.convertUnits(X[j]);
+        double xm = XtargetUnits[j];
         XtargetUnits[j - 1] = 0.5 * (xm + xm1);
         xm1 = xm;
       }
       XtargetUnits.back() = xm1; // just in case, should not be used
-    } else
-      for (size_t j = 0; j < XtargetUnits.size(); j++)
-        XtargetUnits[j] = localUnitConv.convertUnits(X[j]);
+    }
 
     //=> START INTERNAL LOOP OVER THE "TIME"
     for (size_t j = 0; j < specSize; ++j) {
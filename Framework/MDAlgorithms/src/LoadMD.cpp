@@ -104,6 +104,15 @@ void LoadMD::init() {
   setPropertySettings("Memory", make_unique<EnabledWhenProperty>(
                                     "FileBackEnd", IS_EQUAL_TO, "1"));
 
+  declareProperty(
+      make_unique<PropertyWithValue<bool>>("MemoryMapped", false),
+      "For FileBackEnd only: open the file read-only and map the events into "
+      "memory instead of reading them. Requires a file saved with the "
+      "MemoryMappable option of SaveMD; other files are read as usual.\n"
+      "The workspace can not be modified if this is set.");
+  setPropertySettings("MemoryMapped", make_unique<EnabledWhenProperty>(
+                                          "FileBackEnd", IS_EQUAL_TO, "1"));
+
   declareProperty("LoadHistory", true,
                   "If true, the workspace history will be loaded");
 
@@ -542,9 +551,17 @@ void LoadMD::doLoad(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // ---------------------------------------- DEAL WITH BOXES
   // ------------------------------------
   if (fileBackEnd) { // TODO:: call to the file format factory
-    auto loader = boost::shared_ptr<API::IBoxControllerIO>(
-        new DataObjects::BoxControllerNeXusIO(bc.get()));
+    auto loader =
+        boost::make_shared<DataObjects::BoxControllerNeXusIO>(bc.get());
     loader->setDataType(sizeof(coord_t), MDE::getTypeName());
+    const bool memoryMapped = getProperty("MemoryMapped");
+    if (memoryMapped) {
+      loader->setMemoryMapped(true);
+      loader->openFile(m_filename, "r");
+      if (!loader->isMemoryMapped())
+        g_log.warning() << "Could not memory-map the events, they will be "
+                           "read from the file.\n";
+    }
     bc->setFileBacked(loader, m_filename);
     // boxes have been already made file-backed when restoring the boxTree;
     // How much memory for the cache?
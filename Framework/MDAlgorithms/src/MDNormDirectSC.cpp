@@ -457,6 +457,7 @@ void MDNormDirectSC::calculateNormalization(
     solidAngDetToIdx = solidAngleWS->getDetectorIDToWorkspaceIndexMap();
   }
 
+  signal_t *signalArray = m_normWS->getSignalArray();
   auto prog = make_unique<API::Progress>(this, 0.3, 1.0, ndets);
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t i = 0; i < ndets; i++) {
@@ -524,10 +525,10 @@ void MDNormDirectSC::calculateNormalization(
       // *PC
       double signal = solid * delta;
 
-      PARALLEL_CRITICAL(updateMD) {
-        signal += m_normWS->getSignalAt(linIndex);
-        m_normWS->setSignalAt(linIndex, signal);
-      }
+      // Different threads rarely hit the same bin, so atomic adds scale much
+      // better than a lock around the whole update
+      PARALLEL_ATOMIC
+      signalArray[linIndex] += signal;
     }
     prog->report();
 
@@ -403,6 +403,7 @@ void MDNormSCD::calculateNormalization(
   const detid2index_map solidAngDetToIdx =
       solidAngleWS->getDetectorIDToWorkspaceIndexMap();
 
+  signal_t *signalArray = m_normWS->getSignalArray();
   auto prog = make_unique<API::Progress>(this, 0.3, 1.0, ndets);
   PARALLEL_FOR_IF(Kernel::threadSafe(*integrFlux))
   for (int64_t i = 0; i < ndets; i++) {
@@ -485,10 +486,10 @@ void MDNormSCD::calculateNormalization(
       // signal = integral between two consecutive intersections
       double signal = (yValues[k] - yValues[k - 1]) * solid;
 
-      PARALLEL_CRITICAL(updateMD) {
-        signal += m_normWS->getSignalAt(linIndex);
-        m_normWS->setSignalAt(linIndex, signal);
-      }
+      // Different threads rarely hit the same bin, so atomic adds scale much
+      // better than a lock around the whole update
+      PARALLEL_ATOMIC
+      signalArray[linIndex] += signal;
     }
     prog->report();
 
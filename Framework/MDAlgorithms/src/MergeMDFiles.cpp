@@ -3,6 +3,8 @@
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 #include "MantidKernel/VectorHelper.h"
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDEventFactory.h"
@@ -239,7 +241,11 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
   // Prepare thread pool
   CPUTimer overallTime;
 
-  auto ts = new ThreadSchedulerFIFO();
+  ThreadScheduler *ts;
+  if (ThreadPool::useWorkStealing())
+    ts = new ThreadSchedulerWorkStealing();
+  else
+    ts = new ThreadSchedulerFIFO();
   ThreadPool tp(ts);
 
   Kernel::DiskBuffer *DiskBuf(nullptr);
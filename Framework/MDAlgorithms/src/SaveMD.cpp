@@ -13,6 +13,7 @@
 #include "MantidAPI/Progress.h"
 #include "MantidKernel/EnabledWhenProperty.h"
 #include <Poco/File.h>
+#include <algorithm>
 #include "MantidDataObjects/MDHistoWorkspace.h"
 #include "MantidDataObjects/MDBoxFlatTree.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
@@ -76,6 +77,15 @@ void SaveMD::init() {
   setPropertySettings(
       "MakeFileBacked",
       make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+
+  declareProperty("MemoryMappable", false,
+                  "For an MDEventWorkspace that was created in memory:\n"
+                  "Store the events contiguously, so that LoadMD can map "
+                  "them into memory with the MemoryMapped option. The file "
+                  "can not be extended later.");
+  setPropertySettings(
+      "MemoryMappable",
+      make_unique<EnabledWhenProperty>("MakeFileBacked", IS_EQUAL_TO, "0"));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -159,8 +169,8 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     // the boxes file positions are unknown and we need to calculate it.
     BoxFlatStruct.initFlatStructure(ws, filename);
     // create saver class
-    auto Saver = boost::shared_ptr<API::IBoxControllerIO>(
-        new DataObjects::BoxControllerNeXusIO(bc.get()));
+    auto Saver =
+        boost::make_shared<DataObjects::BoxControllerNeXusIO>(bc.get());
     Saver->setDataType(sizeof(coord_t), MDE::getTypeName());
     if (makeFileBackend) {
       // store saver with box controller
@@ -196,10 +206,19 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       Saver->flushData();
     } else // just save data, and finish with it
     {
-      Saver->openFile(filename, "w");
       BoxFlatStruct.setBoxesFilePositions(false);
       std::vector<API::IMDNode *> &boxes = BoxFlatStruct.getBoxes();
       std::vector<uint64_t> &eventIndex = BoxFlatStruct.getEventIndex();
+      const bool memoryMappable = getProperty("MemoryMappable");
+      if (memoryMappable) {
+        // The size of the contiguous event data set has to be known upfront
+        uint64_t nEvents(0);
+        for (size_t i = 0; i < boxes.size(); i++)
+          nEvents =
+              std::max(nEvents, eventIndex[2 * i] + eventIndex[2 * i + 1]);
+        Saver->setContiguousFileLength(nEvents);
+      }
+      Saver->openFile(filename, "w");
       prog->resetNumSteps(boxes.size(), 0.06, 0.90);
       for (size_t i = 0; i < boxes.size(); i++) {
         if (eventIndex[2 * i + 1] == 0 || boxes[i]->getIsMasked())
@@ -64,6 +64,15 @@ void SaveMD2::init() {
   setPropertySettings(
       "MakeFileBacked",
       make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+
+  declareProperty("MemoryMappable", false,
+                  "For an MDEventWorkspace that was created in memory:\n"
+                  "Store the events contiguously, so that LoadMD can map "
+                  "them into memory with the MemoryMapped option. The file "
+                  "can not be extended later.");
+  setPropertySettings(
+      "MemoryMappable",
+      make_unique<EnabledWhenProperty>("MakeFileBacked", IS_EQUAL_TO, "0"));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -209,6 +218,8 @@ void SaveMD2::exec() {
                                 getProperty("UpdateFileBackEnd"));
     saveMDv1->setProperty<bool>("MakeFileBacked",
                                 getProperty("MakeFileBacked"));
+    saveMDv1->setProperty<bool>("MemoryMappable",
+                                getProperty("MemoryMappable"));
     saveMDv1->execute();
   } else if (histoWS) {
     this->doSaveHisto(histoWS);
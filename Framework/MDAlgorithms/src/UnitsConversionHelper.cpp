@@ -2,6 +2,7 @@
 #include "MantidAPI/NumericAxis.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/Strings.h"
+#include <algorithm>
 #include <cmath>
 
 namespace Mantid {
@@ -332,6 +333,38 @@ double UnitsConversionHelper::convertUnits(double val) const {
         "updateConversion: unknown type of conversion requested");
   }
 }
+/** do unit conversion of an array of values from input to output units
+@param   in   -- the values to convert
+@param   out  -- the array to place the converted values in. May be the same
+                 array as in
+@param   n    -- the number of values
+*/
+void UnitsConversionHelper::convertUnits(const double *in, double *out,
+                                         size_t n) const {
+  switch (m_UnitCnvrsn) {
+  case (CnvrtToMD::ConvertNo): {
+    if (in != out)
+      std::copy(in, in + n, out);
+    return;
+  }
+  case (CnvrtToMD::ConvertFast): {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = m_Factor * std::pow(in[i], m_Power);
+    return;
+  }
+  case (CnvrtToMD::ConvertFromTOF): {
+    m_TargetUnit->multipleFromTOF(in, out, n);
+    return;
+  }
+  case (CnvrtToMD::ConvertByTOF): {
+    m_SourceWSUnit->convertViaTOF(*m_TargetUnit, in, out, n);
+    return;
+  }
+  default:
+    throw std::runtime_error(
+        "updateConversion: unknown type of conversion requested");
+  }
+}
 // copy constructor;
 UnitsConversionHelper::UnitsConversionHelper(
     const UnitsConversionHelper &another) {
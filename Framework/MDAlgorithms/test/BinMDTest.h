@@ -1122,14 +1122,16 @@ public:
 
   ~BinMDTestPerformance() override {
     AnalysisDataService::Instance().remove("BinMDTest_ws");
+    if (!m_filename.empty() && Poco::File(m_filename).exists())
+      Poco::File(m_filename).remove();
   }
 
-  void do_test(std::string binParams, bool IterateEvents) {
+  void do_test(std::string binParams, bool IterateEvents,
+               const std::string &inputWS = "BinMDTest_ws") {
     BinMD alg;
     TS_ASSERT_THROWS_NOTHING(alg.initialize())
     TS_ASSERT(alg.isInitialized())
-    TS_ASSERT_THROWS_NOTHING(
-        alg.setPropertyValue("InputWorkspace", "BinMDTest_ws"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("InputWorkspace", inputWS));
     TS_ASSERT_THROWS_NOTHING(
         alg.setPropertyValue("AlignedDim0", "Axis0," + binParams));
     TS_ASSERT_THROWS_NOTHING(
@@ -1158,6 +1160,42 @@ public:
     for (size_t i = 0; i < 1; i++)
       do_test("2.0,8.0, 1", true);
   }
+
+  void test_3D_60cube_FileBackEnd() { do_test_file_backed(false); }
+
+  void test_3D_60cube_FileBackEnd_MemoryMapped() {
+    do_test_file_backed(true);
+  }
+
+private:
+  /// Bin a file-backed copy of the workspace, reading or mapping the events
+  void do_test_file_backed(bool memoryMapped) {
+    if (m_filename.empty()) {
+      SaveMD2 saver;
+      saver.initialize();
+      saver.setPropertyValue("InputWorkspace", "BinMDTest_ws");
+      saver.setPropertyValue("Filename", "BinMDTestPerformance.nxs");
+      saver.setProperty("MemoryMappable", true);
+      saver.execute();
+      m_filename = saver.getPropertyValue("Filename");
+    }
+    LoadMD loader;
+    loader.initialize();
+    loader.setPropertyValue("Filename", m_filename);
+    loader.setProperty("FileBackEnd", true);
+    loader.setProperty("MemoryMapped", memoryMapped);
+    loader.setPropertyValue("OutputWorkspace", "BinMDTest_fileWS");
+    TS_ASSERT_THROWS_NOTHING(loader.execute());
+
+    do_test("2.0,8.0, 60", true, "BinMDTest_fileWS");
+
+    auto ws = AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(
+        "BinMDTest_fileWS");
+    ws->clearFileBacked(false);
+    AnalysisDataService::Instance().remove("BinMDTest_fileWS");
+  }
+
+  std::string m_filename;
 };
 
 #endif /* MANTID_MDALGORITHMS_BINTOMDHISTOWORKSPACETEST_H_ */
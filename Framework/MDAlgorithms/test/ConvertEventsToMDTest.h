@@ -65,6 +65,24 @@ public:
     AnalysisDataService::Instance().remove("testMDEvWorkspace");
   }
 
+  void test_multithreaded_conversion_matches_serial() {
+    auto serial = convertWithThreads(0, "testMDEvSerial");
+    auto threaded = convertWithThreads(4, "testMDEvThreads");
+    TS_ASSERT(serial);
+    TS_ASSERT(threaded);
+    if (!serial || !threaded)
+      return;
+    TS_ASSERT_EQUALS(900, serial->getNPoints());
+    TS_ASSERT_EQUALS(serial->getNPoints(), threaded->getNPoints());
+    auto serialBox = serial->getBox();
+    auto threadedBox = threaded->getBox();
+    TS_ASSERT_DELTA(serialBox->getSignal(), threadedBox->getSignal(), 1e-6);
+    TS_ASSERT_DELTA(serialBox->getErrorSquared(),
+                    threadedBox->getErrorSquared(), 1e-6);
+    AnalysisDataService::Instance().remove("testMDEvSerial");
+    AnalysisDataService::Instance().remove("testMDEvThreads");
+  }
+
   ConvertEventsToMDTest() {
     FrameworkManager::Instance();
 
@@ -84,6 +102,31 @@ public:
 
     AnalysisDataService::Instance().addOrReplace("testEvWS", wsEv);
   }
+
+private:
+  /// Run ConvertToMD on testEvWS with the given NUM_THREADS
+  boost::shared_ptr<MDEventWorkspace3>
+  convertWithThreads(int nThreads, const std::string &outputName) {
+    auto inWS =
+        AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("testEvWS");
+    inWS->mutableRun().addProperty("NUM_THREADS", double(nThreads), true);
+
+    ConvertEvents2MDEvTestHelper alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", "testEvWS");
+    alg.setPropertyValue("OutputWorkspace", outputName);
+    alg.setPropertyValue("OtherDimensions", "");
+    alg.setPropertyValue("QDimensions", "Q3D");
+    alg.setPropertyValue("PreprocDetectorsWS", "");
+    alg.setPropertyValue("dEAnalysisMode", "Elastic");
+    alg.setPropertyValue("MinValues", "-10,-10,-10");
+    alg.setPropertyValue("MaxValues", " 10, 10, 10");
+    alg.execute();
+    inWS->mutableRun().removeProperty("NUM_THREADS");
+    TS_ASSERT(alg.isExecuted());
+    return AnalysisDataService::Instance().retrieveWS<MDEventWorkspace3>(
+        outputName);
+  }
 };
 
 #endif /* MANTID_MDEVENTS_MAKEDIFFRACTIONMDEVENTWORKSPACETEST_H_ */
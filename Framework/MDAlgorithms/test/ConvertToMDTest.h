@@ -11,6 +11,8 @@
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 
 #include "MantidAPI/AlgorithmManager.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/Timer.h"
 #include <Poco/File.h>
 #include <cxxtest/TestSuite.h>
 
@@ -727,6 +729,43 @@ public:
         boost::lexical_cast<std::string>(sec) + " sec");
   }
 
+  void test_EventFromTOFConv_thread_scaling() {
+    NumericAxis *pAxis0 = new NumericAxis(2);
+    pAxis0->setUnit("TOF");
+    inWsEv->replaceAxis(0, pAxis0);
+
+    MDWSDescription WSD;
+    std::vector<double> min(4, -1e+30), max(4, 1e+30);
+    WSD.setMinMax(min, max);
+    WSD.buildFromMatrixWS(inWsEv, "Q3D", "Indirect");
+    WSD.m_PreprDetTable = pDetLoc_events;
+    WSD.m_RotMatrix = Rot;
+    WSD.addProperty("RUN_INDEX", static_cast<uint16_t>(10), true);
+
+    const size_t maxThreads = Kernel::ThreadPool::getNumPhysicalCores();
+    for (size_t nThreads = 1; nThreads <= std::min(maxThreads, size_t(64));
+         nThreads *= 2) {
+      inWsEv->mutableRun().addProperty("NUM_THREADS", double(nThreads), true);
+      pTargWS->releaseWorkspace();
+      pTargWS->createEmptyMDWS(WSD);
+
+      ConvToMDSelector AlgoSelector;
+      pConvMethods = AlgoSelector.convSelector(inWsEv, pConvMethods);
+      pConvMethods->initialize(WSD, pTargWS, false);
+
+      pMockAlgorithm->resetProgress(numHist);
+      Kernel::Timer timer;
+      TS_ASSERT_THROWS_NOTHING(
+          pConvMethods->runConversion(pMockAlgorithm->getProgress()));
+      double sec = timer.elapsed();
+      size_t nEvents = pTargWS->pWorkspace()->getNPoints();
+      TS_WARN("Events per second with " +
+              boost::lexical_cast<std::string>(nThreads) + " threads: " +
+              boost::lexical_cast<std::string>(double(nEvents) / sec));
+    }
+    inWsEv->mutableRun().removeProperty("NUM_THREADS");
+  }
+
   ConvertToMDTestPerformance() : Rot(3, 3) {
     numHist = 100 * 100;
     size_t nEvents = 1000;
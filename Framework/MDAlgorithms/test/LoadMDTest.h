@@ -170,7 +170,8 @@ public:
   //=================================================================================================================
   template <size_t nd>
   void do_test_exec(bool FileBackEnd, bool deleteWorkspace = true,
-                    double memory = 0, bool BoxStructureOnly = false) {
+                    double memory = 0, bool BoxStructureOnly = false,
+                    bool memoryMapped = false) {
     typedef MDLeanEvent<nd> MDE;
 
     //------ Start by creating the file
@@ -203,6 +204,7 @@ public:
         saver.setProperty("InputWorkspace", "LoadMDTest_ws"));
     TS_ASSERT_THROWS_NOTHING(saver.setPropertyValue(
         "Filename", "LoadMDTest" + Strings::toString(nd) + ".nxs"));
+    TS_ASSERT_THROWS_NOTHING(saver.setProperty("MemoryMappable", memoryMapped));
 
     // Retrieve the full path; delete any pre-existing file
     std::string filename = saver.getPropertyValue("Filename");
@@ -222,6 +224,7 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Filename", filename));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("FileBackEnd", FileBackEnd));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("Memory", memory));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("MemoryMapped", memoryMapped));
     TS_ASSERT_THROWS_NOTHING(
         alg.setPropertyValue("OutputWorkspace", outWSName));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("MetadataOnly", false));
@@ -406,6 +409,11 @@ public:
     do_test_exec<3>(true, true, 1.0);
   }
 
+  /// Keep the events on file and map them into memory
+  void test_exec_3D_with_FileBackEnd_MemoryMapped() {
+    do_test_exec<3>(true, true, 0.0, false, true);
+  }
+
   /** Use the file back end,
    * then change it and save to update the file at the back end.
    */
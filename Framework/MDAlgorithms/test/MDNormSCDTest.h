@@ -6,8 +6,11 @@
 #include "MantidMDAlgorithms/MDNormSCD.h"
 #include "MantidMDAlgorithms/CreateMDWorkspace.h"
 #include "MantidAPI/Axis.h"
+#include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/IMDHistoWorkspace.h"
+#include "MantidAPI/Run.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidDataObjects/EventWorkspace.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 
 using Mantid::MDAlgorithms::MDNormSCD;
@@ -111,4 +114,74 @@ private:
   }
 };
 
+class MDNormSCDTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDNormSCDTestPerformance *createSuite() {
+    return new MDNormSCDTestPerformance();
+  }
+  static void destroySuite(MDNormSCDTestPerformance *suite) { delete suite; }
+
+  MDNormSCDTestPerformance() {
+    FrameworkManager::Instance();
+    // 100 banks of 32x32 pixels: 102400 detectors. The normalization only
+    // depends on the detectors, so no events are needed.
+    auto dataWS =
+        WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(100,
+                                                                        32);
+    dataWS->mutableRun().setProtonCharge(1.0);
+    AnalysisDataService::Instance().addOrReplace("__MDNormSCDPerf_data",
+                                                 dataWS);
+    FrameworkManager::Instance().exec(
+        "SetUB", 14, "Workspace", "__MDNormSCDPerf_data", "a", "5", "b", "5",
+        "c", "5", "alpha", "90", "beta", "90", "gamma", "90");
+    FrameworkManager::Instance().exec(
+        "ConvertToMD", 16, "InputWorkspace", "__MDNormSCDPerf_data",
+        "QDimensions", "Q3D", "dEAnalysisMode", "Elastic", "Q3DFrames", "HKL",
+        "QConversionScales", "HKL", "MinValues", "-10,-10,-10", "MaxValues",
+        "10,10,10", "OutputWorkspace", "__MDNormSCDPerf_md");
+
+    const size_t numHist = dataWS->getNumberHistograms();
+    auto flux = WorkspaceFactory::Instance().create(dataWS, numHist, 2, 2);
+    auto solidAngle =
+        WorkspaceFactory::Instance().create(dataWS, numHist, 2, 1);
+    for (size_t i = 0; i < numHist; ++i) {
+      flux->dataX(i)[0] = 1.0;
+      flux->dataX(i)[1] = 10.0;
+      flux->dataY(i)[0] = 0.0;
+      flux->dataY(i)[1] = 1.0;
+      solidAngle->dataX(i)[0] = 1.0;
+      solidAngle->dataX(i)[1] = 10.0;
+      solidAngle->dataY(i)[0] = 1.0;
+    }
+    flux->getAxis(0)->setUnit("Momentum");
+    solidAngle->getAxis(0)->setUnit("Momentum");
+    AnalysisDataService::Instance().addOrReplace("__MDNormSCDPerf_flux", flux);
+    AnalysisDataService::Instance().addOrReplace("__MDNormSCDPerf_sa",
+                                                 solidAngle);
+  }
+
+  ~MDNormSCDTestPerformance() override {
+    AnalysisDataService::Instance().clear();
+  }
+
+  void test_normalization_200_cubed_bins() {
+    MDNormSCD alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setPropertyValue("InputWorkspace", "__MDNormSCDPerf_md");
+    alg.setPropertyValue("AlignedDim0", "[H,0,0],-8,8,200");
+    alg.setPropertyValue("AlignedDim1", "[0,K,0],-8,8,200");
+    alg.setPropertyValue("AlignedDim2", "[0,0,L],-8,8,200");
+    alg.setPropertyValue("FluxWorkspace", "__MDNormSCDPerf_flux");
+    alg.setPropertyValue("SolidAngleWorkspace", "__MDNormSCDPerf_sa");
+    alg.setPropertyValue("OutputWorkspace", "__MDNormSCDPerf_out");
+    alg.setPropertyValue("OutputNormalizationWorkspace",
+                         "__MDNormSCDPerf_norm");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+  }
+};
+
 #endif /* MANTID_MDALGORITHMS_MDNORMSCDTEST_H_ */
@@ -69,6 +69,8 @@ public:
   /// open the nexus file for writing
   void openNexusWrite(const std::string &fileName,
                       optional_size_t entryNumber = optional_size_t());
+  /// Name of the entry opened by openNexusWrite, e.g. mantid_workspace_1
+  const std::string &entryName() const { return m_entryName; }
   /// write the header ifon for the Mantid workspace format
   int writeNexusProcessedHeader(const std::string &title,
                                 const std::string &wsName = "") const;
@@ -204,6 +206,8 @@ private:
 
   /// nexus file name
   std::string m_filename;
+  /// name of the open mantid_workspace_<n> entry
+  std::string m_entryName;
 
   /** Writes a numeric log to the Nexus file
    *  @tparam T A numeric type (double, int, bool)
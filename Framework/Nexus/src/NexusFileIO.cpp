@@ -39,12 +39,12 @@ Logger g_log("NexusFileIO");
 /// Empty default constructor
 NexusFileIO::NexusFileIO()
     : fileID(), m_filehandle(), m_nexuscompression(NX_COMP_LZW),
-      m_progress(nullptr), m_filename() {}
+      m_progress(nullptr), m_filename(), m_entryName() {}
 
 /// Constructor that supplies a progress object
 NexusFileIO::NexusFileIO(Progress *prog)
     : fileID(), m_filehandle(), m_nexuscompression(NX_COMP_LZW),
-      m_progress(prog), m_filename() {}
+      m_progress(prog), m_filename(), m_entryName() {}
 
 void NexusFileIO::resetProgress(Progress *prog) { m_progress = prog; }
 
@@ -149,6 +149,7 @@ void NexusFileIO::openNexusWrite(const std::string &fileName,
   //
   const std::string className = "NXentry";
 
+  m_entryName = mantidEntryName;
   m_filehandle->makeGroup(mantidEntryName, className);
   m_filehandle->openGroup(mantidEntryName, className);
 }